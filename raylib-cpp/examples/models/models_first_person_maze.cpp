@@ -25,17 +25,18 @@ int main(void)
 
     raylib::Image imMap("resources/cubicmap.png");      // Load cubicmap image (RAM)
     raylib::Texture cubicmap(imMap);                    // Convert image to texture to display (VRAM)
-    raylib::MeshUnmanaged mesh = raylib::MeshUnmanaged::Cubicmap(imMap, Vector3{ 1.0f, 1.0f, 1.0f });     // Use MeshUnmanaged, Mesh will be handled by Model
+    raylib::CubicMap map(imMap);                        // Wall grid, used for the mesh and for collision
+    raylib::MeshUnmanaged mesh = map.GenMesh();         // Merged faces; use MeshUnmanaged, Mesh will be handled by Model
     raylib::Model model(mesh);
 
-    // NOTE: By default each cube is mapped to one part of texture atlas
-    raylib::Texture texture("resources/cubicmap_atlas.png");    // Load map texture
+    // NOTE: Merged faces span many cells, so they tile one texture rather than using parts of the atlas
+    raylib::Image imAtlas("resources/cubicmap_atlas.png");
+    imAtlas.Crop(imAtlas.width/2, imAtlas.height/2);    // Keep the atlas' wall tile
+    raylib::Texture texture(imAtlas);                   // Load map texture
     model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;     // Set map diffuse texture
 
-    // Get map image data to be used for collision detection
-    Color *mapPixels = imMap.LoadColors();
-
-    imMap.Unload();                   // Unload image from RAM
+    imMap.Unload();                   // Unload images from RAM
+    imAtlas.Unload();
 
     raylib::Vector3 mapPosition(-16.0f, 0.0f, -8.0f);   // Set model position
     raylib::Vector3 playerPosition(camera.position);    // Set player position
@@ -55,8 +56,8 @@ int main(void)
         raylib::Vector2 playerPos(camera.position.x, camera.position.z);
         float playerRadius = 0.1f;  // Collision radius (player is modelled as a cilinder for collision)
 
-        int playerCellX = static_cast<int>(playerPos.x - mapPosition.x + 0.5f);
-        int playerCellY = static_cast<int>(playerPos.y - mapPosition.z + 0.5f);
+        int playerCellX, playerCellY;
+        map.GetCell(playerPos - raylib::Vector2(mapPosition.x, mapPosition.z), &playerCellX, &playerCellY);
 
         // Out-of-limits security check
         if (playerCellX < 0) playerCellX = 0;
@@ -65,20 +66,11 @@ int main(void)
         if (playerCellY < 0) playerCellY = 0;
         else if (playerCellY >= cubicmap.height) playerCellY = cubicmap.height - 1;
 
-        // Check map collisions using image data and player position
-        // TODO: Improvement: Just check player surrounding cells for collision
-        for (int y = 0; y < cubicmap.height; y++)
+        // Check map collisions against the cells around the player only
+        if (map.CheckCollision(playerPos - raylib::Vector2(mapPosition.x, mapPosition.z), playerRadius))
         {
-            for (int x = 0; x < cubicmap.width; x++)
-            {
-                if ((mapPixels[y*cubicmap.width + x].r == 255) &&       // Collision: white pixel, only check R channel
-                    (playerPos.CheckCollisionCircle(playerRadius,
-                    Rectangle{ mapPosition.x - 0.5f + x*1.0f, mapPosition.z - 0.5f + y*1.0f, 1.0f, 1.0f })))
-                {
-                    // Collision detected, reset camera position
-                    camera.position = oldCamPos;
-                }
-            }
+            // Collision detected, reset camera position
+            camera.position = oldCamPos;
         }
         //----------------------------------------------------------------------------------
 
@@ -110,8 +102,6 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
 
-    UnloadImageColors(mapPixels);          // Unload color array
-
     //----------------------------------------------------------------------------------
 
     return 0;
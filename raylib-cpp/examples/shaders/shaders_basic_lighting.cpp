@@ -76,6 +76,15 @@ int main(void)
         CreateLight(LIGHT_POINT, (Vector3) {2, 1, -2}, Vector3Zero(), BLUE, shader),
     };
 
+    // Uniforms updated every frame: locations are looked up once, and only changed values are sent
+    raylib::UniformBlock uniforms(shader);
+    int viewPosUniform = uniforms.Add("viewPos", SHADER_UNIFORM_VEC3);
+    std::array<int, MAX_LIGHTS> enabledUniforms;
+    for (int i = 0; i < MAX_LIGHTS; i++)
+    {
+        enabledUniforms[i] = uniforms.Add(TextFormat("lights[%i].enabled", i), SHADER_UNIFORM_INT);
+    }
+
     SetTargetFPS(60);                   // Set our game to run at 60 frames-per-second
     //--------------------------------------------------------------------------------------
 
@@ -87,8 +96,7 @@ int main(void)
         camera.Update(CAMERA_ORBITAL);
 
         // Update the shader with the camera view vector (points towards { 0.0f, 0.0f, 0.0f })
-        std::array<float, 3> cameraPos = { camera.position.x, camera.position.y, camera.position.z };
-        SetShaderValue(shader, shader.locs[SHADER_LOC_VECTOR_VIEW], cameraPos.data(), SHADER_UNIFORM_VEC3);
+        uniforms.Set(viewPosUniform, camera.position);
 
         // Check key inputs to enable/disable lights
         if (IsKeyPressed(KEY_Y)) { lights[0].enabled = !lights[0].enabled; }
@@ -96,8 +104,9 @@ int main(void)
         if (IsKeyPressed(KEY_G)) { lights[2].enabled = !lights[2].enabled; }
         if (IsKeyPressed(KEY_B)) { lights[3].enabled = !lights[3].enabled; }
 
-        // Update light values (actually, only enable/disable them)
-        for (const auto& light : lights) UpdateLightValues(shader, light);
+        // Update light values (actually, only enable/disable them), sending only the ones that changed
+        for (int i = 0; i < MAX_LIGHTS; i++) uniforms.Set(enabledUniforms[i], lights[i].enabled);
+        uniforms.Upload();
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -95,8 +95,10 @@ int main()
     camera.projection = CAMERA_PERSPECTIVE;             // Camera projection type
 
     // Load PBR shader and setup all required locations
-    raylib::Shader shader (TextFormat("resources/shaders/glsl%i/pbr.vs", GLSL_VERSION),
-                           TextFormat("resources/shaders/glsl%i/pbr.fs", GLSL_VERSION));
+    // NOTE: The linked program is kept in shadercache/, so later runs skip compiling it
+    raylib::ShaderCache shaderCache("shadercache");
+    raylib::Shader shader (shaderCache.Load(TextFormat("resources/shaders/glsl%i/pbr.vs", GLSL_VERSION),
+                                            TextFormat("resources/shaders/glsl%i/pbr.fs", GLSL_VERSION)));
     shader.locs[SHADER_LOC_MAP_ALBEDO] = GetShaderLocation(shader, "albedoMap");
     // WARNING: Metalness, roughness, and ambient occlusion are all packed into a MRA texture
     // They are passed as to the SHADER_LOC_MAP_METALNESS location for convenience,
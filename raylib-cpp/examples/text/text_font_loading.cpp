@@ -42,6 +42,10 @@ int main() {
     // NOTE: We define a font base size of 32 pixels tall and up-to 250 characters
     raylib::Font fontTtf("resources/pixantiqua.ttf", 32, 0, 250);
 
+    // The message doesn't change, so lay it out once for each font rather than on every frame
+    raylib::TextLayout msgBm(fontBm, msg, fontBm.baseSize, 2, MAROON);
+    raylib::TextLayout msgTtf(fontTtf, msg, fontTtf.baseSize, 2, LIME);
+
     bool useTtf = false;
 
     window.SetTargetFPS(60);               // Set our game to run at 60 frames-per-second
@@ -66,12 +70,12 @@ int main() {
 
             if (!useTtf)
             {
-                fontBm.DrawText(msg, Vector2{ 20.0f, 100.0f }, fontBm.baseSize, 2, MAROON);
+                msgBm.Draw(Vector2{ 20.0f, 100.0f });
                 raylib::DrawText("Using BMFont (Angelcode) imported", 20, GetScreenHeight() - 30, 20, GRAY);
             }
             else
             {
-                fontTtf.DrawText(msg, Vector2{ 20.0f, 100.0f }, fontTtf.baseSize, 2, LIME);
+                msgTtf.Draw(Vector2{ 20.0f, 100.0f });
                 raylib::DrawText("Using TTF font generated", 20, GetScreenHeight() - 30, 20, GRAY);
             }
         }
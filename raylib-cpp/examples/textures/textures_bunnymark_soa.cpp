@@ -0,0 +1,116 @@
+/*******************************************************************************************
+*
+*   raylib [textures] example - Bunnymark (contiguous storage)
+*
+*   Same workload as textures_bunnymark, with the bunnies kept in parallel contiguous
+*   arrays instead of a std::list<Bunny>. Positions advance with one raylib::Vector2Batch
+*   call over the whole array, and the update and draw times are shown so the two
+*   layouts can be compared side by side.
+*
+*   This example has been created using raylib 1.6 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2014-2019 Ramon Santamaria (@raysan5)
+*
+********************************************************************************************/
+
+#include <vector>
+
+#include "raylib-cpp.hpp"
+
+// This is the maximum amount of elements (quads) per batch
+// NOTE: This value is defined in [rlgl] module and can be changed there
+#define MAX_BATCH_ELEMENTS  8192
+
+// One array per field: the update streams through positions and speeds only
+struct Bunnies {
+    std::vector<raylib::Vector2> position;
+    std::vector<raylib::Vector2> speed;
+    std::vector<raylib::Color> color;
+
+    size_t Size() const { return position.size(); }
+
+    void Spawn(Vector2 at) {
+        position.push_back(at);
+        speed.push_back(raylib::Vector2(
+            static_cast<float>(GetRandomValue(-250, 250)) / 60.0f,
+            static_cast<float>(GetRandomValue(-250, 250)) / 60.0f));
+        color.push_back(raylib::Color(
+            GetRandomValue(50, 240),
+            GetRandomValue(80, 240),
+            GetRandomValue(100, 240)));
+    }
+
+    void Update(const raylib::Texture2D& texBunny) {
+        const size_t count = Size();
+        raylib::Vector2Batch::Add(position.data(), position.data(), speed.data(), count);
+
+        const float halfW = texBunny.width / 2.0f;
+        const float halfH = texBunny.height / 2.0f;
+        const float screenW = static_cast<float>(GetScreenWidth());
+        const float screenH = static_cast<float>(GetScreenHeight());
+        for (size_t i = 0; i < count; i++) {
+            if (position[i].x + halfW > screenW || position[i].x + halfW < 0) speed[i].x *= -1;
+            if (position[i].y + halfH > screenH || position[i].y + halfH - 40 < 0) speed[i].y *= -1;
+        }
+    }
+};
+
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 800;
+    const int screenHeight = 450;
+
+    raylib::Window window(screenWidth, screenHeight, "raylib [textures] example - bunnymark (contiguous)");
+
+    // Load bunny texture
+    raylib::Texture2D texBunny("resources/wabbit_alpha.png");
+
+    Bunnies bunnies;
+
+    SetTargetFPS(60);               // Set our game to run at 60 frames-per-second
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!window.ShouldClose()) {    // Detect window close button or ESC key
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+            // Create more bunnies
+            for (int i = 0; i < 100; i++) {
+                bunnies.Spawn(GetMousePosition());
+            }
+        }
+
+        double updateStart = GetTime();
+        bunnies.Update(texBunny);
+        double updateMs = (GetTime() - updateStart) * 1000.0;
+        //----------------------------------------------------------------------------------
+
+        // Draw
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+        {
+            window.ClearBackground(RAYWHITE);
+
+            double drawStart = GetTime();
+            for (size_t i = 0; i < bunnies.Size(); i++) {
+                texBunny.Draw(bunnies.position[i], bunnies.color[i]);
+            }
+            double drawMs = (GetTime() - drawStart) * 1000.0;
+
+            DrawRectangle(0, 0, screenWidth, 40, BLACK);
+            raylib::DrawText(TextFormat("bunnies: %i", static_cast<int>(bunnies.Size())), 100, 10, 20, GREEN);
+            raylib::DrawText(TextFormat("draw calls: %i", 1 + static_cast<int>(bunnies.Size())/MAX_BATCH_ELEMENTS), 260, 10, 20, MAROON);
+            raylib::DrawText(TextFormat("update %.2f ms  draw %.2f ms", updateMs, drawMs), 460, 10, 20, RAYWHITE);
+
+            DrawFPS(10, 10);
+        }
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * Baked skinning results for model animation clips.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_ANIMATIONCACHE_HPP_
+#define RAYLIB_CPP_INCLUDE_ANIMATIONCACHE_HPP_
+
+#ifndef RAYLIB_CPP_NO_MATH
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "./raylib.hpp"
+#include "./raymath.hpp"
+
+namespace raylib {
+/**
+ * Every frame of one ModelAnimation clip, skinned once for one model and kept.
+ *
+ * Model::UpdateAnimation skins every vertex on the CPU each time it is called, for each model, even when many models
+ * play the same clip. The cache does that work once per frame of the clip, up front, and afterwards Apply() (or
+ * Model::UpdateAnimation(cache, frame)) only uploads the stored vertices. One cache serves every model that shares the
+ * meshes it was built from, at any mix of frames.
+ *
+ * Frames are independent, so they are skinned in parallel, one band of frames per thread. Skinning matches raylib's
+ * CPU path (UpdateModelAnimationBones followed by UpdateModelAnimation). Memory is frames x vertices x 24 bytes (12
+ * when there are no normals); GetBytes() reports it.
+ *
+ * @code
+ * raylib::AnimationCache walk(model, anims[0]);
+ * for (const Walker& w : walkers) {
+ *     model.UpdateAnimation(walk, w.frame);
+ *     model.Draw(w.position);
+ * }
+ * @endcode
+ */
+class AnimationCache {
+public:
+    /**
+     * Skins every frame of anim for model. threads 0 uses one per hardware thread.
+     */
+    AnimationCache(const ::Model& model, const ::ModelAnimation& anim, int threads = 0) { Bake(model, anim, threads); }
+
+    int GetFrameCount() const { return frameCount; }
+    int GetMeshCount() const { return (int)meshes.size(); }
+    size_t GetBytes() const { return data.size() * sizeof(float); }
+
+    /**
+     * Skinned positions (3 floats per vertex) of one mesh at one frame, or null if that mesh isn't skinned
+     */
+    const float* GetVertices(int frame, int mesh) const {
+        const MeshSlice* slice = Slice(mesh);
+        return slice ? &data[FrameBase(frame) + slice->vertices] : nullptr;
+    }
+
+    /**
+     * Skinned normals of one mesh at one frame, or null if that mesh isn't skinned or has none
+     */
+    const float* GetNormals(int frame, int mesh) const {
+        const MeshSlice* slice = Slice(mesh);
+        return slice && slice->hasNormals ? &data[FrameBase(frame) + slice->normals] : nullptr;
+    }
+
+    /**
+     * Uploads frame (wrapped to the clip length) to model's vertex buffers. model must have the meshes the cache was
+     * built from, or copies of them; meshes that differ are left alone.
+     */
+    void Apply(const ::Model& model, int frame) const {
+        if (frameCount == 0 || model.meshCount != (int)meshes.size()) return;
+        for (int m = 0; m < model.meshCount; m++) {
+            const ::Mesh& mesh = model.meshes[m];
+            const MeshSlice& slice = meshes[(size_t)m];
+            if (!slice.skinned || mesh.vertexCount != slice.vertexCount || mesh.vboId == nullptr) continue;
+            int bytes = mesh.vertexCount * 3 * (int)sizeof(float);
+            ::UpdateMeshBuffer(mesh, 0, GetVertices(frame, m), bytes, 0);
+            if (slice.hasNormals) ::UpdateMeshBuffer(mesh, 2, GetNormals(frame, m), bytes, 0);
+        }
+    }
+
+protected:
+    struct MeshSlice {
+        bool skinned = false;
+        bool hasNormals = false;
+        int vertexCount = 0;
+        size_t vertices = 0; // Float offsets within a frame
+        size_t normals = 0;
+    };
+
+    int frameCount = 0;
+    size_t frameFloats = 0;
+    std::vector<MeshSlice> meshes;
+    std::vector<float> data; // frameCount blocks of frameFloats
+
+    size_t FrameBase(int frame) const {
+        frame %= frameCount;
+        if (frame < 0) frame += frameCount;
+        return (size_t)frame * frameFloats;
+    }
+
+    const MeshSlice* Slice(int mesh) const {
+        if (frameCount == 0 || mesh < 0 || mesh >= (int)meshes.size() || !meshes[(size_t)mesh].skinned) return nullptr;
+        return &meshes[(size_t)mesh];
+    }
+
+    void Bake(const ::Model& model, const ::ModelAnimation& anim, int threads) {
+        if (anim.frameCount <= 0 || anim.framePoses == nullptr || model.bindPose == nullptr) return;
+        if (anim.boneCount > model.boneCount) return;
+
+        meshes.resize((size_t)model.meshCount);
+        for (int m = 0; m < model.meshCount; m++) {
+            const ::Mesh& mesh = model.meshes[m];
+            MeshSlice& slice = meshes[(size_t)m];
+            slice.vertexCount = mesh.vertexCount;
+            slice.skinned = mesh.vertices != nullptr && mesh.boneIds != nullptr && mesh.boneWeights != nullptr;
+            if (!slice.skinned) continue;
+            slice.hasNormals = mesh.normals != nullptr;
+            slice.vertices = frameFloats;
+            frameFloats += (size_t)mesh.vertexCount * 3;
+            if (slice.hasNormals) {
+                slice.normals = frameFloats;
+                frameFloats += (size_t)mesh.vertexCount * 3;
+            }
+        }
+        if (frameFloats == 0) {
+            meshes.clear();
+            return;
+        }
+        frameCount = anim.frameCount;
+        data.assign((size_t)frameCount * frameFloats, 0.0f);
+
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+        if (threads > frameCount) threads = frameCount;
+        if (threads <= 1) {
+            SkinFrames(model, anim, 0, frameCount);
+            return;
+        }
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) {
+            workers.push_back(std::thread(&AnimationCache::SkinFrames, this, std::cref(model), std::cref(anim),
+                                          frameCount * t / threads, frameCount * (t + 1) / threads));
+        }
+        SkinFrames(model, anim, 0, frameCount / threads);
+        for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    }
+
+    static ::Matrix PoseMatrix(const ::Transform& t) {
+        return ::MatrixMultiply(::MatrixMultiply(::MatrixScale(t.scale.x, t.scale.y, t.scale.z),
+                                                 ::QuaternionToMatrix(t.rotation)),
+                                ::MatrixTranslate(t.translation.x, t.translation.y, t.translation.z));
+    }
+
+    /**
+     * Skins frames [first, last) into data. Only reads the model and clip, so bands run side by side.
+     */
+    void SkinFrames(const ::Model& model, const ::ModelAnimation& anim, int first, int last) {
+        std::vector<::Matrix> bones((size_t)anim.boneCount);
+        std::vector<::Matrix> normalBones((size_t)anim.boneCount);
+        for (int frame = first; frame < last; frame++) {
+            for (int b = 0; b < anim.boneCount; b++) {
+                bones[(size_t)b] = ::MatrixMultiply(::MatrixInvert(PoseMatrix(model.bindPose[b])),
+                                            PoseMatrix(anim.framePoses[frame][b]));
+                normalBones[(size_t)b] = ::MatrixTranspose(::MatrixInvert(bones[(size_t)b]));
+            }
+            float* out = &data[(size_t)frame * frameFloats];
+            for (int m = 0; m < model.meshCount; m++) {
+                const MeshSlice& slice = meshes[(size_t)m];
+                if (!slice.skinned) continue;
+                const ::Mesh& mesh = model.meshes[m];
+                float* vertices = out + slice.vertices;
+                float* normals = slice.hasNormals ? out + slice.normals : nullptr;
+                for (int v = 0; v < mesh.vertexCount; v++) {
+                    ::Vector3 position{0.0f, 0.0f, 0.0f}, normal{0.0f, 0.0f, 0.0f};
+                    ::Vector3 restPosition{mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]};
+                    for (int j = 0; j < 4; j++) {
+                        float weight = mesh.boneWeights[v * 4 + j];
+                        int bone = mesh.boneIds[v * 4 + j];
+                        if (weight == 0.0f || bone >= anim.boneCount) continue;
+                        ::Vector3 p = ::Vector3Transform(restPosition, bones[(size_t)bone]);
+                        position.x += p.x * weight;
+                        position.y += p.y * weight;
+                        position.z += p.z * weight;
+                        if (normals) {
+                            ::Vector3 rest{mesh.normals[v * 3], mesh.normals[v * 3 + 1], mesh.normals[v * 3 + 2]};
+                            ::Vector3 n = ::Vector3Transform(rest, normalBones[(size_t)bone]);
+                            normal.x += n.x * weight;
+                            normal.y += n.y * weight;
+                            normal.z += n.z * weight;
+                        }
+                    }
+                    vertices[v * 3] = position.x;
+                    vertices[v * 3 + 1] = position.y;
+                    vertices[v * 3 + 2] = position.z;
+                    if (normals) {
+                        normals[v * 3] = normal.x;
+                        normals[v * 3 + 1] = normal.y;
+                        normals[v * 3 + 2] = normal.z;
+                    }
+                }
+            }
+        }
+    }
+};
+} // namespace raylib
+
+using RAnimationCache = raylib::AnimationCache;
+
+#endif // RAYLIB_CPP_NO_MATH
+
+#endif // RAYLIB_CPP_INCLUDE_ANIMATIONCACHE_HPP_
@@ -26,7 +26,7 @@ public:
      *
      * @param fileName The file path to load the automation events list from.
      */
-    AutomationEventList(const char* fileName) { Load(fileName); }
+    AutomationEventList(const char* fileName) : ::AutomationEventList{} { Load(fileName); }
 
     AutomationEventList(const AutomationEventList&) = delete;
 
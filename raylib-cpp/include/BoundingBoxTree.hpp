@@ -0,0 +1,320 @@
+/**
+ * Bounding volume hierarchy over scene object boxes.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_BOUNDINGBOXTREE_HPP_
+#define RAYLIB_CPP_INCLUDE_BOUNDINGBOXTREE_HPP_
+
+#ifndef RAYLIB_CPP_NO_MATH
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+#include "./Frustum.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A bounding volume hierarchy over the boxes of a scene's objects, answering which objects a camera sees and which one
+ * a ray hits without looking at each object.
+ *
+ * Objects are referred to by the index they were added at. Build() sorts them into a binary tree, splitting each node
+ * at the median of its widest axis, so a frustum or box query only visits the branches that reach it, and a ray only
+ * tests the objects whose boxes it passes through, nearest first, stopping once the boxes left are further than the
+ * best hit. Moving objects can be updated with SetBox() and Refit(), which keeps the tree and only grows its nodes;
+ * Build() again once objects have moved far.
+ *
+ * @code
+ * raylib::BoundingBoxTree tree;
+ * for (const Crate& c : crates) tree.Add(c.bounds);
+ * tree.Build();
+ * // Each frame:
+ * tree.Query(camera.GetFrustum(), visible);
+ * for (int i : visible) crates[i].Draw();
+ * int picked = -1;
+ * RayCollision hit = tree.GetCollision(camera.GetMouseRay(GetMousePosition()), &picked,
+ *     [&](int i, const ::Ray& ray) { return GetRayCollisionMesh(ray, crates[i].mesh, crates[i].transform); });
+ * @endcode
+ */
+class BoundingBoxTree {
+public:
+    static constexpr int LEAF_SIZE = 4;
+
+    /**
+     * Appends an object and returns its index. Takes effect at the next Build().
+     */
+    int Add(const ::BoundingBox& box) {
+        boxes.push_back(box);
+        return (int)boxes.size() - 1;
+    }
+
+    /**
+     * Removes every object and node
+     */
+    void Clear() {
+        boxes.clear();
+        items.clear();
+        nodes.clear();
+    }
+
+    int GetCount() const { return (int)boxes.size(); }
+    int GetNodeCount() const { return (int)nodes.size(); }
+    const ::BoundingBox& GetBox(int index) const { return boxes[(size_t)index]; }
+
+    /**
+     * Bounds of every object in the tree, or an empty box at the origin if there are none
+     */
+    ::BoundingBox GetBounds() const { return nodes.empty() ? ::BoundingBox{} : nodes[0].bounds; }
+
+    /**
+     * Moves an object. Call Refit() (or Build()) after the moves of a frame.
+     */
+    void SetBox(int index, const ::BoundingBox& box) { boxes[(size_t)index] = box; }
+
+    /**
+     * Builds the tree over every object added so far
+     */
+    void Build() {
+        nodes.clear();
+        items.resize(boxes.size());
+        for (size_t i = 0; i < items.size(); i++) items[i] = (int)i;
+        if (items.empty()) return;
+        nodes.reserve(2 * (items.size() / LEAF_SIZE) + 1);
+        centers.resize(boxes.size());
+        for (size_t i = 0; i < boxes.size(); i++) {
+            centers[i] = ::Vector3{(boxes[i].min.x + boxes[i].max.x) * 0.5f, (boxes[i].min.y + boxes[i].max.y) * 0.5f,
+                                   (boxes[i].min.z + boxes[i].max.z) * 0.5f};
+        }
+        BuildNode(0, (int)items.size());
+        std::vector<::Vector3>().swap(centers);
+    }
+
+    /**
+     * Recomputes node bounds from the current object boxes, keeping the tree's shape
+     */
+    void Refit() {
+        // Children always come after their parent, so walking backwards finishes them first
+        for (size_t n = nodes.size(); n-- > 0;) {
+            Node& node = nodes[n];
+            if (node.count > 0) {
+                node.bounds = boxes[(size_t)items[(size_t)node.first]];
+                for (int i = 1; i < node.count; i++) {
+                    node.bounds = Union(node.bounds, boxes[(size_t)items[(size_t)(node.first + i)]]);
+                }
+            } else {
+                node.bounds = Union(nodes[(size_t)(n + 1)].bounds, nodes[(size_t)node.first].bounds);
+            }
+        }
+    }
+
+    /**
+     * Sets out to the objects whose boxes may be inside frustum. Returns how many.
+     */
+    size_t Query(const ::raylib::Frustum& frustum, std::vector<int>& out) const {
+        out.clear();
+        if (nodes.empty()) return 0;
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[(size_t)stack[--top]];
+            ::raylib::Frustum::Result result = frustum.Classify(node.bounds);
+            if (result == ::raylib::Frustum::OUTSIDE) continue;
+            if (result == ::raylib::Frustum::INSIDE) {
+                AppendAll(node, out);
+            } else if (node.count > 0) {
+                for (int i = 0; i < node.count; i++) {
+                    int item = items[(size_t)(node.first + i)];
+                    if (frustum.CheckCollision(boxes[(size_t)item])) out.push_back(item);
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = (int)(&node - nodes.data()) + 1;
+            }
+        }
+        return out.size();
+    }
+
+    /**
+     * Sets out to the objects whose boxes overlap box. Returns how many.
+     */
+    size_t Query(const ::BoundingBox& box, std::vector<int>& out) const {
+        out.clear();
+        if (nodes.empty()) return 0;
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[(size_t)stack[--top]];
+            if (!Overlaps(node.bounds, box)) continue;
+            if (node.count > 0) {
+                for (int i = 0; i < node.count; i++) {
+                    int item = items[(size_t)(node.first + i)];
+                    if (Overlaps(boxes[(size_t)item], box)) out.push_back(item);
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = (int)(&node - nodes.data()) + 1;
+            }
+        }
+        return out.size();
+    }
+
+    /**
+     * Nearest hit of ray against the objects, where test(index, ray) returns the RayCollision for one object (for
+     * example GetRayCollisionMesh). test is only called for objects whose boxes the ray enters closer than the best hit
+     * so far, which assumes ray.direction is unit length, as GetMouseRay's is. If index isn't null it gets the object
+     * hit, or -1.
+     */
+    template<typename Test>
+    RayCollision GetCollision(const ::Ray& ray, int* index, Test test) const {
+        RayCollision best{};
+        if (index) *index = -1;
+        if (nodes.empty()) return best;
+
+        ::Vector3 inverse{1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+        int stack[STACK_SIZE];
+        float entry[STACK_SIZE];
+        int top = 0;
+        entry[top] = Enter(nodes[0].bounds, ray, inverse);
+        if (entry[top] < 0.0f) return best;
+        stack[top++] = 0;
+        best.distance = FLT_MAX;
+        while (top > 0) {
+            top--;
+            if (entry[top] > best.distance) continue;
+            const Node& node = nodes[(size_t)stack[top]];
+            if (node.count > 0) {
+                for (int i = 0; i < node.count; i++) {
+                    int item = items[(size_t)(node.first + i)];
+                    float enter = Enter(boxes[(size_t)item], ray, inverse);
+                    if (enter < 0.0f || enter > best.distance) continue;
+                    RayCollision hit = test(item, ray);
+                    if (hit.hit && hit.distance < best.distance) {
+                        best = hit;
+                        if (index) *index = item;
+                    }
+                }
+                continue;
+            }
+            // Push the further child first so the nearer one is tried first
+            int a = (int)(&node - nodes.data()) + 1, b = node.first;
+            float enterA = Enter(nodes[(size_t)a].bounds, ray, inverse);
+            float enterB = Enter(nodes[(size_t)b].bounds, ray, inverse);
+            if (enterA > enterB) {
+                std::swap(a, b);
+                std::swap(enterA, enterB);
+            }
+            if (enterB >= 0.0f) {
+                entry[top] = enterB;
+                stack[top++] = b;
+            }
+            if (enterA >= 0.0f) {
+                entry[top] = enterA;
+                stack[top++] = a;
+            }
+        }
+        if (!best.hit) best.distance = 0.0f;
+        return best;
+    }
+
+    /**
+     * Nearest hit of ray against the object boxes themselves
+     */
+    RayCollision GetCollision(const ::Ray& ray, int* index = nullptr) const {
+        return GetCollision(ray, index, [this](int item, const ::Ray& r) {
+            return ::GetRayCollisionBox(r, boxes[(size_t)item]);
+        });
+    }
+protected:
+    /**
+     * Leaves hold count objects from items[first]; inner nodes have count 0, their left child right after them and
+     * their right child at first
+     */
+    struct Node {
+        ::BoundingBox bounds;
+        int first;
+        int count;
+    };
+
+    // Median splits keep the depth near log2(objects / LEAF_SIZE), and a walk holds at most one node per level
+    static constexpr int STACK_SIZE = 64;
+
+    std::vector<::BoundingBox> boxes;
+    std::vector<int> items;
+    std::vector<Node> nodes;
+    std::vector<::Vector3> centers; // Only during Build()
+
+    static ::BoundingBox Union(const ::BoundingBox& a, const ::BoundingBox& b) {
+        return ::BoundingBox{
+            ::Vector3{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+            ::Vector3{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}};
+    }
+
+    static bool Overlaps(const ::BoundingBox& a, const ::BoundingBox& b) {
+        return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+               a.min.z <= b.max.z && b.min.z <= a.max.z;
+    }
+
+    static float Axis(const ::Vector3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+    /**
+     * Distance along ray at which it enters box, 0 if it starts inside, or -1 if it misses
+     */
+    static float Enter(const ::BoundingBox& box, const ::Ray& ray, const ::Vector3& inverse) {
+        float enter = 0.0f, leave = FLT_MAX;
+        for (int axis = 0; axis < 3; axis++) {
+            float origin = Axis(ray.position, axis), inv = Axis(inverse, axis);
+            float t0 = (Axis(box.min, axis) - origin) * inv;
+            float t1 = (Axis(box.max, axis) - origin) * inv;
+            if (t0 > t1) std::swap(t0, t1);
+            // A zero direction gives NaN when the origin is on a face; these comparisons drop it and keep the old bound
+            enter = t0 > enter ? t0 : enter;
+            leave = t1 < leave ? t1 : leave;
+            if (enter > leave) return -1.0f;
+        }
+        return enter;
+    }
+
+    void AppendAll(const Node& root, std::vector<int>& out) const {
+        // Subtrees are contiguous in nodes, and leaves in order cover a contiguous run of items
+        const Node* node = &root;
+        while (node->count == 0) node++;
+        int first = node->first;
+        node = &root;
+        while (node->count == 0) node = &nodes[(size_t)node->first];
+        out.insert(out.end(), items.begin() + first, items.begin() + node->first + node->count);
+    }
+
+    int BuildNode(int first, int count) {
+        int index = (int)nodes.size();
+        nodes.push_back(Node{boxes[(size_t)items[(size_t)first]], first, count});
+        ::BoundingBox centerBounds{centers[(size_t)items[(size_t)first]], centers[(size_t)items[(size_t)first]]};
+        for (int i = 0; i < count; i++) {
+            int item = items[(size_t)(first + i)];
+            nodes[(size_t)index].bounds = Union(nodes[(size_t)index].bounds, boxes[(size_t)item]);
+            centerBounds = Union(centerBounds, ::BoundingBox{centers[(size_t)item], centers[(size_t)item]});
+        }
+        if (count <= LEAF_SIZE) return index;
+
+        ::Vector3 extent{centerBounds.max.x - centerBounds.min.x, centerBounds.max.y - centerBounds.min.y,
+                         centerBounds.max.z - centerBounds.min.z};
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        int half = count / 2;
+        const std::vector<::Vector3>& c = centers;
+        std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+                         [&c, axis](int a, int b) { return Axis(c[(size_t)a], axis) < Axis(c[(size_t)b], axis); });
+
+        BuildNode(first, half);
+        int right = BuildNode(first + half, count - half);
+        nodes[(size_t)index].first = right;
+        nodes[(size_t)index].count = 0;
+        return index;
+    }
+};
+} // namespace raylib
+
+using RBoundingBoxTree = raylib::BoundingBoxTree;
+
+#endif // RAYLIB_CPP_NO_MATH
+
+#endif // RAYLIB_CPP_INCLUDE_BOUNDINGBOXTREE_HPP_
@@ -1,6 +1,7 @@
 #ifndef RAYLIB_CPP_INCLUDE_CAMERA3D_HPP_
 #define RAYLIB_CPP_INCLUDE_CAMERA3D_HPP_
 
+#include "./Frustum.hpp"
 #include "./Vector3.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
@@ -65,6 +66,20 @@ public:
      */
     Matrix GetMatrix() const { return ::GetCameraMatrix(*this); }
 
+#ifndef RAYLIB_CPP_NO_MATH
+    /**
+     * Get the planes of what the camera sees, for a render target with the given aspect ratio
+     */
+    Frustum GetFrustum(float aspect) const { return Frustum(*this, aspect); }
+
+    /**
+     * Get the planes of what the camera sees on screen
+     */
+    Frustum GetFrustum() const {
+        return Frustum(*this, (float)::GetScreenWidth() / (float)::GetScreenHeight());
+    }
+#endif
+
     /**
      * Update camera position for selected mode
      */
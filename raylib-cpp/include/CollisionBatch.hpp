@@ -0,0 +1,171 @@
+/**
+ * Many-vs-one collision checks over contiguous arrays of shapes.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_COLLISIONBATCH_HPP_
+#define RAYLIB_CPP_INCLUDE_COLLISIONBATCH_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "./raylib-cpp-simd.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+
+static_assert(sizeof(::Rectangle) == 4 * sizeof(float), "Rectangle arrays must be tightly packed floats");
+
+/**
+ * Kernels testing every shape in an array against one other shape, such as every enemy against the player or every
+ * bullet against one wall, in place of one CheckCollision*() call per shape.
+ *
+ * Each writes a hit mask, hits[i] set to 1 or 0, and returns how many hit. The tests are raylib's own, with the same
+ * edge rules: CheckRecs() is CheckCollisionRecs(), CheckCircles() is CheckCollisionCircles() and so on, so a batch
+ * agrees with the single calls it replaces. Rectangle and circle arrays run four shapes per SSE2/NEON register, with a
+ * scalar tail. Arrays of raylib::Rectangle and raylib::Vector2 can be passed directly. For many-vs-many checks see
+ * SweepAndPrune.
+ */
+namespace CollisionBatch {
+
+namespace detail {
+inline bool Recs(const ::Rectangle& a, const ::Rectangle& b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+inline bool Circles(::Vector2 center1, float radius1, ::Vector2 center2, float radius2) {
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+    float radii = radius1 + radius2;
+    return dx * dx + dy * dy <= radii * radii;
+}
+
+inline bool CircleRec(::Vector2 center, float radius, const ::Rectangle& rec) {
+    float halfWidth = rec.width / 2.0f;
+    float halfHeight = rec.height / 2.0f;
+    float dx = std::fabs(center.x - (rec.x + halfWidth));
+    float dy = std::fabs(center.y - (rec.y + halfHeight));
+    if (dx > halfWidth + radius || dy > halfHeight + radius) return false;
+    if (dx <= halfWidth || dy <= halfHeight) return true;
+    float cornerDistanceSq = (dx - halfWidth) * (dx - halfWidth) + (dy - halfHeight) * (dy - halfHeight);
+    return cornerDistanceSq <= radius * radius;
+}
+
+inline bool PointRec(::Vector2 point, const ::Rectangle& rec) {
+    return point.x >= rec.x && point.x < rec.x + rec.width && point.y >= rec.y && point.y < rec.y + rec.height;
+}
+
+// Writes four lanes of a comparison mask as bytes; returns how many were set
+inline size_t Store(uint8_t* hits, int mask) {
+    size_t count = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        hits[lane] = (uint8_t)((mask >> lane) & 1);
+        count += hits[lane];
+    }
+    return count;
+}
+} // namespace detail
+
+/**
+ * hits[i] = CheckCollisionRecs(recs[i], rec)
+ */
+inline size_t CheckRecs(uint8_t* hits, const ::Rectangle* recs, size_t count, const ::Rectangle& rec) {
+    size_t total = 0;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    const __m128 left = _mm_set1_ps(rec.x), right = _mm_set1_ps(rec.x + rec.width);
+    const __m128 top = _mm_set1_ps(rec.y), bottom = _mm_set1_ps(rec.y + rec.height);
+    for (; i + 4 <= count; i += 4) {
+        const float* p = reinterpret_cast<const float*>(recs + i);
+        __m128 x = _mm_loadu_ps(p), y = _mm_loadu_ps(p + 4), w = _mm_loadu_ps(p + 8), h = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(x, y, w, h);
+        __m128 hit = _mm_and_ps(_mm_cmplt_ps(x, right), _mm_cmpgt_ps(_mm_add_ps(x, w), left));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmplt_ps(y, bottom), _mm_cmpgt_ps(_mm_add_ps(y, h), top)));
+        total += detail::Store(hits + i, _mm_movemask_ps(hit));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    const float32x4_t left = vdupq_n_f32(rec.x), right = vdupq_n_f32(rec.x + rec.width);
+    const float32x4_t top = vdupq_n_f32(rec.y), bottom = vdupq_n_f32(rec.y + rec.height);
+    for (; i + 4 <= count; i += 4) {
+        float32x4x4_t r = vld4q_f32(reinterpret_cast<const float*>(recs + i));  // Deinterleaves x, y, width, height
+        uint32x4_t hit = vandq_u32(vcltq_f32(r.val[0], right), vcgtq_f32(vaddq_f32(r.val[0], r.val[2]), left));
+        hit = vandq_u32(hit, vandq_u32(vcltq_f32(r.val[1], bottom), vcgtq_f32(vaddq_f32(r.val[1], r.val[3]), top)));
+        uint32_t lanes[4];
+        vst1q_u32(lanes, vshrq_n_u32(hit, 31));
+        total += detail::Store(hits + i, (int)(lanes[0] | lanes[1] << 1 | lanes[2] << 2 | lanes[3] << 3));
+    }
+#endif
+    for (; i < count; i++) {
+        hits[i] = detail::Recs(recs[i], rec);
+        total += hits[i];
+    }
+    return total;
+}
+
+/**
+ * hits[i] = CheckCollisionCircles(centers[i], radii[i], center, radius)
+ */
+inline size_t CheckCircles(uint8_t* hits, const ::Vector2* centers, const float* radii, size_t count,
+                           ::Vector2 center, float radius) {
+    size_t total = 0;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), r = _mm_set1_ps(radius);
+    for (; i + 4 <= count; i += 4) {
+        const float* p = reinterpret_cast<const float*>(centers + i);
+        __m128 lo = _mm_loadu_ps(p), hi = _mm_loadu_ps(p + 4);  // x0 y0 x1 y1, x2 y2 x3 y3
+        __m128 dx = _mm_sub_ps(cx, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128 dy = _mm_sub_ps(cy, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(radii + i), r);
+        __m128 hit = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(sum, sum));
+        total += detail::Store(hits + i, _mm_movemask_ps(hit));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    const float32x4_t cx = vdupq_n_f32(center.x), cy = vdupq_n_f32(center.y), r = vdupq_n_f32(radius);
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t c = vld2q_f32(reinterpret_cast<const float*>(centers + i));  // Deinterleaves x and y
+        float32x4_t dx = vsubq_f32(cx, c.val[0]);
+        float32x4_t dy = vsubq_f32(cy, c.val[1]);
+        float32x4_t sum = vaddq_f32(vld1q_f32(radii + i), r);
+        // Separate multiplies and adds, not vmlaq/vfmaq, to round like the scalar code
+        uint32x4_t hit = vcleq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(sum, sum));
+        uint32_t lanes[4];
+        vst1q_u32(lanes, vshrq_n_u32(hit, 31));
+        total += detail::Store(hits + i, (int)(lanes[0] | lanes[1] << 1 | lanes[2] << 2 | lanes[3] << 3));
+    }
+#endif
+    for (; i < count; i++) {
+        hits[i] = detail::Circles(centers[i], radii[i], center, radius);
+        total += hits[i];
+    }
+    return total;
+}
+
+/**
+ * hits[i] = CheckCollisionCircleRec(center, radius, recs[i])
+ */
+inline size_t CheckRecsCircle(uint8_t* hits, const ::Rectangle* recs, size_t count, ::Vector2 center, float radius) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        hits[i] = detail::CircleRec(center, radius, recs[i]);
+        total += hits[i];
+    }
+    return total;
+}
+
+/**
+ * hits[i] = CheckCollisionPointRec(points[i], rec)
+ */
+inline size_t CheckPoints(uint8_t* hits, const ::Vector2* points, size_t count, const ::Rectangle& rec) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        hits[i] = detail::PointRec(points[i], rec);
+        total += hits[i];
+    }
+    return total;
+}
+
+} // namespace CollisionBatch
+
+} // namespace raylib
+
+#endif // RAYLIB_CPP_INCLUDE_COLLISIONBATCH_HPP_
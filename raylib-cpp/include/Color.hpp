@@ -13,15 +13,15 @@ namespace raylib {
  */
 class Color : public ::Color {
 public:
-    Color(const ::Color& color) : ::Color{color.r, color.g, color.b, color.a} {}
+    constexpr Color(const ::Color& color) : ::Color{color.r, color.g, color.b, color.a} {}
 
-    Color(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha = 255)
-        : ::Color{red, green, blue, alpha} {};
+    constexpr Color(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha = 255)
+        : ::Color{red, green, blue, alpha} {}
 
     /**
      * Black.
      */
-    Color() : ::Color{0, 0, 0, 255} {};
+    constexpr Color() : ::Color{0, 0, 0, 255} {}
 
     /**
      * Returns a Color from HSV values
@@ -36,19 +36,27 @@ public:
     /**
      * Get Color structure from hexadecimal value
      */
-    explicit Color(unsigned int hexValue) : ::Color(::GetColor(hexValue)) { }
+    constexpr explicit Color(unsigned int hexValue)
+        : ::Color{
+              static_cast<unsigned char>(hexValue >> 24 & 0xFF),
+              static_cast<unsigned char>(hexValue >> 16 & 0xFF),
+              static_cast<unsigned char>(hexValue >> 8 & 0xFF),
+              static_cast<unsigned char>(hexValue & 0xFF)} {}
 
     Color(void* srcPtr, int format) : ::Color(::GetPixelColor(srcPtr, format)) { }
 
     /**
      * Returns hexadecimal value for a Color
      */
-    [[nodiscard]] int ToInt() const { return ::ColorToInt(*this); }
+    [[nodiscard]] constexpr int ToInt() const {
+        return static_cast<int>(static_cast<unsigned int>(r) << 24 | static_cast<unsigned int>(g) << 16 |
+                                static_cast<unsigned int>(b) << 8 | static_cast<unsigned int>(a));
+    }
 
     /**
      * Returns hexadecimal value for a Color
      */
-    explicit operator int() const { return ::ColorToInt(*this); }
+    constexpr explicit operator int() const { return ToInt(); }
 
     [[nodiscard]] std::string ToString() const { return TextFormat("Color(%d, %d, %d, %d)", r, g, b, a); }
 
@@ -79,7 +87,7 @@ public:
     GETTERSETTER(unsigned char, B, b)
     GETTERSETTER(unsigned char, A, a)
 
-    Color& operator=(const ::Color& color) {
+    RAYLIB_CPP_CONSTEXPR14 Color& operator=(const ::Color& color) {
         set(color);
         return *this;
     }
@@ -217,34 +225,34 @@ public:
      */
     [[nodiscard]] Color AlphaBlend(::Color dst, ::Color tint) const { return ::ColorAlphaBlend(dst, *this, tint); }
 
-    static Color LightGray() { return LIGHTGRAY; }
-    static Color Gray() { return GRAY; }
-    static Color DarkGray() { return DARKGRAY; }
-    static Color Yellow() { return YELLOW; }
-    static Color Gold() { return GOLD; }
-    static Color Orange() { return ORANGE; }
-    static Color Pink() { return PINK; }
-    static Color Red() { return RED; }
-    static Color Maroon() { return MAROON; }
-    static Color Green() { return GREEN; }
-    static Color Lime() { return LIME; }
-    static Color DarkGreen() { return DARKGREEN; }
-    static Color SkyBlue() { return SKYBLUE; }
-    static Color Blue() { return BLUE; }
-    static Color DarkBlue() { return DARKBLUE; }
-    static Color Purple() { return PURPLE; }
-    static Color Violet() { return VIOLET; }
-    static Color DarkPurple() { return DARKPURPLE; }
-    static Color Beige() { return BEIGE; }
-    static Color Brown() { return BROWN; }
-    static Color DarkBrown() { return DARKBROWN; }
-    static Color White() { return WHITE; }
-    static Color Black() { return BLACK; }
-    static Color Blank() { return BLANK; }
-    static Color Magenta() { return MAGENTA; }
-    static Color RayWhite() { return RAYWHITE; }
+    static constexpr Color LightGray() { return LIGHTGRAY; }
+    static constexpr Color Gray() { return GRAY; }
+    static constexpr Color DarkGray() { return DARKGRAY; }
+    static constexpr Color Yellow() { return YELLOW; }
+    static constexpr Color Gold() { return GOLD; }
+    static constexpr Color Orange() { return ORANGE; }
+    static constexpr Color Pink() { return PINK; }
+    static constexpr Color Red() { return RED; }
+    static constexpr Color Maroon() { return MAROON; }
+    static constexpr Color Green() { return GREEN; }
+    static constexpr Color Lime() { return LIME; }
+    static constexpr Color DarkGreen() { return DARKGREEN; }
+    static constexpr Color SkyBlue() { return SKYBLUE; }
+    static constexpr Color Blue() { return BLUE; }
+    static constexpr Color DarkBlue() { return DARKBLUE; }
+    static constexpr Color Purple() { return PURPLE; }
+    static constexpr Color Violet() { return VIOLET; }
+    static constexpr Color DarkPurple() { return DARKPURPLE; }
+    static constexpr Color Beige() { return BEIGE; }
+    static constexpr Color Brown() { return BROWN; }
+    static constexpr Color DarkBrown() { return DARKBROWN; }
+    static constexpr Color White() { return WHITE; }
+    static constexpr Color Black() { return BLACK; }
+    static constexpr Color Blank() { return BLANK; }
+    static constexpr Color Magenta() { return MAGENTA; }
+    static constexpr Color RayWhite() { return RAYWHITE; }
 protected:
-    void set(const ::Color& color) {
+    RAYLIB_CPP_CONSTEXPR14 void set(const ::Color& color) {
         r = color.r;
         g = color.g;
         b = color.b;
@@ -0,0 +1,137 @@
+/**
+ * Texture files stored in their GPU format, mipmaps included, for loading without decoding.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_COOKEDTEXTURE_HPP_
+#define RAYLIB_CPP_INCLUDE_COOKEDTEXTURE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "./DataView.hpp"
+#include "./MappedFileData.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Reads and writes cooked textures: an image's pixel data exactly as raylib uploads it, in any PixelFormat including
+ * the PIXELFORMAT_COMPRESSED_* ones, with every mipmap level, behind a 28 byte header.
+ *
+ * Loading a PNG decodes it on the CPU, and the texture it makes is uncompressed with a single level. A cooked file
+ * made offline (see the digdug_cook tool) is already block-compressed and mipmapped, so loading it is a file map and
+ * one upload, and the texture takes a quarter (DXT5) or an eighth (DXT1) of the VRAM. Texture::Load() picks the
+ * format up from the ".rltex" extension.
+ *
+ * The GPU has to support the format the file was cooked to: DXT for desktop GL, ETC2 on GLES3 and mobile, ASTC where
+ * available. Texture::Load() throws if the upload fails, as it does for an unsupported format.
+ *
+ * @code
+ * raylib::Texture sprites("resources/sprites.rltex");
+ * @endcode
+ */
+class CookedTexture {
+public:
+    /**
+     * Version written to and expected in the header. Files from another version are rejected.
+     */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * File header, little-endian, followed by dataSize bytes of pixel data with each mipmap level after the last
+     */
+    struct Header {
+        char magic[4]; // "RLTX"
+        uint32_t version;
+        int32_t width;
+        int32_t height;
+        int32_t format;  // PixelFormat
+        int32_t mipmaps; // Levels, 1 for none
+        uint32_t dataSize;
+    };
+
+    /**
+     * Bytes of pixel data for mipmaps levels from width x height down, as raylib lays them out and uploads them
+     */
+    static int GetDataSize(int width, int height, int format, int mipmaps) {
+        int size = 0;
+        for (int level = 0; level < mipmaps; level++) {
+            size += ::GetPixelDataSize(width, height, format);
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        return size;
+    }
+
+    /**
+     * Writes an image, in whatever format and with whatever mipmaps it has, as a cooked texture
+     */
+    static bool Export(const ::Image& image, const std::string& fileName) {
+        if (image.data == nullptr || image.width <= 0 || image.height <= 0 || image.mipmaps < 1) return false;
+        Header header = MakeHeader(image);
+        std::vector<unsigned char> file(sizeof(Header) + header.dataSize);
+        std::memcpy(file.data(), &header, sizeof(Header));
+        std::memcpy(file.data() + sizeof(Header), image.data, header.dataSize);
+        return ::SaveFileData(fileName.c_str(), file.data(), (int)file.size());
+    }
+
+    /**
+     * Points image at the pixel data inside a cooked file's contents, without copying it. The image doesn't own its
+     * data and must not be unloaded; it is only valid while the contents are.
+     *
+     * @return false if the contents aren't a cooked texture of this version, or are cut short
+     */
+    static bool Read(const DataView& file, ::Image* image) {
+        if (file.GetSize() < (int)sizeof(Header)) return false;
+        Header header;
+        std::memcpy(&header, file.GetData(), sizeof(Header));
+        if (std::memcmp(header.magic, "RLTX", 4) != 0 || header.version != VERSION) return false;
+        if (header.width <= 0 || header.height <= 0 || header.mipmaps < 1) return false;
+        int expected = GetDataSize(header.width, header.height, header.format, header.mipmaps);
+        if (expected <= 0 || header.dataSize != (uint32_t)expected) return false;
+        if (file.GetSize() - (int)sizeof(Header) < expected) return false;
+
+        image->data = const_cast<unsigned char*>(file.GetData() + sizeof(Header));
+        image->width = header.width;
+        image->height = header.height;
+        image->format = header.format;
+        image->mipmaps = header.mipmaps;
+        return true;
+    }
+
+    /**
+     * Loads a cooked file into an image that owns its data, for handing to another thread or keeping on the CPU.
+     * Returns an image with no data if the file can't be read.
+     */
+    static ::Image Load(const std::string& fileName) {
+        ::Image image{};
+        MappedFileData file(fileName);
+        ::Image view{};
+        if (!Read(file.GetView(), &view)) {
+            ::TraceLog(LOG_WARNING, "IMAGE: [%s] Not a cooked texture", fileName.c_str());
+            return image;
+        }
+        int size = GetDataSize(view.width, view.height, view.format, view.mipmaps);
+        image = view;
+        image.data = RL_MALLOC((size_t)size);
+        std::memcpy(image.data, view.data, (size_t)size);
+        return image;
+    }
+protected:
+    static Header MakeHeader(const ::Image& image) {
+        Header header;
+        std::memcpy(header.magic, "RLTX", 4);
+        header.version = VERSION;
+        header.width = image.width;
+        header.height = image.height;
+        header.format = image.format;
+        header.mipmaps = image.mipmaps;
+        header.dataSize = (uint32_t)GetDataSize(image.width, image.height, image.format, image.mipmaps);
+        return header;
+    }
+};
+} // namespace raylib
+
+using RCookedTexture = raylib::CookedTexture;
+
+#endif // RAYLIB_CPP_INCLUDE_COOKEDTEXTURE_HPP_
@@ -0,0 +1,238 @@
+/**
+ * Cubicmap walls with merged faces and grid collision.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_CUBICMAP_HPP_
+#define RAYLIB_CPP_INCLUDE_CUBICMAP_HPP_
+
+#include <cmath>
+#include <vector>
+
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A cubicmap image turned into a wall grid, for building its mesh and testing collision against it.
+ *
+ * Pixels with a red channel of 255 are walls and every other pixel is open floor, as in the first person maze example.
+ * Cells are laid out like GenMeshCubicmap's: cell (x, y) is centred on (x * size.x, 0, y * size.z) and walls rise
+ * from 0 to size.y, so the two meshes line up.
+ *
+ * GenMesh() merges coplanar faces greedily: wall sides become one quad per straight run of wall, and wall tops, floors
+ * and ceilings one quad per rectangle of cells, where GenMeshCubicmap makes a quad per cell face. Texture coordinates
+ * count cells, so a repeating texture tiles once per cell; an atlas like cubicmap_atlas.png can't be used, because a
+ * merged quad spans many cells.
+ *
+ * CheckCollision() only looks at the cells under the circle, rather than the whole map.
+ *
+ * @code
+ * raylib::CubicMap map(image);
+ * raylib::Model model(map.GenMesh());
+ * // Each frame, with the player's position relative to the model's:
+ * if (map.CheckCollision(Vector2{local.x, local.z}, 0.1f)) camera.position = oldPosition;
+ * @endcode
+ */
+class CubicMap {
+public:
+    /**
+     * Reads the walls of cubicmap, whose cells are size apart
+     */
+    CubicMap(const ::Image& cubicmap, ::Vector3 size = ::Vector3{1.0f, 1.0f, 1.0f})
+        : width(cubicmap.width), height(cubicmap.height), size(size) {
+        walls.assign((size_t)width * (size_t)height, 0);
+        ::Color* pixels = ::LoadImageColors(cubicmap);
+        if (pixels == nullptr) return;
+        for (size_t i = 0; i < walls.size(); i++) walls[i] = pixels[i].r == 255 ? 1 : 0;
+        ::UnloadImageColors(pixels);
+    }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    ::Vector3 GetSize() const { return size; }
+
+    /**
+     * Whether cell (x, y) is a wall; cells outside the map are open
+     */
+    bool IsWall(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width && y < height && walls[(size_t)y * (size_t)width + (size_t)x] != 0;
+    }
+
+    /**
+     * Cell containing a point given as (x, z) relative to the mesh
+     */
+    void GetCell(::Vector2 point, int* x, int* y) const {
+        *x = (int)std::floor(point.x / size.x + 0.5f);
+        *y = (int)std::floor(point.y / size.z + 0.5f);
+    }
+
+    /**
+     * Whether a circle on the ground, centred on (x, z) relative to the mesh, overlaps a wall
+     */
+    [[nodiscard]] bool CheckCollision(::Vector2 center, float radius) const {
+        // Every cell whose closed bounds reach the circle's bounding square, including ones it only touches
+        int x0 = (int)std::ceil((center.x - radius) / size.x - 0.5f);
+        int x1 = (int)std::floor((center.x + radius) / size.x + 0.5f);
+        int y0 = (int)std::ceil((center.y - radius) / size.z - 0.5f);
+        int y1 = (int)std::floor((center.y + radius) / size.z + 0.5f);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                if (!IsWall(x, y)) continue;
+                // Nearest point of the cell to the circle's centre
+                float cx = ((float)x - 0.5f) * size.x, cy = ((float)y - 0.5f) * size.z;
+                float nx = center.x < cx ? cx : (center.x > cx + size.x ? cx + size.x : center.x);
+                float ny = center.y < cy ? cy : (center.y > cy + size.z ? cy + size.z : center.y);
+                float dx = center.x - nx, dy = center.y - ny;
+                if (dx * dx + dy * dy <= radius * radius) return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Generates and uploads the merged mesh: wall sides and tops, and a floor and ceiling over open cells
+     */
+    ::Mesh GenMesh() const {
+        std::vector<Quad> quads;
+        // Wall sides facing -x, +x, -z and +z, merged along the run of cells beside them
+        for (int x = 0; x < width; x++) {
+            SideRuns(quads, x, -1, 0);
+            SideRuns(quads, x, 1, 0);
+        }
+        for (int y = 0; y < height; y++) {
+            SideRuns(quads, y, 0, -1);
+            SideRuns(quads, y, 0, 1);
+        }
+        Rectangles(quads, true, TOP);
+        Rectangles(quads, false, FLOOR);
+        Rectangles(quads, false, CEILING);
+        return Build(quads);
+    }
+protected:
+    enum Face { SIDE_NEG_X, SIDE_POS_X, SIDE_NEG_Z, SIDE_POS_Z, TOP, FLOOR, CEILING };
+
+    /**
+     * A face of (x, y, w, h) cells
+     */
+    struct Quad {
+        Face face;
+        int x, y, w, h;
+    };
+
+    int width, height;
+    ::Vector3 size;
+    std::vector<unsigned char> walls;
+
+    /**
+     * Faces on one column (dx set) or row (dy set) of cells, between a wall and the open cell in direction (dx, dy).
+     * Walls on the map's edge get their outer faces too, as in GenMeshCubicmap.
+     */
+    void SideRuns(std::vector<Quad>& quads, int line, int dx, int dy) const {
+        Face face = dx < 0 ? SIDE_NEG_X : (dx > 0 ? SIDE_POS_X : (dy < 0 ? SIDE_NEG_Z : SIDE_POS_Z));
+        int length = dx != 0 ? height : width;
+        int start = -1;
+        for (int i = 0; i <= length; i++) {
+            int x = dx != 0 ? line : i, y = dx != 0 ? i : line;
+            bool open = i < length && IsWall(x, y) && !IsWall(x + dx, y + dy);
+            if (open && start < 0) start = i;
+            if (!open && start >= 0) {
+                if (dx != 0) {
+                    quads.push_back(Quad{face, line, start, 1, i - start});
+                } else {
+                    quads.push_back(Quad{face, start, line, i - start, 1});
+                }
+                start = -1;
+            }
+        }
+    }
+
+    /**
+     * Greedily covers the cells that are (or aren't) walls with rectangles
+     */
+    void Rectangles(std::vector<Quad>& quads, bool wall, Face face) const {
+        std::vector<unsigned char> done(walls.size(), 0);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (!Free(done, x, y, wall)) continue;
+                int w = 1;
+                while (Free(done, x + w, y, wall)) w++;
+                int h = 1;
+                for (bool grow = true; grow && y + h < height; h += grow ? 1 : 0) {
+                    for (int i = 0; i < w && grow; i++) grow = Free(done, x + i, y + h, wall);
+                }
+                for (int j = 0; j < h; j++) {
+                    for (int i = 0; i < w; i++) done[(size_t)(y + j) * (size_t)width + (size_t)(x + i)] = 1;
+                }
+                quads.push_back(Quad{face, x, y, w, h});
+            }
+        }
+    }
+
+    bool Free(const std::vector<unsigned char>& done, int x, int y, bool wall) const {
+        return x < width && y < height && IsWall(x, y) == wall && !done[(size_t)y * (size_t)width + (size_t)x];
+    }
+
+    /**
+     * Corners of a quad in counter-clockwise order seen from the front, as (x, y, z) in cells and cube heights
+     */
+    static void Corners(const Quad& q, float corners[4][3]) {
+        float x0 = (float)q.x - 0.5f, x1 = x0 + (float)q.w;
+        float z0 = (float)q.y - 0.5f, z1 = z0 + (float)q.h;
+        float box[7][4][3] = {
+            {{x0, 0, z0}, {x0, 0, z1}, {x0, 1, z1}, {x0, 1, z0}}, // -x
+            {{x1, 0, z1}, {x1, 0, z0}, {x1, 1, z0}, {x1, 1, z1}}, // +x
+            {{x1, 0, z0}, {x0, 0, z0}, {x0, 1, z0}, {x1, 1, z0}}, // -z
+            {{x0, 0, z1}, {x1, 0, z1}, {x1, 1, z1}, {x0, 1, z1}}, // +z
+            {{x0, 1, z0}, {x0, 1, z1}, {x1, 1, z1}, {x1, 1, z0}}, // Wall tops
+            {{x0, 0, z0}, {x0, 0, z1}, {x1, 0, z1}, {x1, 0, z0}}, // Floor
+            {{x0, 1, z0}, {x1, 1, z0}, {x1, 1, z1}, {x0, 1, z1}}, // Ceiling
+        };
+        for (int c = 0; c < 4; c++) {
+            for (int i = 0; i < 3; i++) corners[c][i] = box[q.face][c][i];
+        }
+    }
+
+    ::Mesh Build(const std::vector<Quad>& quads) const {
+        static const float normals[7][3] = {
+            {-1, 0, 0}, {1, 0, 0}, {0, 0, -1}, {0, 0, 1}, {0, 1, 0}, {0, 1, 0}, {0, -1, 0}};
+        ::Mesh mesh{};
+        if (quads.empty()) return mesh;
+        // Shared corners need 16-bit indices; past that the quads are written out as plain triangles
+        bool indexed = quads.size() * 4 <= 65535;
+        mesh.vertexCount = (int)quads.size() * (indexed ? 4 : 6);
+        mesh.triangleCount = (int)quads.size() * 2;
+        mesh.vertices = (float*)RL_MALLOC((size_t)mesh.vertexCount * 3 * sizeof(float));
+        mesh.texcoords = (float*)RL_MALLOC((size_t)mesh.vertexCount * 2 * sizeof(float));
+        mesh.normals = (float*)RL_MALLOC((size_t)mesh.vertexCount * 3 * sizeof(float));
+        if (indexed) mesh.indices = (unsigned short*)RL_MALLOC(quads.size() * 6 * sizeof(unsigned short));
+
+        static const int triangles[6] = {0, 1, 2, 0, 2, 3};
+        int v = 0;
+        for (size_t q = 0; q < quads.size(); q++) {
+            float corners[4][3];
+            Corners(quads[q], corners);
+            int count = indexed ? 4 : 6;
+            for (int k = 0; k < count; k++) {
+                const float* c = corners[indexed ? k : triangles[k]];
+                mesh.vertices[v * 3] = c[0] * size.x;
+                mesh.vertices[v * 3 + 1] = c[1] * size.y;
+                mesh.vertices[v * 3 + 2] = c[2] * size.z;
+                // Floors and tops map x and z; sides map along the wall and down from its top
+                bool flat = quads[q].face >= TOP;
+                bool alongX = quads[q].face == SIDE_NEG_Z || quads[q].face == SIDE_POS_Z;
+                mesh.texcoords[v * 2] = flat || alongX ? c[0] + 0.5f : c[2] + 0.5f;
+                mesh.texcoords[v * 2 + 1] = flat ? c[2] + 0.5f : 1.0f - c[1];
+                for (int i = 0; i < 3; i++) mesh.normals[v * 3 + i] = normals[quads[q].face][i];
+                v++;
+            }
+            if (indexed) {
+                for (size_t k = 0; k < 6; k++) mesh.indices[q * 6 + k] = (unsigned short)(q * 4 + (size_t)triangles[k]);
+            }
+        }
+        ::UploadMesh(&mesh, false);
+        return mesh;
+    }
+};
+} // namespace raylib
+
+using RCubicMap = raylib::CubicMap;
+
+#endif // RAYLIB_CPP_INCLUDE_CUBICMAP_HPP_
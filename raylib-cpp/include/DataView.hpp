@@ -0,0 +1,41 @@
+#ifndef RAYLIB_CPP_INCLUDE_DATAVIEW_HPP_
+#define RAYLIB_CPP_INCLUDE_DATAVIEW_HPP_
+
+namespace raylib {
+/**
+ * A read-only view of bytes owned by something else, such as a FileData or MappedFileData, for passing file contents
+ * to the Load*FromMemory constructors without copying them.
+ *
+ * The view doesn't own its bytes; whatever it was taken from must outlive it.
+ */
+class DataView {
+public:
+    constexpr DataView() = default;
+    constexpr DataView(const unsigned char* data, int size) : data(data), size(size) {}
+
+    const unsigned char* GetData() const { return data; }
+    int GetSize() const { return size; }
+    bool IsEmpty() const { return data == nullptr || size <= 0; }
+
+    const unsigned char* begin() const { return data; }
+    const unsigned char* end() const { return data + size; }
+    unsigned char operator[](int index) const { return data[index]; }
+
+    /**
+     * The count bytes from offset, clamped to this view
+     */
+    DataView Subview(int offset, int count) const {
+        if (offset < 0) offset = 0;
+        if (offset > size) offset = size;
+        if (count < 0 || count > size - offset) count = size - offset;
+        return DataView(data + offset, count);
+    }
+private:
+    const unsigned char* data = nullptr;
+    int size = 0;
+};
+} // namespace raylib
+
+using RDataView = raylib::DataView;
+
+#endif // RAYLIB_CPP_INCLUDE_DATAVIEW_HPP_
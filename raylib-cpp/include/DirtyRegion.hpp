@@ -0,0 +1,187 @@
+/**
+ * Dirty-rectangle tracking for partial texture uploads.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_DIRTYREGION_HPP_
+#define RAYLIB_CPP_INCLUDE_DIRTYREGION_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Collects the parts of a CPU-side image that changed, so only those are sent to its texture.
+ *
+ * Rectangles are merged as they are added: one that overlaps or sits next to another joins it when the combined
+ * rectangle is no more than twice the pixels the two cover, since each UpdateTextureRec call has a fixed cost that a
+ * few extra pixels are cheaper than. At most maxRects are kept; past that the pair whose union wastes least is merged.
+ *
+ * @code
+ * dirty.Add(x, y, 8, 8);        // After drawing into image
+ * dirty.Flush(texture, image);  // Once per frame
+ * @endcode
+ */
+class DirtyRegion {
+public:
+    static constexpr int DEFAULT_MAX_RECTS = 8;
+
+    /**
+     * Tracks an image of width x height pixels
+     */
+    DirtyRegion(int width, int height, int maxRects = DEFAULT_MAX_RECTS)
+        : width(width), height(height), maxRects(maxRects < 1 ? 1 : maxRects) {}
+
+    /**
+     * Marks a rectangle as changed; the parts outside the image are ignored
+     */
+    void Add(int x, int y, int w, int h) {
+        Rect r{std::max(x, 0), std::max(y, 0), std::min(x + w, width), std::min(y + h, height)};
+        if (r.x1 <= r.x0 || r.y1 <= r.y0) return;
+
+        // Absorbing one rectangle can bring the result next to another, so repeat until none merge
+        for (size_t i = 0; i < rects.size();) {
+            if (r.Contains(rects[i]) || (Touch(r, rects[i]) && Waste(r, rects[i]) <= Covered(r, rects[i]))) {
+                r = Union(r, rects[i]);
+                rects.erase(rects.begin() + (long)i);
+                i = 0;
+            } else if (rects[i].Contains(r)) {
+                return;
+            } else {
+                i++;
+            }
+        }
+        rects.push_back(r);
+
+        while ((int)rects.size() > maxRects) {
+            size_t a = 0, b = 1;
+            long best = -1;
+            for (size_t i = 0; i < rects.size(); i++) {
+                for (size_t j = i + 1; j < rects.size(); j++) {
+                    long waste = Waste(rects[i], rects[j]);
+                    if (best < 0 || waste < best) {
+                        best = waste;
+                        a = i;
+                        b = j;
+                    }
+                }
+            }
+            rects[a] = Union(rects[a], rects[b]);
+            rects.erase(rects.begin() + (long)b);
+        }
+    }
+
+    void Add(::Rectangle rect) {
+        Add((int)rect.x, (int)rect.y, (int)std::ceil(rect.x + rect.width) - (int)rect.x,
+            (int)std::ceil(rect.y + rect.height) - (int)rect.y);
+    }
+
+    /**
+     * Marks the whole image as changed
+     */
+    void AddAll() {
+        rects.clear();
+        rects.push_back(Rect{0, 0, width, height});
+    }
+
+    void Clear() { rects.clear(); }
+
+    bool IsEmpty() const { return rects.empty(); }
+
+    /**
+     * The merged rectangles, in no particular order
+     */
+    std::vector<::Rectangle> GetRects() const {
+        std::vector<::Rectangle> out;
+        for (size_t i = 0; i < rects.size(); i++) {
+            const Rect& r = rects[i];
+            out.push_back(::Rectangle{(float)r.x0, (float)r.y0, (float)(r.x1 - r.x0), (float)(r.y1 - r.y0)});
+        }
+        return out;
+    }
+
+    /**
+     * Pixels the merged rectangles cover
+     */
+    long GetPixels() const {
+        long n = 0;
+        for (size_t i = 0; i < rects.size(); i++) n += rects[i].Area();
+        return n;
+    }
+
+    /**
+     * Sends the changed parts of image to texture with one UpdateTextureRec per rectangle, then clears. image must be
+     * the size this region tracks, in texture's (uncompressed) format. Returns the bytes uploaded.
+     */
+    size_t Flush(const ::Texture& texture, const ::Image& image) {
+        size_t bytes = 0;
+        if (image.data == nullptr || image.width != width || image.height != height) {
+            rects.clear();
+            return bytes;
+        }
+        int pixelBytes = ::GetPixelDataSize(1, 1, image.format);
+        size_t stride = (size_t)width * (size_t)pixelBytes;
+        for (size_t i = 0; i < rects.size(); i++) {
+            const Rect& r = rects[i];
+            size_t rowBytes = (size_t)(r.x1 - r.x0) * (size_t)pixelBytes;
+            const unsigned char* first = (const unsigned char*)image.data + (size_t)r.y0 * stride +
+                                         (size_t)r.x0 * (size_t)pixelBytes;
+            const void* pixels = first;
+            if (r.x1 - r.x0 != width) {
+                // UpdateTextureRec wants the rectangle's rows packed together
+                scratch.resize(rowBytes * (size_t)(r.y1 - r.y0));
+                for (size_t y = 0; y < (size_t)(r.y1 - r.y0); y++) {
+                    std::memcpy(&scratch[y * rowBytes], first + y * stride, rowBytes);
+                }
+                pixels = scratch.data();
+            }
+            ::Rectangle rec{(float)r.x0, (float)r.y0, (float)(r.x1 - r.x0), (float)(r.y1 - r.y0)};
+            ::UpdateTextureRec(texture, rec, pixels);
+            bytes += rowBytes * (size_t)(r.y1 - r.y0);
+        }
+        rects.clear();
+        return bytes;
+    }
+
+protected:
+    /**
+     * Half-open pixel bounds [x0, x1) x [y0, y1)
+     */
+    struct Rect {
+        int x0, y0, x1, y1;
+        long Area() const { return (long)(x1 - x0) * (long)(y1 - y0); }
+        bool Contains(const Rect& o) const { return x0 <= o.x0 && y0 <= o.y0 && x1 >= o.x1 && y1 >= o.y1; }
+    };
+
+    int width, height;
+    int maxRects;
+    std::vector<Rect> rects;
+    std::vector<unsigned char> scratch;
+
+    static Rect Union(const Rect& a, const Rect& b) {
+        return Rect{std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+    }
+
+    // Overlapping or sharing an edge or corner
+    static bool Touch(const Rect& a, const Rect& b) {
+        return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+    }
+
+    // Pixels a and b cover between them
+    static long Covered(const Rect& a, const Rect& b) {
+        long ix = std::min(a.x1, b.x1) - std::max(a.x0, b.x0);
+        long iy = std::min(a.y1, b.y1) - std::max(a.y0, b.y0);
+        long overlap = ix > 0 && iy > 0 ? ix * iy : 0;
+        return a.Area() + b.Area() - overlap;
+    }
+
+    // Pixels their union would upload that neither covers
+    static long Waste(const Rect& a, const Rect& b) { return Union(a, b).Area() - Covered(a, b); }
+};
+} // namespace raylib
+
+using RDirtyRegion = raylib::DirtyRegion;
+
+#endif // RAYLIB_CPP_INCLUDE_DIRTYREGION_HPP_
@@ -4,6 +4,7 @@
 #include <string>
 #include <utility>
 
+#include "./DataView.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
 
@@ -30,6 +31,9 @@ public:
     GETTER(const unsigned char*, Data, data)
     GETTER(int, BytesRead, bytesRead)
 
+    DataView GetView() const { return DataView(data, bytesRead); }
+    operator DataView() const { return GetView(); }
+
     void Load(const std::string& fileName) { Load(fileName.c_str()); }
     void Load(const char* fileName) {
         Unload();
@@ -0,0 +1,224 @@
+/**
+ * Fixed-capacity strings for text that is rebuilt every frame.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_FIXEDSTRING_HPP_
+#define RAYLIB_CPP_INCLUDE_FIXEDSTRING_HPP_
+
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A string of up to Capacity characters stored inline, for HUD text formatted every frame without touching the heap.
+ *
+ * TextFormat writes into one of a few static buffers that it reuses in turn, so a string it returns is overwritten a
+ * few calls later, and its result copied into a std::string can allocate. A FixedString lives wherever it is declared,
+ * usually on the stack or in the object that draws it, and converts to const char*, so it can be passed straight to
+ * DrawText, Text::SetText and the rest of the C API.
+ *
+ * Numbers are appended by Append(), which writes integers digit by digit and fixed-point floats the same way,
+ * without going through printf; Format() and AppendFormat() take printf formats for anything else. Text that doesn't
+ * fit is cut off at Capacity characters, and IsTruncated() reports it.
+ *
+ * @code
+ * raylib::FixedString<32> score;
+ * score.Append("Score: ").Append(player.score, 7);
+ * DrawText(score, 10, 10, 20, WHITE);
+ * @endcode
+ */
+template <size_t Capacity>
+class FixedString {
+public:
+    FixedString() { buffer[0] = '\0'; }
+
+    FixedString(const char* text) {
+        buffer[0] = '\0';
+        Append(text);
+    }
+
+    const char* c_str() const { return buffer; }
+    operator const char*() const { return buffer; }
+
+    size_t size() const { return length; }
+    static constexpr size_t capacity() { return Capacity; }
+    bool empty() const { return length == 0; }
+
+    /**
+     * Whether anything appended since the last Clear() was cut off
+     */
+    bool IsTruncated() const { return truncated; }
+
+    FixedString& Clear() {
+        length = 0;
+        truncated = false;
+        buffer[0] = '\0';
+        return *this;
+    }
+
+    FixedString& Append(const char* text) { return text == nullptr ? *this : Append(text, std::strlen(text)); }
+
+    FixedString& Append(const char* text, size_t count) {
+        if (count > Capacity - length) {
+            count = Capacity - length;
+            truncated = true;
+        }
+        std::memcpy(buffer + length, text, count);
+        length += count;
+        buffer[length] = '\0';
+        return *this;
+    }
+
+    FixedString& Append(char c) { return Append(&c, 1); }
+
+    /**
+     * Appends an integer, right-aligned in at least width characters padded with fill, as "%*d" would
+     */
+    FixedString& Append(int value, int width = 0, char fill = ' ') { return Append((long long)value, width, fill); }
+    FixedString& Append(long value, int width = 0, char fill = ' ') { return Append((long long)value, width, fill); }
+
+    FixedString& Append(long long value, int width = 0, char fill = ' ') {
+        // Negated as unsigned, so the most negative value is still correct
+        unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+        return AppendNumber(magnitude, value < 0, 0, 0, width, fill);
+    }
+
+    FixedString& Append(unsigned int value, int width = 0, char fill = ' ') {
+        return Append((unsigned long long)value, width, fill);
+    }
+
+    FixedString& Append(unsigned long value, int width = 0, char fill = ' ') {
+        return Append((unsigned long long)value, width, fill);
+    }
+
+    FixedString& Append(unsigned long long value, int width = 0, char fill = ' ') {
+        return AppendNumber(value, false, 0, 0, width, fill);
+    }
+
+    /**
+     * Appends a number rounded to decimals places, right-aligned in at least width characters, as "%*.*f" would,
+     * except that halves round away from zero (2.675 may print as 2.68 where printf gives 2.67). Values with more
+     * digits than a double holds exactly, NaN and infinities go through snprintf.
+     */
+    FixedString& Append(double value, int decimals = 2, int width = 0, char fill = ' ') {
+        if (decimals < 0) decimals = 0;
+        if (decimals <= 9) {
+            unsigned long long scale = 1;
+            for (int i = 0; i < decimals; i++) scale *= 10;
+            double scaled = std::fabs(value) * (double)scale + 0.5;
+            if (scaled < 9007199254740992.0) {
+                unsigned long long fixed = (unsigned long long)scaled;
+                return AppendNumber(fixed / scale, value < 0 && fixed != 0, fixed % scale, decimals, width, fill);
+            }
+        }
+        return AppendFormat("%*.*f", width, decimals, value);
+    }
+
+    /**
+     * Replaces the contents with printf-style formatted text
+     */
+    FixedString& Format(const char* format, ...) {
+        Clear();
+        va_list args;
+        va_start(args, format);
+        AppendFormatV(format, args);
+        va_end(args);
+        return *this;
+    }
+
+    FixedString& AppendFormat(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        AppendFormatV(format, args);
+        va_end(args);
+        return *this;
+    }
+
+    bool operator==(const char* other) const { return std::strcmp(buffer, other) == 0; }
+    bool operator!=(const char* other) const { return !(*this == other); }
+protected:
+    char buffer[Capacity + 1];
+    size_t length = 0;
+    bool truncated = false;
+
+    /**
+     * Appends [-]whole[.fraction], with fraction zero-padded to decimals digits, padded on the left to width
+     */
+    FixedString& AppendNumber(unsigned long long whole, bool negative, unsigned long long fraction, int decimals,
+                              int width, char fill) {
+        // Written backwards from the end: 20 digits, a sign, a point and up to 9 decimals
+        char digits[32];
+        int start = (int)sizeof(digits);
+        for (int i = 0; i < decimals; i++) {
+            digits[--start] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        if (decimals > 0) digits[--start] = '.';
+        do {
+            digits[--start] = (char)('0' + whole % 10);
+            whole /= 10;
+        } while (whole != 0);
+        if (negative && fill != '0') digits[--start] = '-';
+        int count = (int)sizeof(digits) - start;
+        if (negative && fill == '0') {
+            // Zeros go after the sign, as in "%07d"
+            Append('-');
+            width--;
+        }
+        for (int i = count; i < width; i++) Append(fill);
+        return Append(digits + start, (size_t)count);
+    }
+
+    void AppendFormatV(const char* format, va_list args) {
+        int written = std::vsnprintf(buffer + length, Capacity - length + 1, format, args);
+        if (written < 0) {
+            buffer[length] = '\0';
+            return;
+        }
+        if ((size_t)written > Capacity - length) {
+            truncated = true;
+            written = (int)(Capacity - length);
+        }
+        length += (size_t)written;
+    }
+};
+
+/*
+ * A FixedString converts to const char* just as well for ::DrawText as for the raylib:: overloads that argument
+ * dependent lookup also finds, so an unqualified DrawText(label, ...) would be ambiguous without these.
+ */
+
+/**
+ * Draw text (using default font)
+ */
+template <size_t Capacity>
+inline void DrawText(const FixedString<Capacity>& text, int posX, int posY, int fontSize, ::Color color) {
+    ::DrawText(text.c_str(), posX, posY, fontSize, color);
+}
+
+/**
+ * Draw text using font and additional parameters
+ */
+template <size_t Capacity>
+inline void DrawTextEx(const ::Font& font, const FixedString<Capacity>& text, ::Vector2 position, float fontSize,
+                       float spacing, ::Color tint) {
+    ::DrawTextEx(font, text.c_str(), position, fontSize, spacing, tint);
+}
+
+/**
+ * Measure string width for default font
+ */
+template <size_t Capacity>
+inline int MeasureText(const FixedString<Capacity>& text, int fontSize) {
+    return ::MeasureText(text.c_str(), fontSize);
+}
+} // namespace raylib
+
+template <size_t Capacity>
+using RFixedString = raylib::FixedString<Capacity>;
+
+#endif // RAYLIB_CPP_INCLUDE_FIXEDSTRING_HPP_
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "./DataView.hpp"
 #include "./RaylibException.hpp"
 #include "./TextureUnmanaged.hpp"
 #include "./raylib-cpp-utils.hpp"
@@ -82,6 +83,22 @@ public:
         Load(fileType, fileData, dataSize, fontSize, fontChars, charsCount);
     }
 
+    /**
+     * Loads a font from a view of file contents, such as a FileData or MappedFileData's.
+     *
+     * @throws raylib::RaylibException Throws if the given font failed to initialize.
+     *
+     * @see ::LoadFontFromMemory()
+     */
+    Font(
+        const std::string& fileType,
+        const DataView& fileData,
+        int fontSize,
+        int* fontChars = nullptr,
+        int charsCount = 0) {
+        Load(fileType, fileData.GetData(), fileData.GetSize(), fontSize, fontChars, charsCount);
+    }
+
     Font(const Font&) = delete;
 
     Font(Font&& other) noexcept {
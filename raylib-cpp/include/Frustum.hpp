@@ -0,0 +1,124 @@
+/**
+ * View frustum planes for culling.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_FRUSTUM_HPP_
+#define RAYLIB_CPP_INCLUDE_FRUSTUM_HPP_
+
+#ifndef RAYLIB_CPP_NO_MATH
+#include <cmath>
+
+#include "./raylib.hpp"
+#include "./raymath.hpp"
+
+namespace raylib {
+/**
+ * The six planes bounding what a camera can see, for discarding objects before they are drawn.
+ *
+ * Each plane is stored as (x, y, z, w) with a unit normal pointing inwards, so a point p is inside when
+ * x * p.x + y * p.y + z * p.z + w >= 0 for all six.
+ *
+ * @code
+ * raylib::Frustum frustum = camera.GetFrustum();
+ * for (const Crate& c : crates) {
+ *     if (frustum.CheckCollision(c.bounds)) c.Draw();
+ * }
+ * @endcode
+ */
+class Frustum {
+public:
+    enum Plane { LEFT = 0, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, PLANE_COUNT };
+
+    enum Result { OUTSIDE = 0, INTERSECTS, INSIDE };
+
+    /**
+     * Frustum of a combined view-projection matrix, MatrixMultiply(view, projection)
+     */
+    explicit Frustum(const ::Matrix& viewProjection) { set(viewProjection); }
+
+    /**
+     * Frustum of camera as BeginMode3D sets it up for a target with the given aspect ratio. nearPlane and farPlane
+     * default to rlgl's cull distances.
+     */
+    Frustum(const ::Camera3D& camera, float aspect, float nearPlane = 0.01f, float farPlane = 1000.0f) {
+        ::Matrix view = ::MatrixLookAt(camera.position, camera.target, camera.up);
+        ::Matrix projection;
+        if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+            double top = camera.fovy / 2.0;
+            double right = top * aspect;
+            projection = ::MatrixOrtho(-right, right, -top, top, nearPlane, farPlane);
+        } else {
+            projection = ::MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+        }
+        set(::MatrixMultiply(view, projection));
+    }
+
+    const ::Vector4& GetPlane(int plane) const { return planes[plane]; }
+
+    /**
+     * Whether box is fully outside, partly inside or fully inside
+     */
+    Result Classify(const ::BoundingBox& box) const {
+        Result result = INSIDE;
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            const ::Vector4& p = planes[i];
+            // The corner furthest along the normal decides outside; the nearest decides inside
+            float furthest = p.x * (p.x >= 0.0f ? box.max.x : box.min.x) + p.y * (p.y >= 0.0f ? box.max.y : box.min.y) +
+                             p.z * (p.z >= 0.0f ? box.max.z : box.min.z) + p.w;
+            if (furthest < 0.0f) return OUTSIDE;
+            float nearest = p.x * (p.x >= 0.0f ? box.min.x : box.max.x) + p.y * (p.y >= 0.0f ? box.min.y : box.max.y) +
+                            p.z * (p.z >= 0.0f ? box.min.z : box.max.z) + p.w;
+            if (nearest < 0.0f) result = INTERSECTS;
+        }
+        return result;
+    }
+
+    /**
+     * Whether any part of box may be visible. Large boxes just off a corner can pass, as with any plane test.
+     */
+    [[nodiscard]] bool CheckCollision(const ::BoundingBox& box) const { return Classify(box) != OUTSIDE; }
+
+    /**
+     * Whether any part of a sphere may be visible
+     */
+    [[nodiscard]] bool CheckCollision(::Vector3 center, float radius) const {
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            const ::Vector4& p = planes[i];
+            if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Whether a point is visible
+     */
+    [[nodiscard]] bool CheckCollision(::Vector3 point) const { return CheckCollision(point, 0.0f); }
+protected:
+    ::Vector4 planes[PLANE_COUNT];
+
+    void set(const ::Matrix& m) {
+        // Gribb-Hartmann: each plane is the last row of the clip matrix plus or minus one of the others
+        planes[LEFT] = ::Vector4{m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12};
+        planes[RIGHT] = ::Vector4{m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12};
+        planes[BOTTOM] = ::Vector4{m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13};
+        planes[TOP] = ::Vector4{m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13};
+        planes[NEAR_PLANE] = ::Vector4{m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14};
+        planes[FAR_PLANE] = ::Vector4{m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14};
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            ::Vector4& p = planes[i];
+            float length = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+            if (length > 0.0f) {
+                p.x /= length;
+                p.y /= length;
+                p.z /= length;
+                p.w /= length;
+            }
+        }
+    }
+};
+} // namespace raylib
+
+using RFrustum = raylib::Frustum;
+
+#endif // RAYLIB_CPP_NO_MATH
+
+#endif // RAYLIB_CPP_INCLUDE_FRUSTUM_HPP_
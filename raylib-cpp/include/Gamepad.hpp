@@ -1,12 +1,46 @@
 #ifndef RAYLIB_CPP_INCLUDE_GAMEPAD_HPP_
 #define RAYLIB_CPP_INCLUDE_GAMEPAD_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+#include "./InputQueue.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
 
 namespace raylib {
+/**
+ * Everything about one gamepad at one moment: which buttons are down, which went down or up since the capture
+ * before, and every axis. Filled by Gamepad::Capture().
+ *
+ * Gameplay that asks about several buttons and axes of several pads every tick can capture each pad once and query
+ * the copy, which is a bit test or an array read, instead of calling into raylib per button. Edges are relative to
+ * the previous capture into the same state, so capturing once per tick makes them per-tick edges.
+ */
+class GamepadState {
+public:
+    static constexpr int MAX_AXES = GAMEPAD_AXIS_RIGHT_TRIGGER + 1;
+
+    bool available = false;
+    uint32_t buttons = 0;  // Bit b set while GamepadButton b is down
+    uint32_t pressed = 0;  // Went down since the previous capture
+    uint32_t released = 0; // Went up since the previous capture
+    float axes[MAX_AXES] = {};
+
+    [[nodiscard]] bool IsButtonDown(int button) const { return (buttons >> button) & 1u; }
+    [[nodiscard]] bool IsButtonUp(int button) const { return !IsButtonDown(button); }
+    [[nodiscard]] bool IsButtonPressed(int button) const { return (pressed >> button) & 1u; }
+    [[nodiscard]] bool IsButtonReleased(int button) const { return (released >> button) & 1u; }
+
+    /**
+     * Axis movement, 0 for axes the pad doesn't have
+     */
+    [[nodiscard]] float GetAxisMovement(int axis) const {
+        return axis >= 0 && axis < MAX_AXES ? axes[axis] : 0.0f;
+    }
+};
+
 /**
  * Input-related functions: gamepads
  */
@@ -96,11 +130,48 @@ public:
     void SetVibration(float leftMotor, float rightMotor, float duration) const {
         ::SetGamepadVibration(number, leftMotor, rightMotor, duration);
     }
+
+    /**
+     * Fill state with every button and axis of this gamepad. A pad that isn't connected reads as nothing held, so
+     * unplugging one releases its buttons.
+     */
+    void Capture(GamepadState& state) const {
+        uint32_t down = 0;
+        state.available = IsAvailable();
+        if (state.available) {
+            for (int button = GAMEPAD_BUTTON_LEFT_FACE_UP; button <= GAMEPAD_BUTTON_RIGHT_THUMB; button++) {
+                if (::IsGamepadButtonDown(number, button)) down |= 1u << button;
+            }
+        }
+        state.pressed = down & ~state.buttons;
+        state.released = state.buttons & ~down;
+        state.buttons = down;
+
+        const int axisCount = state.available ? GetAxisCount() : 0;
+        for (int axis = 0; axis < GamepadState::MAX_AXES; axis++) {
+            state.axes[axis] = axis < axisCount ? ::GetGamepadAxisMovement(number, axis) : 0.0f;
+        }
+    }
+
+    /**
+     * Push a down or up event stamped with time for each of buttons that went down or up since the last input poll,
+     * with this gamepad's number as the device; returns how many. Call it once after each poll.
+     */
+    template<size_t Capacity>
+    size_t QueueButtons(InputQueue<Capacity>& queue, const int* buttons, size_t count, double time) const {
+        size_t pushed = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (IsButtonPressed(buttons[i])) pushed += queue.Push(time, number, buttons[i], true);
+            if (IsButtonReleased(buttons[i])) pushed += queue.Push(time, number, buttons[i], false);
+        }
+        return pushed;
+    }
 protected:
     void set(int gamepadNumber) { number = gamepadNumber; }
 };
 } // namespace raylib
 
 using RGamepad = raylib::Gamepad;
+using RGamepadState = raylib::GamepadState;
 
 #endif // RAYLIB_CPP_INCLUDE_GAMEPAD_HPP_
@@ -0,0 +1,300 @@
+/**
+ * Font glyphs rasterized on first use into a growing atlas.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_GLYPHATLAS_HPP_
+#define RAYLIB_CPP_INCLUDE_GLYPHATLAS_HPP_
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./DirtyRegion.hpp"
+#include "./RaylibException.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Draws text from a TrueType/OpenType font whose glyphs are rasterized the first time they are drawn, rather than all
+ * when the font loads.
+ *
+ * LoadFontEx rasterizes every codepoint asked for up front, so a HUD that may show any of a few thousand CJK glyphs
+ * pays for all of them in load time and texture memory. The atlas keeps only the font file, and draws each new glyph into
+ * a shelf-packed CPU image the first time it appears: glyphs go on the lowest shelf tall enough for them, and a new
+ * shelf opens below when none has room. The image starts a few shelves tall and doubles, up to maxSize, as shelves
+ * fill; only the changed parts of it are sent to the texture (see DirtyRegion). Glyphs are kept once rasterized; past
+ * maxSize new ones are left out of the text.
+ *
+ * Drawing is laid out like DrawTextEx, with the glyphs rasterized at fontSize and scaled to the size asked for.
+ *
+ * @code
+ * raylib::GlyphAtlas hud("resources/NotoSansJP.ttf", 32);
+ * // Each frame:
+ * hud.Draw(localized.c_str(), Vector2{20, 20}, 32, 1, WHITE);
+ * @endcode
+ */
+class GlyphAtlas {
+public:
+    static constexpr int DEFAULT_WIDTH = 512;
+    static constexpr int DEFAULT_MAX_SIZE = 4096;
+
+    /**
+     * Reads a font file to rasterize glyphs from at fontSize pixels.
+     *
+     * @throws raylib::RaylibException Throws if the file can't be read.
+     */
+    GlyphAtlas(const std::string& fileName, int fontSize, int width = DEFAULT_WIDTH, int maxSize = DEFAULT_MAX_SIZE,
+               int padding = 2)
+        : fontSize(fontSize), width(width), maxHeight(maxSize), padding(padding), dirty(0, 0) {
+        int size = 0;
+        unsigned char* data = ::LoadFileData(fileName.c_str(), &size);
+        if (data == nullptr || size <= 0) {
+            throw RaylibException("Failed to load font file for GlyphAtlas: " + fileName);
+        }
+        fileData.assign(data, data + size);
+        ::UnloadFileData(data);
+        Resize(fontSize * 4);
+    }
+
+    ~GlyphAtlas() {
+        if (texture.id != 0) ::UnloadTexture(texture);
+        ::UnloadImage(image);
+    }
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    int GetFontSize() const { return fontSize; }
+    int GetGlyphCount() const { return (int)glyphs.size(); }
+    const ::Image& GetImage() const { return image; }
+    const ::Texture2D& GetTexture() const { return texture; }
+
+    /**
+     * Pixels between lines, in addition to the font size, as SetTextLineSpacing sets for DrawTextEx
+     */
+    void SetLineSpacing(int spacing) { lineSpacing = spacing; }
+
+    /**
+     * Rasterizes a codepoint if it hasn't been, returning false if it couldn't be placed
+     */
+    bool Require(int codepoint) { return Find(codepoint).placed; }
+
+    /**
+     * Rasterizes every codepoint of UTF-8 text that hasn't been
+     */
+    void Require(const char* text) {
+        for (int i = 0; text[i] != '\0';) {
+            int bytes = 0;
+            int codepoint = ::GetCodepointNext(&text[i], &bytes);
+            Find(codepoint);
+            i += bytes;
+        }
+    }
+
+    /**
+     * Sends the glyphs added since the last call to the texture, creating it the first time. Draw() calls this.
+     */
+    void Upload() {
+        if (texture.id == 0) {
+            texture = ::LoadTextureFromImage(image);
+            dirty.Clear();
+        } else if (!dirty.IsEmpty()) {
+            dirty.Flush(texture, image);
+        }
+    }
+
+    /**
+     * Draws UTF-8 text with its top-left corner at position, as DrawTextEx does
+     */
+    void Draw(const char* text, ::Vector2 position, float size, float spacing, ::Color tint = WHITE) {
+        Require(text);
+        Upload();
+        float scale = size / (float)fontSize;
+        float x = 0.0f, y = 0.0f;
+        for (int i = 0; text[i] != '\0';) {
+            int bytes = 0;
+            int codepoint = ::GetCodepointNext(&text[i], &bytes);
+            i += bytes;
+            if (codepoint == '\n') {
+                x = 0.0f;
+                y += size + (float)lineSpacing;
+                continue;
+            }
+            const Glyph& glyph = Find(codepoint);
+            if (glyph.placed && glyph.rec.width > 0.0f) {
+                float p = (float)padding;
+                ::Rectangle source{glyph.rec.x - p, glyph.rec.y - p, glyph.rec.width + 2 * p, glyph.rec.height + 2 * p};
+                ::Rectangle dest{position.x + x + ((float)glyph.offsetX - p) * scale,
+                                 position.y + y + ((float)glyph.offsetY - p) * scale, source.width * scale,
+                                 source.height * scale};
+                ::DrawTexturePro(texture, source, dest, ::Vector2{0.0f, 0.0f}, 0.0f, tint);
+            }
+            x += Advance(glyph) * scale + spacing;
+        }
+    }
+
+    void Draw(const std::string& text, ::Vector2 position, float size, float spacing, ::Color tint = WHITE) {
+        Draw(text.c_str(), position, size, spacing, tint);
+    }
+
+    /**
+     * Size of UTF-8 text as Draw() lays it out, rasterizing any new glyphs
+     */
+    ::Vector2 Measure(const char* text, float size, float spacing) {
+        float scale = size / (float)fontSize;
+        float lineWidth = 0.0f, widest = 0.0f;
+        int lines = 1;
+        bool lineStart = true;
+        for (int i = 0; text[i] != '\0';) {
+            int bytes = 0;
+            int codepoint = ::GetCodepointNext(&text[i], &bytes);
+            i += bytes;
+            if (codepoint == '\n') {
+                lineWidth = 0.0f;
+                lineStart = true;
+                lines++;
+                continue;
+            }
+            lineWidth += (lineStart ? 0.0f : spacing) + Advance(Find(codepoint)) * scale;
+            lineStart = false;
+            if (lineWidth > widest) widest = lineWidth;
+        }
+        return ::Vector2{widest, (float)lines * size + (float)(lines - 1) * (float)lineSpacing};
+    }
+protected:
+    struct Glyph {
+        ::Rectangle rec{0.0f, 0.0f, 0.0f, 0.0f}; // In the atlas, without padding; empty for blank glyphs
+        int offsetX = 0;
+        int offsetY = 0;
+        int advanceX = 0;
+        bool placed = false;
+    };
+
+    /**
+     * A row of glyphs no taller than height, filled left to right up to x
+     */
+    struct Shelf {
+        int y;
+        int height;
+        int x;
+    };
+
+    int fontSize;
+    int width;
+    int maxHeight;
+    int padding;
+    int lineSpacing = 2;
+    std::vector<unsigned char> fileData;
+    std::unordered_map<int, Glyph> glyphs;
+    std::vector<Shelf> shelves;
+    ::Image image{};
+    ::Texture2D texture{};
+    DirtyRegion dirty;
+
+    static float Advance(const Glyph& glyph) {
+        return glyph.advanceX != 0 ? (float)glyph.advanceX : glyph.rec.width;
+    }
+
+    const Glyph& Find(int codepoint) {
+        std::unordered_map<int, Glyph>::iterator found = glyphs.find(codepoint);
+        if (found != glyphs.end()) return found->second;
+
+        Glyph& glyph = glyphs[codepoint];
+        int size = (int)fileData.size();
+        ::GlyphInfo* info = ::LoadFontData(fileData.data(), size, fontSize, &codepoint, 1, FONT_DEFAULT);
+        if (info == nullptr) return glyph;
+        glyph.offsetX = info->offsetX;
+        glyph.offsetY = info->offsetY;
+        glyph.advanceX = info->advanceX;
+        const ::Image& bitmap = info->image;
+        const unsigned char* pixels = (const unsigned char*)bitmap.data;
+        bool blank = true;
+        for (int i = 0; pixels != nullptr && blank && i < bitmap.width * bitmap.height; i++) blank = pixels[i] == 0;
+        if (blank) {
+            // Spaces and the like only advance, so they take no room
+            glyph.placed = true;
+        } else {
+            int x = 0, y = 0;
+            if (Place(bitmap.width + 2 * padding, bitmap.height + 2 * padding, &x, &y)) {
+                x += padding;
+                y += padding;
+                Blit(bitmap, x, y);
+                glyph.rec = ::Rectangle{(float)x, (float)y, (float)bitmap.width, (float)bitmap.height};
+                glyph.placed = true;
+            }
+        }
+        ::UnloadFontData(info, 1);
+        return glyph;
+    }
+
+    /**
+     * Finds room for a w x h cell, opening shelves and growing the image as needed
+     */
+    bool Place(int w, int h, int* x, int* y) {
+        if (w > width) return false;
+        Shelf* best = nullptr;
+        for (size_t i = 0; i < shelves.size(); i++) {
+            Shelf& shelf = shelves[i];
+            if (shelf.height >= h && shelf.x + w <= width && (best == nullptr || shelf.height < best->height)) {
+                best = &shelf;
+            }
+        }
+        if (best == nullptr) {
+            int top = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+            while (top + h > image.height) {
+                if (image.height >= maxHeight) return false;
+                Resize(image.height * 2 > maxHeight ? maxHeight : image.height * 2);
+            }
+            Shelf shelf{top, h, 0};
+            shelves.push_back(shelf);
+            best = &shelves.back();
+        }
+        *x = best->x;
+        *y = best->y;
+        best->x += w;
+        return true;
+    }
+
+    /**
+     * Writes a grayscale glyph bitmap into the atlas as white with that alpha, as LoadFontEx's atlas is
+     */
+    void Blit(const ::Image& bitmap, int x, int y) {
+        unsigned char* atlas = (unsigned char*)image.data;
+        const unsigned char* pixels = (const unsigned char*)bitmap.data;
+        for (int row = 0; row < bitmap.height; row++) {
+            unsigned char* out = atlas + ((size_t)(y + row) * (size_t)width + (size_t)x) * 2;
+            for (int col = 0; col < bitmap.width; col++) {
+                out[col * 2] = 255;
+                out[col * 2 + 1] = pixels[row * bitmap.width + col];
+            }
+        }
+        dirty.Add(x, y, bitmap.width, bitmap.height);
+    }
+
+    /**
+     * Makes the image height rows tall, keeping what is drawn; the texture is remade at the next Upload()
+     */
+    void Resize(int height) {
+        ::Image grown{};
+        grown.width = width;
+        grown.height = height;
+        grown.mipmaps = 1;
+        grown.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+        grown.data = RL_CALLOC((size_t)width * (size_t)height * 2, 1);
+        if (image.data != nullptr) {
+            std::memcpy(grown.data, image.data, (size_t)width * (size_t)image.height * 2);
+            ::UnloadImage(image);
+        }
+        image = grown;
+        if (texture.id != 0) {
+            ::UnloadTexture(texture);
+            texture = ::Texture2D{};
+        }
+        dirty = DirtyRegion(width, height);
+    }
+};
+} // namespace raylib
+
+using RGlyphAtlas = raylib::GlyphAtlas;
+
+#endif // RAYLIB_CPP_INCLUDE_GLYPHATLAS_HPP_
@@ -0,0 +1,153 @@
+/**
+ * Running totals of the GPU memory held through raylib-cpp's resource wrappers.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_GPUMEMORY_HPP_
+#define RAYLIB_CPP_INCLUDE_GPUMEMORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "./CookedTexture.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * How many textures, render textures and meshes are alive and roughly how much VRAM they take, for budgets and
+ * debug overlays.
+ *
+ * raylib::Texture, raylib::RenderTexture and raylib::Mesh register what they load or take ownership of, and forget
+ * it when they unload it; TextureUnmanaged and MeshUnmanaged register what their Load() and Upload() calls create.
+ * Resources are keyed by their GL id, so one handed from wrapper to wrapper is only counted once, but anything
+ * loaded with raylib's C functions and never given to a managed wrapper isn't seen at all. Sizes are estimates from
+ * the dimensions and pixel format, vertex attributes or depth buffer: drivers pad and may keep extra copies.
+ *
+ * @code
+ * raylib::GpuMemory::Usage textures = raylib::GpuMemory::Get(raylib::GpuMemory::TEXTURE);
+ * DrawText(TextFormat("%d textures, %d KB", (int)textures.count, (int)(textures.bytes >> 10)), 10, 10, 10, WHITE);
+ * @endcode
+ */
+class GpuMemory {
+public:
+    enum Kind { TEXTURE, RENDER_TEXTURE, MESH, KIND_COUNT };
+
+    struct Usage {
+        size_t count;
+        size_t bytes;
+    };
+
+    /**
+     * Records a resource of bytes under its GL id; registering an id again just updates its size
+     */
+    static void Track(Kind kind, unsigned int id, size_t bytes) {
+        if (id == 0) return;
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto inserted = registry.sizes.insert(std::make_pair(Key(kind, id), bytes));
+        Usage& usage = registry.usage[kind];
+        if (inserted.second) {
+            usage.count++;
+        } else {
+            usage.bytes -= inserted.first->second;
+            inserted.first->second = bytes;
+        }
+        usage.bytes += bytes;
+    }
+
+    /**
+     * Forgets a resource about to be unloaded; ids that were never tracked are ignored
+     */
+    static void Untrack(Kind kind, unsigned int id) {
+        if (id == 0) return;
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto found = registry.sizes.find(Key(kind, id));
+        if (found == registry.sizes.end()) return;
+        registry.usage[kind].count--;
+        registry.usage[kind].bytes -= found->second;
+        registry.sizes.erase(found);
+    }
+
+    /**
+     * Resources of one kind alive right now
+     */
+    static Usage Get(Kind kind) {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        return registry.usage[kind];
+    }
+
+    /**
+     * Bytes held across every kind
+     */
+    static size_t GetTotalBytes() {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        size_t total = 0;
+        for (int kind = 0; kind < KIND_COUNT; kind++) total += registry.usage[kind].bytes;
+        return total;
+    }
+
+    /**
+     * Pixel data of every mip level
+     */
+    static size_t TextureBytes(const ::Texture& texture) {
+        int mipmaps = texture.mipmaps > 0 ? texture.mipmaps : 1;
+        int size = CookedTexture::GetDataSize(texture.width, texture.height, texture.format, mipmaps);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+    /**
+     * The color attachment plus raylib's 32-bit depth renderbuffer, if it has one
+     */
+    static size_t RenderTextureBytes(const ::RenderTexture& target) {
+        size_t depth = target.depth.id != 0
+            ? static_cast<size_t>(target.texture.width) * static_cast<size_t>(target.texture.height) * 4
+            : 0;
+        return TextureBytes(target.texture) + depth;
+    }
+
+    /**
+     * The vertex buffers raylib uploads for the attributes the mesh has
+     */
+    static size_t MeshBytes(const ::Mesh& mesh) {
+        size_t vertex = 0;
+        if (mesh.vertices) vertex += 3 * sizeof(float);
+        if (mesh.texcoords) vertex += 2 * sizeof(float);
+        if (mesh.texcoords2) vertex += 2 * sizeof(float);
+        if (mesh.normals) vertex += 3 * sizeof(float);
+        if (mesh.tangents) vertex += 4 * sizeof(float);
+        if (mesh.colors) vertex += 4;
+        if (mesh.boneIds) vertex += 4;
+        if (mesh.boneWeights) vertex += 4 * sizeof(float);
+        size_t indices = mesh.indices ? static_cast<size_t>(mesh.triangleCount) * 3 * sizeof(unsigned short) : 0;
+        return static_cast<size_t>(mesh.vertexCount) * vertex + indices;
+    }
+
+    /**
+     * The id a mesh is tracked under: its first vertex buffer, 0 if it was never uploaded
+     */
+    static unsigned int MeshId(const ::Mesh& mesh) { return mesh.vboId ? mesh.vboId[0] : 0; }
+
+private:
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, size_t> sizes;
+        Usage usage[KIND_COUNT] = {};
+    };
+
+    // Never destroyed, so wrappers with static storage can still unload at exit
+    static Registry& GetRegistry() {
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+
+    static uint64_t Key(Kind kind, unsigned int id) { return static_cast<uint64_t>(kind) << 32 | id; }
+};
+} // namespace raylib
+
+using RGpuMemory = raylib::GpuMemory;
+
+#endif // RAYLIB_CPP_INCLUDE_GPUMEMORY_HPP_
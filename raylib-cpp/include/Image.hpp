@@ -4,6 +4,7 @@
 #include <string>
 
 #include "./Color.hpp"
+#include "./DataView.hpp"
 #include "./RaylibException.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
@@ -66,6 +67,13 @@ public:
         Load(fileType, fileData, dataSize);
     }
 
+    /**
+     * Load an image from file contents already in memory, such as a FileData or MappedFileData's view.
+     *
+     * @throws raylib::RaylibException Thrown if the image failed to load from the data.
+     */
+    Image(const std::string& fileType, const DataView& fileData) { Load(fileType, fileData); }
+
     /**
      * Load an image from the given file.
      *
@@ -260,6 +268,15 @@ public:
         }
     }
 
+    /**
+     * Load image from a view of file contents, fileType refers to extension: i.e. "png".
+     *
+     * @throws raylib::RaylibException Thrown if the image failed to load from the data.
+     */
+    void Load(const std::string& fileType, const DataView& fileData) {
+        Load(fileType, fileData.GetData(), fileData.GetSize());
+    }
+
     /**
      * Load an image from the given file.
      *
@@ -641,7 +658,13 @@ public:
         ::ImageDrawRectangleLines(this, rec, thick, color);
     }
 
-    // TODO: Add ImageDrawTriangle()
+    void DrawCircleLines(int centerX, int centerY, int radius, ::Color color = {255, 255, 255, 255}) {
+        ::ImageDrawCircleLines(this, centerX, centerY, radius, color);
+    }
+
+    void DrawTriangle(::Vector2 v1, ::Vector2 v2, ::Vector2 v3, ::Color color = {255, 255, 255, 255}) {
+        ::ImageDrawTriangle(this, v1, v2, v3, color);
+    }
 
     void Draw(const ::Image& src, ::Rectangle srcRec, ::Rectangle dstRec, ::Color tint = {255, 255, 255, 255}) {
         ::ImageDraw(this, src, srcRec, dstRec, tint);
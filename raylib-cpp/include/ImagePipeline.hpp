@@ -0,0 +1,509 @@
+/**
+ * Lazy, fused image operations.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_IMAGEPIPELINE_HPP_
+#define RAYLIB_CPP_INCLUDE_IMAGEPIPELINE_HPP_
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "./Image.hpp"
+#include "./raylib-cpp-simd.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Records image operations and runs them together in Execute().
+ *
+ * Chaining raylib::Image methods calls one C function per step, and most of them allocate a new pixel buffer. The
+ * pipeline instead folds every crop, flip, 90 degree rotation and nearest-neighbour resize into a single coordinate
+ * mapping, and applies the colour operations to each pixel as it is copied, so a chain of those costs one pass and at
+ * most one allocation. When the mapping is the identity and the pipeline owns its source, the colour operations run in
+ * place with no allocation at all. Runs of per-channel colour operations (tint, invert, brightness, contrast) are
+ * further folded into one lookup table per channel.
+ *
+ * Parallel() splits each pass into bands of rows run on their own threads, for large images such as full-screen
+ * backgrounds. Bands never share output rows, so the result is the same as running on one thread.
+ *
+ * The result matches running the same raylib::Image methods one by one, with two exceptions: ColorGrayscale keeps
+ * RGBA8 (and alpha) where ImageColorGrayscale changes the format, and only the base mipmap level is kept. Resize()
+ * (smooth) and Format() can't be fused; each ends the current pass and runs through raylib. Work happens in RGBA8;
+ * other source formats are converted once up front.
+ *
+ * @code
+ * raylib::Image thumb = raylib::ImagePipeline(std::move(image)).Crop(area).FlipVertical().ResizeNN(64, 64)
+ *     .ColorTint(GOLD).Execute();
+ * @endcode
+ */
+class ImagePipeline {
+public:
+    /**
+     * Reads source without modifying it; the result is always a new image.
+     */
+    explicit ImagePipeline(const ::Image& source) : current(source), owned(false) {}
+
+    /**
+     * Takes over source's pixels, so work that needs no new buffer runs in place.
+     */
+    explicit ImagePipeline(Image&& source) : current(source), owned(true) {
+        source.data = nullptr;
+        source.width = 0;
+        source.height = 0;
+    }
+
+    ~ImagePipeline() {
+        if (owned && current.data) ::UnloadImage(current);
+    }
+
+    ImagePipeline(const ImagePipeline&) = delete;
+    ImagePipeline& operator=(const ImagePipeline&) = delete;
+
+    ImagePipeline& Crop(::Rectangle crop) {
+        return Push(Op(CROP, (int)crop.x, (int)crop.y, (int)crop.width, (int)crop.height));
+    }
+    ImagePipeline& FlipVertical() { return Push(Op(FLIP_V)); }
+    ImagePipeline& FlipHorizontal() { return Push(Op(FLIP_H)); }
+    ImagePipeline& RotateCW() { return Push(Op(ROTATE_CW)); }
+    ImagePipeline& RotateCCW() { return Push(Op(ROTATE_CCW)); }
+    ImagePipeline& ResizeNN(int newWidth, int newHeight) { return Push(Op(RESIZE_NN, newWidth, newHeight)); }
+
+    /**
+     * Smooth resize through ::ImageResize; ends the fused pass
+     */
+    ImagePipeline& Resize(int newWidth, int newHeight) { return Push(Op(RESIZE, newWidth, newHeight)); }
+
+    ImagePipeline& ColorTint(::Color color) {
+        Op op(TINT);
+        op.color = color;
+        return Push(op);
+    }
+    ImagePipeline& ColorInvert() { return Push(Op(INVERT)); }
+    ImagePipeline& ColorGrayscale() { return Push(Op(GRAYSCALE)); }
+    ImagePipeline& ColorBrightness(int brightness) { return Push(Op(BRIGHTNESS, brightness)); }
+    ImagePipeline& ColorContrast(float contrast) {
+        Op op(CONTRAST);
+        op.f = contrast;
+        return Push(op);
+    }
+
+    ImagePipeline& AlphaClear(::Color color, float threshold) {
+        Op op(ALPHA_CLEAR);
+        op.color = color;
+        op.f = threshold;
+        return Push(op);
+    }
+    ImagePipeline& AlphaPremultiply() { return Push(Op(PREMULTIPLY)); }
+
+    /**
+     * Converts to newFormat through ::ImageFormat; ends the fused pass
+     */
+    ImagePipeline& Format(int newFormat) { return Push(Op(FORMAT, newFormat)); }
+
+    /**
+     * Dithers to a 16 bpp format through ::ImageDither; ends the fused pass
+     */
+    ImagePipeline& Dither(int rBpp, int gBpp, int bBpp, int aBpp) { return Push(Op(DITHER, rBpp, gBpp, bBpp, aBpp)); }
+
+    /**
+     * Runs each pass on up to threads threads (0: one per hardware thread). Images under minPixels stay on the calling
+     * thread, where starting threads would cost more than it saves.
+     */
+    ImagePipeline& Parallel(int threads = 0, int minPixels = PARALLEL_MIN_PIXELS) {
+        this->threads = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+        if (this->threads < 1) this->threads = 1;
+        this->minPixels = minPixels;
+        return *this;
+    }
+
+    /**
+     * Runs every recorded operation and returns the result. The pipeline is empty afterwards.
+     */
+    Image Execute() {
+        if (!current.data) return Image();
+
+        size_t start = 0;
+        for (size_t i = 0; i <= ops.size(); i++) {
+            bool end = i == ops.size();
+            if (!end && !IsBarrier(ops[i].kind)) continue;
+            if (start < i && current.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) ToRgba();
+            RunFused(start, i);
+            if (!end) {
+                const Op& op = ops[i];
+                Own();
+                if (op.kind == RESIZE) ::ImageResize(&current, op.a, op.b);
+                else if (op.kind == DITHER) ::ImageDither(&current, op.a, op.b, op.c, op.d);
+                else ::ImageFormat(&current, op.a);
+                passes++;
+            }
+            start = i + 1;
+        }
+        ops.clear();
+
+        Own();
+        Image result(current);
+        current = ::Image{};
+        owned = false;
+        return result;
+    }
+
+    /**
+     * Pixel passes Execute() has made so far; each is at most one allocation.
+     */
+    int Passes() const { return passes; }
+
+    static constexpr int PARALLEL_MIN_PIXELS = 256 * 256;
+
+protected:
+    enum Kind { CROP, FLIP_V, FLIP_H, ROTATE_CW, ROTATE_CCW, RESIZE_NN, RESIZE, TINT, INVERT, GRAYSCALE, BRIGHTNESS,
+                CONTRAST, ALPHA_CLEAR, PREMULTIPLY, FORMAT, DITHER };
+
+    static bool IsBarrier(Kind kind) { return kind == RESIZE || kind == FORMAT || kind == DITHER; }
+
+    struct Op {
+        Kind kind;
+        int a, b, c, d;
+        float f;
+        ::Color color;
+        explicit Op(Kind kind, int a = 0, int b = 0, int c = 0, int d = 0)
+            : kind(kind), a(a), b(b), c(c), d(d), f(0.0f), color(::Color{255, 255, 255, 255}) {}
+    };
+
+    /**
+     * Where each output pixel comes from. Every geometric operation here moves whole rows and columns, so one source
+     * index per output column and one per output row say everything; when swapped, columns come from source rows and
+     * rows from source columns.
+     */
+    struct IndexMap {
+        std::vector<int> xs, ys;
+        bool swapped;
+
+        IndexMap(int w, int h) : xs((size_t)w), ys((size_t)h), swapped(false) {
+            for (size_t i = 0; i < xs.size(); i++) xs[i] = (int)i;
+            for (size_t i = 0; i < ys.size(); i++) ys[i] = (int)i;
+        }
+
+        bool IsIdentity(int w, int h) const { return !swapped && (int)xs.size() == w && (int)ys.size() == h && IsRun(xs, 0) && IsRun(ys, 0); }
+
+        // Each output row is one unbroken stretch of a source row
+        bool IsRowCopy() const { return !swapped && IsRun(xs, xs[0]); }
+
+        static bool IsRun(const std::vector<int>& v, int from) {
+            for (size_t i = 0; i < v.size(); i++) if (v[i] != from + (int)i) return false;
+            return true;
+        }
+    };
+
+    /**
+     * The colour work of one fused pass: per-channel tables, with the steps that mix channels between them. Stages run
+     * in order over a span of pixels at a time.
+     */
+    struct ColorProgram {
+        enum StageKind { TABLE, GRAYSCALE, ALPHA_CLEAR, PREMULTIPLY };
+        struct Stage {
+            StageKind kind;
+            ::Color color;
+            unsigned char threshold;
+            unsigned char lut[4][256];
+        };
+        std::vector<Stage> stages;
+
+        bool Empty() const { return stages.empty(); }
+
+        void Apply(unsigned char* pixels, size_t count) const {
+            for (size_t s = 0; s < stages.size(); s++) {
+                const Stage& stage = stages[s];
+                switch (stage.kind) {
+                    case TABLE:
+                        for (unsigned char* p = pixels; p < pixels + count * 4; p += 4) {
+                            p[0] = stage.lut[0][p[0]];
+                            p[1] = stage.lut[1][p[1]];
+                            p[2] = stage.lut[2][p[2]];
+                            p[3] = stage.lut[3][p[3]];
+                        }
+                        break;
+                    case GRAYSCALE:
+                        for (unsigned char* p = pixels; p < pixels + count * 4; p += 4) {
+                            p[0] = p[1] = p[2] =
+                                (unsigned char)((float)p[0] * 0.299f + (float)p[1] * 0.587f + (float)p[2] * 0.114f);
+                        }
+                        break;
+                    case ALPHA_CLEAR:
+                        for (unsigned char* p = pixels; p < pixels + count * 4; p += 4) {
+                            if (p[3] > stage.threshold) continue;
+                            p[0] = stage.color.r;
+                            p[1] = stage.color.g;
+                            p[2] = stage.color.b;
+                            p[3] = stage.color.a;
+                        }
+                        break;
+                    case PREMULTIPLY: Premultiply(pixels, count); break;
+                }
+            }
+        }
+    };
+
+    /**
+     * rgb *= a / 255, truncated, as ::ImageAlphaPremultiply does. The vector paths do the same float operations in the
+     * same order, so they give the same bytes.
+     */
+    static void Premultiply(unsigned char* pixels, size_t count) {
+        size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+        const __m128 max = _mm_set1_ps(255.0f);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaLane = _mm_set_epi32(-1, 0, 0, 0);
+        for (; i + 4 <= count; i += 4) {
+            __m128i packed = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+            __m128i lo = _mm_unpacklo_epi8(packed, zero);
+            __m128i hi = _mm_unpackhi_epi8(packed, zero);
+            __m128i px[4] = {_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero), _mm_unpacklo_epi16(hi, zero),
+                             _mm_unpackhi_epi16(hi, zero)};
+            for (int k = 0; k < 4; k++) {
+                __m128 v = _mm_cvtepi32_ps(px[k]);
+                __m128 alpha = _mm_div_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), max);
+                __m128i scaled = _mm_cvttps_epi32(_mm_mul_ps(v, alpha));
+                // Alpha itself is kept
+                px[k] = _mm_or_si128(_mm_andnot_si128(alphaLane, scaled), _mm_and_si128(alphaLane, px[k]));
+            }
+            __m128i out = _mm_packus_epi16(_mm_packs_epi32(px[0], px[1]), _mm_packs_epi32(px[2], px[3]));
+            _mm_storeu_si128((__m128i*)(pixels + i * 4), out);
+        }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+        const float32x4_t max = vdupq_n_f32(255.0f);
+        for (; i + 4 <= count; i += 4) {
+            uint8x16_t packed = vld1q_u8(pixels + i * 4);
+            uint16x8_t lo = vmovl_u8(vget_low_u8(packed));
+            uint16x8_t hi = vmovl_u8(vget_high_u8(packed));
+            uint32x4_t px[4] = {vmovl_u16(vget_low_u16(lo)), vmovl_u16(vget_high_u16(lo)), vmovl_u16(vget_low_u16(hi)),
+                                vmovl_u16(vget_high_u16(hi))};
+            for (int k = 0; k < 4; k++) {
+                float32x4_t v = vcvtq_f32_u32(px[k]);
+                float32x4_t alpha = vdivq_f32(vdupq_n_f32(vgetq_lane_f32(v, 3)), max);
+                uint32x4_t scaled = vcvtq_u32_f32(vmulq_f32(v, alpha));
+                px[k] = vsetq_lane_u32(vgetq_lane_u32(px[k], 3), scaled, 3);
+            }
+            uint16x8_t outLo = vcombine_u16(vmovn_u32(px[0]), vmovn_u32(px[1]));
+            uint16x8_t outHi = vcombine_u16(vmovn_u32(px[2]), vmovn_u32(px[3]));
+            vst1q_u8(pixels + i * 4, vcombine_u8(vmovn_u16(outLo), vmovn_u16(outHi)));
+        }
+#endif
+        for (; i < count; i++) {
+            unsigned char* p = pixels + i * 4;
+            float alpha = (float)p[3] / 255.0f;
+            p[0] = (unsigned char)((float)p[0] * alpha);
+            p[1] = (unsigned char)((float)p[1] * alpha);
+            p[2] = (unsigned char)((float)p[2] * alpha);
+        }
+    }
+
+    std::vector<Op> ops;
+    ::Image current;
+    bool owned;
+    int passes = 0;
+    int threads = 1;
+    int minPixels = PARALLEL_MIN_PIXELS;
+
+    ImagePipeline& Push(const Op& op) {
+        ops.push_back(op);
+        return *this;
+    }
+
+    // Makes current a buffer the pipeline may write to
+    void Own() {
+        if (owned) return;
+        current = ::ImageCopy(current);
+        owned = true;
+    }
+
+    void ToRgba() {
+        Own();
+        ::ImageFormat(&current, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        passes++;
+    }
+
+    static unsigned char Clamp255(float v) { return (unsigned char)(v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v)); }
+
+    // Folds one per-channel operation into the tables, matching raylib's own formulas
+    static void FoldInto(ColorProgram::Stage& stage, const Op& op) {
+        for (int ch = 0; ch < 4; ch++) {
+            for (int v = 0; v < 256; v++) {
+                unsigned char x = stage.lut[ch][v];
+                switch (op.kind) {
+                    case TINT: {
+                        const unsigned char tint[4] = {op.color.r, op.color.g, op.color.b, op.color.a};
+                        x = (unsigned char)(((float)x / 255.0f * ((float)tint[ch] / 255.0f)) * 255.0f);
+                        break;
+                    }
+                    case INVERT:
+                        if (ch < 3) x = (unsigned char)(255 - x);
+                        break;
+                    case BRIGHTNESS: {
+                        int b = op.a < -255 ? -255 : (op.a > 255 ? 255 : op.a);
+                        if (ch < 3) x = Clamp255((float)(x + b));
+                        break;
+                    }
+                    case CONTRAST: {
+                        float c = op.f < -100.0f ? -100.0f : (op.f > 100.0f ? 100.0f : op.f);
+                        c = (100.0f + c) / 100.0f;
+                        c *= c;
+                        if (ch < 3) x = Clamp255((((float)x / 255.0f - 0.5f) * c + 0.5f) * 255.0f);
+                        break;
+                    }
+                    default: break;
+                }
+                stage.lut[ch][v] = x;
+            }
+        }
+    }
+
+    /**
+     * Runs ops [begin, end), which are all fusable, as one pass over current.
+     */
+    void RunFused(size_t begin, size_t end) {
+        if (begin == end) return;
+        IndexMap map(current.width, current.height);
+        ColorProgram color;
+        bool lastWasTable = false;
+
+        for (size_t i = begin; i < end; i++) {
+            const Op& op = ops[i];
+            int w = (int)map.xs.size(), h = (int)map.ys.size();
+            switch (op.kind) {
+                case CROP: {
+                    int x0 = op.a < 0 ? 0 : op.a, y0 = op.b < 0 ? 0 : op.b;
+                    int x1 = op.a + op.c > w ? w : op.a + op.c, y1 = op.b + op.d > h ? h : op.b + op.d;
+                    if (x1 <= x0 || y1 <= y0) break;
+                    map.xs = std::vector<int>(map.xs.begin() + x0, map.xs.begin() + x1);
+                    map.ys = std::vector<int>(map.ys.begin() + y0, map.ys.begin() + y1);
+                    break;
+                }
+                case FLIP_V: std::reverse(map.ys.begin(), map.ys.end()); break;
+                case FLIP_H: std::reverse(map.xs.begin(), map.xs.end()); break;
+                case ROTATE_CW:
+                    // Output (x, y) shows input (y, h - 1 - x)
+                    std::reverse(map.ys.begin(), map.ys.end());
+                    map.xs.swap(map.ys);
+                    map.swapped = !map.swapped;
+                    break;
+                case ROTATE_CCW:
+                    // Output (x, y) shows input (w - 1 - y, x)
+                    std::reverse(map.xs.begin(), map.xs.end());
+                    map.xs.swap(map.ys);
+                    map.swapped = !map.swapped;
+                    break;
+                case RESIZE_NN:
+                    if (op.a <= 0 || op.b <= 0) break;
+                    map.xs = ResampleNN(map.xs, op.a);
+                    map.ys = ResampleNN(map.ys, op.b);
+                    break;
+                case GRAYSCALE:
+                case ALPHA_CLEAR:
+                case PREMULTIPLY: {
+                    color.stages.push_back(ColorProgram::Stage());
+                    ColorProgram::Stage& stage = color.stages.back();
+                    stage.kind = op.kind == GRAYSCALE     ? ColorProgram::GRAYSCALE
+                                 : op.kind == ALPHA_CLEAR ? ColorProgram::ALPHA_CLEAR
+                                                          : ColorProgram::PREMULTIPLY;
+                    stage.color = op.color;
+                    stage.threshold = (unsigned char)(op.f * 255.0f);
+                    lastWasTable = false;
+                    break;
+                }
+                default:
+                    if (!lastWasTable) {
+                        color.stages.push_back(ColorProgram::Stage());
+                        ColorProgram::Stage& stage = color.stages.back();
+                        stage.kind = ColorProgram::TABLE;
+                        for (int ch = 0; ch < 4; ch++)
+                            for (int v = 0; v < 256; v++) stage.lut[ch][v] = (unsigned char)v;
+                        lastWasTable = true;
+                    }
+                    FoldInto(color.stages.back(), op);
+                    break;
+            }
+        }
+
+        int w = (int)map.xs.size(), h = (int)map.ys.size();
+        if (map.IsIdentity(current.width, current.height)) {
+            if (color.Empty()) return;
+            if (owned) {
+                // In place: nothing moves, so each pixel only depends on itself
+                unsigned char* pixels = (unsigned char*)current.data;
+                ForBands(h, (size_t)w * (size_t)h, [&](int y0, int y1) {
+                    color.Apply(pixels + (size_t)y0 * (size_t)w * 4, (size_t)(y1 - y0) * (size_t)w);
+                });
+                passes++;
+                return;
+            }
+        }
+
+        // Byte offsets into the source contributed by each output column
+        size_t stride = (size_t)current.width * 4;
+        std::vector<size_t> columns((size_t)w);
+        for (size_t x = 0; x < columns.size(); x++) {
+            columns[x] = map.swapped ? (size_t)map.xs[x] * stride : (size_t)map.xs[x] * 4;
+        }
+
+        unsigned char* out = (unsigned char*)RL_MALLOC((size_t)w * (size_t)h * 4);
+        ForBands(h, (size_t)w * (size_t)h, [&](int y0, int y1) { Sample(map, columns, color, out, y0, y1); });
+        if (owned) ::UnloadImage(current);
+        current = ::Image{out, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        owned = true;
+        passes++;
+    }
+
+    // The picks ::ImageResizeNN makes along one axis
+    static std::vector<int> ResampleNN(const std::vector<int>& from, int size) {
+        int ratio = (int)(((int)from.size() << 16) / size) + 1;
+        std::vector<int> to((size_t)size);
+        for (int i = 0; i < size; i++) to[(size_t)i] = from[(size_t)((i * ratio) >> 16)];
+        return to;
+    }
+
+    /**
+     * Calls fn(y0, y1) over bands covering rows [0, rows): one band per thread when the pass is large enough, else a
+     * single band on this thread.
+     */
+    template <typename Fn>
+    void ForBands(int rows, size_t pixels, Fn fn) const {
+        int bands = pixels < (size_t)minPixels ? 1 : std::min(threads, rows);
+        if (bands <= 1) {
+            fn(0, rows);
+            return;
+        }
+        std::vector<std::thread> workers;
+        for (int b = 1; b < bands; b++) workers.push_back(std::thread(fn, rows * b / bands, rows * (b + 1) / bands));
+        fn(0, rows / bands);
+        for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    }
+
+    /**
+     * Writes rows [y0, y1) of the output described by map from current. Rows are independent.
+     */
+    void Sample(const IndexMap& map, const std::vector<size_t>& columns, const ColorProgram& color, unsigned char* out,
+                int y0, int y1) const {
+        const unsigned char* src = (const unsigned char*)current.data;
+        size_t w = map.xs.size();
+        size_t stride = (size_t)current.width * 4;
+        bool rowCopy = map.IsRowCopy();
+
+        for (int y = y0; y < y1; y++) {
+            unsigned char* row = out + (size_t)y * w * 4;
+            const unsigned char* from = src + (map.swapped ? (size_t)map.ys[(size_t)y] * 4 : (size_t)map.ys[(size_t)y] * stride);
+            if (rowCopy) {
+                std::memcpy(row, from + columns[0], w * 4);
+            } else {
+                for (size_t x = 0; x < w; x++) std::memcpy(row + x * 4, from + columns[x], 4);
+            }
+            // Colour runs on the row while it is still in cache
+            if (!color.Empty()) color.Apply(row, w);
+        }
+    }
+};
+} // namespace raylib
+
+using RImagePipeline = raylib::ImagePipeline;
+
+#endif // RAYLIB_CPP_INCLUDE_IMAGEPIPELINE_HPP_
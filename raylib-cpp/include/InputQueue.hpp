@@ -0,0 +1,115 @@
+/**
+ * Timestamped input events handed from the thread that polls input to the one that consumes it.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_INPUTQUEUE_HPP_
+#define RAYLIB_CPP_INCLUDE_INPUTQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+namespace raylib {
+/**
+ * One key or gamepad button going down or up.
+ */
+struct InputEvent {
+    enum { KEYBOARD = -1 };
+
+    double time; // On whatever clock the producer stamps with, e.g. GetTime()
+    int device;  // KEYBOARD, or the gamepad number
+    int code;    // KeyboardKey or GamepadButton
+    bool down;
+};
+
+/**
+ * Fixed-capacity queue of input events with one producer and one consumer, which may be different threads. Neither
+ * side ever locks or allocates: the producer only writes the tail and the consumer only the head.
+ *
+ * A fixed-timestep simulation can drain it per tick rather than per frame: with events stamped when they were
+ * sampled, each tick takes the ones due by its own time through PopUntil(), so input that arrives while several
+ * ticks run in one frame goes to the tick it belongs to, and none is lost or repeated. Events must be pushed in time
+ * order. When the queue is full new events are dropped and counted.
+ *
+ * @code
+ * raylib::InputQueue<> queue;
+ * // Input thread, after polling:
+ * raylib::Keyboard::QueueKeys(queue, keys, keyCount, now);
+ * // Each tick:
+ * queue.PopUntil(tickTime, [&](const raylib::InputEvent& e) { Apply(e); });
+ * @endcode
+ */
+template<size_t Capacity = 256>
+class InputQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "InputQueue capacity must be a power of two");
+
+public:
+    /**
+     * Producer: appends an event; false if the queue is full and it was dropped
+     */
+    bool Push(const InputEvent& event) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events[t & (Capacity - 1)] = event;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Producer: appends an event; false if the queue is full and it was dropped
+     */
+    bool Push(double time, int device, int code, bool down) { return Push(InputEvent{time, device, code, down}); }
+
+    /**
+     * Consumer: takes the oldest event, if any
+     */
+    bool Pop(InputEvent& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = events[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer: calls fn(event) for each event stamped at or before time, oldest first. Returns how many.
+     */
+    template<typename Fn>
+    size_t PopUntil(double time, Fn fn) {
+        size_t taken = 0;
+        size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_acquire);
+        for (; h != t && events[h & (Capacity - 1)].time <= time; h++, taken++) {
+            fn(static_cast<const InputEvent&>(events[h & (Capacity - 1)]));
+        }
+        head.store(h, std::memory_order_release);
+        return taken;
+    }
+
+    /**
+     * Events waiting; exact only on the consumer's thread
+     */
+    size_t Size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+    bool Empty() const { return Size() == 0; }
+
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+    /**
+     * Events that arrived while the queue was full
+     */
+    size_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    InputEvent events[Capacity];
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<size_t> dropped{0};
+};
+} // namespace raylib
+
+template <size_t Capacity>
+using RInputQueue = raylib::InputQueue<Capacity>;
+using RInputEvent = raylib::InputEvent;
+
+#endif // RAYLIB_CPP_INCLUDE_INPUTQUEUE_HPP_
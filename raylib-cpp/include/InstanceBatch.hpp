@@ -0,0 +1,92 @@
+/**
+ * Instanced mesh drawing from an accumulated transform buffer.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_INSTANCEBATCH_HPP_
+#define RAYLIB_CPP_INCLUDE_INSTANCEBATCH_HPP_
+
+#include <vector>
+
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Collects transforms for one mesh and material and draws them all with a single DrawMeshInstanced call.
+ *
+ * The transforms live in one contiguous vector that keeps its capacity across Clear(), so a scene that adds about the
+ * same number of instances every frame stops allocating after the first. The mesh and material are referenced, not
+ * copied, and must outlive the batch.
+ *
+ * Instancing needs a shader with an instanceTransform attribute (SHADER_LOC_VERTEX_INSTANCE_TX). With any other shader
+ * Draw() falls back to one DrawMesh per instance, which looks the same and is only slower.
+ *
+ * @code
+ * raylib::InstanceBatch crowd(mesh, material);
+ * // Each frame:
+ * crowd.Clear();
+ * for (const Walker& w : walkers) crowd.Add(w.transform);
+ * crowd.Draw();
+ * @endcode
+ */
+class InstanceBatch {
+public:
+    InstanceBatch(const ::Mesh& mesh, const ::Material& material) : mesh(&mesh), material(&material) {}
+
+    /**
+     * Queues one instance
+     */
+    InstanceBatch& Add(const ::Matrix& transform) {
+        transforms.push_back(transform);
+        return *this;
+    }
+
+    /**
+     * Queues count instances from a contiguous array
+     */
+    InstanceBatch& Add(const ::Matrix* first, size_t count) {
+        transforms.insert(transforms.end(), first, first + count);
+        return *this;
+    }
+
+    /**
+     * Makes room for count instances up front
+     */
+    void Reserve(size_t count) { transforms.reserve(count); }
+
+    /**
+     * Drops the queued instances, keeping the buffer for the next frame
+     */
+    void Clear() { transforms.clear(); }
+
+    size_t GetCount() const { return transforms.size(); }
+    size_t GetCapacity() const { return transforms.capacity(); }
+    const ::Matrix* GetTransforms() const { return transforms.data(); }
+
+    /**
+     * Draws every queued instance; they stay queued until Clear()
+     */
+    void Draw() const {
+        if (transforms.empty()) return;
+        if (IsInstancing()) {
+            ::DrawMeshInstanced(*mesh, *material, transforms.data(), (int)transforms.size());
+            return;
+        }
+        for (size_t i = 0; i < transforms.size(); i++) ::DrawMesh(*mesh, *material, transforms[i]);
+    }
+
+    /**
+     * Whether Draw() makes one instanced call, rather than one call per instance
+     */
+    bool IsInstancing() const {
+        return material->shader.locs != nullptr && material->shader.locs[SHADER_LOC_VERTEX_INSTANCE_TX] >= 0;
+    }
+
+protected:
+    const ::Mesh* mesh;
+    const ::Material* material;
+    std::vector<::Matrix> transforms;
+};
+} // namespace raylib
+
+using RInstanceBatch = raylib::InstanceBatch;
+
+#endif // RAYLIB_CPP_INCLUDE_INSTANCEBATCH_HPP_
@@ -1,7 +1,10 @@
 #ifndef RAYLIB_CPP_INCLUDE_KEYBOARD_HPP_
 #define RAYLIB_CPP_INCLUDE_KEYBOARD_HPP_
 
+#include <cstddef>
+
 #include "./Functions.hpp"
+#include "./InputQueue.hpp"
 #include "./raylib.hpp"
 
 namespace raylib {
@@ -58,6 +61,34 @@ namespace Keyboard {
 [[maybe_unused]] RLCPPAPI inline int GetCharPressed() {
     return ::GetCharPressed();
 }
+
+/**
+ * Pushes a down or up event stamped with time for each of keys that went down or up since the last input poll, and
+ * returns how many. Call it once after each poll.
+ *
+ * A key tapped and let go between two polls never shows in IsKeyPressed(), but it is still in GetKeyPressed()'s
+ * queue, so that queue is drained here and such a tap queues a down and an up at the same time. Other callers of
+ * GetKeyPressed() see it empty until the next poll.
+ */
+template<size_t Capacity>
+size_t QueueKeys(InputQueue<Capacity>& queue, const int* keys, size_t count, double time) {
+    int tapped[32];
+    int tapCount = 0;
+    for (int key = ::GetKeyPressed(); key != 0; key = ::GetKeyPressed()) {
+        if (tapCount < 32) tapped[tapCount++] = key;
+    }
+
+    size_t pushed = 0;
+    for (size_t i = 0; i < count; i++) {
+        const int key = keys[i];
+        bool tap = false;
+        for (int t = 0; t < tapCount && !tap; t++) tap = tapped[t] == key;
+        const bool down = ::IsKeyDown(key);
+        if (::IsKeyPressed(key) || tap) pushed += queue.Push(time, InputEvent::KEYBOARD, key, true);
+        if (::IsKeyReleased(key) || (tap && !down)) pushed += queue.Push(time, InputEvent::KEYBOARD, key, false);
+    }
+    return pushed;
+}
 } // namespace Keyboard
 } // namespace raylib
 
@@ -0,0 +1,113 @@
+#ifndef RAYLIB_CPP_INCLUDE_MAPPEDFILEDATA_HPP_
+#define RAYLIB_CPP_INCLUDE_MAPPEDFILEDATA_HPP_
+
+#include <string>
+#include <utility>
+
+#include "./DataView.hpp"
+#include "./raylib-cpp-utils.hpp"
+#include "./raylib.hpp"
+
+// Android assets aren't files mmap can see, and <windows.h> can't be included alongside raylib.h
+#if !defined(_WIN32) && !defined(__ANDROID__) && !defined(RAYLIB_CPP_NO_MMAP)
+#define RAYLIB_CPP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace raylib {
+/**
+ * A file's contents mapped into memory rather than read into a buffer, so a large asset passed on to Image, Wave or
+ * Font through GetView() is copied only by the decoder that reads it.
+ *
+ * Pages are read in by the OS as they are touched, and unmapped when the object is destroyed. Where mapping isn't
+ * available (Windows, Android, or with RAYLIB_CPP_NO_MMAP defined) the file is read with LoadFileData instead, so the
+ * class works everywhere but only saves the copy where it can. Mapping skips any SetLoadFileDataCallback.
+ *
+ * @code
+ * raylib::MappedFileData file("resources/level_atlas.png");
+ * raylib::Image atlas(".png", file.GetView());
+ * @endcode
+ */
+class MappedFileData {
+public:
+    MappedFileData() = default;
+    MappedFileData(const MappedFileData&) = delete;
+    MappedFileData(MappedFileData&& other) noexcept : data(other.data), size(other.size), mapped(other.mapped) {
+        other.data = nullptr;
+        other.size = 0;
+        other.mapped = false;
+    }
+    MappedFileData& operator=(const MappedFileData&) = delete;
+    MappedFileData& operator=(MappedFileData&& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(mapped, other.mapped);
+        return *this;
+    }
+    ~MappedFileData() { Unload(); }
+
+    explicit MappedFileData(const std::string& fileName) { Load(fileName); }
+
+    GETTER(const unsigned char*, Data, data)
+    GETTER(int, Size, size)
+
+    /**
+     * Whether the contents are mapped, rather than read into memory or not loaded
+     */
+    bool IsMapped() const { return mapped; }
+
+    bool IsValid() const { return data != nullptr; }
+
+    DataView GetView() const { return DataView(data, size); }
+    operator DataView() const { return GetView(); }
+
+    /**
+     * Maps a file, or reads it where mapping isn't available, returning false if neither worked
+     */
+    bool Load(const std::string& fileName) { return Load(fileName.c_str()); }
+    bool Load(const char* fileName) {
+        Unload();
+#ifdef RAYLIB_CPP_MMAP
+        int fd = ::open(fileName, O_RDONLY);
+        if (fd >= 0) {
+            struct stat info;
+            // Empty files and ones past an int's reach can't be mapped or passed on; LoadFileData reports them
+            if (::fstat(fd, &info) == 0 && info.st_size > 0 && info.st_size <= 0x7fffffff) {
+                void* address = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address != MAP_FAILED) {
+                    data = static_cast<unsigned char*>(address);
+                    size = (int)info.st_size;
+                    mapped = true;
+                }
+            }
+            ::close(fd);
+            if (mapped) return true;
+        }
+#endif
+        data = ::LoadFileData(fileName, &size);
+        return data != nullptr;
+    }
+
+    void Unload() {
+        if (data == nullptr) return;
+#ifdef RAYLIB_CPP_MMAP
+        if (mapped) ::munmap(data, (size_t)size);
+#endif
+        if (!mapped) ::UnloadFileData(data);
+        data = nullptr;
+        size = 0;
+        mapped = false;
+    }
+private:
+    unsigned char* data{nullptr};
+    int size{0};
+    bool mapped{false};
+};
+} // namespace raylib
+
+using RMappedFileData = raylib::MappedFileData;
+
+#endif // RAYLIB_CPP_INCLUDE_MAPPEDFILEDATA_HPP_
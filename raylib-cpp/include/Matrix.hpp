@@ -12,15 +12,18 @@
 namespace raylib {
 /**
  * Matrix type (OpenGL style 4x4 - right handed, column major)
+ *
+ * Construction, Identity, Translate, Scale and the element-wise and multiplying arithmetic are constexpr, written out
+ * with raymath's own formulas so the results match it exactly; rotations, projections and Invert use raymath.
  */
 class Matrix : public ::Matrix {
 public:
-    Matrix(const ::Matrix& mat)
+    constexpr Matrix(const ::Matrix& mat)
         : ::Matrix(mat) {
         // Nothing.
     }
 
-    Matrix(
+    constexpr Matrix(
         float m0 = 0,
         float m4 = 0,
         float m8 = 0,
@@ -58,53 +61,69 @@ public:
     GETTERSETTER(float, M14, m14)
     GETTERSETTER(float, M15, m15)
 
-    Matrix& operator=(const ::Matrix& matrix) {
+    RAYLIB_CPP_CONSTEXPR14 Matrix& operator=(const ::Matrix& matrix) {
         if (this != &matrix) {
             set(matrix);
         }
         return *this;
     }
 
-    Matrix& operator=(const Matrix& matrix) {
+    RAYLIB_CPP_CONSTEXPR14 Matrix& operator=(const Matrix& matrix) {
         if (this != &matrix) {
             set(matrix);
         }
         return *this;
     }
 
-    bool operator==(const ::Matrix& other) {
+    constexpr bool operator==(const ::Matrix& other) const {
         return m0 == other.m0 && m1 == other.m1 && m2 == other.m2 && m3 == other.m3 && m4 == other.m4 &&
                m5 == other.m5 && m6 == other.m6 && m7 == other.m7 && m8 == other.m8 && m9 == other.m9 &&
                m10 == other.m10 && m11 == other.m11 && m12 == other.m12 && m13 == other.m13 && m14 == other.m14 &&
                m15 == other.m15;
     }
 
-    bool operator!=(const ::Matrix& other) { return !(*this == other); }
+    constexpr bool operator!=(const ::Matrix& other) const { return !(*this == other); }
 
 #ifndef RAYLIB_CPP_NO_MATH
     /**
      * Returns the trace of the matrix (sum of the values along the diagonal)
      */
-    [[nodiscard]] float Trace() const { return ::MatrixTrace(*this); }
+    [[nodiscard]] constexpr float Trace() const { return m0 + m5 + m10 + m15; }
 
     /**
      * Transposes provided matrix
      */
-    [[nodiscard]] Matrix Transpose() const { return ::MatrixTranspose(*this); }
+    [[nodiscard]] constexpr Matrix Transpose() const {
+        return Matrix(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+    }
 
     [[nodiscard]] Matrix Invert() const { return ::MatrixInvert(*this); }
 
-    static Matrix Identity() { return ::MatrixIdentity(); }
+    static constexpr Matrix Identity() { return Matrix(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1); }
 
-    Matrix Add(const ::Matrix& right) { return ::MatrixAdd(*this, right); }
+    constexpr Matrix Add(const ::Matrix& right) const {
+        return Matrix(
+            m0 + right.m0, m4 + right.m4, m8 + right.m8, m12 + right.m12,
+            m1 + right.m1, m5 + right.m5, m9 + right.m9, m13 + right.m13,
+            m2 + right.m2, m6 + right.m6, m10 + right.m10, m14 + right.m14,
+            m3 + right.m3, m7 + right.m7, m11 + right.m11, m15 + right.m15);
+    }
 
-    Matrix operator+(const ::Matrix& matrix) { return ::MatrixAdd(*this, matrix); }
+    constexpr Matrix operator+(const ::Matrix& matrix) const { return Add(matrix); }
 
-    Matrix Subtract(const ::Matrix& right) { return ::MatrixSubtract(*this, right); }
+    constexpr Matrix Subtract(const ::Matrix& right) const {
+        return Matrix(
+            m0 - right.m0, m4 - right.m4, m8 - right.m8, m12 - right.m12,
+            m1 - right.m1, m5 - right.m5, m9 - right.m9, m13 - right.m13,
+            m2 - right.m2, m6 - right.m6, m10 - right.m10, m14 - right.m14,
+            m3 - right.m3, m7 - right.m7, m11 - right.m11, m15 - right.m15);
+    }
 
-    Matrix operator-(const ::Matrix& matrix) { return ::MatrixSubtract(*this, matrix); }
+    constexpr Matrix operator-(const ::Matrix& matrix) const { return Subtract(matrix); }
 
-    static Matrix Translate(float x, float y, float z) { return ::MatrixTranslate(x, y, z); }
+    static constexpr Matrix Translate(float x, float y, float z) {
+        return Matrix(1, 0, 0, x, 0, 1, 0, y, 0, 0, 1, z, 0, 0, 0, 1);
+    }
 
     static Matrix Rotate(Vector3 axis, float angle) { return ::MatrixRotate(axis, angle); }
 
@@ -116,11 +135,34 @@ public:
 
     static Matrix RotateZ(float angle) { return ::MatrixRotateZ(angle); }
 
-    static Matrix Scale(float x, float y, float z) { return ::MatrixScale(x, y, z); }
+    static constexpr Matrix Scale(float x, float y, float z) {
+        return Matrix(x, 0, 0, 0, 0, y, 0, 0, 0, 0, z, 0, 0, 0, 0, 1);
+    }
 
-    [[nodiscard]] Matrix Multiply(const ::Matrix& right) const { return ::MatrixMultiply(*this, right); }
+    /**
+     * Multiplies two matrices, this one applied first, as MatrixMultiply(*this, right)
+     */
+    [[nodiscard]] constexpr Matrix Multiply(const ::Matrix& right) const {
+        return Matrix(
+            m0 * right.m0 + m1 * right.m4 + m2 * right.m8 + m3 * right.m12,
+            m4 * right.m0 + m5 * right.m4 + m6 * right.m8 + m7 * right.m12,
+            m8 * right.m0 + m9 * right.m4 + m10 * right.m8 + m11 * right.m12,
+            m12 * right.m0 + m13 * right.m4 + m14 * right.m8 + m15 * right.m12,
+            m0 * right.m1 + m1 * right.m5 + m2 * right.m9 + m3 * right.m13,
+            m4 * right.m1 + m5 * right.m5 + m6 * right.m9 + m7 * right.m13,
+            m8 * right.m1 + m9 * right.m5 + m10 * right.m9 + m11 * right.m13,
+            m12 * right.m1 + m13 * right.m5 + m14 * right.m9 + m15 * right.m13,
+            m0 * right.m2 + m1 * right.m6 + m2 * right.m10 + m3 * right.m14,
+            m4 * right.m2 + m5 * right.m6 + m6 * right.m10 + m7 * right.m14,
+            m8 * right.m2 + m9 * right.m6 + m10 * right.m10 + m11 * right.m14,
+            m12 * right.m2 + m13 * right.m6 + m14 * right.m10 + m15 * right.m14,
+            m0 * right.m3 + m1 * right.m7 + m2 * right.m11 + m3 * right.m15,
+            m4 * right.m3 + m5 * right.m7 + m6 * right.m11 + m7 * right.m15,
+            m8 * right.m3 + m9 * right.m7 + m10 * right.m11 + m11 * right.m15,
+            m12 * right.m3 + m13 * right.m7 + m14 * right.m11 + m15 * right.m15);
+    }
 
-    Matrix operator*(const ::Matrix& matrix) { return ::MatrixMultiply(*this, matrix); }
+    constexpr Matrix operator*(const ::Matrix& matrix) const { return Multiply(matrix); }
 
     static Matrix Frustum(double left, double right, double bottom, double top, double near, double far) {
         return ::MatrixFrustum(left, right, bottom, top, near, far);
@@ -154,7 +196,7 @@ public:
 
 #endif
 protected:
-    void set(const ::Matrix& mat) {
+    RAYLIB_CPP_CONSTEXPR14 void set(const ::Matrix& mat) {
         m0 = mat.m0;
         m1 = mat.m1;
         m2 = mat.m2;
@@ -0,0 +1,172 @@
+/**
+ * Batch operations over contiguous arrays of Matrix and of points transformed by one.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_MATRIXBATCH_HPP_
+#define RAYLIB_CPP_INCLUDE_MATRIXBATCH_HPP_
+
+#include <cstddef>
+
+#include "./raylib-cpp-simd.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+
+static_assert(sizeof(::Matrix) == 16 * sizeof(float), "Matrix arrays must be tightly packed floats");
+static_assert(sizeof(::Vector3) == 3 * sizeof(float), "Vector3 arrays must be tightly packed floats");
+
+/**
+ * Kernels for skinning and instancing: many 4x4 multiplies, or many points through one matrix.
+ *
+ * ::Matrix stores its fields m0, m4, m8, m12 first, so each group of four floats in memory is one row of the matrix
+ * as raymath writes it, and a product's rows are sums of the left matrix's rows scaled by one right-hand row's
+ * entries: one SSE2/NEON register per row. The vector paths multiply and add in the same order as MatrixMultiply()
+ * and Vector3Transform(), so they give the same results as the scalar code unless the compiler fuses the scalar
+ * multiply-adds. Output may alias an input; other overlaps are not supported.
+ */
+namespace MatrixBatch {
+
+namespace detail {
+inline const float* Floats(const ::Matrix* m) {
+    return reinterpret_cast<const float*>(m);
+}
+inline float* Floats(::Matrix* m) {
+    return reinterpret_cast<float*>(m);
+}
+
+// One product, as MatrixMultiply(left, right); out may be either input
+inline void Multiply(float* out, const float* left, const float* right) {
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 l0 = _mm_loadu_ps(left);
+    __m128 l1 = _mm_loadu_ps(left + 4);
+    __m128 l2 = _mm_loadu_ps(left + 8);
+    __m128 l3 = _mm_loadu_ps(left + 12);
+    __m128 rows[4];
+    for (int j = 0; j < 4; j++) {
+        const float* r = right + j * 4;
+        __m128 sum = _mm_mul_ps(l0, _mm_set1_ps(r[0]));
+        sum = _mm_add_ps(sum, _mm_mul_ps(l1, _mm_set1_ps(r[1])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(l2, _mm_set1_ps(r[2])));
+        rows[j] = _mm_add_ps(sum, _mm_mul_ps(l3, _mm_set1_ps(r[3])));
+    }
+    for (int j = 0; j < 4; j++) _mm_storeu_ps(out + j * 4, rows[j]);
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    float32x4_t l0 = vld1q_f32(left);
+    float32x4_t l1 = vld1q_f32(left + 4);
+    float32x4_t l2 = vld1q_f32(left + 8);
+    float32x4_t l3 = vld1q_f32(left + 12);
+    float32x4_t rows[4];
+    for (int j = 0; j < 4; j++) {
+        const float* r = right + j * 4;
+        // Separate multiplies and adds, not vmlaq/vfmaq, to round like the scalar code
+        float32x4_t sum = vmulq_n_f32(l0, r[0]);
+        sum = vaddq_f32(sum, vmulq_n_f32(l1, r[1]));
+        sum = vaddq_f32(sum, vmulq_n_f32(l2, r[2]));
+        rows[j] = vaddq_f32(sum, vmulq_n_f32(l3, r[3]));
+    }
+    for (int j = 0; j < 4; j++) vst1q_f32(out + j * 4, rows[j]);
+#else
+    float rows[16];
+    for (int j = 0; j < 4; j++) {
+        const float* r = right + j * 4;
+        for (int k = 0; k < 4; k++) {
+            rows[j * 4 + k] = left[k] * r[0] + left[4 + k] * r[1] + left[8 + k] * r[2] + left[12 + k] * r[3];
+        }
+    }
+    for (int i = 0; i < 16; i++) out[i] = rows[i];
+#endif
+}
+
+// a * x + b * y + c * z + d across four points, in Vector3Transform()'s order
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+inline __m128 Dot(__m128 x, __m128 y, __m128 z, float a, float b, float c, float d) {
+    __m128 sum = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a), x), _mm_mul_ps(_mm_set1_ps(b), y));
+    return _mm_add_ps(_mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(c), z)), _mm_set1_ps(d));
+}
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+inline float32x4_t Dot(float32x4_t x, float32x4_t y, float32x4_t z, float a, float b, float c, float d) {
+    float32x4_t sum = vaddq_f32(vmulq_n_f32(x, a), vmulq_n_f32(y, b));
+    return vaddq_f32(vaddq_f32(sum, vmulq_n_f32(z, c)), vdupq_n_f32(d));
+}
+#endif
+} // namespace detail
+
+/**
+ * out[i] = a[i] * b[i], like MatrixMultiply(a[i], b[i]): a[i] applied first
+ */
+inline void Multiply(::Matrix* out, const ::Matrix* a, const ::Matrix* b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        detail::Multiply(detail::Floats(out + i), detail::Floats(a + i), detail::Floats(b + i));
+    }
+}
+
+/**
+ * out[i] = a[i] * right, e.g. every bone's pose into model space, or every instance under one parent
+ */
+inline void Multiply(::Matrix* out, const ::Matrix* a, const ::Matrix& right, size_t count) {
+    const ::Matrix r = right; // May be an element of out
+    for (size_t i = 0; i < count; i++) {
+        detail::Multiply(detail::Floats(out + i), detail::Floats(a + i), detail::Floats(&r));
+    }
+}
+
+/**
+ * out[i] = points[i] transformed by mat, like Vector3Transform()
+ */
+inline void TransformPoints(::Vector3* out, const ::Vector3* points, const ::Matrix& mat, size_t count) {
+    float* o = reinterpret_cast<float*>(out);
+    const float* p = reinterpret_cast<const float*>(points);
+    const ::Matrix m = mat;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    // Four points at a time, taken apart into x, y and z registers and put back together after
+    for (; i + 4 <= count; i += 4) {
+        const float* src = p + i * 3;
+        __m128 a = _mm_loadu_ps(src);      // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(src + 4);  // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(src + 8);  // z2 x3 y3 z3
+        __m128 xs = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        __m128 ys = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                   _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 zs = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                                   _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+        __m128 rx = detail::Dot(xs, ys, zs, m.m0, m.m4, m.m8, m.m12);
+        __m128 ry = detail::Dot(xs, ys, zs, m.m1, m.m5, m.m9, m.m13);
+        __m128 rz = detail::Dot(xs, ys, zs, m.m2, m.m6, m.m10, m.m14);
+
+        __m128 xyLo = _mm_unpacklo_ps(rx, ry);  // x0 y0 x1 y1
+        __m128 xyHi = _mm_unpackhi_ps(rx, ry);  // x2 y2 x3 y3
+        float* dst = o + i * 3;
+        _mm_storeu_ps(dst, _mm_shuffle_ps(xyLo, _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)),
+                                          _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)), xyHi,
+                                              _MM_SHUFFLE(1, 0, 2, 0)));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)),
+                                              _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)),
+                                              _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        float32x4x3_t v = vld3q_f32(p + i * 3);  // Deinterleaves into x, y and z lanes
+        float32x4x3_t r;
+        r.val[0] = detail::Dot(v.val[0], v.val[1], v.val[2], m.m0, m.m4, m.m8, m.m12);
+        r.val[1] = detail::Dot(v.val[0], v.val[1], v.val[2], m.m1, m.m5, m.m9, m.m13);
+        r.val[2] = detail::Dot(v.val[0], v.val[1], v.val[2], m.m2, m.m6, m.m10, m.m14);
+        vst3q_f32(o + i * 3, r);
+    }
+#endif
+    for (; i < count; i++) {
+        float x = p[i * 3];
+        float y = p[i * 3 + 1];
+        float z = p[i * 3 + 2];
+        o[i * 3] = m.m0 * x + m.m4 * y + m.m8 * z + m.m12;
+        o[i * 3 + 1] = m.m1 * x + m.m5 * y + m.m9 * z + m.m13;
+        o[i * 3 + 2] = m.m2 * x + m.m6 * y + m.m10 * z + m.m14;
+    }
+}
+
+} // namespace MatrixBatch
+
+} // namespace raylib
+
+#endif // RAYLIB_CPP_INCLUDE_MATRIXBATCH_HPP_
@@ -21,6 +21,16 @@ class Mesh : public MeshUnmanaged {
 public:
     using MeshUnmanaged::MeshUnmanaged;
 
+    /**
+     * Takes ownership of a mesh, e.g. one from a Gen*() function, which raylib uploads as it generates it.
+     */
+    Mesh(const ::Mesh& mesh) : MeshUnmanaged(mesh) { Track(); }
+
+    /**
+     * Takes ownership of a mesh, e.g. one from a Gen*() function, which raylib uploads as it generates it.
+     */
+    Mesh(::Mesh&& mesh) : MeshUnmanaged(mesh) { Track(); }
+
     /**
      * Explicitly forbid the copy constructor.
      */
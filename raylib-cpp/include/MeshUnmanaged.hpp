@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "./BoundingBox.hpp"
+#include "./GpuMemory.hpp"
 #include "./Matrix.hpp"
 #include "./Model.hpp"
 #include "./raylib-cpp-utils.hpp"
@@ -145,6 +146,7 @@ public:
      */
     void Unload() {
         if (vboId != nullptr) {
+            GpuMemory::Untrack(GpuMemory::MESH, GpuMemory::MeshId(*this));
             ::UnloadMesh(*this);
             vboId = nullptr;
         }
@@ -153,7 +155,10 @@ public:
     /**
      * Upload mesh vertex data to GPU (VRAM)
      */
-    void Upload(bool dynamic = false) { ::UploadMesh(this, dynamic); }
+    void Upload(bool dynamic = false) {
+        ::UploadMesh(this, dynamic);
+        Track();
+    }
 
     /**
      * Upload mesh vertex data to GPU (VRAM)
@@ -230,6 +235,9 @@ public:
     bool IsValid() { return ::IsModelValid(*this); }
 
 protected:
+    // Counts this mesh in GpuMemory, once it has been uploaded
+    void Track() const { GpuMemory::Track(GpuMemory::MESH, GpuMemory::MeshId(*this), GpuMemory::MeshBytes(*this)); }
+
     void set(const ::Mesh& mesh) {
         vertexCount = mesh.vertexCount;
         triangleCount = mesh.triangleCount;
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "./AnimationCache.hpp"
 #include "./RaylibException.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
@@ -135,6 +136,16 @@ public:
         return *this;
     }
 
+#ifndef RAYLIB_CPP_NO_MATH
+    /**
+     * Update model animation pose from a baked cache, without skinning
+     */
+    Model& UpdateAnimation(const AnimationCache& cache, int frame) {
+        cache.Apply(*this, frame);
+        return *this;
+    }
+#endif
+
     /**
      * Check model animation skeleton match
      */
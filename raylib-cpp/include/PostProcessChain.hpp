@@ -0,0 +1,155 @@
+#ifndef RAYLIB_CPP_INCLUDE_POSTPROCESSCHAIN_HPP_
+#define RAYLIB_CPP_INCLUDE_POSTPROCESSCHAIN_HPP_
+
+#include <vector>
+
+#include "./RenderTexture.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A stack of full-screen shader passes run over a scene, such as a CRT filter after a bloom, using at most two render
+ * textures however many passes there are.
+ *
+ * The scene is drawn between Begin() and End() into the first texture. Each enabled pass then reads the texture the
+ * one before it wrote and draws into the other, and the last pass draws straight to whatever was bound before
+ * Begin(), normally the screen, so N passes cost N full-screen draws and no more than two textures. Disabled passes
+ * are skipped, not run as copies, and with none enabled Begin() and End() do nothing and the scene is drawn directly:
+ * the textures are only created once a frame needs them, the second only for two or more passes.
+ *
+ * Shaders are not owned and must outlive the chain. Each is drawn with texture0 bound to the previous pass's result;
+ * set any uniforms it needs (resolution, time) before End().
+ *
+ * @code
+ * raylib::PostProcessChain post(GetScreenWidth(), GetScreenHeight());
+ * post.Add(bloom);
+ * int crtPass = post.Add(crt);
+ *
+ * BeginDrawing();
+ * post.Begin();
+ * ClearBackground(BLACK);
+ * // ... draw the scene ...
+ * post.End();
+ * EndDrawing();
+ * @endcode
+ */
+class PostProcessChain {
+public:
+    PostProcessChain() = default;
+    PostProcessChain(int width, int height) : width(width), height(height) {}
+    PostProcessChain(const PostProcessChain&) = delete;
+    PostProcessChain& operator=(const PostProcessChain&) = delete;
+
+    /**
+     * Appends a pass, enabled unless told otherwise, and returns its index
+     */
+    int Add(const ::Shader& shader, bool enabled = true) {
+        passes.push_back(Pass{shader, enabled});
+        return (int)passes.size() - 1;
+    }
+
+    void SetEnabled(int pass, bool enabled) { passes[(size_t)pass].enabled = enabled; }
+    bool IsEnabled(int pass) const { return passes[(size_t)pass].enabled; }
+    void Toggle(int pass) { SetEnabled(pass, !IsEnabled(pass)); }
+
+    int GetPassCount() const { return (int)passes.size(); }
+
+    /**
+     * Passes that will run on the next End()
+     */
+    int GetEnabledCount() const {
+        int count = 0;
+        for (const Pass& pass : passes) count += pass.enabled;
+        return count;
+    }
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    /**
+     * Sets the size the scene is drawn at. The textures are recreated at the new size when next needed.
+     */
+    void SetSize(int newWidth, int newHeight) {
+        if (newWidth == width && newHeight == height) return;
+        width = newWidth;
+        height = newHeight;
+        Unload();
+    }
+
+    /**
+     * Starts drawing the scene into the chain, or does nothing if no pass is enabled
+     */
+    void Begin() {
+        active = GetEnabledCount() > 0 && width > 0 && height > 0;
+        if (!active) return;
+        Allocate(0);
+        targets[0].BeginMode();
+    }
+
+    /**
+     * Runs the enabled passes over the scene, the last drawing to dest on the target bound before Begin()
+     */
+    void End(const ::Rectangle& dest) {
+        if (!active) return;
+        active = false;
+        ::EndTextureMode();
+
+        int remaining = GetEnabledCount();
+        int source = 0;
+        for (const Pass& pass : passes) {
+            if (!pass.enabled) continue;
+            if (--remaining > 0) {
+                int target = 1 - source;
+                Allocate(target);
+                targets[target].BeginMode();
+                ::ClearBackground(BLANK);
+                Blit(pass.shader, source, ::Rectangle{0, 0, (float)width, (float)height});
+                targets[target].EndMode();
+                source = target;
+            } else {
+                Blit(pass.shader, source, dest);
+            }
+        }
+    }
+
+    void End() { End(::Rectangle{0, 0, (float)width, (float)height}); }
+
+    /**
+     * Frees both textures; they are created again when next needed
+     */
+    void Unload() {
+        targets[0].Unload();
+        targets[1].Unload();
+        targets[0] = ::RenderTexture{};
+        targets[1] = ::RenderTexture{};
+    }
+private:
+    struct Pass {
+        ::Shader shader;
+        bool enabled;
+    };
+
+    void Allocate(int index) {
+        if (targets[index].id == 0) targets[index] = ::LoadRenderTexture(width, height);
+    }
+
+    // Render textures are stored upside down, so the source rectangle flips them back
+    void Blit(const ::Shader& shader, int source, const ::Rectangle& dest) {
+        const ::Texture& texture = targets[source].texture;
+        ::BeginShaderMode(shader);
+        ::DrawTexturePro(texture, ::Rectangle{0, 0, (float)texture.width, -(float)texture.height}, dest,
+                         ::Vector2{0, 0}, 0.0f, WHITE);
+        ::EndShaderMode();
+    }
+
+    std::vector<Pass> passes;
+    RenderTexture targets[2];
+    int width{0};
+    int height{0};
+    bool active{false};
+};
+} // namespace raylib
+
+using RPostProcessChain = raylib::PostProcessChain;
+
+#endif // RAYLIB_CPP_INCLUDE_POSTPROCESSCHAIN_HPP_
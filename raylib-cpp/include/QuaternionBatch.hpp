@@ -0,0 +1,187 @@
+/**
+ * Batch interpolation over contiguous arrays of Quaternion.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_QUATERNIONBATCH_HPP_
+#define RAYLIB_CPP_INCLUDE_QUATERNIONBATCH_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+#include "./raylib-cpp-simd.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+
+static_assert(sizeof(::Quaternion) == 4 * sizeof(float), "Quaternion arrays must be tightly packed floats");
+
+/**
+ * Kernels for blending animation poses: every bone's rotation at once.
+ *
+ * The vector paths take four quaternions at a time, one component per register. QuaternionSlerp() falls back to a
+ * normalized lerp when the two rotations are within about 18 degrees, which is nearly always the case between
+ * neighbouring keyframes, and that path runs entirely in vector registers; lanes that need the full slerp's acos
+ * and sin are finished one at a time with the scalar code. Operations are in raymath's order, with IEEE square roots
+ * and divisions, so results match QuaternionSlerp() and QuaternionNlerp() unless the compiler fuses the scalar
+ * multiply-adds. The NEON path needs AArch64 for its vector division. Output may alias an input; other overlaps are
+ * not supported.
+ */
+namespace QuaternionBatch {
+
+namespace detail {
+// QuaternionNlerp() as raymath writes it
+inline ::Quaternion Nlerp(const ::Quaternion& q1, const ::Quaternion& q2, float amount) {
+    ::Quaternion q = {
+        q1.x + amount * (q2.x - q1.x),
+        q1.y + amount * (q2.y - q1.y),
+        q1.z + amount * (q2.z - q1.z),
+        q1.w + amount * (q2.w - q1.w)};
+    float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (length == 0.0f) length = 1.0f;
+    float ilength = 1.0f / length;
+    return ::Quaternion{q.x * ilength, q.y * ilength, q.z * ilength, q.w * ilength};
+}
+
+// QuaternionSlerp() as raymath writes it
+inline ::Quaternion Slerp(const ::Quaternion& q1, ::Quaternion q2, float amount) {
+    float cosHalfTheta = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+    if (cosHalfTheta < 0) {
+        q2 = ::Quaternion{-q2.x, -q2.y, -q2.z, -q2.w};
+        cosHalfTheta = -cosHalfTheta;
+    }
+    if (std::fabs(cosHalfTheta) >= 1.0f) return q1;
+    if (cosHalfTheta > 0.95f) return Nlerp(q1, q2, amount);
+
+    float halfTheta = std::acos(cosHalfTheta);
+    float sinHalfTheta = std::sqrt(1.0f - cosHalfTheta * cosHalfTheta);
+    if (std::fabs(sinHalfTheta) < 0.000001f) {
+        return ::Quaternion{
+            q1.x * 0.5f + q2.x * 0.5f, q1.y * 0.5f + q2.y * 0.5f, q1.z * 0.5f + q2.z * 0.5f, q1.w * 0.5f + q2.w * 0.5f};
+    }
+    float ratioA = std::sin((1 - amount) * halfTheta) / sinHalfTheta;
+    float ratioB = std::sin(amount * halfTheta) / sinHalfTheta;
+    return ::Quaternion{
+        q1.x * ratioA + q2.x * ratioB,
+        q1.y * ratioA + q2.y * ratioB,
+        q1.z * ratioA + q2.z * ratioB,
+        q1.w * ratioA + q2.w * ratioB};
+}
+} // namespace detail
+
+/**
+ * out[i] = QuaternionSlerp(a[i], b[i], amount)
+ */
+inline void Slerp(::Quaternion* out, const ::Quaternion* a, const ::Quaternion* b, float amount, size_t count) {
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    const __m128 t = _mm_set1_ps(amount);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float* pa = reinterpret_cast<const float*>(a + i);
+        const float* pb = reinterpret_cast<const float*>(b + i);
+        __m128 ax = _mm_loadu_ps(pa), ay = _mm_loadu_ps(pa + 4), az = _mm_loadu_ps(pa + 8), aw = _mm_loadu_ps(pa + 12);
+        __m128 bx = _mm_loadu_ps(pb), by = _mm_loadu_ps(pb + 4), bz = _mm_loadu_ps(pb + 8), bw = _mm_loadu_ps(pb + 12);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        __m128 cosHalfTheta = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                                    _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+        // Take the short way round: flip b, and the cosine with it, where the cosine is negative
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(cosHalfTheta, _mm_setzero_ps()), signBit);
+        bx = _mm_xor_ps(bx, flip);
+        by = _mm_xor_ps(by, flip);
+        bz = _mm_xor_ps(bz, flip);
+        bw = _mm_xor_ps(bw, flip);
+        cosHalfTheta = _mm_xor_ps(cosHalfTheta, flip);
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(t, _mm_sub_ps(bx, ax)));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(t, _mm_sub_ps(by, ay)));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(t, _mm_sub_ps(bz, az)));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(t, _mm_sub_ps(bw, aw)));
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                                          _mm_mul_ps(rz, rz)), _mm_mul_ps(rw, rw)));
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 zero = _mm_cmpeq_ps(length, _mm_setzero_ps());
+        length = _mm_or_ps(_mm_and_ps(zero, one), _mm_andnot_ps(zero, length));
+        __m128 ilength = _mm_div_ps(one, length);
+        rx = _mm_mul_ps(rx, ilength);
+        ry = _mm_mul_ps(ry, ilength);
+        rz = _mm_mul_ps(rz, ilength);
+        rw = _mm_mul_ps(rw, ilength);
+
+        // Identical rotations keep a as it is
+        __m128 same = _mm_cmpge_ps(cosHalfTheta, one);
+        rx = _mm_or_ps(_mm_and_ps(same, ax), _mm_andnot_ps(same, rx));
+        ry = _mm_or_ps(_mm_and_ps(same, ay), _mm_andnot_ps(same, ry));
+        rz = _mm_or_ps(_mm_and_ps(same, az), _mm_andnot_ps(same, rz));
+        rw = _mm_or_ps(_mm_and_ps(same, aw), _mm_andnot_ps(same, rw));
+
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        float* po = reinterpret_cast<float*>(out + i);
+        // Lanes further apart than the lerp covers, or NaN, go the scalar way; read before out is written
+        int slow = _mm_movemask_ps(_mm_cmpngt_ps(cosHalfTheta, _mm_set1_ps(0.95f)));
+        ::Quaternion slerped[4];
+        for (int lane = 0; lane < 4; lane++) {
+            if (slow & (1 << lane)) slerped[lane] = detail::Slerp(a[i + (size_t)lane], b[i + (size_t)lane], amount);
+        }
+        _mm_storeu_ps(po, rx);
+        _mm_storeu_ps(po + 4, ry);
+        _mm_storeu_ps(po + 8, rz);
+        _mm_storeu_ps(po + 12, rw);
+        for (int lane = 0; lane < 4; lane++) {
+            if (slow & (1 << lane)) out[i + (size_t)lane] = slerped[lane];
+        }
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        float32x4x4_t qa = vld4q_f32(reinterpret_cast<const float*>(a + i));  // Deinterleaves x, y, z and w
+        float32x4x4_t qb = vld4q_f32(reinterpret_cast<const float*>(b + i));
+        float32x4_t cosHalfTheta = vmulq_f32(qa.val[0], qb.val[0]);
+        for (int k = 1; k < 4; k++) cosHalfTheta = vaddq_f32(cosHalfTheta, vmulq_f32(qa.val[k], qb.val[k]));
+        // Take the short way round: flip b, and the cosine with it, where the cosine is negative
+        uint32x4_t flip = vandq_u32(vcltq_f32(cosHalfTheta, vdupq_n_f32(0.0f)), vdupq_n_u32(0x80000000u));
+        for (int k = 0; k < 4; k++) {
+            qb.val[k] = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(qb.val[k]), flip));
+        }
+        cosHalfTheta = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosHalfTheta), flip));
+
+        float32x4x4_t r;
+        for (int k = 0; k < 4; k++) {
+            r.val[k] = vaddq_f32(qa.val[k], vmulq_n_f32(vsubq_f32(qb.val[k], qa.val[k]), amount));
+        }
+        float32x4_t squares = vmulq_f32(r.val[0], r.val[0]);
+        for (int k = 1; k < 4; k++) squares = vaddq_f32(squares, vmulq_f32(r.val[k], r.val[k]));
+        float32x4_t length = vsqrtq_f32(squares);
+        length = vbslq_f32(vceqq_f32(length, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f), length);
+        float32x4_t ilength = vdivq_f32(vdupq_n_f32(1.0f), length);
+        // Identical rotations keep a as it is
+        uint32x4_t same = vcgeq_f32(cosHalfTheta, vdupq_n_f32(1.0f));
+        for (int k = 0; k < 4; k++) r.val[k] = vbslq_f32(same, qa.val[k], vmulq_f32(r.val[k], ilength));
+
+        // Lanes further apart than the lerp covers, or NaN, go the scalar way; read before out is written
+        uint32_t fast[4];
+        vst1q_u32(fast, vcgtq_f32(cosHalfTheta, vdupq_n_f32(0.95f)));
+        ::Quaternion slerped[4];
+        for (int lane = 0; lane < 4; lane++) {
+            if (!fast[lane]) slerped[lane] = detail::Slerp(a[i + (size_t)lane], b[i + (size_t)lane], amount);
+        }
+        vst4q_f32(reinterpret_cast<float*>(out + i), r);
+        for (int lane = 0; lane < 4; lane++) {
+            if (!fast[lane]) out[i + (size_t)lane] = slerped[lane];
+        }
+    }
+#endif
+    for (; i < count; i++) out[i] = detail::Slerp(a[i], b[i], amount);
+}
+
+/**
+ * out[i] = QuaternionNlerp(a[i], b[i], amount), the normalized lerp without Slerp()'s short-way-round flip
+ */
+inline void Nlerp(::Quaternion* out, const ::Quaternion* a, const ::Quaternion* b, float amount, size_t count) {
+    for (size_t i = 0; i < count; i++) out[i] = detail::Nlerp(a[i], b[i], amount);
+}
+
+} // namespace QuaternionBatch
+
+} // namespace raylib
+
+#endif // RAYLIB_CPP_INCLUDE_QUATERNIONBATCH_HPP_
@@ -11,24 +11,24 @@ namespace raylib {
  */
 class Rectangle : public ::Rectangle {
 public:
-    Rectangle(const ::Rectangle& rect) : ::Rectangle{rect.x, rect.y, rect.width, rect.height} {}
+    constexpr Rectangle(const ::Rectangle& rect) : ::Rectangle{rect.x, rect.y, rect.width, rect.height} {}
 
-    Rectangle(float x, float y, float width, float height) : ::Rectangle{x, y, width, height} {}
-    Rectangle(float x, float y, float width) : ::Rectangle{x, y, width, 0} {}
-    Rectangle(float x, float y) : ::Rectangle{x, y, 0, 0} {}
-    Rectangle(float x) : ::Rectangle{x, 0, 0, 0} {}
-    Rectangle() : ::Rectangle{0, 0, 0, 0} {}
+    constexpr Rectangle(float x, float y, float width, float height) : ::Rectangle{x, y, width, height} {}
+    constexpr Rectangle(float x, float y, float width) : ::Rectangle{x, y, width, 0} {}
+    constexpr Rectangle(float x, float y) : ::Rectangle{x, y, 0, 0} {}
+    constexpr Rectangle(float x) : ::Rectangle{x, 0, 0, 0} {}
+    constexpr Rectangle() : ::Rectangle{0, 0, 0, 0} {}
 
-    Rectangle(::Vector2 position, ::Vector2 size) : ::Rectangle{position.x, position.y, size.x, size.y} {}
-    Rectangle(::Vector2 size) : ::Rectangle{0, 0, size.x, size.y} {}
-    Rectangle(::Vector4 rect) : ::Rectangle{rect.x, rect.y, rect.z, rect.w} {}
+    constexpr Rectangle(::Vector2 position, ::Vector2 size) : ::Rectangle{position.x, position.y, size.x, size.y} {}
+    constexpr Rectangle(::Vector2 size) : ::Rectangle{0, 0, size.x, size.y} {}
+    constexpr Rectangle(::Vector4 rect) : ::Rectangle{rect.x, rect.y, rect.z, rect.w} {}
 
     GETTERSETTER(float, X, x)
     GETTERSETTER(float, Y, y)
     GETTERSETTER(float, Width, width)
     GETTERSETTER(float, Height, height)
 
-    Rectangle& operator=(const ::Rectangle& rect) {
+    RAYLIB_CPP_CONSTEXPR14 Rectangle& operator=(const ::Rectangle& rect) {
         set(rect);
         return *this;
     }
@@ -140,7 +140,7 @@ public:
 
     Rectangle& SetPosition(const ::Vector2& position) { return SetPosition(position.x, position.y); }
 protected:
-    void set(const ::Rectangle& rect) {
+    RAYLIB_CPP_CONSTEXPR14 void set(const ::Rectangle& rect) {
         x = rect.x;
         y = rect.y;
         width = rect.width;
@@ -17,7 +17,7 @@ public:
 
     RenderTexture(const ::RenderTexture& renderTexture)
         : ::RenderTexture(renderTexture) {
-        // Nothing.
+        Track();
     }
 
     RenderTexture(unsigned int id, const ::Texture& texture, const ::Texture& depth)
@@ -28,7 +28,7 @@ public:
      */
     RenderTexture(int width, int height)
         : ::RenderTexture(::LoadRenderTexture(width, height)) {
-        // Nothing.
+        Track();
     }
 
     RenderTexture(const RenderTexture&) = delete;
@@ -60,6 +60,7 @@ public:
 
     RenderTexture& operator=(const ::RenderTexture& texture) {
         set(texture);
+        Track();
         return *this;
     }
 
@@ -82,7 +83,10 @@ public:
 
     ~RenderTexture() { Unload(); }
 
-    void Unload() { UnloadRenderTexture(*this); }
+    void Unload() {
+        GpuMemory::Untrack(GpuMemory::RENDER_TEXTURE, id);
+        UnloadRenderTexture(*this);
+    }
 
     /**
      * Initializes render texture for drawing
@@ -115,6 +119,9 @@ protected:
         texture = renderTexture.texture;
         depth = renderTexture.depth;
     }
+
+    // Counts this render texture in GpuMemory
+    void Track() const { GpuMemory::Track(GpuMemory::RENDER_TEXTURE, id, GpuMemory::RenderTextureBytes(*this)); }
 };
 
 using RenderTexture2D = RenderTexture;
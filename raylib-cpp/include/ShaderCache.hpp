@@ -0,0 +1,300 @@
+/**
+ * On-disk cache of linked shader program binaries.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_SHADERCACHE_HPP_
+#define RAYLIB_CPP_INCLUDE_SHADERCACHE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "./raylib.hpp"
+
+#include <rlgl.h>
+
+// Names raylib's LoadShader() looks up; rlgl.h normally defines them
+#ifndef RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION "vertexPosition"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD "vertexTexCoord"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL "vertexNormal"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR "vertexColor"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT "vertexTangent"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2 "vertexTexCoord2"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS "vertexBoneIds"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_BONEWEIGHTS "vertexBoneWeights"
+#define RL_DEFAULT_SHADER_ATTRIB_NAME_INSTANCE_TX "instanceTransform"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_MVP "mvp"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW "matView"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION "matProjection"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL "matModel"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL "matNormal"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR "colDiffuse"
+#define RL_DEFAULT_SHADER_UNIFORM_NAME_BONE_MATRICES "boneMatrices"
+#define RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0 "texture0"
+#define RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1 "texture1"
+#define RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2 "texture2"
+#endif
+
+#ifndef RL_MAX_SHADER_LOCATIONS
+#define RL_MAX_SHADER_LOCATIONS 32
+#endif
+
+#if defined(_WIN32)
+#define RAYLIB_CPP_GL_APIENTRY __stdcall
+#else
+#define RAYLIB_CPP_GL_APIENTRY
+#endif
+
+#if defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)
+// Built into raylib on desktop
+typedef void (*GLFWglproc)(void);
+extern "C" GLFWglproc glfwGetProcAddress(const char* procname);
+#endif
+
+namespace raylib {
+/**
+ * Loads shaders from a directory of linked program binaries, compiling and saving them only the first time.
+ *
+ * LoadShader compiles and links GLSL at every launch, which on slow drivers takes hundreds of milliseconds per
+ * program. Once a program has been linked the cache asks the driver for its binary (glGetProgramBinary) and writes it
+ * to directory; later loads of the same sources hand the binary straight back (glProgramBinary). Entries are keyed by
+ * a hash of both sources and the GL vendor, renderer and version strings, so a driver update misses and recompiles
+ * rather than loading a binary the driver no longer accepts. A binary the driver rejects anyway is recompiled and
+ * overwritten.
+ *
+ * rlgl doesn't expose program binaries, so the GL entry points come from getProcAddress. It defaults to raylib's own
+ * GLFW on desktop; elsewhere pass the platform's (eglGetProcAddress, say). Without one, or on a driver with no binary
+ * formats, the cache simply compiles every time.
+ *
+ * The shaders it returns are the same as LoadShader's, with the default locations set, and are unloaded with
+ * UnloadShader (or owned by raylib::Shader).
+ *
+ * @code
+ * raylib::ShaderCache cache("shadercache");
+ * raylib::Shader shader(cache.Load("resources/shaders/pbr.vs", "resources/shaders/pbr.fs"));
+ * @endcode
+ */
+class ShaderCache {
+public:
+    typedef void* (*ProcAddressLoader)(const char* name);
+
+    explicit ShaderCache(const std::string& directory, ProcAddressLoader getProcAddress = DefaultLoader())
+        : directory(directory), loader(getProcAddress) {}
+
+    /**
+     * Loads a shader from GLSL files, as LoadShader does; either may be empty for raylib's default
+     */
+    ::Shader Load(const std::string& vsFileName, const std::string& fsFileName) {
+        char* vsCode = vsFileName.empty() ? nullptr : ::LoadFileText(vsFileName.c_str());
+        char* fsCode = fsFileName.empty() ? nullptr : ::LoadFileText(fsFileName.c_str());
+        ::Shader shader = LoadFromMemory(vsCode, fsCode);
+        ::UnloadFileText(vsCode);
+        ::UnloadFileText(fsCode);
+        return shader;
+    }
+
+    /**
+     * Loads a shader from GLSL source, as LoadShaderFromMemory does; either may be null for raylib's default
+     */
+    ::Shader LoadFromMemory(const char* vsCode, const char* fsCode) {
+        if (!Init()) return ::LoadShaderFromMemory(vsCode, fsCode);
+
+        uint64_t key = Key(vsCode, fsCode);
+        std::string path = Path(key);
+        ::Shader shader{};
+        if (LoadBinary(path, key, &shader)) {
+            hits++;
+            return shader;
+        }
+        misses++;
+        shader = ::LoadShaderFromMemory(vsCode, fsCode);
+        if (shader.id != 0 && shader.id != ::rlGetShaderIdDefault()) SaveBinary(path, key, shader.id);
+        return shader;
+    }
+
+    /**
+     * Whether the driver can hand out program binaries; false before the first load
+     */
+    bool IsAvailable() const { return available; }
+
+    int GetHits() const { return hits; }
+    int GetMisses() const { return misses; }
+    const std::string& GetDirectory() const { return directory; }
+protected:
+    enum : unsigned int {
+        GL_VENDOR_ = 0x1F00,
+        GL_RENDERER_ = 0x1F01,
+        GL_VERSION_ = 0x1F02,
+        GL_LINK_STATUS_ = 0x8B82,
+        GL_PROGRAM_BINARY_LENGTH_ = 0x8741,
+        GL_NUM_PROGRAM_BINARY_FORMATS_ = 0x87FE,
+    };
+
+    typedef const unsigned char*(RAYLIB_CPP_GL_APIENTRY* GetStringProc)(unsigned int name);
+    typedef void(RAYLIB_CPP_GL_APIENTRY* GetIntegervProc)(unsigned int name, int* data);
+    typedef unsigned int(RAYLIB_CPP_GL_APIENTRY* CreateProgramProc)();
+    typedef void(RAYLIB_CPP_GL_APIENTRY* GetProgramivProc)(unsigned int program, unsigned int name, int* params);
+    typedef void(RAYLIB_CPP_GL_APIENTRY* GetProgramBinaryProc)(
+        unsigned int program, int bufSize, int* length, unsigned int* format, void* binary);
+    typedef void(RAYLIB_CPP_GL_APIENTRY* ProgramBinaryProc)(
+        unsigned int program, unsigned int format, const void* binary, int length);
+
+    // Written before each binary, so a stale or foreign file is recognised
+    struct Header {
+        char magic[4];
+        uint32_t format;
+        uint64_t key;
+    };
+
+    std::string directory;
+    ProcAddressLoader loader;
+    bool initialized = false;
+    bool available = false;
+    std::string driver;
+    int hits = 0;
+    int misses = 0;
+
+    GetProgramivProc getProgramiv = nullptr;
+    GetProgramBinaryProc getProgramBinary = nullptr;
+    ProgramBinaryProc programBinary = nullptr;
+    CreateProgramProc createProgram = nullptr;
+
+    static ProcAddressLoader DefaultLoader() {
+#if defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)
+        return &GlfwLoader;
+#else
+        return nullptr;
+#endif
+    }
+
+#if defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)
+    static void* GlfwLoader(const char* name) { return (void*)::glfwGetProcAddress(name); }
+#endif
+
+    /**
+     * Fetches the entry points on first use, once there is a GL context
+     */
+    bool Init() {
+        if (initialized) return available;
+        initialized = true;
+        if (loader == nullptr) return false;
+        GetStringProc getString = (GetStringProc)loader("glGetString");
+        GetIntegervProc getIntegerv = (GetIntegervProc)loader("glGetIntegerv");
+        getProgramiv = (GetProgramivProc)loader("glGetProgramiv");
+        getProgramBinary = (GetProgramBinaryProc)loader("glGetProgramBinary");
+        programBinary = (ProgramBinaryProc)loader("glProgramBinary");
+        createProgram = (CreateProgramProc)loader("glCreateProgram");
+        if (!getString || !getIntegerv || !getProgramiv || !getProgramBinary || !programBinary || !createProgram) {
+            return false;
+        }
+        int formats = 0;
+        getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_, &formats);
+        if (formats <= 0) return false;
+
+        const unsigned int names[3] = {GL_VENDOR_, GL_RENDERER_, GL_VERSION_};
+        for (int i = 0; i < 3; i++) {
+            const unsigned char* text = getString(names[i]);
+            if (text) driver += (const char*)text;
+            driver += '\n';
+        }
+        if (!::DirectoryExists(directory.c_str())) ::MakeDirectory(directory.c_str());
+        available = true;
+        return true;
+    }
+
+    static void Hash(uint64_t& hash, const char* text) {
+        // FNV-1a, with a separator so ("ab", "c") and ("a", "bc") differ
+        const unsigned char* p = (const unsigned char*)(text ? text : "");
+        for (; *p; p++) hash = (hash ^ *p) * 1099511628211ull;
+        hash = (hash ^ (text ? 0xFFu : 0xFEu)) * 1099511628211ull;
+    }
+
+    uint64_t Key(const char* vsCode, const char* fsCode) const {
+        uint64_t hash = 14695981039346656037ull;
+        Hash(hash, vsCode);
+        Hash(hash, fsCode);
+        Hash(hash, driver.c_str());
+        return hash;
+    }
+
+    std::string Path(uint64_t key) const {
+        return directory + "/" + ::TextFormat("%08x%08x.bin", (unsigned int)(key >> 32), (unsigned int)key);
+    }
+
+    bool LoadBinary(const std::string& path, uint64_t key, ::Shader* shader) {
+        if (!::FileExists(path.c_str())) return false;
+        int size = 0;
+        unsigned char* data = ::LoadFileData(path.c_str(), &size);
+        if (data == nullptr) return false;
+        Header header;
+        bool valid = size > (int)sizeof(header);
+        if (valid) {
+            std::memcpy(&header, data, sizeof(header));
+            valid = std::memcmp(header.magic, "RLSB", 4) == 0 && header.key == key;
+        }
+        unsigned int program = 0;
+        int linked = 0;
+        if (valid) {
+            program = createProgram();
+            programBinary(program, header.format, data + sizeof(header), size - (int)sizeof(header));
+            getProgramiv(program, GL_LINK_STATUS_, &linked);
+        }
+        ::UnloadFileData(data);
+        if (!linked) {
+            if (program != 0) ::rlUnloadShaderProgram(program);
+            return false;
+        }
+        shader->id = program;
+        shader->locs = SetDefaultLocations(program);
+        return true;
+    }
+
+    void SaveBinary(const std::string& path, uint64_t key, unsigned int program) const {
+        int length = 0;
+        getProgramiv(program, GL_PROGRAM_BINARY_LENGTH_, &length);
+        if (length <= 0) return;
+        Header header{{'R', 'L', 'S', 'B'}, 0, key};
+        std::vector<unsigned char> file(sizeof(header) + (size_t)length);
+        unsigned int format = 0;
+        int written = 0;
+        getProgramBinary(program, length, &written, &format, file.data() + sizeof(header));
+        if (written <= 0) return;
+        header.format = format;
+        std::memcpy(file.data(), &header, sizeof(header));
+        ::SaveFileData(path.c_str(), file.data(), (int)sizeof(header) + written);
+    }
+
+    /**
+     * The locations LoadShaderFromMemory sets up after linking
+     */
+    static int* SetDefaultLocations(unsigned int id) {
+        int* locs = (int*)RL_MALLOC(RL_MAX_SHADER_LOCATIONS * sizeof(int));
+        for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; i++) locs[i] = -1;
+        locs[SHADER_LOC_VERTEX_POSITION] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+        locs[SHADER_LOC_VERTEX_TEXCOORD01] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+        locs[SHADER_LOC_VERTEX_TEXCOORD02] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+        locs[SHADER_LOC_VERTEX_NORMAL] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+        locs[SHADER_LOC_VERTEX_TANGENT] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+        locs[SHADER_LOC_VERTEX_COLOR] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+        locs[SHADER_LOC_VERTEX_BONEIDS] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_BONEIDS);
+        locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_BONEWEIGHTS);
+        locs[SHADER_LOC_VERTEX_INSTANCE_TX] = ::rlGetLocationAttrib(id, RL_DEFAULT_SHADER_ATTRIB_NAME_INSTANCE_TX);
+        locs[SHADER_LOC_MATRIX_MVP] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
+        locs[SHADER_LOC_MATRIX_VIEW] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
+        locs[SHADER_LOC_MATRIX_PROJECTION] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
+        locs[SHADER_LOC_MATRIX_MODEL] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
+        locs[SHADER_LOC_MATRIX_NORMAL] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
+        locs[SHADER_LOC_BONE_MATRICES] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_BONE_MATRICES);
+        locs[SHADER_LOC_COLOR_DIFFUSE] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
+        locs[SHADER_LOC_MAP_ALBEDO] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
+        locs[SHADER_LOC_MAP_METALNESS] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
+        locs[SHADER_LOC_MAP_NORMAL] = ::rlGetLocationUniform(id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
+        return locs;
+    }
+};
+} // namespace raylib
+
+using RShaderCache = raylib::ShaderCache;
+
+#endif // RAYLIB_CPP_INCLUDE_SHADERCACHE_HPP_
@@ -0,0 +1,130 @@
+/**
+ * Streaming vertex buffers for geometry rebuilt every frame.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_STREAMINGMESH_HPP_
+#define RAYLIB_CPP_INCLUDE_STREAMINGMESH_HPP_
+
+#include <vector>
+
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A triangle mesh whose vertices are written on the CPU and sent to the GPU each frame without waiting on it.
+ *
+ * Updating one dynamic mesh every frame (MeshUnmanaged::UpdateBuffer) writes into buffers the GPU may still be drawing
+ * from, and the driver stalls until it is done with them. rlgl offers no buffer orphaning or mapping, so instead the
+ * mesh keeps RING uploaded copies of itself and each Commit(), once a frame, writes the next one round. A copy is only
+ * written again RING frames after it was drawn, by which time the GPU has finished with it.
+ *
+ * Vertices are unindexed triangles: positions (3 floats each), plus texture coordinates (2 floats) and colors (4
+ * bytes) when asked for. GPU buffers are created on the first Commit(), so construction needs no graphics context.
+ *
+ * @code
+ * raylib::StreamingMesh particles(MAX_PARTICLES * 6);
+ * // Each frame: write particles.Positions() and particles.Colors(), then
+ * particles.Commit(liveParticles * 6);
+ * particles.Draw(material, transform);
+ * @endcode
+ */
+class StreamingMesh {
+public:
+    static constexpr int RING = 3;
+
+    explicit StreamingMesh(int maxVertices, bool texcoords = true, bool colors = true)
+        : maxVertices(maxVertices < 0 ? 0 : maxVertices),
+          positions((size_t)this->maxVertices * 3),
+          uvs(texcoords ? (size_t)this->maxVertices * 2 : 0),
+          tints(colors ? (size_t)this->maxVertices * 4 : 0) {
+        for (int i = 0; i < RING; i++) slots[i] = ::Mesh{};
+    }
+
+    ~StreamingMesh() { Unload(); }
+
+    StreamingMesh(const StreamingMesh&) = delete;
+    StreamingMesh& operator=(const StreamingMesh&) = delete;
+
+    /**
+     * CPU-side vertex arrays, maxVertices long; null for attributes the mesh was made without
+     */
+    float* Positions() { return positions.data(); }
+    float* Texcoords() { return uvs.empty() ? nullptr : uvs.data(); }
+    unsigned char* Colors() { return tints.empty() ? nullptr : tints.data(); }
+
+    int GetMaxVertices() const { return maxVertices; }
+
+    /**
+     * Vertices in the copy Draw() uses
+     */
+    int GetVertexCount() const { return slots[current].vertexCount; }
+
+    bool IsReady() const { return slots[0].vboId != nullptr; }
+
+    /**
+     * Sends the first count vertices (a multiple of 3) to the next copy and makes it the one drawn
+     */
+    void Commit(int count) {
+        if (maxVertices == 0) return;
+        if (!IsReady()) Upload();
+        count = count < 0 ? 0 : (count > maxVertices ? maxVertices : count);
+        current = (current + 1) % RING;
+        ::Mesh& slot = slots[current];
+        if (count > 0) {
+            ::UpdateMeshBuffer(slot, 0, positions.data(), count * 3 * (int)sizeof(float), 0);
+            if (!uvs.empty()) ::UpdateMeshBuffer(slot, 1, uvs.data(), count * 2 * (int)sizeof(float), 0);
+            if (!tints.empty()) ::UpdateMeshBuffer(slot, 3, tints.data(), count * 4, 0);
+        }
+        slot.vertexCount = count;
+        slot.triangleCount = count / 3;
+    }
+
+    /**
+     * Draws what the last Commit() sent
+     */
+    void Draw(const ::Material& material, const ::Matrix& transform) const {
+        const ::Mesh& slot = slots[current];
+        if (slot.vboId != nullptr && slot.vertexCount > 0) ::DrawMesh(slot, material, transform);
+    }
+
+    /**
+     * Frees the GPU copies; the next Commit() makes them again
+     */
+    void Unload() {
+        for (int i = 0; i < RING; i++) {
+            // The CPU arrays belong to the vectors, so UnloadMesh only sees the GPU side
+            if (slots[i].vaoId != 0 || slots[i].vboId != nullptr) ::UnloadMesh(slots[i]);
+            slots[i] = ::Mesh{};
+        }
+        current = 0;
+    }
+
+protected:
+    int maxVertices;
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<unsigned char> tints;
+    ::Mesh slots[RING];
+    int current = 0;
+
+    void Upload() {
+        for (int i = 0; i < RING; i++) {
+            ::Mesh& slot = slots[i];
+            slot.vertexCount = maxVertices;
+            slot.triangleCount = maxVertices / 3;
+            slot.vertices = positions.data();
+            slot.texcoords = Texcoords();
+            slot.colors = Colors();
+            ::UploadMesh(&slot, true);
+            slot.vertices = nullptr;
+            slot.texcoords = nullptr;
+            slot.colors = nullptr;
+            slot.vertexCount = 0;
+            slot.triangleCount = 0;
+        }
+    }
+};
+} // namespace raylib
+
+using RStreamingMesh = raylib::StreamingMesh;
+
+#endif // RAYLIB_CPP_INCLUDE_STREAMINGMESH_HPP_
@@ -0,0 +1,142 @@
+/**
+ * Sweep-and-prune broadphase finding every overlapping pair of shapes.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_SWEEPANDPRUNE_HPP_
+#define RAYLIB_CPP_INCLUDE_SWEEPANDPRUNE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "./CollisionBatch.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * Finds which shapes in a set overlap each other, or which shapes of one set overlap those of another, without testing
+ * every pair.
+ *
+ * The shapes are sorted by their left edge, and each is then only tested against those that start before its right
+ * edge, so the cost grows with the number of shapes plus the number of near misses along x rather than with the
+ * square of the count. The sorted order is kept between calls: when the same number of shapes is passed again, as it
+ * is frame to frame, the order is repaired with an insertion sort, which is close to linear while things move a little
+ * each frame, so keep one SweepAndPrune per set of shapes. Exact tests are raylib's CheckCollisionRecs() and
+ * CheckCollisionCircles(), so the pairs are the same ones a loop over every pair would find. Widths, heights and radii
+ * should not be negative.
+ *
+ * @code
+ * raylib::SweepAndPrune broadphase;
+ * std::vector<raylib::SweepAndPrune::Pair> pairs;
+ * // Each frame:
+ * broadphase.FindPairs(bounds.data(), bounds.size(), pairs);
+ * for (const raylib::SweepAndPrune::Pair& p : pairs) Collide(bodies[p.first], bodies[p.second]);
+ * @endcode
+ */
+class SweepAndPrune {
+public:
+    /**
+     * Indices of two overlapping shapes. Within one set first < second; across two sets first indexes the first set.
+     */
+    struct Pair {
+        int first;
+        int second;
+    };
+
+    /**
+     * Sets out to every pair of overlapping rectangles in recs. Returns how many.
+     */
+    size_t FindPairs(const ::Rectangle* recs, size_t count, std::vector<Pair>& out) {
+        Sort(count, [recs](size_t i) { return Span{recs[i].x, recs[i].x + recs[i].width}; });
+        return Sweep(out, -1, [recs](int a, int b) { return CollisionBatch::detail::Recs(recs[a], recs[b]); });
+    }
+
+    /**
+     * Sets out to every pair of overlapping circles. Returns how many.
+     */
+    size_t FindPairs(const ::Vector2* centers, const float* radii, size_t count, std::vector<Pair>& out) {
+        Sort(count, [centers, radii](size_t i) { return Span{centers[i].x - radii[i], centers[i].x + radii[i]}; });
+        return Sweep(out, -1, [centers, radii](int a, int b) {
+            return CollisionBatch::detail::Circles(centers[a], radii[a], centers[b], radii[b]);
+        });
+    }
+
+    /**
+     * Sets out to every pair of a rectangle from a and one from b that overlap, such as bullets against enemies.
+     * Rectangles within the same set are not tested against each other. Returns how many.
+     */
+    size_t FindPairs(const ::Rectangle* a, size_t countA, const ::Rectangle* b, size_t countB, std::vector<Pair>& out) {
+        const int split = (int)countA;
+        auto at = [a, b, split](int i) -> const ::Rectangle& { return i < split ? a[i] : b[i - split]; };
+        Sort(countA + countB, [&at](size_t i) -> Span {
+            const ::Rectangle& r = at((int)i);
+            return Span{r.x, r.x + r.width};
+        });
+        return Sweep(out, split, [&at](int i, int j) { return CollisionBatch::detail::Recs(at(i), at(j)); });
+    }
+
+    /**
+     * Forgets the sorted order, so the next call sorts from scratch
+     */
+    void Clear() { order.clear(); }
+
+private:
+    struct Span {
+        float min;
+        float max;
+    };
+    struct Entry {
+        float min;
+        float max;
+        int index;
+    };
+
+    std::vector<Entry> order;
+
+    template<typename Bounds>
+    void Sort(size_t count, Bounds bounds) {
+        auto byMin = [](const Entry& l, const Entry& r) { return l.min < r.min; };
+        if (order.size() != count) {
+            order.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                Span span = bounds(i);
+                order[i] = Entry{span.min, span.max, (int)i};
+            }
+            std::sort(order.begin(), order.end(), byMin);
+            return;
+        }
+        // Same shapes as last time: refresh their spans in last time's order, which is nearly sorted already
+        for (Entry& e : order) {
+            Span span = bounds((size_t)e.index);
+            e.min = span.min;
+            e.max = span.max;
+        }
+        for (size_t i = 1; i < order.size(); i++) {
+            Entry e = order[i];
+            size_t j = i;
+            for (; j > 0 && byMin(e, order[j - 1]); j--) order[j] = order[j - 1];
+            order[j] = e;
+        }
+    }
+
+    // With split >= 0, indices below split are one set and the rest another, and only pairs across the two count
+    template<typename Test>
+    size_t Sweep(std::vector<Pair>& out, int split, Test test) const {
+        out.clear();
+        for (size_t i = 0; i < order.size(); i++) {
+            const Entry& e = order[i];
+            // Touching circles meet at a shared edge, so keep going while the next one starts exactly on this end
+            for (size_t j = i + 1; j < order.size() && order[j].min <= e.max; j++) {
+                int a = e.index, b = order[j].index;
+                if (split >= 0 && (a < split) == (b < split)) continue;
+                if (a > b) std::swap(a, b);
+                if (test(a, b)) out.push_back(Pair{a, split >= 0 ? b - split : b});
+            }
+        }
+        return out.size();
+    }
+};
+} // namespace raylib
+
+using RSweepAndPrune = raylib::SweepAndPrune;
+
+#endif // RAYLIB_CPP_INCLUDE_SWEEPANDPRUNE_HPP_
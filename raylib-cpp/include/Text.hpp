@@ -90,6 +90,11 @@ public:
     GETTERSETTER(::Color, Color, color)
     GETTERSETTER(float, Spacing, spacing)
 
+    /**
+     * Copies text into the existing string, which only allocates when it has to grow; a FixedString converts to this.
+     */
+    void SetText(const char* value) { text.assign(value); }
+
     /**
      * Draw text with values in class.
      */
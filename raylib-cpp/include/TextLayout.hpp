@@ -0,0 +1,218 @@
+/**
+ * Text laid out once and drawn as a single batch of quads.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_TEXTLAYOUT_HPP_
+#define RAYLIB_CPP_INCLUDE_TEXTLAYOUT_HPP_
+
+#include <string>
+#include <vector>
+
+#include "./Text.hpp"
+#include "./raylib.hpp"
+
+#include <rlgl.h>
+
+namespace raylib {
+/**
+ * Text whose glyphs are positioned once and drawn from that cache each frame.
+ *
+ * DrawTextEx decodes the UTF-8, looks up every glyph and works out where it goes on every call, then draws each glyph
+ * with its own DrawTexturePro. A layout does the decoding and placement the first time it is drawn or measured, and
+ * again only after its text, font, size or spacing changes; drawing then writes the cached quads into raylib's batch
+ * in straight runs, with the font texture bound once. Positions and line breaks are the same as DrawTextEx's.
+ *
+ * The font is copied, not owned, and must stay loaded while the layout is used. If the font is unloaded and another
+ * one loaded in its place, SetFont() it again.
+ *
+ * @code
+ * raylib::TextLayout score(font, "0", 32, 2, GOLD);
+ * // When the score changes:
+ * score.SetText(std::to_string(points));
+ * // Each frame:
+ * score.Draw(Vector2{20, 20});
+ * @endcode
+ */
+class TextLayout {
+public:
+    /**
+     * Glyphs written into the batch between limit checks
+     */
+    static constexpr int QUADS_PER_RUN = 1024;
+
+    TextLayout(
+        const ::Font& font,
+        const std::string& text = "",
+        float fontSize = 10,
+        float spacing = 0,
+        const ::Color& color = WHITE)
+        : font(font)
+        , text(text)
+        , fontSize(fontSize)
+        , spacing(spacing)
+        , color(color) {}
+
+    /**
+     * Lays out a Text's string, font, size and spacing, drawn in its color
+     */
+    explicit TextLayout(const Text& text)
+        : TextLayout(text.font, text.text, text.fontSize, text.spacing, text.color) {}
+
+    const ::Font& GetFont() const { return font; }
+    const std::string& GetText() const { return text; }
+    float GetFontSize() const { return fontSize; }
+    float GetSpacing() const { return spacing; }
+    int GetLineSpacing() const { return lineSpacing; }
+    ::Color GetColor() const { return color; }
+    void SetColor(const ::Color& value) { color = value; }
+
+    void SetFont(const ::Font& value) {
+        font = value;
+        dirty = true;
+    }
+
+    void SetText(const std::string& value) {
+        if (value == text) return;
+        text = value;
+        dirty = true;
+    }
+
+    void SetFontSize(float value) {
+        if (value == fontSize) return;
+        fontSize = value;
+        dirty = true;
+    }
+
+    void SetSpacing(float value) {
+        if (value == spacing) return;
+        spacing = value;
+        dirty = true;
+    }
+
+    /**
+     * Pixels between lines, in addition to the font size. raylib's own is set with SetTextLineSpacing and can't be
+     * read back, so set it here too if it was changed from its default of 2.
+     */
+    void SetLineSpacing(int value) {
+        if (value == lineSpacing) return;
+        lineSpacing = value;
+        dirty = true;
+    }
+
+    /**
+     * Size of the text as drawn: its widest line, and its lines' height, as MeasureTextEx measures them
+     */
+    [[nodiscard]] ::Vector2 Measure() {
+        Layout();
+        return size;
+    }
+
+    /**
+     * Glyphs that are drawn, leaving out spaces, tabs and line breaks
+     */
+    int GetQuadCount() {
+        Layout();
+        return (int)quads.size();
+    }
+
+    /**
+     * Draws the text with its top-left corner at position, in the layout's color
+     */
+    void Draw(const ::Vector2& position) { Draw(position, color); }
+
+    void Draw(const ::Vector2& position, const ::Color& tint) {
+        Layout();
+        if (quads.empty()) return;
+        float width = (float)font.texture.width, height = (float)font.texture.height;
+        ::rlSetTexture(font.texture.id);
+        for (size_t first = 0; first < quads.size(); first += QUADS_PER_RUN) {
+            size_t last = first + QUADS_PER_RUN < quads.size() ? first + QUADS_PER_RUN : quads.size();
+            // Flushes the batch first if this run wouldn't fit, so a run never straddles a flush
+            ::rlCheckRenderBatchLimit((int)(last - first) * 4);
+            ::rlBegin(RL_QUADS);
+            ::rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+            ::rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (size_t i = first; i < last; i++) {
+                const Quad& q = quads[i];
+                float x0 = position.x + q.dest.x, y0 = position.y + q.dest.y;
+                float x1 = x0 + q.dest.width, y1 = y0 + q.dest.height;
+                float u0 = q.source.x / width, v0 = q.source.y / height;
+                float u1 = (q.source.x + q.source.width) / width, v1 = (q.source.y + q.source.height) / height;
+                ::rlTexCoord2f(u0, v0);
+                ::rlVertex2f(x0, y0);
+                ::rlTexCoord2f(u0, v1);
+                ::rlVertex2f(x0, y1);
+                ::rlTexCoord2f(u1, v1);
+                ::rlVertex2f(x1, y1);
+                ::rlTexCoord2f(u1, v0);
+                ::rlVertex2f(x1, y0);
+            }
+            ::rlEnd();
+        }
+        ::rlSetTexture(0);
+    }
+protected:
+    /**
+     * A glyph's rectangle in the font texture, and where it is drawn relative to the text's top-left corner
+     */
+    struct Quad {
+        ::Rectangle source;
+        ::Rectangle dest;
+    };
+
+    ::Font font;
+    std::string text;
+    float fontSize;
+    float spacing;
+    int lineSpacing = 2;
+    ::Color color;
+    std::vector<Quad> quads;
+    ::Vector2 size{0.0f, 0.0f};
+    bool dirty = true;
+
+    /**
+     * Works out every glyph's quad as DrawTextEx and DrawTextCodepoint would place it, if anything changed
+     */
+    void Layout() {
+        if (!dirty) return;
+        dirty = false;
+        quads.clear();
+        size = ::Vector2{0.0f, 0.0f};
+        if (font.texture.id == 0 || font.glyphs == nullptr || font.baseSize == 0 || text.empty()) return;
+
+        float scale = fontSize / (float)font.baseSize;
+        float padding = (float)font.glyphPadding;
+        float x = 0.0f, y = 0.0f;
+        for (size_t i = 0; i < text.size();) {
+            int bytes = 0;
+            int codepoint = ::GetCodepointNext(&text[i], &bytes);
+            i += (size_t)bytes;
+            if (codepoint == '\n') {
+                x = 0.0f;
+                y += fontSize + (float)lineSpacing;
+                continue;
+            }
+            int index = ::GetGlyphIndex(font, codepoint);
+            const ::GlyphInfo& glyph = font.glyphs[index];
+            const ::Rectangle& rec = font.recs[index];
+            if (codepoint != ' ' && codepoint != '\t') {
+                Quad quad;
+                quad.source = ::Rectangle{rec.x - padding, rec.y - padding, rec.width + 2.0f * padding,
+                                          rec.height + 2.0f * padding};
+                quad.dest = ::Rectangle{x + ((float)glyph.offsetX - padding) * scale,
+                                        y + ((float)glyph.offsetY - padding) * scale, quad.source.width * scale,
+                                        quad.source.height * scale};
+                quads.push_back(quad);
+            }
+            float advance = (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale;
+            // Spacing only goes between glyphs, so it doesn't count at the end of a line
+            if (x + advance > size.x) size.x = x + advance;
+            x += advance + spacing;
+        }
+        size.y = y + fontSize;
+    }
+};
+} // namespace raylib
+
+using RTextLayout = raylib::TextLayout;
+
+#endif // RAYLIB_CPP_INCLUDE_TEXTLAYOUT_HPP_
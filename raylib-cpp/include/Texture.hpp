@@ -15,6 +15,16 @@ class Texture : public TextureUnmanaged {
 public:
     using TextureUnmanaged::TextureUnmanaged;
 
+    /**
+     * Takes ownership of a texture loaded elsewhere, e.g. with raylib's C functions.
+     */
+    Texture(const ::Texture& texture) : TextureUnmanaged(texture) { Track(); }
+
+    /**
+     * Takes ownership of a texture loaded elsewhere, e.g. with raylib's C functions.
+     */
+    Texture(::Texture&& texture) : TextureUnmanaged(texture) { Track(); }
+
     /**
      * Explicitly forbid the copy constructor.
      */
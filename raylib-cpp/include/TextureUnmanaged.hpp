@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "./CookedTexture.hpp"
+#include "./GpuMemory.hpp"
 #include "./Image.hpp"
 #include "./Material.hpp"
 #include "./RaylibException.hpp"
@@ -99,6 +101,7 @@ public:
         if (!IsValid()) {
             throw RaylibException("Failed to load Texture from Image");
         }
+        Track();
     }
 
     /**
@@ -109,16 +112,42 @@ public:
         if (!IsValid()) {
             throw RaylibException("Failed to load Texture from Cubemap");
         }
+        Track();
     }
 
     /**
-     * Load texture from file into GPU memory (VRAM)
+     * Load texture from file into GPU memory (VRAM). Cooked ".rltex" files are uploaded as they are.
      */
     void Load(const std::string& fileName) {
+        if (::IsFileExtension(fileName.c_str(), ".rltex")) {
+            LoadCooked(fileName);
+            return;
+        }
         set(::LoadTexture(fileName.c_str()));
         if (!IsValid()) {
             throw RaylibException("Failed to load Texture from file: " + fileName);
         }
+        Track();
+    }
+
+    /**
+     * Uploads a cooked texture straight from the mapped file, mipmaps and all, with no decoding
+     *
+     * @throws raylib::RaylibException Thrown if the file isn't a cooked texture, or the GPU doesn't support its format.
+     *
+     * @see raylib::CookedTexture
+     */
+    void LoadCooked(const std::string& fileName) {
+        MappedFileData file(fileName);
+        ::Image image{};
+        if (!CookedTexture::Read(file.GetView(), &image)) {
+            throw RaylibException("Failed to load cooked Texture from file: " + fileName);
+        }
+        set(::LoadTextureFromImage(image));
+        if (!IsValid()) {
+            throw RaylibException("Failed to upload cooked Texture, its format may not be supported: " + fileName);
+        }
+        Track();
     }
 
     /**
@@ -127,6 +156,7 @@ public:
     void Unload() {
         // Protect against calling UnloadTexture() twice.
         if (id != 0) {
+            GpuMemory::Untrack(GpuMemory::TEXTURE, id);
             ::UnloadTexture(*this);
             id = 0;
         }
@@ -328,6 +358,9 @@ protected:
         mipmaps = texture.mipmaps;
         format = texture.format;
     }
+
+    // Counts this texture in GpuMemory
+    void Track() const { GpuMemory::Track(GpuMemory::TEXTURE, id, GpuMemory::TextureBytes(*this)); }
 };
 
 // Create the TextureUnmanaged aliases.
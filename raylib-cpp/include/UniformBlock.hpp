@@ -0,0 +1,205 @@
+/**
+ * Shader uniforms resolved once and sent only when they change.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_UNIFORMBLOCK_HPP_
+#define RAYLIB_CPP_INCLUDE_UNIFORMBLOCK_HPP_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "./RaylibException.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+/**
+ * A shader's uniforms, looked up by name once and then set by handle, each frame, with only the values that changed
+ * sent to the GPU.
+ *
+ * Set() stores a value and marks the uniform dirty if it differs from what was last stored; Upload() sends the dirty
+ * ones, one SetShaderValue each, and forgets them. A scene that sets every light's uniforms each frame but only moves
+ * one light makes that light's calls and no others. The shader keeps uniforms between draws, so this is safe as long as
+ * nothing else writes the same uniforms; if something does, Invalidate() resends everything at the next Upload().
+ *
+ * The shader is copied, not owned, and must stay loaded while the block is used.
+ *
+ * @code
+ * raylib::UniformBlock uniforms(shader);
+ * int viewPos = uniforms.Add("viewPos", SHADER_UNIFORM_VEC3);
+ * int ambient = uniforms.Add("ambient", SHADER_UNIFORM_VEC4);
+ * // Each frame:
+ * uniforms.Set(viewPos, camera.position).Set(ambient, ambientColor);
+ * uniforms.Upload();
+ * @endcode
+ */
+class UniformBlock {
+public:
+    /**
+     * Uniform type of a mat4, for Add() alongside the SHADER_UNIFORM_* types
+     */
+    static constexpr int MATRIX = -1;
+
+    explicit UniformBlock(const ::Shader& shader) : shader(shader) {}
+
+    /**
+     * Looks up a uniform of uniformType (SHADER_UNIFORM_*, or MATRIX for a mat4), count elements long, and returns
+     * its handle. Uniforms the shader doesn't have, or that its compiler dropped, still get a handle, and are never
+     * sent.
+     */
+    int Add(const std::string& name, int uniformType, int count = 1) {
+        Entry entry;
+        entry.location = ::GetShaderLocation(shader, name.c_str());
+        entry.type = uniformType;
+        entry.count = uniformType == MATRIX ? 1 : (count < 1 ? 1 : count);
+        entry.offset = values.size();
+        entry.bytes = (size_t)UniformSize(uniformType) * (size_t)entry.count;
+        values.resize(values.size() + entry.bytes);
+        entries.push_back(entry);
+        return (int)entries.size() - 1;
+    }
+
+    int GetCount() const { return (int)entries.size(); }
+
+    /**
+     * The shader location behind a handle, or -1 if the shader doesn't have it
+     */
+    int GetLocation(int handle) const { return entries[(size_t)handle].location; }
+
+    /**
+     * Uniforms waiting for Upload()
+     */
+    int GetDirtyCount() const { return (int)dirty.size(); }
+
+    /**
+     * Sets all count elements of a uniform from raw data of the uniform's full size
+     */
+    UniformBlock& Set(int handle, const void* data) {
+        Store(handle, data, entries[(size_t)handle].bytes);
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, float value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, int value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, bool value) { return Set(handle, value ? 1 : 0); }
+
+    UniformBlock& Set(int handle, const ::Vector2& value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, const ::Vector3& value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, const ::Vector4& value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    /**
+     * Sets a vec4 (or vec3) uniform to a color normalized to 0..1, as ColorNormalize does
+     */
+    UniformBlock& Set(int handle, const ::Color& color) {
+        ::Vector4 value = ::ColorNormalize(color);
+        Store(handle, &value, entries[(size_t)handle].type == SHADER_UNIFORM_VEC3 ? sizeof(float) * 3 : sizeof(value));
+        return *this;
+    }
+
+    UniformBlock& Set(int handle, const ::Matrix& value) {
+        Store(handle, &value, sizeof(value));
+        return *this;
+    }
+
+    /**
+     * Sends every uniform changed since the last Upload(), returning how many calls that took
+     */
+    int Upload() {
+        int sent = 0;
+        for (size_t i = 0; i < dirty.size(); i++) {
+            Entry& entry = entries[(size_t)dirty[i]];
+            entry.dirty = false;
+            if (entry.location < 0) continue;
+            const void* data = &values[entry.offset];
+            if (entry.type == MATRIX) {
+                ::Matrix matrix;
+                std::memcpy(&matrix, data, sizeof(matrix));
+                ::SetShaderValueMatrix(shader, entry.location, matrix);
+            } else {
+                ::SetShaderValueV(shader, entry.location, data, entry.type, entry.count);
+            }
+            sent++;
+        }
+        dirty.clear();
+        return sent;
+    }
+
+    /**
+     * Marks every uniform that has been set dirty, for when something else changed them or the shader was reloaded
+     */
+    void Invalidate() {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].stored) MarkDirty((int)i);
+        }
+    }
+protected:
+    struct Entry {
+        int location = -1;
+        int type = SHADER_UNIFORM_FLOAT;
+        int count = 1;
+        size_t offset = 0;
+        size_t bytes = 0;
+        bool stored = false; // Set at least once, so values holds something to compare with
+        bool dirty = false;
+    };
+
+    ::Shader shader;
+    std::vector<Entry> entries;
+    std::vector<unsigned char> values; // Every uniform's last value, packed
+    std::vector<int> dirty;
+
+    static int UniformSize(int uniformType) {
+        switch (uniformType) {
+            case MATRIX: return (int)sizeof(::Matrix);
+            case SHADER_UNIFORM_VEC2:
+            case SHADER_UNIFORM_IVEC2: return 8;
+            case SHADER_UNIFORM_VEC3:
+            case SHADER_UNIFORM_IVEC3: return 12;
+            case SHADER_UNIFORM_VEC4:
+            case SHADER_UNIFORM_IVEC4: return 16;
+            default: return 4;
+        }
+    }
+
+    void Store(int handle, const void* data, size_t bytes) {
+        Entry& entry = entries[(size_t)handle];
+        if (bytes != entry.bytes) {
+            throw RaylibException(TextFormat(
+                "UniformBlock: %d byte value set on a %d byte uniform", (int)bytes, (int)entry.bytes));
+        }
+        unsigned char* stored = &values[entry.offset];
+        if (entry.stored && std::memcmp(stored, data, bytes) == 0) return;
+        std::memcpy(stored, data, bytes);
+        entry.stored = true;
+        MarkDirty(handle);
+    }
+
+    void MarkDirty(int handle) {
+        if (entries[(size_t)handle].dirty) return;
+        entries[(size_t)handle].dirty = true;
+        dirty.push_back(handle);
+    }
+};
+} // namespace raylib
+
+using RUniformBlock = raylib::UniformBlock;
+
+#endif // RAYLIB_CPP_INCLUDE_UNIFORMBLOCK_HPP_
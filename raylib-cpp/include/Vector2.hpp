@@ -14,14 +14,17 @@
 namespace raylib {
 /**
  * Vector2 type
+ *
+ * Arithmetic that needs no library calls is constexpr, written out with raymath's own formulas so the results match
+ * it exactly; anything with a square root or trigonometry still goes through raymath.
  */
 class Vector2 : public ::Vector2 {
 public:
-    Vector2(const ::Vector2& vec) : ::Vector2{vec.x, vec.y} {}
+    constexpr Vector2(const ::Vector2& vec) : ::Vector2{vec.x, vec.y} {}
 
-    Vector2(float x, float y) : ::Vector2{x, y} {}
-    Vector2(float x) : ::Vector2{x, 0} {}
-    Vector2() : ::Vector2{0, 0} {}
+    constexpr Vector2(float x, float y) : ::Vector2{x, y} {}
+    constexpr Vector2(float x) : ::Vector2{x, 0} {}
+    constexpr Vector2() : ::Vector2{0, 0} {}
 
     GETTERSETTER(float, X, x)
     GETTERSETTER(float, Y, y)
@@ -29,7 +32,7 @@ public:
     /**
      * Set the Vector2 to the same as the given Vector2.
      */
-    Vector2& operator=(const ::Vector2& vector2) {
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator=(const ::Vector2& vector2) {
         set(vector2);
         return *this;
     }
@@ -37,12 +40,12 @@ public:
     /**
      * Determine whether or not the vectors are equal.
      */
-    bool operator==(const ::Vector2& other) const { return x == other.x && y == other.y; }
+    constexpr bool operator==(const ::Vector2& other) const { return x == other.x && y == other.y; }
 
     /**
      * Determines if the vectors are not equal.
      */
-    bool operator!=(const ::Vector2& other) const { return !(*this == other); }
+    constexpr bool operator!=(const ::Vector2& other) const { return !(*this == other); }
 
     [[nodiscard]] std::string ToString() const { return TextFormat("Vector2(%f, %f)", x, y); }
 
@@ -52,18 +55,19 @@ public:
     /**
      * Add two vectors (v1 + v2)
      */
-    Vector2 Add(const ::Vector2& vector2) const { return Vector2Add(*this, vector2); }
+    constexpr Vector2 Add(const ::Vector2& vector2) const { return Vector2(x + vector2.x, y + vector2.y); }
 
     /**
      * Add two vectors (v1 + v2)
      */
-    Vector2 operator+(const ::Vector2& vector2) const { return Vector2Add(*this, vector2); }
+    constexpr Vector2 operator+(const ::Vector2& vector2) const { return Add(vector2); }
 
     /**
      * Add two vectors (v1 + v2)
      */
-    Vector2& operator+=(const ::Vector2& vector2) {
-        set(Vector2Add(*this, vector2));
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator+=(const ::Vector2& vector2) {
+        x += vector2.x;
+        y += vector2.y;
 
         return *this;
     }
@@ -71,18 +75,21 @@ public:
     /**
      * Subtract two vectors (v1 - v2)
      */
-    [[nodiscard]] Vector2 Subtract(const ::Vector2& vector2) const { return Vector2Subtract(*this, vector2); }
+    [[nodiscard]] constexpr Vector2 Subtract(const ::Vector2& vector2) const {
+        return Vector2(x - vector2.x, y - vector2.y);
+    }
 
     /**
      * Subtract two vectors (v1 - v2)
      */
-    Vector2 operator-(const ::Vector2& vector2) const { return Vector2Subtract(*this, vector2); }
+    constexpr Vector2 operator-(const ::Vector2& vector2) const { return Subtract(vector2); }
 
     /**
      * Subtract two vectors (v1 - v2)
      */
-    Vector2& operator-=(const ::Vector2& vector2) {
-        set(Vector2Subtract(*this, vector2));
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator-=(const ::Vector2& vector2) {
+        x -= vector2.x;
+        y -= vector2.y;
 
         return *this;
     }
@@ -90,28 +97,31 @@ public:
     /**
      * Negate vector
      */
-    [[nodiscard]] Vector2 Negate() const { return Vector2Negate(*this); }
+    [[nodiscard]] constexpr Vector2 Negate() const { return Vector2(-x, -y); }
 
     /**
      * Negate vector
      */
-    Vector2 operator-() const { return Vector2Negate(*this); }
+    constexpr Vector2 operator-() const { return Negate(); }
 
     /**
      * Multiply vector by vector
      */
-    [[nodiscard]] Vector2 Multiply(const ::Vector2& vector2) const { return Vector2Multiply(*this, vector2); }
+    [[nodiscard]] constexpr Vector2 Multiply(const ::Vector2& vector2) const {
+        return Vector2(x * vector2.x, y * vector2.y);
+    }
 
     /**
      * Multiply vector by vector
      */
-    Vector2 operator*(const ::Vector2& vector2) const { return Vector2Multiply(*this, vector2); }
+    constexpr Vector2 operator*(const ::Vector2& vector2) const { return Multiply(vector2); }
 
     /**
      * Multiply vector by vector
      */
-    Vector2& operator*=(const ::Vector2& vector2) {
-        set(Vector2Multiply(*this, vector2));
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator*=(const ::Vector2& vector2) {
+        x *= vector2.x;
+        y *= vector2.y;
 
         return *this;
     }
@@ -119,18 +129,19 @@ public:
     /**
      * Scale vector (multiply by value)
      */
-    [[nodiscard]] Vector2 Scale(const float scale) const { return Vector2Scale(*this, scale); }
+    [[nodiscard]] constexpr Vector2 Scale(const float scale) const { return Vector2(x * scale, y * scale); }
 
     /**
      * Scale vector (multiply by value)
      */
-    Vector2 operator*(const float scale) const { return Vector2Scale(*this, scale); }
+    constexpr Vector2 operator*(const float scale) const { return Scale(scale); }
 
     /**
      * Scale vector (multiply by value)
      */
-    Vector2& operator*=(const float scale) {
-        set(Vector2Scale(*this, scale));
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator*=(const float scale) {
+        x *= scale;
+        y *= scale;
 
         return *this;
     }
@@ -138,19 +149,22 @@ public:
     /**
      * Divide vector by vector
      */
-    [[nodiscard]] Vector2 Divide(const ::Vector2& vector2) const { return Vector2Divide(*this, vector2); }
+    [[nodiscard]] constexpr Vector2 Divide(const ::Vector2& vector2) const {
+        return Vector2(x / vector2.x, y / vector2.y);
+    }
 
 
     /**
      * Divide vector by vector
      */
-    Vector2 operator/(const ::Vector2& vector2) const { return Vector2Divide(*this, vector2); }
+    constexpr Vector2 operator/(const ::Vector2& vector2) const { return Divide(vector2); }
 
     /**
      * Divide vector by vector
      */
-    Vector2& operator/=(const ::Vector2& vector2) {
-        set(Vector2Divide(*this, vector2));
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator/=(const ::Vector2& vector2) {
+        x /= vector2.x;
+        y /= vector2.y;
 
         return *this;
     }
@@ -158,17 +172,17 @@ public:
     /**
      * Divide vector by value
      */
-    [[nodiscard]] Vector2 Divide(const float div) const { return ::Vector2{x / div, y / div}; }
+    [[nodiscard]] constexpr Vector2 Divide(const float div) const { return Vector2(x / div, y / div); }
 
     /**
      * Divide vector by value
      */
-    Vector2 operator/(const float div) const { return Divide(div); }
+    constexpr Vector2 operator/(const float div) const { return Divide(div); }
 
     /**
      * Divide vector by value
      */
-    Vector2& operator/=(const float div) {
+    RAYLIB_CPP_CONSTEXPR14 Vector2& operator/=(const float div) {
         this->x /= div;
         this->y /= div;
 
@@ -188,7 +202,9 @@ public:
     /**
      * Calculate linear interpolation between two vectors
      */
-    [[nodiscard]] Vector2 Lerp(const ::Vector2& vector2, float amount) const { return Vector2Lerp(*this, vector2, amount); }
+    [[nodiscard]] constexpr Vector2 Lerp(const ::Vector2& vector2, float amount) const {
+        return Vector2(x + amount * (vector2.x - x), y + amount * (vector2.y - y));
+    }
 
     /**
      * Calculate reflected vector to normal
@@ -210,7 +226,7 @@ public:
     /**
      * Invert the given vector
      */
-    [[nodiscard]] Vector2 Invert() const { return ::Vector2Invert(*this); }
+    [[nodiscard]] constexpr Vector2 Invert() const { return Vector2(1.0f / x, 1.0f / y); }
 
     /**
      * Clamp the components of the vector between
@@ -235,12 +251,12 @@ public:
     /**
      * Calculate vector square length
      */
-    [[nodiscard]] float LengthSqr() const { return Vector2LengthSqr(*this); }
+    [[nodiscard]] constexpr float LengthSqr() const { return x * x + y * y; }
 
     /**
      * Calculate two vectors dot product
      */
-    [[nodiscard]] float DotProduct(const ::Vector2& vector2) const { return Vector2DotProduct(*this, vector2); }
+    [[nodiscard]] constexpr float DotProduct(const ::Vector2& vector2) const { return x * vector2.x + y * vector2.y; }
 
     /**
      * Calculate distance between two vectors
@@ -250,7 +266,9 @@ public:
     /**
      * Calculate square distance between two vectors
      */
-    [[nodiscard]] float DistanceSqr(::Vector2 v2) const { return ::Vector2DistanceSqr(*this, v2); }
+    [[nodiscard]] constexpr float DistanceSqr(::Vector2 v2) const {
+        return (x - v2.x) * (x - v2.x) + (y - v2.y) * (y - v2.y);
+    }
 
     /**
      * Calculate angle from two vectors in X-axis
@@ -260,12 +278,12 @@ public:
     /**
      * Vector with components value 0.0f
      */
-    static Vector2 Zero() { return Vector2Zero(); }
+    static constexpr Vector2 Zero() { return Vector2(0.0f, 0.0f); }
 
     /**
      * Vector with components value 1.0f
      */
-    static Vector2 One() { return Vector2One(); }
+    static constexpr Vector2 One() { return Vector2(1.0f, 1.0f); }
 #endif
 
     void DrawPixel(::Color color = {0, 0, 0, 255}) const { ::DrawPixelV(*this, color); }
@@ -339,7 +357,7 @@ public:
         return ::CheckCollisionPointLine(*this, p1, p2, threshold);
     }
 protected:
-    void set(const ::Vector2& vec) {
+    RAYLIB_CPP_CONSTEXPR14 void set(const ::Vector2& vec) {
         x = vec.x;
         y = vec.y;
     }
@@ -0,0 +1,195 @@
+/**
+ * Batch operations over contiguous arrays of Vector2.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_VECTOR2BATCH_HPP_
+#define RAYLIB_CPP_INCLUDE_VECTOR2BATCH_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+#include "./Vector2.hpp"
+#include "./raylib-cpp-simd.hpp"
+#include "./raylib.hpp"
+
+namespace raylib {
+
+static_assert(sizeof(::Vector2) == 2 * sizeof(float), "Vector2 arrays must be tightly packed floats");
+static_assert(sizeof(raylib::Vector2) == sizeof(::Vector2), "raylib::Vector2 must add no storage to ::Vector2");
+
+/**
+ * Span-style kernels applying one raymath operation to every element of a Vector2 array.
+ *
+ * Arrays are interleaved (x0, y0, x1, y1, ...), so element-wise operations run over them as flat float arrays, four
+ * floats per SSE2/NEON register, with a scalar tail. Output may alias an input; other overlaps are not supported.
+ * Arrays of raylib::Vector2 can be passed directly.
+ */
+namespace Vector2Batch {
+
+namespace detail {
+inline const float* Floats(const ::Vector2* v) {
+    return reinterpret_cast<const float*>(v);
+}
+inline float* Floats(::Vector2* v) {
+    return reinterpret_cast<float*>(v);
+}
+} // namespace detail
+
+/**
+ * out[i] = a[i] + b[i]
+ */
+inline void Add(::Vector2* out, const ::Vector2* a, const ::Vector2* b, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    const float* pb = detail::Floats(b);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(o + i, _mm_add_ps(_mm_loadu_ps(pa + i), _mm_loadu_ps(pb + i)));
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) vst1q_f32(o + i, vaddq_f32(vld1q_f32(pa + i), vld1q_f32(pb + i)));
+#endif
+    for (; i < n; i++) o[i] = pa[i] + pb[i];
+}
+
+/**
+ * out[i] = a[i] + value
+ */
+inline void AddValue(::Vector2* out, const ::Vector2* a, ::Vector2 value, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 v = _mm_setr_ps(value.x, value.y, value.x, value.y);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(o + i, _mm_add_ps(_mm_loadu_ps(pa + i), v));
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    const float lanes[4] = {value.x, value.y, value.x, value.y};
+    float32x4_t v = vld1q_f32(lanes);
+    for (; i + 4 <= n; i += 4) vst1q_f32(o + i, vaddq_f32(vld1q_f32(pa + i), v));
+#endif
+    for (; i < n; i += 2) {
+        o[i] = pa[i] + value.x;
+        o[i + 1] = pa[i + 1] + value.y;
+    }
+}
+
+/**
+ * out[i] = a[i] * scale
+ */
+inline void Scale(::Vector2* out, const ::Vector2* a, float scale, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 s = _mm_set1_ps(scale);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(o + i, _mm_mul_ps(_mm_loadu_ps(pa + i), s));
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) vst1q_f32(o + i, vmulq_n_f32(vld1q_f32(pa + i), scale));
+#endif
+    for (; i < n; i++) o[i] = pa[i] * scale;
+}
+
+/**
+ * out[i] = a[i] + b[i] * scale, e.g. position += velocity * deltaTime
+ */
+inline void AddScaled(::Vector2* out, const ::Vector2* a, const ::Vector2* b, float scale, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    const float* pb = detail::Floats(b);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 s = _mm_set1_ps(scale);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(o + i, _mm_add_ps(_mm_loadu_ps(pa + i), _mm_mul_ps(_mm_loadu_ps(pb + i), s)));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) vst1q_f32(o + i, vaddq_f32(vld1q_f32(pa + i), vmulq_n_f32(vld1q_f32(pb + i), scale)));
+#endif
+    for (; i < n; i++) o[i] = pa[i] + pb[i] * scale;
+}
+
+/**
+ * out[i] = a[i] + amount * (b[i] - a[i]), like Vector2Lerp()
+ */
+inline void Lerp(::Vector2* out, const ::Vector2* a, const ::Vector2* b, float amount, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    const float* pb = detail::Floats(b);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 t = _mm_set1_ps(amount);
+    for (; i + 4 <= n; i += 4) {
+        __m128 va = _mm_loadu_ps(pa + i);
+        _mm_storeu_ps(o + i, _mm_add_ps(va, _mm_mul_ps(t, _mm_sub_ps(_mm_loadu_ps(pb + i), va))));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t va = vld1q_f32(pa + i);
+        vst1q_f32(o + i, vaddq_f32(va, vmulq_n_f32(vsubq_f32(vld1q_f32(pb + i), va), amount)));
+    }
+#endif
+    for (; i < n; i++) o[i] = pa[i] + amount * (pb[i] - pa[i]);
+}
+
+/**
+ * Clamp every component of a[i] between min and max, like Vector2Clamp()
+ */
+inline void Clamp(::Vector2* out, const ::Vector2* a, ::Vector2 min, ::Vector2 max, size_t count) {
+    float* o = detail::Floats(out);
+    const float* pa = detail::Floats(a);
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    __m128 lo = _mm_setr_ps(min.x, min.y, min.x, min.y);
+    __m128 hi = _mm_setr_ps(max.x, max.y, max.x, max.y);
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(o + i, _mm_min_ps(hi, _mm_max_ps(lo, _mm_loadu_ps(pa + i))));
+#elif defined(RAYLIB_CPP_SIMD_NEON)
+    const float loLanes[4] = {min.x, min.y, min.x, min.y};
+    const float hiLanes[4] = {max.x, max.y, max.x, max.y};
+    float32x4_t lo = vld1q_f32(loLanes);
+    float32x4_t hi = vld1q_f32(hiLanes);
+    for (; i + 4 <= n; i += 4) vst1q_f32(o + i, vminq_f32(hi, vmaxq_f32(lo, vld1q_f32(pa + i))));
+#endif
+    for (; i < n; i += 2) {
+        o[i] = std::fmin(max.x, std::fmax(min.x, pa[i]));
+        o[i + 1] = std::fmin(max.y, std::fmax(min.y, pa[i + 1]));
+    }
+}
+
+/**
+ * out[i] = length of a[i], like Vector2Length()
+ */
+inline void Length(float* out, const ::Vector2* a, size_t count) {
+    const float* pa = detail::Floats(a);
+    size_t i = 0;
+#if defined(RAYLIB_CPP_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 v0 = _mm_loadu_ps(pa + i * 2);      // x0 y0 x1 y1
+        __m128 v1 = _mm_loadu_ps(pa + i * 2 + 4);  // x2 y2 x3 y3
+        v0 = _mm_mul_ps(v0, v0);
+        v1 = _mm_mul_ps(v1, v1);
+        __m128 xx = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 yy = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(xx, yy)));
+    }
+#elif defined(RAYLIB_CPP_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t v = vld2q_f32(pa + i * 2);  // Deinterleaves into x and y lanes
+        vst1q_f32(out + i, vsqrtq_f32(vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1]))));
+    }
+#endif
+    for (; i < count; i++) {
+        float x = pa[i * 2];
+        float y = pa[i * 2 + 1];
+        out[i] = std::sqrt(x * x + y * y);
+    }
+}
+
+} // namespace Vector2Batch
+
+} // namespace raylib
+
+#endif // RAYLIB_CPP_INCLUDE_VECTOR2BATCH_HPP_
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "./DataView.hpp"
 #include "./RaylibException.hpp"
 #include "./raylib-cpp-utils.hpp"
 #include "./raylib.hpp"
@@ -41,6 +42,13 @@ public:
         Load(fileType, fileData, dataSize);
     }
 
+    /**
+     * Load wave from a view of file contents, such as a FileData or MappedFileData's
+     *
+     * @throws raylib::RaylibException Throws if the Wave failed to load.
+     */
+    Wave(const std::string& fileType, const DataView& fileData) { Load(fileType, fileData); }
+
     Wave(const Wave& other) { set(other.Copy()); }
 
     Wave(Wave&& other) noexcept {
@@ -189,6 +197,15 @@ public:
         }
     }
 
+    /**
+     * Load wave from a view of file contents, fileType refers to extension: i.e. "wav"
+     *
+     * @throws raylib::RaylibException Throws if the Wave failed to load.
+     */
+    void Load(const std::string& fileType, const DataView& fileData) {
+        Load(fileType, fileData.GetData(), fileData.GetSize());
+    }
+
     /**
      * Retrieve whether or not the Wave data has been loaded.
      *
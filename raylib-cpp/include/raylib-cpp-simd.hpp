@@ -0,0 +1,20 @@
+/**
+ * SIMD instruction set selection for the batch kernels and the image pipeline.
+ */
+#ifndef RAYLIB_CPP_INCLUDE_RAYLIB_CPP_SIMD_HPP_
+#define RAYLIB_CPP_INCLUDE_RAYLIB_CPP_SIMD_HPP_
+
+/**
+ * Select the SIMD path for the batch and pixel kernels. Define RAYLIB_CPP_NO_SIMD to force the portable scalar loops.
+ */
+#ifndef RAYLIB_CPP_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAYLIB_CPP_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RAYLIB_CPP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#endif // RAYLIB_CPP_INCLUDE_RAYLIB_CPP_SIMD_HPP_
@@ -35,4 +35,16 @@
     }
 #endif
 
+#ifndef RAYLIB_CPP_CONSTEXPR14
+/**
+ * constexpr on functions that C++11 doesn't allow it on, such as ones that modify the object, when compiling as C++14
+ * or later.
+ */
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define RAYLIB_CPP_CONSTEXPR14 constexpr
+#else
+#define RAYLIB_CPP_CONSTEXPR14
+#endif
+#endif
+
 #endif // RAYLIB_CPP_INCLUDE_RAYLIB_CPP_UTILS_HPP_
@@ -31,39 +31,63 @@
 #ifndef RAYLIB_CPP_INCLUDE_RAYLIB_CPP_HPP_
 #define RAYLIB_CPP_INCLUDE_RAYLIB_CPP_HPP_
 
+#include "./AnimationCache.hpp"
 #include "./AudioDevice.hpp"
 #include "./AudioStream.hpp"
 #include "./AutomationEventList.hpp"
 #include "./BoundingBox.hpp"
+#include "./BoundingBoxTree.hpp"
 #include "./Camera2D.hpp"
 #include "./Camera3D.hpp"
+#include "./CollisionBatch.hpp"
 #include "./Color.hpp"
+#include "./CookedTexture.hpp"
+#include "./CubicMap.hpp"
+#include "./DataView.hpp"
+#include "./DirtyRegion.hpp"
 #include "./FileData.hpp"
+#include "./FixedString.hpp"
 #include "./FileText.hpp"
 #include "./Font.hpp"
+#include "./Frustum.hpp"
 #include "./Functions.hpp"
 #include "./Gamepad.hpp"
+#include "./GlyphAtlas.hpp"
+#include "./GpuMemory.hpp"
 #include "./Image.hpp"
+#include "./ImagePipeline.hpp"
+#include "./InputQueue.hpp"
+#include "./InstanceBatch.hpp"
 #include "./Keyboard.hpp"
+#include "./MappedFileData.hpp"
 #include "./Material.hpp"
 #include "./Matrix.hpp"
+#include "./MatrixBatch.hpp"
 #include "./Mesh.hpp"
 #include "./Model.hpp"
 #include "./ModelAnimation.hpp"
 #include "./Mouse.hpp"
 #include "./Music.hpp"
+#include "./PostProcessChain.hpp"
+#include "./QuaternionBatch.hpp"
 #include "./Ray.hpp"
 #include "./RayCollision.hpp"
 #include "./RaylibException.hpp"
 #include "./Rectangle.hpp"
 #include "./RenderTexture.hpp"
 #include "./Shader.hpp"
+#include "./ShaderCache.hpp"
 #include "./Sound.hpp"
+#include "./StreamingMesh.hpp"
+#include "./SweepAndPrune.hpp"
 #include "./Text.hpp"
+#include "./TextLayout.hpp"
 #include "./Texture.hpp"
 #include "./TextureUnmanaged.hpp"
 #include "./Touch.hpp"
+#include "./UniformBlock.hpp"
 #include "./Vector2.hpp"
+#include "./Vector2Batch.hpp"
 #include "./Vector3.hpp"
 #include "./Vector4.hpp"
 #include "./VrStereoConfig.hpp"
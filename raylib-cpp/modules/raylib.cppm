@@ -45,25 +45,42 @@ export module raylib;
  */
 export namespace raylib {
     // Classes
+    using raylib::AnimationCache;
     using raylib::AudioDevice;
     using raylib::AudioStream;
     using raylib::AutomationEventList;
     using raylib::BoundingBox;
+    using raylib::BoundingBoxTree;
     using raylib::Camera; // Alias for Camera3D
     using raylib::Camera2D;
     using raylib::Camera3D;
     using raylib::Color;
+    using raylib::CookedTexture;
+    using raylib::CubicMap;
+    using raylib::DataView;
+    using raylib::DirtyRegion;
     using raylib::FileData;
     using raylib::FileText;
+    using raylib::FixedString;
     using raylib::Font;
+    using raylib::Frustum;
     using raylib::Gamepad;
+    using raylib::GamepadState;
+    using raylib::GlyphAtlas;
+    using raylib::GpuMemory;
     using raylib::Image;
+    using raylib::ImagePipeline;
+    using raylib::InputEvent;
+    using raylib::InputQueue;
+    using raylib::InstanceBatch;
+    using raylib::MappedFileData;
     using raylib::Material;
     using raylib::Matrix;
     using raylib::Mesh;
     using raylib::Model;
     using raylib::ModelAnimation;
     using raylib::Music;
+    using raylib::PostProcessChain;
     using raylib::Ray;
     using raylib::RayCollision;
     using raylib::RaylibException;
@@ -71,14 +88,19 @@ export namespace raylib {
     using raylib::RenderTexture;
     using raylib::RenderTexture2D; // Alias for RenderTexture
     using raylib::Shader;
+    using raylib::ShaderCache;
     using raylib::Sound;
+    using raylib::StreamingMesh;
+    using raylib::SweepAndPrune;
     using raylib::Text;
+    using raylib::TextLayout;
     using raylib::Texture;
     using raylib::Texture2D; // Alias for Texture
     using raylib::TextureCubemap; // Alias for Texture
     using raylib::TextureUnmanaged;
     using raylib::Texture2DUnmanaged; // Alias for TextureUnmanaged
     using raylib::TextureCubemapUnmanaged; // Alias for TextureUnmanaged
+    using raylib::UniformBlock;
     using raylib::Vector2;
     using raylib::Vector3;
     using raylib::Vector4;
@@ -203,6 +225,7 @@ export namespace raylib {
         using raylib::Keyboard::IsKeyUp;
         using raylib::Keyboard::GetKeyPressed;
         using raylib::Keyboard::GetCharPressed;
+        using raylib::Keyboard::QueueKeys;
     }
 
     /**
@@ -244,30 +267,92 @@ export namespace raylib {
         using raylib::Touch::GetPointCount;
     }
 
+    /**
+     * @namespace raylib::Vector2Batch
+     * @brief Batch operations over Vector2 arrays
+     */
+    namespace Vector2Batch {
+        using raylib::Vector2Batch::Add;
+        using raylib::Vector2Batch::AddValue;
+        using raylib::Vector2Batch::Scale;
+        using raylib::Vector2Batch::AddScaled;
+        using raylib::Vector2Batch::Lerp;
+        using raylib::Vector2Batch::Clamp;
+        using raylib::Vector2Batch::Length;
+    }
+
+    /**
+     * @namespace raylib::CollisionBatch
+     * @brief Many-vs-one collision checks over shape arrays
+     */
+    namespace CollisionBatch {
+        using raylib::CollisionBatch::CheckRecs;
+        using raylib::CollisionBatch::CheckCircles;
+        using raylib::CollisionBatch::CheckRecsCircle;
+        using raylib::CollisionBatch::CheckPoints;
+    }
+
+    /**
+     * @namespace raylib::MatrixBatch
+     * @brief Batch operations over Matrix arrays
+     */
+    namespace MatrixBatch {
+        using raylib::MatrixBatch::Multiply;
+        using raylib::MatrixBatch::TransformPoints;
+    }
+
+    /**
+     * @namespace raylib::QuaternionBatch
+     * @brief Batch interpolation over Quaternion arrays
+     */
+    namespace QuaternionBatch {
+        using raylib::QuaternionBatch::Slerp;
+        using raylib::QuaternionBatch::Nlerp;
+    }
+
 
 } // namespace raylib
 
 #ifdef RAYLIB_CPP_R_PREFIXES
 export {
+    using RAnimationCache = raylib::AnimationCache;
     using RAudioDevice = raylib::AudioDevice;
     using RAudioStream = raylib::AudioStream;
     using RAutomationEventList = raylib::AutomationEventList;
     using RBoundingBox = raylib::BoundingBox;
+    using RBoundingBoxTree = raylib::BoundingBoxTree;
     using RCamera = raylib::Camera; // Alias for Camera3D
     using RCamera2D = raylib::Camera2D;
     using RCamera3D = raylib::Camera3D;
     using RColor = raylib::Color;
+    using RCookedTexture = raylib::CookedTexture;
+    using RCubicMap = raylib::CubicMap;
+    using RDataView = raylib::DataView;
+    using RDirtyRegion = raylib::DirtyRegion;
     using RFileData = raylib::FileData;
     using RFileText = raylib::FileText;
+    template <size_t Capacity>
+    using RFixedString = raylib::FixedString<Capacity>;
     using RFont = raylib::Font;
+    using RFrustum = raylib::Frustum;
     using RGamepad = raylib::Gamepad;
+    using RGamepadState = raylib::GamepadState;
+    using RGlyphAtlas = raylib::GlyphAtlas;
+    using RGpuMemory = raylib::GpuMemory;
     using RImage = raylib::Image;
+    using RImagePipeline = raylib::ImagePipeline;
+    using RInputEvent = raylib::InputEvent;
+    template <size_t Capacity>
+    using RInputQueue = raylib::InputQueue<Capacity>;
+    using RInstanceBatch = raylib::InstanceBatch;
+    using RMappedFileData = raylib::MappedFileData;
     using RMaterial = raylib::Material;
     using RMatrix = raylib::Matrix;
     using RMesh = raylib::Mesh;
     using RModel = raylib::Model;
     using RModelAnimation = raylib::ModelAnimation;
     using RMusic = raylib::Music;
+    using RPostProcessChain = raylib::PostProcessChain;
     using RRay = raylib::Ray;
     using RRayCollision = raylib::RayCollision;
     using RRaylibException = raylib::RaylibException;
@@ -275,14 +360,19 @@ export {
     using RRenderTexture = raylib::RenderTexture;
     using RRenderTexture2D = raylib::RenderTexture2D; // Alias for RenderTexture
     using RShader = raylib::Shader;
+    using RShaderCache = raylib::ShaderCache;
     using RSound = raylib::Sound;
+    using RStreamingMesh = raylib::StreamingMesh;
+    using RSweepAndPrune = raylib::SweepAndPrune;
     using RText = raylib::Text;
+    using RTextLayout = raylib::TextLayout;
     using RTexture = raylib::Texture;
     using RTexture2D = raylib::Texture2D; // Alias for Texture
     using RTextureCubemap = raylib::TextureCubemap; // Alias for Texture
     using RTextureUnmanaged = raylib::TextureUnmanaged;
     using RTexture2DUnmanaged = raylib::Texture2DUnmanaged; // Alias for TextureUnmanaged
     using RTextureCubemapUnmanaged = raylib::TextureCubemapUnmanaged; // Alias for TextureUnmanaged
+    using RUniformBlock = raylib::UniformBlock;
     using RVector2 = raylib::Vector2;
     using RVector3 = raylib::Vector3;
     using RVector4 = raylib::Vector4;
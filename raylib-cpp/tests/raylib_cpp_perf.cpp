@@ -0,0 +1,329 @@
+/**
+ * Throughput regression checks for raylib-cpp's batch kernels, image pipeline, collision batches and text layout.
+ *
+ * Every benchmark is timed with a reference doing the same work the plain way (scalar loops, raylib's one-call-per-
+ * step image functions, a brute-force pair test, a measuring pass), measured in the same run, and the best run of
+ * each is compared as a ratio, so the check holds on any machine. A benchmark fails if its ratio is more than the
+ * tolerance over its bar: the ratio recorded for it in the baseline file when there is one, otherwise its built-in
+ * bound, which says how it must compare with the plain way at worst. One over the bar is measured again, with its
+ * reference, and fails the run if it stays over. To record the current ratios as bars, from raylib-cpp's build
+ * directory:
+ *
+ *     tests/raylib_cpp_perf --baseline ../tests/perf_baseline.txt --update
+ *
+ *     raylib_cpp_perf [--baseline FILE] [--update] [--tolerance FRACTION] [--filter TEXT]
+ */
+#include "raylib-cpp.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    const char* baseline = "perf_baseline.txt";
+    bool update = false;
+    double tolerance = 0.25; // Fraction slower than the baseline that still passes
+    const char* filter = nullptr;
+};
+
+struct Benchmark {
+    const char* name;
+    std::function<void()> fn;
+    std::function<void()> reference; // The same work done the plain way
+    double bound;                    // Most fn may cost as a multiple of reference without a recorded ratio
+};
+
+struct Result {
+    std::string name;
+    double ratio; // fn's best ns over reference's
+};
+
+// Extra measurements of a benchmark that looks slower than its bar before it counts as a regression
+const int RETRIES = 2;
+
+// Keeps results alive so the optimiser can't drop the work that produced them
+volatile float perfSink;
+
+// Best of several runs of fn, in nanoseconds per call; each run repeats fn for at least MIN_RUN_SECONDS
+double Measure(const std::function<void()>& fn) {
+    const int RUNS = 7;
+    const double MIN_RUN_SECONDS = 0.02;
+    typedef std::chrono::steady_clock Clock;
+    fn(); // Warm caches and lazy allocations
+
+    long iterations = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < iterations; i++) fn();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= MIN_RUN_SECONDS) break;
+        iterations *= 2;
+    }
+
+    double best = 0.0;
+    for (int run = 0; run < RUNS; run++) {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < iterations; i++) fn();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (double)iterations;
+        if (run == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// fn's cost as a multiple of reference's, each its best of several runs
+double MeasureRatio(const Benchmark& bench) {
+    double ns = Measure(bench.fn);
+    double referenceNs = Measure(bench.reference);
+    return referenceNs > 0.0 ? ns / referenceNs : 0.0;
+}
+
+std::map<std::string, double> LoadBaseline(const char* path) {
+    std::map<std::string, double> baseline;
+    FILE* file = fopen(path, "r");
+    if (!file) return baseline;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        char* end = nullptr;
+        double ratio = strtod(line, &end);
+        if (end == line) continue;
+        while (*end == ' ' || *end == '\t') end++;
+        std::string name(end);
+        while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+        if (ratio > 0.0 && !name.empty()) baseline[name] = ratio;
+    }
+    fclose(file);
+    return baseline;
+}
+
+bool SaveBaseline(const char* path, const std::vector<Result>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "# raylib_cpp_perf baseline: cost as a multiple of the benchmark's reference, then its name\n");
+    fprintf(file, "# Recorded with raylib_cpp_perf --update; a benchmark without a line here is held to its bound\n");
+    for (const Result& r : results) fprintf(file, "%.3f %s\n", r.ratio, r.name.c_str());
+    fclose(file);
+    return true;
+}
+
+// A monospaced font for the printable ASCII range that never touches the GPU: layout only reads the glyph tables
+struct FakeFont {
+    std::vector< ::GlyphInfo> glyphs;
+    std::vector< ::Rectangle> recs;
+    ::Font font;
+
+    FakeFont() : glyphs(95), recs(95), font() {
+        for (int i = 0; i < 95; i++) {
+            glyphs[(size_t)i].value = 32 + i;
+            glyphs[(size_t)i].advanceX = 10;
+            recs[(size_t)i] = ::Rectangle{(float)(i % 16) * 10.0f, (float)(i / 16) * 10.0f, 10.0f, 10.0f};
+        }
+        font.baseSize = 10;
+        font.glyphCount = 95;
+        font.texture.id = 1; // Only checked for non-zero
+        font.glyphs = glyphs.data();
+        font.recs = recs.data();
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--update")) opt.update = true;
+        else if (!strcmp(argv[i], "--baseline") && hasValue) opt.baseline = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && hasValue) opt.tolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && hasValue) opt.filter = argv[++i];
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::vector<Benchmark> benchmarks;
+    auto add = [&](const char* name, std::function<void()> fn, std::function<void()> reference, double bound) {
+        if (!opt.filter || strstr(name, opt.filter)) benchmarks.push_back(Benchmark{name, fn, reference, bound});
+    };
+
+    // Vector2Batch and MatrixBatch, against raymath one element at a time; the kernels exist to beat those loops,
+    // so they may not lose to them
+    // Not const, so the kernels are timed as games call them rather than specialised for a known count
+    size_t points = 4096;
+    std::vector< ::Vector2> a(points), b(points), moved(points);
+    std::vector<float> lengths(points);
+    for (size_t i = 0; i < points; i++) {
+        a[i] = ::Vector2{(float)i, (float)(points - i)};
+        b[i] = ::Vector2{0.5f, -0.25f};
+    }
+    add("Vector2Batch::AddScaled x4096", [&] {
+        raylib::Vector2Batch::AddScaled(moved.data(), a.data(), b.data(), 0.016f, points);
+        perfSink = moved[points - 1].x;
+    }, [&] {
+        for (size_t i = 0; i < points; i++) moved[i] = Vector2Add(a[i], Vector2Scale(b[i], 0.016f));
+        perfSink = moved[points - 1].x;
+    }, 1.0);
+    add("Vector2Batch::Lerp x4096", [&] {
+        raylib::Vector2Batch::Lerp(moved.data(), a.data(), b.data(), 0.3f, points);
+        perfSink = moved[points - 1].y;
+    }, [&] {
+        for (size_t i = 0; i < points; i++) moved[i] = Vector2Lerp(a[i], b[i], 0.3f);
+        perfSink = moved[points - 1].y;
+    }, 1.0);
+    add("Vector2Batch::Length x4096", [&] {
+        raylib::Vector2Batch::Length(lengths.data(), a.data(), points);
+        perfSink = lengths[points - 1];
+    }, [&] {
+        for (size_t i = 0; i < points; i++) lengths[i] = Vector2Length(a[i]);
+        perfSink = lengths[points - 1];
+    }, 1.0);
+
+    size_t matrices = 1024;
+    std::vector< ::Matrix> models(matrices, MatrixRotateZ(0.5f)), products(matrices);
+    ::Matrix view = MatrixTranslate(1.0f, 2.0f, 3.0f);
+    add("MatrixBatch::Multiply x1024", [&] {
+        raylib::MatrixBatch::Multiply(products.data(), models.data(), view, matrices);
+        perfSink = products[matrices - 1].m12;
+    }, [&] {
+        for (size_t i = 0; i < matrices; i++) products[i] = MatrixMultiply(models[i], view);
+        perfSink = products[matrices - 1].m12;
+    }, 1.5); // MatrixMultiply is straight-line code that compilers vectorise about as well, so they run neck and neck
+
+    // ImagePipeline, against the same steps as separate raylib calls, each a pass over the whole image; fusing them
+    // is the point, so the pipeline may not lose either
+    raylib::Image source(256, 256, ::Color{200, 120, 40, 255});
+    add("ImagePipeline fused colour 256x256", [&] {
+        raylib::Image result = raylib::ImagePipeline(source).ColorInvert().ColorBrightness(20)
+            .ColorTint(::Color{255, 200, 200, 255}).Execute();
+        perfSink = (float)result.width;
+    }, [&] {
+        ::Image result = ImageCopy(source);
+        ImageColorInvert(&result);
+        ImageColorBrightness(&result, 20);
+        ImageColorTint(&result, ::Color{255, 200, 200, 255});
+        perfSink = (float)result.width;
+        UnloadImage(result);
+    }, 1.0);
+    add("ImagePipeline flip+crop+resize 256x256", [&] {
+        raylib::Image result = raylib::ImagePipeline(source).FlipHorizontal()
+            .Crop(::Rectangle{16, 16, 224, 224}).Resize(128, 128).Execute();
+        perfSink = (float)result.width;
+    }, [&] {
+        ::Image result = ImageCopy(source);
+        ImageFlipHorizontal(&result);
+        ImageCrop(&result, ::Rectangle{16, 16, 224, 224});
+        ImageResize(&result, 128, 128);
+        perfSink = (float)result.width;
+        UnloadImage(result);
+    }, 1.0);
+
+    // CollisionBatch against the scalar test per shape, SweepAndPrune against testing every pair
+    size_t shapes = 4096;
+    std::vector< ::Rectangle> recs(shapes);
+    std::vector< ::Vector2> centers(shapes);
+    std::vector<float> radii(shapes, 6.0f);
+    std::vector<uint8_t> hits(shapes);
+    for (size_t i = 0; i < shapes; i++) {
+        float x = (float)((i * 37) % 1024), y = (float)((i * 91) % 768);
+        recs[i] = ::Rectangle{x, y, 12.0f, 12.0f};
+        centers[i] = ::Vector2{x, y};
+    }
+    const ::Rectangle probe{500, 300, 64, 64};
+    add("CollisionBatch::CheckRecs x4096", [&] {
+        perfSink = (float)raylib::CollisionBatch::CheckRecs(hits.data(), recs.data(), shapes, probe);
+    }, [&] {
+        size_t total = 0;
+        for (size_t i = 0; i < shapes; i++) total += hits[i] = raylib::CollisionBatch::detail::Recs(recs[i], probe);
+        perfSink = (float)total;
+    }, 1.0);
+    const ::Vector2 probeCenter{500, 300};
+    add("CollisionBatch::CheckCircles x4096", [&] {
+        perfSink = (float)raylib::CollisionBatch::CheckCircles(hits.data(), centers.data(), radii.data(), shapes,
+                                                               probeCenter, 32.0f);
+    }, [&] {
+        size_t total = 0;
+        for (size_t i = 0; i < shapes; i++) {
+            total += hits[i] = raylib::CollisionBatch::detail::Circles(centers[i], radii[i], probeCenter, 32.0f);
+        }
+        perfSink = (float)total;
+    }, 1.0);
+
+    raylib::SweepAndPrune broadphase;
+    std::vector<raylib::SweepAndPrune::Pair> pairs;
+    add("SweepAndPrune::FindPairs x1024", [&] { perfSink = (float)broadphase.FindPairs(recs.data(), 1024, pairs); },
+        [&] {
+            size_t found = 0;
+            for (size_t i = 0; i < 1024; i++) {
+                for (size_t j = i + 1; j < 1024; j++) found += raylib::CollisionBatch::detail::Recs(recs[i], recs[j]);
+            }
+            perfSink = (float)found;
+        }, 1.0);
+
+    // TextLayout against MeasureTextEx, which decodes and advances through the same text; laying out also looks up
+    // and stores every glyph's quad, so it gets a few measuring passes' worth
+    FakeFont fake;
+    std::string texts[2];
+    for (int i = 0; i < 16; i++) {
+        texts[0] += "The quick brown fox jumps over the lazy dog 0123456789\n";
+        texts[1] += "Pack my box with five dozen liquor jugs! 9876543210 ~\n";
+    }
+    raylib::TextLayout layout(fake.font, texts[0], 20, 1);
+    int which = 0;
+    add("TextLayout relayout 16 lines", [&] {
+        which ^= 1; // Alternating texts so every call lays out again
+        layout.SetText(texts[which]);
+        perfSink = (float)layout.GetQuadCount();
+    }, [&] {
+        which ^= 1;
+        perfSink = MeasureTextEx(fake.font, texts[which].c_str(), 20, 1).x;
+    }, 3.0);
+
+    std::vector<Result> results;
+    for (const Benchmark& bench : benchmarks) results.push_back(Result{bench.name, MeasureRatio(bench)});
+
+    if (opt.update) {
+        // Keep baselines of benchmarks this run skipped
+        std::map<std::string, double> baseline = LoadBaseline(opt.baseline);
+        for (const Result& r : results) baseline[r.name] = r.ratio;
+        std::vector<Result> merged;
+        for (const auto& entry : baseline) merged.push_back(Result{entry.first, entry.second});
+        if (!SaveBaseline(opt.baseline, merged)) {
+            fprintf(stderr, "Could not write %s\n", opt.baseline);
+            return 1;
+        }
+        for (const Result& r : results) printf("%8.3f  %s\n", r.ratio, r.name.c_str());
+        printf("Recorded %d baselines in %s\n", (int)results.size(), opt.baseline);
+        return 0;
+    }
+
+    std::map<std::string, double> baseline = LoadBaseline(opt.baseline);
+    int regressions = 0, unrecorded = 0;
+    printf("%8s %8s %9s  %s\n", "ratio", "bar", "from", "benchmark");
+    for (size_t i = 0; i < results.size(); i++) {
+        Result& r = results[i];
+        std::map<std::string, double>::const_iterator found = baseline.find(r.name);
+        bool recorded = found != baseline.end();
+        if (!recorded) unrecorded++;
+        double bar = recorded ? found->second : benchmarks[i].bound;
+        double limit = bar * (1.0 + opt.tolerance);
+        // Another process can steal a run or two, so a benchmark only fails if it stays slow when measured again
+        for (int retry = 0; retry < RETRIES && r.ratio > limit; retry++) {
+            double again = MeasureRatio(benchmarks[i]);
+            if (again < r.ratio) r.ratio = again;
+        }
+        bool slower = r.ratio > limit;
+        if (slower) regressions++;
+        printf("%8.3f %8.3f %9s  %s%s\n", r.ratio, bar, recorded ? "baseline" : "bound", r.name.c_str(),
+               slower ? "  REGRESSED" : "");
+    }
+    if (unrecorded > 0) printf("%d benchmark(s) not in %s, held to their bounds\n", unrecorded, opt.baseline);
+    if (regressions > 0) {
+        printf("%d benchmark(s) more than %.0f%% over their bar\n", regressions, opt.tolerance * 100.0);
+        return 1;
+    }
+    return 0;
+}
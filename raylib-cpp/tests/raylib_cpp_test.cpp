@@ -1,5 +1,8 @@
 #include "raylib-assert.h"
 #include "raylib-cpp.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -69,6 +72,263 @@ int main(int argc, char* argv[]) {
         raylib::Vector2 direction(50, 50);
         raylib::Vector2 newDirection = direction.Rotate(30);
         AssertEqual((int)newDirection.x, 57);
+
+        // Folded at compile time
+        constexpr raylib::Vector2 spawn = raylib::Vector2(16, 32) * 2.0f + raylib::Vector2::One();
+        static_assert(spawn.x == 33 && spawn.y == 65, "Vector2 arithmetic is constexpr");
+        constexpr raylib::Matrix moved = raylib::Matrix::Translate(1, 2, 3) * raylib::Matrix::Scale(2, 2, 2);
+        static_assert(moved.m12 == 2 && moved.m0 == 2, "Matrix arithmetic is constexpr");
+        static_assert(raylib::Color(0xE62937FF).r == 230, "Color from hex is constexpr");
+
+        // And the same as raymath
+        raylib::Matrix rotated = raylib::Matrix::RotateZ(0.5f) * moved;
+        ::Matrix expected = ::MatrixMultiply(::MatrixRotateZ(0.5f), moved);
+        Assert(std::memcmp(&rotated, &expected, sizeof(::Matrix)) == 0);
+    }
+
+    // Vector2Batch
+    {
+        // Odd count so both the SIMD body and the scalar tail run
+        const size_t count = 7;
+        std::vector<raylib::Vector2> a, b, out(count);
+        for (size_t i = 0; i < count; i++) {
+            a.push_back(raylib::Vector2(static_cast<float>(i), -static_cast<float>(i) * 2.0f));
+            b.push_back(raylib::Vector2(3.0f, 4.0f));
+        }
+
+        raylib::Vector2Batch::Add(out.data(), a.data(), b.data(), count);
+        for (size_t i = 0; i < count; i++) Assert(out[i] == a[i] + b[i]);
+
+        raylib::Vector2Batch::AddValue(out.data(), a.data(), ::Vector2{1.0f, -1.0f}, count);
+        for (size_t i = 0; i < count; i++) Assert(out[i] == a[i] + raylib::Vector2(1.0f, -1.0f));
+
+        raylib::Vector2Batch::Scale(out.data(), a.data(), 0.5f, count);
+        for (size_t i = 0; i < count; i++) Assert(out[i] == a[i].Scale(0.5f));
+
+        raylib::Vector2Batch::AddScaled(out.data(), a.data(), b.data(), 2.0f, count);
+        for (size_t i = 0; i < count; i++) Assert(out[i] == a[i] + b[i].Scale(2.0f));
+
+        raylib::Vector2Batch::Lerp(out.data(), a.data(), b.data(), 0.25f, count);
+        for (size_t i = 0; i < count; i++) Assert(out[i] == a[i].Lerp(b[i], 0.25f));
+
+        raylib::Vector2Batch::Clamp(out.data(), a.data(), ::Vector2{1.0f, -5.0f}, ::Vector2{4.0f, -1.0f}, count);
+        for (size_t i = 0; i < count; i++) {
+            Assert(out[i] == a[i].Clamp(raylib::Vector2(1.0f, -5.0f), raylib::Vector2(4.0f, -1.0f)));
+        }
+
+        std::vector<float> lengths(count);
+        raylib::Vector2Batch::Length(lengths.data(), b.data(), count);
+        for (size_t i = 0; i < count; i++) AssertEqual(lengths[i], 5.0f);
+
+        // In place
+        raylib::Vector2Batch::Add(a.data(), a.data(), b.data(), count);
+        AssertEqual(a[6].x, 9.0f);
+        AssertEqual(a[6].y, -8.0f);
+    }
+
+    // MatrixBatch and QuaternionBatch
+    {
+        // Set apart from raymath only by a fused multiply-add here and there
+        struct Close {
+            static bool Floats(const float* a, const float* b, size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    if (std::fabs(a[i] - b[i]) > 1e-5f * (1.0f + std::fabs(b[i]))) return false;
+                }
+                return true;
+            }
+        };
+
+        const size_t count = 7;
+        std::vector<::Matrix> a, b, out(count);
+        std::vector<::Vector3> points, moved(count);
+        for (size_t i = 0; i < count; i++) {
+            float f = static_cast<float>(i);
+            a.push_back(::Matrix{f, 1.5f, -2.0f, 3.0f, 0.25f, f * f, 1.0f, -f, 2.0f, 0.5f, -1.0f, 4.0f,
+                                 0.0f, 0.0f, 0.0f, 1.0f});
+            b.push_back(MatrixTranspose(a[i]));
+            points.push_back(::Vector3{f, -0.5f * f, 2.0f - f});
+        }
+
+        raylib::MatrixBatch::Multiply(out.data(), a.data(), b.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            ::Matrix expected = MatrixMultiply(a[i], b[i]);
+            Assert(Close::Floats(&out[i].m0, &expected.m0, 16));
+        }
+
+        raylib::MatrixBatch::Multiply(out.data(), a.data(), a[3], count);
+        for (size_t i = 0; i < count; i++) {
+            ::Matrix expected = MatrixMultiply(a[i], a[3]);
+            Assert(Close::Floats(&out[i].m0, &expected.m0, 16));
+        }
+
+        raylib::MatrixBatch::TransformPoints(moved.data(), points.data(), a[5], count);
+        for (size_t i = 0; i < count; i++) {
+            ::Vector3 expected = Vector3Transform(points[i], a[5]);
+            Assert(Close::Floats(&moved[i].x, &expected.x, 3));
+        }
+
+        // Near and far pairs, one the long way round and one identical, for every branch of QuaternionSlerp()
+        std::vector<::Quaternion> from, to, blended(count);
+        const float angles[count] = {0.1f, 2.5f, 0.3f, 1.0f, -0.2f, 3.0f, 0.05f};
+        for (size_t i = 0; i < count; i++) {
+            float h = 0.5f * static_cast<float>(i) * 0.2f;
+            float g = h + 0.5f * angles[i];
+            from.push_back(::Quaternion{0.0f, std::sin(h), 0.0f, std::cos(h)});
+            to.push_back(::Quaternion{0.0f, std::sin(g), 0.0f, std::cos(g)});
+        }
+        to[2] = ::Quaternion{-to[2].x, -to[2].y, -to[2].z, -to[2].w};
+        to[0] = from[0];
+
+        raylib::QuaternionBatch::Slerp(blended.data(), from.data(), to.data(), 0.3f, count);
+        for (size_t i = 0; i < count; i++) {
+            ::Quaternion expected = QuaternionSlerp(from[i], to[i], 0.3f);
+            Assert(Close::Floats(&blended[i].x, &expected.x, 4));
+        }
+
+        raylib::QuaternionBatch::Nlerp(blended.data(), from.data(), to.data(), 0.3f, count);
+        for (size_t i = 0; i < count; i++) {
+            ::Quaternion expected = QuaternionNlerp(from[i], to[i], 0.3f);
+            Assert(Close::Floats(&blended[i].x, &expected.x, 4));
+        }
+    }
+
+    // CollisionBatch and SweepAndPrune
+    {
+        // Seven rectangles in a staggered row, so some overlap their neighbours and both SIMD and tail lanes hit
+        const size_t count = 7;
+        std::vector<::Rectangle> recs;
+        std::vector<::Vector2> centers;
+        std::vector<float> radii;
+        for (size_t i = 0; i < count; i++) {
+            float f = static_cast<float>(i);
+            recs.push_back(::Rectangle{f * 15.0f, static_cast<float>(i % 2) * 10.0f, 20.0f, 12.0f});
+            centers.push_back(::Vector2{f * 15.0f, static_cast<float>(i % 3) * 5.0f});
+            radii.push_back(5.0f + f);
+        }
+        const ::Rectangle probe{30.0f, 5.0f, 40.0f, 10.0f};
+        std::vector<uint8_t> hits(count);
+
+        size_t total = raylib::CollisionBatch::CheckRecs(hits.data(), recs.data(), count, probe);
+        size_t expected = 0;
+        for (size_t i = 0; i < count; i++) {
+            AssertEqual(hits[i] != 0, CheckCollisionRecs(recs[i], probe));
+            expected += hits[i];
+        }
+        AssertEqual(total, expected);
+        AssertNot(total == 0);
+
+        total = raylib::CollisionBatch::CheckCircles(hits.data(), centers.data(), radii.data(), count,
+                                                      ::Vector2{45.0f, 5.0f}, 4.0f);
+        for (size_t i = 0; i < count; i++) {
+            AssertEqual(hits[i] != 0, CheckCollisionCircles(centers[i], radii[i], ::Vector2{45.0f, 5.0f}, 4.0f));
+        }
+
+        raylib::CollisionBatch::CheckRecsCircle(hits.data(), recs.data(), count, ::Vector2{45.0f, 5.0f}, 4.0f);
+        for (size_t i = 0; i < count; i++) {
+            AssertEqual(hits[i] != 0, CheckCollisionCircleRec(::Vector2{45.0f, 5.0f}, 4.0f, recs[i]));
+        }
+
+        raylib::CollisionBatch::CheckPoints(hits.data(), centers.data(), count, probe);
+        for (size_t i = 0; i < count; i++) AssertEqual(hits[i] != 0, CheckCollisionPointRec(centers[i], probe));
+
+        // Every pair a loop over all pairs finds, once, whether sorted from scratch or repaired after a move
+        struct Pairs {
+            static size_t Brute(const std::vector<::Rectangle>& r) {
+                size_t n = 0;
+                for (size_t i = 0; i < r.size(); i++) {
+                    for (size_t j = i + 1; j < r.size(); j++) n += CheckCollisionRecs(r[i], r[j]);
+                }
+                return n;
+            }
+        };
+        raylib::SweepAndPrune broadphase;
+        std::vector<raylib::SweepAndPrune::Pair> pairs;
+        for (int frame = 0; frame < 2; frame++) {
+            AssertEqual(broadphase.FindPairs(recs.data(), count, pairs), Pairs::Brute(recs));
+            for (const raylib::SweepAndPrune::Pair& pair : pairs) {
+                Assert(pair.first < pair.second);
+                Assert(CheckCollisionRecs(recs[(size_t)pair.first], recs[(size_t)pair.second]));
+            }
+            std::swap(recs[0].x, recs[6].x);
+        }
+
+        raylib::SweepAndPrune circlePhase;
+        size_t circlePairs = 0;
+        for (size_t i = 0; i < count; i++) {
+            for (size_t j = i + 1; j < count; j++) {
+                circlePairs += CheckCollisionCircles(centers[i], radii[i], centers[j], radii[j]);
+            }
+        }
+        AssertEqual(circlePhase.FindPairs(centers.data(), radii.data(), count, pairs), circlePairs);
+
+        // Across two sets only
+        raylib::SweepAndPrune crossPhase;
+        AssertEqual(crossPhase.FindPairs(recs.data(), count, &probe, 1, pairs), expected);
+        for (const raylib::SweepAndPrune::Pair& pair : pairs) {
+            AssertEqual(pair.second, 0);
+            Assert(CheckCollisionRecs(recs[(size_t)pair.first], probe));
+        }
+    }
+
+    // InputQueue
+    {
+        raylib::InputQueue<4> queue;
+        Assert(queue.Empty());
+        Assert(queue.Push(0.0, raylib::InputEvent::KEYBOARD, KEY_SPACE, true));
+        Assert(queue.Push(0.5, raylib::InputEvent::KEYBOARD, KEY_SPACE, false));
+        Assert(queue.Push(1.0, 0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, true));
+        Assert(queue.Push(1.0, 0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, false));
+        AssertNot(queue.Push(2.0, 0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, true));
+        AssertEqual(queue.Dropped(), (size_t)1);
+
+        // Only the events due by the given time, oldest first
+        int downs = 0;
+        AssertEqual(queue.PopUntil(0.75, [&](const raylib::InputEvent& e) { downs += e.down; }), (size_t)2);
+        AssertEqual(downs, 1);
+        AssertEqual(queue.Size(), (size_t)2);
+
+        // Wraps around the ring
+        Assert(queue.Push(3.0, raylib::InputEvent::KEYBOARD, KEY_ENTER, true));
+        raylib::InputEvent e{};
+        Assert(queue.Pop(e));
+        AssertEqual(e.device, 0);
+        AssertEqual(queue.PopUntil(10.0, [](const raylib::InputEvent&) {}), (size_t)2);
+        AssertNot(queue.Pop(e));
+    }
+
+    // GamepadState
+    {
+        raylib::GamepadState state;
+        state.buttons = 1u << GAMEPAD_BUTTON_RIGHT_FACE_DOWN;
+        state.axes[GAMEPAD_AXIS_LEFT_X] = -1.0f;
+        Assert(state.IsButtonDown(GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+        Assert(state.IsButtonUp(GAMEPAD_BUTTON_LEFT_FACE_UP));
+        AssertEqual(state.GetAxisMovement(GAMEPAD_AXIS_LEFT_X), -1.0f);
+        AssertEqual(state.GetAxisMovement(42), 0.0f);
+
+        // No pad is connected while testing, so everything that was down is released
+        raylib::Gamepad(3).Capture(state);
+        AssertNot(state.available);
+        Assert(state.IsButtonReleased(GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+        AssertNot(state.IsButtonDown(GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+        AssertEqual(state.GetAxisMovement(GAMEPAD_AXIS_LEFT_X), 0.0f);
+    }
+
+    // GpuMemory
+    {
+        raylib::GpuMemory::Usage before = raylib::GpuMemory::Get(raylib::GpuMemory::MESH);
+        raylib::GpuMemory::Track(raylib::GpuMemory::MESH, 9001, 100);
+        raylib::GpuMemory::Track(raylib::GpuMemory::MESH, 9001, 300);
+        raylib::GpuMemory::Usage tracked = raylib::GpuMemory::Get(raylib::GpuMemory::MESH);
+        AssertEqual(tracked.count, before.count + 1);
+        AssertEqual(tracked.bytes, before.bytes + 300);
+
+        raylib::GpuMemory::Untrack(raylib::GpuMemory::MESH, 9002);
+        raylib::GpuMemory::Untrack(raylib::GpuMemory::MESH, 9001);
+        AssertEqual(raylib::GpuMemory::Get(raylib::GpuMemory::MESH).bytes, before.bytes);
+
+        ::Texture texture = { 1, 16, 8, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        AssertEqual(raylib::GpuMemory::TextureBytes(texture), (size_t)(16 * 8 * 4));
     }
 
     // Image
@@ -81,6 +341,264 @@ int main(int argc, char* argv[]) {
         image.Crop(100, 100).Resize(50, 50);
         AssertEqual(image.GetWidth(), 50);
         AssertEqual(image.GetHeight(), 50);
+
+        // Drawing shapes
+        raylib::Image canvas(16, 16, BLANK);
+        canvas.DrawTriangle(Vector2{8, 0}, Vector2{0, 16}, Vector2{16, 16}, RED);
+        AssertEqual(canvas.GetColor(8, 12).r, 255);
+        AssertEqual(canvas.GetColor(1, 1).a, 0);
+        canvas.DrawCircleLines(8, 8, 6, GREEN);
+        ::Color green = GREEN;
+        AssertEqual(canvas.GetColor(8, 2).g, green.g);
+    }
+
+    // ImagePipeline
+    {
+        // 4x2 image whose red channel is the pixel index
+        raylib::Image source(4, 2, BLANK);
+        for (int i = 0; i < 8; i++) source.DrawPixel(i % 4, i / 4, ::Color{(unsigned char)i, 0, 0, 255});
+
+        // Borrowed: source stays as it was
+        raylib::Image flipped = raylib::ImagePipeline(source).FlipHorizontal().RotateCW().Execute();
+        AssertEqual(flipped.GetWidth(), 2);
+        AssertEqual(flipped.GetHeight(), 4);
+        AssertEqual(flipped.GetColor(0, 0).r, 7);
+        AssertEqual(source.GetColor(0, 0).r, 0);
+
+        // Geometry and colour fuse into one pass
+        raylib::ImagePipeline fused(source);
+        raylib::Image cropped = fused.Crop(Rectangle{1, 0, 2, 2}).FlipVertical().ColorInvert().Execute();
+        AssertEqual(fused.Passes(), 1);
+        AssertEqual(cropped.GetWidth(), 2);
+        AssertEqual(cropped.GetColor(0, 0).r, 255 - 5);
+
+        // Owned with no geometry: colour runs in place
+        raylib::Image copy = source;
+        raylib::ImagePipeline inPlace(std::move(copy));
+        raylib::Image bright = inPlace.ColorBrightness(10).ColorInvert().Execute();
+        AssertEqual(inPlace.Passes(), 1);
+        AssertEqual(bright.GetColor(3, 1).r, 255 - 17);
+
+        // Bands on several threads give the same pixels as one
+        raylib::Image large(300, 300, ::Color{200, 100, 50, 128});
+        raylib::Image serial = raylib::ImagePipeline(large).FlipVertical().AlphaPremultiply().Execute();
+        raylib::Image parallel = raylib::ImagePipeline(large).Parallel(4).FlipVertical().AlphaPremultiply().Execute();
+        AssertEqual(serial.GetColor(7, 299).r, 100);
+        AssertEqual(std::memcmp(serial.data, parallel.data, 300 * 300 * 4), 0);
+    }
+
+    // DirtyRegion
+    {
+        raylib::DirtyRegion dirty(64, 64, 2);
+        dirty.Add(0, 0, 8, 8);
+        dirty.Add(8, 0, 8, 8); // Beside the first: one strip
+        AssertEqual(dirty.GetRects().size(), 1);
+        AssertEqual(dirty.GetPixels(), 128);
+
+        dirty.Add(40, 40, 8, 8); // Far away: kept apart
+        AssertEqual(dirty.GetRects().size(), 2);
+        dirty.Add(4, 4, 2, 2);   // Already covered
+        AssertEqual(dirty.GetPixels(), 192);
+
+        dirty.Add(60, 0, 4, 4);  // Over the limit: the cheapest pair merges
+        AssertEqual(dirty.GetRects().size(), 2);
+
+        dirty.Add(-10, -10, 100, 100);
+        AssertEqual(dirty.GetPixels(), 64 * 64);
+        dirty.Clear();
+        Assert(dirty.IsEmpty());
+    }
+
+    // StreamingMesh
+    {
+        // No window here, so only the CPU side: buffers are made on the first Commit()
+        raylib::StreamingMesh mesh(6, true, false);
+        AssertEqual(mesh.GetMaxVertices(), 6);
+        Assert(mesh.Texcoords() != nullptr);
+        Assert(mesh.Colors() == nullptr);
+        AssertNot(mesh.IsReady());
+        AssertEqual(mesh.GetVertexCount(), 0);
+    }
+
+    // InstanceBatch
+    {
+        ::Mesh mesh{};
+        ::Material material{};
+        raylib::InstanceBatch batch(mesh, material);
+        ::Matrix transforms[3] = {};
+        batch.Add(transforms[0]).Add(transforms + 1, 2);
+        AssertEqual(batch.GetCount(), 3);
+
+        // Capacity survives Clear(), so the next frame doesn't allocate
+        size_t capacity = batch.GetCapacity();
+        batch.Clear();
+        AssertEqual(batch.GetCount(), 0);
+        AssertEqual(batch.GetCapacity(), capacity);
+
+        // No shader, so no instanceTransform attribute
+        AssertNot(batch.IsInstancing());
+    }
+
+    // AnimationCache
+    {
+        // One triangle fully weighted to a single bone that moves up by one unit over two frames
+        float vertices[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+        unsigned char boneIds[12] = {};
+        float boneWeights[12] = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+        ::Mesh mesh{};
+        mesh.vertexCount = 3;
+        mesh.vertices = vertices;
+        mesh.boneIds = boneIds;
+        mesh.boneWeights = boneWeights;
+
+        ::Transform rest{::Vector3{0, 0, 0}, ::Quaternion{0, 0, 0, 1}, ::Vector3{1, 1, 1}};
+        ::Transform raised{::Vector3{0, 1, 0}, ::Quaternion{0, 0, 0, 1}, ::Vector3{1, 1, 1}};
+        ::Transform* poses[2] = {&rest, &raised};
+        ::Model model{};
+        model.meshCount = 1;
+        model.meshes = &mesh;
+        model.boneCount = 1;
+        model.bindPose = &rest;
+        ::ModelAnimation anim{};
+        anim.boneCount = 1;
+        anim.frameCount = 2;
+        anim.framePoses = poses;
+
+        raylib::AnimationCache cache(model, anim, 2);
+        AssertEqual(cache.GetFrameCount(), 2);
+        AssertEqual(cache.GetVertices(0, 0)[7], 1.0f);
+        AssertEqual(cache.GetVertices(1, 0)[7], 2.0f);
+        AssertEqual(cache.GetVertices(3, 0)[1], 1.0f); // Wraps to frame 1
+        Assert(cache.GetNormals(0, 0) == nullptr);
+    }
+
+    // BoundingBoxTree
+    {
+        // A row of unit boxes along x, with a camera at the origin looking down +x
+        raylib::BoundingBoxTree tree;
+        for (int i = 0; i < 100; i++) {
+            tree.Add(::BoundingBox{::Vector3{(float)i, 0, 0}, ::Vector3{(float)i + 1, 1, 1}});
+        }
+        tree.Build();
+        AssertEqual(tree.GetCount(), 100);
+
+        std::vector<int> found;
+        AssertEqual(tree.Query(::BoundingBox{::Vector3{10.5f, 0, 0}, ::Vector3{12.5f, 1, 1}}, found), 3);
+
+        raylib::Camera3D camera(::Vector3{0, 0.5f, 0.5f}, ::Vector3{1, 0.5f, 0.5f});
+        raylib::Frustum frustum = camera.GetFrustum(1.0f);
+        Assert(frustum.CheckCollision(::Vector3{5, 0.5f, 0.5f}));
+        AssertNot(frustum.CheckCollision(::Vector3{-5, 0.5f, 0.5f}));
+        AssertEqual(tree.Query(frustum, found), 100);
+
+        // The nearest box the ray passes through wins, whatever order the leaves are in
+        int picked = -1;
+        RayCollision hit = tree.GetCollision(::Ray{::Vector3{50.5f, 5, 0.5f}, ::Vector3{0, -1, 0}}, &picked,
+            [](int, const ::Ray&) {
+                RayCollision collision{};
+                collision.hit = true;
+                return collision;
+            });
+        Assert(hit.hit);
+        AssertEqual(picked, 50);
+    }
+
+    // CubicMap
+    {
+        // A 4x4 room with a single wall in cell (2, 1)
+        ::Image image = ::GenImageColor(4, 4, BLACK);
+        ::ImageDrawPixel(&image, 2, 1, WHITE);
+        raylib::CubicMap map(image);
+        ::UnloadImage(image);
+
+        Assert(map.IsWall(2, 1));
+        AssertNot(map.IsWall(1, 1));
+        AssertNot(map.IsWall(-1, 0));
+
+        int x = 0, y = 0;
+        map.GetCell(::Vector2{1.6f, 0.9f}, &x, &y);
+        AssertEqual(x, 2);
+        AssertEqual(y, 1);
+
+        // The wall spans 1.5 to 2.5 on x
+        Assert(map.CheckCollision(::Vector2{1.4f, 1.0f}, 0.2f));
+        AssertNot(map.CheckCollision(::Vector2{1.2f, 1.0f}, 0.2f));
+    }
+
+    // UniformBlock
+    {
+        // Looking up locations needs a GL context, so only the empty block is checked here
+        raylib::UniformBlock uniforms(::Shader{});
+        AssertEqual(uniforms.GetCount(), 0);
+        AssertEqual(uniforms.GetDirtyCount(), 0);
+        AssertEqual(uniforms.Upload(), 0);
+    }
+
+    // ShaderCache
+    {
+        // Binaries need a GL context, so nothing is loaded until the first shader
+        raylib::ShaderCache cache("shadercache", nullptr);
+        AssertNot(cache.IsAvailable());
+        AssertEqual(cache.GetHits(), 0);
+        AssertEqual(cache.GetMisses(), 0);
+        AssertEqual(cache.GetDirectory(), std::string("shadercache"));
+    }
+
+    // GlyphAtlas
+    {
+        bool passed = false;
+        try {
+            raylib::GlyphAtlas atlas("notfound.ttf", 20);
+        } catch (raylib::RaylibException&) {
+            passed = true;
+        }
+        Assert(passed, "Expected a missing font file to throw");
+    }
+
+    // TextLayout
+    {
+        // Without a loaded font there is nothing to lay out
+        raylib::TextLayout layout(::Font{}, "Hello\nWorld", 20, 1, RED);
+        AssertEqual(layout.GetQuadCount(), 0);
+        AssertEqual(layout.Measure().x, 0);
+        layout.SetText("Changed");
+        AssertEqual(layout.GetText(), std::string("Changed"));
+        AssertEqual(layout.GetFontSize(), 20);
+    }
+
+    // FixedString
+    {
+        raylib::FixedString<16> score;
+        score.Append("Score: ").Append(-42, 5);
+        AssertEqual(std::string(score), std::string("Score:   -42"));
+        score.Clear().Append(3.14159, 2);
+        AssertEqual(std::string(score), std::string("3.14"));
+        score.Format("%s", "longer than sixteen");
+        AssertEqual((int)score.size(), 16);
+        Assert(score.IsTruncated());
+
+        raylib::Text text;
+        text.SetText(score.Clear().Append(7, 3, '0'));
+        AssertEqual(text.GetText(), std::string("007"));
+    }
+
+    // PostProcessChain
+    {
+        raylib::PostProcessChain post(320, 240);
+        int bloom = post.Add(::Shader{}, false);
+        int crt = post.Add(::Shader{});
+        AssertEqual(post.GetPassCount(), 2);
+        AssertEqual(post.GetEnabledCount(), 1);
+        post.Toggle(bloom);
+        post.SetEnabled(crt, false);
+        Assert(post.IsEnabled(bloom));
+        AssertNot(post.IsEnabled(crt));
+
+        // With every pass off the scene goes straight to the screen
+        post.SetEnabled(bloom, false);
+        post.Begin();
+        post.End();
+        AssertEqual(post.GetWidth(), 320);
     }
 
     // Keyboard
@@ -144,6 +662,36 @@ int main(int argc, char* argv[]) {
         Assert(file.GetBytesRead() > 0, "Expected file to be loaded correctly");
     }
 
+    // Load MappedFileData
+    {
+        raylib::FileData file(path + "/resources/feynman.png");
+        raylib::MappedFileData mapped(path + "/resources/feynman.png");
+        AssertEqual(mapped.GetSize(), file.GetBytesRead());
+        Assert(std::memcmp(mapped.GetData(), file.GetData(), (size_t)mapped.GetSize()) == 0);
+
+        raylib::Image image(".png", mapped.GetView());
+        AssertEqual(image.GetWidth(), 200);
+        AssertEqual(mapped.GetView().Subview(1, 3)[0], 'P');
+    }
+
+    // CookedTexture
+    {
+        raylib::Image image(4, 4, RED);
+        std::string cooked = path + "/resources/cooked.rltex";
+        Assert(raylib::CookedTexture::Export(image, cooked));
+        raylib::MappedFileData file(cooked);
+        ::Image view{};
+        Assert(raylib::CookedTexture::Read(file.GetView(), &view));
+        AssertEqual(view.width, 4);
+        AssertEqual(view.format, (int)PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        AssertEqual(view.mipmaps, 1);
+        AssertNot(raylib::CookedTexture::Read(file.GetView().Subview(0, 30), &view));
+
+        raylib::Image loaded(raylib::CookedTexture::Load(cooked));
+        Assert(std::memcmp(loaded.data, image.data, 4 * 4 * 4) == 0);
+        std::remove(cooked.c_str());
+    }
+
     // Load FileText
     {
         raylib::FileText text(path + "/resources/lorem.txt");
@@ -0,0 +1,140 @@
+#ifndef DIGDUG_ARCADEFILTER_HPP_
+#define DIGDUG_ARCADEFILTER_HPP_
+
+#include <string>
+
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Arcade look
+// ---------------------------------
+// Bloom and a CRT filter over the finished frame, as post-process passes sharing one pair
+// of screen-sized render textures. Both start off, and with both off the frame is drawn
+// straight to the screen as before, with no textures allocated. F6 toggles the CRT, F7 the
+// bloom, and --arcade starts with both on.
+//
+// The shaders are small enough to keep here rather than ship as files. They are written
+// once against a few macros so the same source builds as GLSL 330 on desktop and GLSL ES
+// 100 on the web.
+#if defined(PLATFORM_WEB) || defined(GRAPHICS_API_OPENGL_ES2)
+static const char* const ARCADE_FS_PREFIX =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "#define TEX texture2D\n"
+    "#define finalColor gl_FragColor\n";
+#else
+static const char* const ARCADE_FS_PREFIX =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    "#define TEX texture\n";
+#endif
+
+// Bright parts bleed into a 12-tap ring around each pixel, in one pass
+static const char* const BLOOM_FS =
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 texel;\n"
+    "vec3 bright(vec2 uv) { vec3 c = TEX(texture0, uv).rgb; return max(c - 0.6, 0.0) * 2.5; }\n"
+    "void main() {\n"
+    "    vec4 base = TEX(texture0, fragTexCoord);\n"
+    "    vec3 glow = vec3(0.0);\n"
+    "    for (int i = 0; i < 12; i++) {\n"
+    "        float a = float(i) * 0.5236;\n"
+    "        vec2 dir = vec2(cos(a), sin(a)) * texel;\n"
+    "        glow += bright(fragTexCoord + dir * 2.0) + bright(fragTexCoord + dir * 5.0) * 0.5;\n"
+    "    }\n"
+    "    finalColor = vec4(base.rgb + glow / 18.0, base.a) * colDiffuse * fragColor;\n"
+    "}\n";
+
+// Scanlines, a shadow mask that alternates by column and a vignette
+static const char* const CRT_FS =
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 size;\n"
+    "void main() {\n"
+    "    vec4 base = TEX(texture0, fragTexCoord);\n"
+    "    float scan = 0.8 + 0.2 * sin(fragTexCoord.y * size.y * 3.14159);\n"
+    "    float column = mod(floor(fragTexCoord.x * size.x), 3.0);\n"
+    "    vec3 mask = vec3(column == 0.0 ? 1.0 : 0.85, column == 1.0 ? 1.0 : 0.85, column == 2.0 ? 1.0 : 0.85);\n"
+    "    vec2 d = fragTexCoord - 0.5;\n"
+    "    float vignette = 1.0 - dot(d, d) * 0.9;\n"
+    "    finalColor = vec4(base.rgb * scan * mask * vignette * 1.15, base.a) * colDiffuse * fragColor;\n"
+    "}\n";
+
+class ArcadeFilter {
+public:
+    // Sets the size the passes run at; they start disabled and their shaders are only
+    // compiled the first time one is enabled, so a session that never turns them on never
+    // pays for it
+    void Load(int width, int height) {
+        this->width = width;
+        this->height = height;
+    }
+
+    // Need the GL context
+    void SetAll(bool enabled) {
+        if (enabled) Compile();
+        wantBloom = wantCrt = enabled;
+        Apply();
+    }
+    void ToggleBloom() {
+        Compile();
+        wantBloom = !wantBloom;
+        Apply();
+    }
+    void ToggleCrt() {
+        Compile();
+        wantCrt = !wantCrt;
+        Apply();
+    }
+
+    // Holds back passes the player has on while frames run over budget: 1 drops the bloom,
+    // 2 both. The player's choice comes back when it goes back to 0, and toggles made in the
+    // meantime still count.
+    void Shed(int passes) {
+        shed = passes;
+        Apply();
+    }
+
+    // Around everything that should look like it's on the cabinet's screen
+    void Begin() { chain.Begin(); }
+    void End() { chain.End(); }
+
+private:
+    raylib::Shader bloom;
+    raylib::Shader crt;
+    raylib::PostProcessChain chain;
+    int bloomPass = -1;
+    int crtPass = -1;
+    int width = 0, height = 0;
+    bool compiled = false;
+    bool wantBloom = false, wantCrt = false; // The player's choice
+    int shed = 0;
+
+    void Apply() {
+        if (!compiled) return;
+        chain.SetEnabled(bloomPass, wantBloom && shed < 1);
+        chain.SetEnabled(crtPass, wantCrt && shed < 2);
+    }
+
+    void Compile() {
+        if (compiled) return;
+        compiled = true;
+        bloom = raylib::Shader::LoadFromMemory(nullptr, (std::string(ARCADE_FS_PREFIX) + BLOOM_FS).c_str());
+        crt = raylib::Shader::LoadFromMemory(nullptr, (std::string(ARCADE_FS_PREFIX) + CRT_FS).c_str());
+        float texel[2] = { 1.0f / (float)width, 1.0f / (float)height };
+        float size[2] = { (float)width, (float)height };
+        bloom.SetValue(bloom.GetLocation("texel"), texel, SHADER_UNIFORM_VEC2);
+        crt.SetValue(crt.GetLocation("size"), size, SHADER_UNIFORM_VEC2);
+
+        chain.SetSize(width, height);
+        bloomPass = chain.Add(bloom, false);
+        crtPass = chain.Add(crt, false);
+    }
+};
+
+#endif // DIGDUG_ARCADEFILTER_HPP_
@@ -0,0 +1,347 @@
+#ifndef DIGDUG_ASSETLOADER_HPP_
+#define DIGDUG_ASSETLOADER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "MemoryStats.hpp"
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Asset loading
+// ---------------------------------
+// raylib's loaders decode and upload in one blocking call. Here the two halves are split:
+// worker threads read and decode files into CPU memory (images, font glyphs and their
+// atlas, audio waves), and the main thread, which owns the GL context, turns them into
+// textures, fonts and sounds in Upload(), one asset at a time until the frame's budget is
+// spent.
+//
+// Load calls return at once with a handle; Get() gives null until the asset is uploaded,
+// and State() says whether it is still coming or failed.
+//
+// Loads are deduplicated by path (and size, for fonts) and reference counted: loading a file
+// that is already in, or on its way, hands out the same asset. Release() drops a reference.
+// An asset nobody holds stays resident, so the next level or screen that wants it finds it
+// ready, until the resident total passes the memory budget; then the least recently
+// released go first. A handle to an evicted asset reads as FAILED.
+enum class AssetState : uint8_t { LOADING, READY, FAILED };
+
+template <typename T>
+struct AssetHandle {
+    int slot = -1;
+    uint32_t generation = 0; // Tells a reused slot from the asset the handle was for
+    bool Valid() const { return slot >= 0; }
+};
+
+class AssetLoader {
+public:
+    static constexpr int FONT_GLYPHS = 95; // Printable ASCII
+    static constexpr int FONT_PADDING = 4;
+    static constexpr size_t DEFAULT_BUDGET = 64u << 20; // Bytes of textures, fonts and sounds
+
+    explicit AssetLoader(int threads = 2, size_t budgetBytes = DEFAULT_BUDGET) : budget(budgetBytes) {
+        for (int i = 0; i < threads; i++) workers.emplace_back([this] { Run(); });
+    }
+
+    ~AssetLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+        // Decoded but never uploaded
+        for (Slot& slot : slots) FreeDecoded(slot);
+    }
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Each call takes a reference, to be given back with Release
+    AssetHandle<raylib::Texture> LoadTexture(const std::string& path) { return Acquire<raylib::Texture>(Kind::TEXTURE, path, 0); }
+    AssetHandle<raylib::Font> LoadFont(const std::string& path, int size) { return Acquire<raylib::Font>(Kind::FONT, path, size); }
+    AssetHandle<raylib::Sound> LoadSound(const std::string& path) { return Acquire<raylib::Sound>(Kind::SOUND, path, 0); }
+
+    // Gives back the reference a Load call took and clears the handle
+    template <typename T>
+    void Release(AssetHandle<T>& handle) {
+        if (Current(handle)) {
+            Slot& slot = slots[(size_t)handle.slot];
+            if (--slot.refs == 0) slot.lastReleased = ++releaseClock;
+            Trim();
+        }
+        handle = {};
+    }
+
+    // Evicts unreferenced assets until the resident ones fit in budgetBytes
+    void SetBudget(size_t budgetBytes) {
+        budget = budgetBytes;
+        Trim();
+    }
+
+    size_t ResidentBytes() const { return resident; }
+
+    // Uploads decoded assets until budgetSeconds have passed; at least one per call, so
+    // loading always moves on. Main thread only.
+    void Upload(double budgetSeconds) {
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        MemoryScope scope(MemTag::ASSETS);
+        do {
+            Slot* slot = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (decoded.empty()) return;
+                slot = decoded.front();
+                decoded.pop_front();
+            }
+            Finish(*slot);
+        } while (std::chrono::duration<double>(Clock::now() - start).count() < budgetSeconds);
+    }
+
+    template <typename T>
+    AssetState State(AssetHandle<T> handle) const {
+        return Current(handle) ? slots[(size_t)handle.slot].state : AssetState::FAILED;
+    }
+
+    // Null until the asset is READY
+    const raylib::Texture* Get(AssetHandle<raylib::Texture> handle) const {
+        return Ready(handle) ? &slots[(size_t)handle.slot].texture : nullptr;
+    }
+    const raylib::Font* Get(AssetHandle<raylib::Font> handle) const {
+        return Ready(handle) ? &slots[(size_t)handle.slot].font : nullptr;
+    }
+    const raylib::Sound* Get(AssetHandle<raylib::Sound> handle) const {
+        return Ready(handle) ? &slots[(size_t)handle.slot].sound : nullptr;
+    }
+
+    // Assets requested and not yet READY or FAILED
+    int Pending() const { return pending; }
+
+private:
+    enum class Kind : uint8_t { TEXTURE, FONT, SOUND };
+
+    // Everything but the decoded fields is main thread only
+    struct Slot {
+        Kind kind;
+        std::string path;
+        int fontSize = 0;
+        AssetState state = AssetState::LOADING;
+        uint32_t generation = 0;
+        int refs = 0;
+        size_t bytes = 0;          // Counted towards the budget once READY
+        uint64_t lastReleased = 0; // releaseClock when refs last reached zero
+        bool evicted = false;      // Free for reuse
+
+        // Filled by a worker, consumed by Finish
+        ::Image image {};
+        ::Wave wave {};
+        GlyphInfo* glyphs = nullptr;
+        Rectangle* glyphRecs = nullptr;
+        bool decodeOk = false;
+
+        raylib::Texture texture;
+        raylib::Font font;
+        raylib::Sound sound;
+    };
+
+    std::deque<Slot, TaggedAllocator<Slot, MemTag::ASSETS>> slots; // A deque, so workers' pointers survive new loads
+    std::vector<int> freeSlots;
+    std::unordered_map<std::string, int> byKey;
+    int pending = 0;
+    size_t budget;
+    size_t resident = 0;
+    uint64_t releaseClock = 0;
+
+    std::mutex mutex; // Guards the queues and stopping
+    std::condition_variable wake;
+    std::deque<Slot*> requested;
+    std::deque<Slot*> decoded;
+    bool stopping = false;
+    std::vector<std::thread> workers; // Last, so they start after everything they touch
+
+    static std::string Key(Kind kind, const std::string& path, int fontSize) {
+        return std::to_string((int)kind) + ":" + std::to_string(fontSize) + ":" + path;
+    }
+
+    template <typename T>
+    AssetHandle<T> Acquire(Kind kind, const std::string& path, int fontSize) {
+        std::string key = Key(kind, path, fontSize);
+        auto found = byKey.find(key);
+        if (found != byKey.end()) {
+            Slot& slot = slots[(size_t)found->second];
+            slot.refs++;
+            return { found->second, slot.generation };
+        }
+
+        int index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (int)slots.size();
+            slots.emplace_back();
+        }
+        Slot& slot = slots[(size_t)index];
+        slot.kind = kind;
+        slot.path = path;
+        slot.fontSize = fontSize;
+        slot.state = AssetState::LOADING;
+        slot.generation++;
+        slot.refs = 1;
+        slot.bytes = 0;
+        slot.evicted = false;
+        slot.decodeOk = false;
+        byKey[key] = index;
+        pending++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requested.push_back(&slot);
+        }
+        wake.notify_one();
+        return { index, slot.generation };
+    }
+
+    template <typename T>
+    bool Current(AssetHandle<T> handle) const {
+        return handle.Valid() && (size_t)handle.slot < slots.size() && slots[(size_t)handle.slot].generation == handle.generation
+            && !slots[(size_t)handle.slot].evicted;
+    }
+
+    template <typename T>
+    bool Ready(AssetHandle<T> handle) const { return State(handle) == AssetState::READY; }
+
+    // Unloads unreferenced assets, least recently released first, while over budget. Failed
+    // loads hold nothing but are dropped too once unreferenced, so a later load retries.
+    void Trim() {
+        for (;;) {
+            int victim = -1;
+            for (size_t i = 0; i < slots.size(); i++) {
+                const Slot& slot = slots[i];
+                if (slot.evicted || slot.refs > 0 || slot.state == AssetState::LOADING) continue;
+                if (slot.state == AssetState::FAILED) { victim = (int)i; break; }
+                if (resident > budget && (victim < 0 || slot.lastReleased < slots[(size_t)victim].lastReleased))
+                    victim = (int)i;
+            }
+            if (victim < 0) return;
+            Evict(slots[(size_t)victim], victim);
+        }
+    }
+
+    void Evict(Slot& slot, int index) {
+        if (slot.state == AssetState::READY) resident -= slot.bytes;
+        slot.texture = raylib::Texture();
+        slot.font = raylib::Font();
+        slot.sound = raylib::Sound();
+        slot.evicted = true;
+        byKey.erase(Key(slot.kind, slot.path, slot.fontSize));
+        freeSlots.push_back(index);
+    }
+
+    void Run() {
+        MemoryScope scope(MemTag::ASSETS);
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !requested.empty(); });
+            if (stopping) return;
+            Slot* slot = requested.front();
+            requested.pop_front();
+            lock.unlock();
+            Decode(*slot);
+            lock.lock();
+            decoded.push_back(slot);
+        }
+    }
+
+    // Worker side: file to CPU memory only, nothing that needs the GL context or audio device
+    static void Decode(Slot& slot) {
+        switch (slot.kind) {
+        case Kind::TEXTURE:
+            // Cooked textures come off the disk already in their GPU format, mipmaps and all
+            if (::IsFileExtension(slot.path.c_str(), ".rltex")) slot.image = raylib::CookedTexture::Load(slot.path);
+            else slot.image = ::LoadImage(slot.path.c_str());
+            slot.decodeOk = ::IsImageValid(slot.image);
+            break;
+        case Kind::FONT: {
+            int size = 0;
+            unsigned char* data = ::LoadFileData(slot.path.c_str(), &size);
+            if (!data) break;
+            slot.glyphs = ::LoadFontData(data, size, slot.fontSize, nullptr, FONT_GLYPHS, FONT_DEFAULT);
+            ::UnloadFileData(data);
+            if (!slot.glyphs) break;
+            slot.image = ::GenImageFontAtlas(slot.glyphs, &slot.glyphRecs, FONT_GLYPHS, slot.fontSize, FONT_PADDING, 0);
+            slot.decodeOk = ::IsImageValid(slot.image);
+            break;
+        }
+        case Kind::SOUND:
+            slot.wave = ::LoadWave(slot.path.c_str());
+            slot.decodeOk = ::IsWaveValid(slot.wave);
+            break;
+        }
+    }
+
+    // Main thread side: the upload, then the CPU copy goes
+    void Finish(Slot& slot) {
+        bool ok = slot.decodeOk;
+        if (ok) {
+            switch (slot.kind) {
+            case Kind::TEXTURE:
+                slot.texture = raylib::Texture(::LoadTextureFromImage(slot.image));
+                ok = slot.texture.IsValid();
+                slot.bytes = (size_t)raylib::CookedTexture::GetDataSize(slot.image.width, slot.image.height,
+                                                                          slot.image.format, slot.image.mipmaps);
+                break;
+            case Kind::FONT: {
+                ::Font font {};
+                font.baseSize = slot.fontSize;
+                font.glyphCount = FONT_GLYPHS;
+                font.glyphPadding = FONT_PADDING;
+                font.texture = ::LoadTextureFromImage(slot.image);
+                font.recs = slot.glyphRecs;
+                font.glyphs = slot.glyphs;
+                slot.glyphRecs = nullptr; // The font owns them now
+                slot.glyphs = nullptr;
+                slot.font = raylib::Font(font);
+                ok = slot.font.IsValid();
+                slot.bytes = (size_t)::GetPixelDataSize(slot.image.width, slot.image.height, slot.image.format)
+                           + FONT_GLYPHS * (sizeof(GlyphInfo) + sizeof(Rectangle));
+                break;
+            }
+            case Kind::SOUND: {
+                ::Sound sound = ::LoadSoundFromWave(slot.wave);
+                slot.sound = raylib::Sound(sound.stream, sound.frameCount);
+                ok = slot.sound.IsValid();
+                slot.bytes = (size_t)slot.wave.frameCount * slot.wave.channels * (slot.wave.sampleSize / 8);
+                break;
+            }
+            }
+        }
+        FreeDecoded(slot);
+        slot.state = ok ? AssetState::READY : AssetState::FAILED;
+        if (!ok) TraceLog(LOG_WARNING, "ASSETS: Failed to load %s", slot.path.c_str());
+        if (ok) resident += slot.bytes;
+        pending--;
+        // Released while still loading, or pushed the total over budget
+        if (slot.refs == 0 || resident > budget) Trim();
+    }
+
+    static void FreeDecoded(Slot& slot) {
+        if (slot.image.data) ::UnloadImage(slot.image);
+        if (slot.wave.data) ::UnloadWave(slot.wave);
+        if (slot.glyphs) ::UnloadFontData(slot.glyphs, FONT_GLYPHS);
+        if (slot.glyphRecs) ::MemFree(slot.glyphRecs);
+        slot.image = ::Image {};
+        slot.wave = ::Wave {};
+        slot.glyphs = nullptr;
+        slot.glyphRecs = nullptr;
+    }
+};
+
+#endif // DIGDUG_ASSETLOADER_HPP_
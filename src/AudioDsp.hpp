@@ -0,0 +1,163 @@
+#ifndef DIGDUG_AUDIODSP_HPP_
+#define DIGDUG_AUDIODSP_HPP_
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Audio effects
+// ---------------------------------
+// Stages for a DspChain. Each works in place on a block of interleaved stereo float frames
+// (what raylib hands stream processors) and keeps all of its state inline. Settings come
+// from the game thread through atomics and are picked up once per block, so the audio
+// thread never locks or allocates. Changes ramp across a block instead of stepping, which
+// would click.
+
+// samples[i] *= a gain moving linearly from `from` to `to` over the block. Branch-free over
+// a flat array so the compiler vectorises it.
+inline void ApplyGainRamp(float* samples, uint32_t frames, float from, float to) {
+    float step = frames > 0 ? (to - from) / (float)frames : 0.0f;
+    uint32_t count = frames * 2;
+    for (uint32_t i = 0; i < count; i++) samples[i] *= from + step * (float)(i >> 1);
+}
+
+class DspGain {
+public:
+    void SetGain(float gain) { target.store(gain, std::memory_order_relaxed); }
+
+    void Process(float* samples, uint32_t frames, int) {
+        float next = target.load(std::memory_order_relaxed);
+        if (next == 1.0f && current == 1.0f) return;
+        ApplyGainRamp(samples, frames, current, next);
+        current = next;
+    }
+
+private:
+    std::atomic<float> target{1.0f};
+    float current = 1.0f;
+};
+
+// One-pole low-pass per channel; a cutoff at or above OPEN_HZ passes the block untouched
+class DspLowPass {
+public:
+    static constexpr float OPEN_HZ = 18000.0f;
+
+    void SetCutoff(float hz) { cutoff.store(hz, std::memory_order_relaxed); }
+
+    void Process(float* samples, uint32_t frames, int sampleRate) {
+        float hz = cutoff.load(std::memory_order_relaxed);
+        if (hz >= OPEN_HZ) {
+            // Track the signal so closing the filter later starts from where it is
+            if (frames > 0) { left = samples[frames * 2 - 2]; right = samples[frames * 2 - 1]; }
+            return;
+        }
+        float a = 1.0f - std::exp(-2.0f * 3.14159265f * hz / (float)sampleRate);
+        for (uint32_t i = 0; i < frames; i++) {
+            left += a * (samples[i * 2] - left);
+            right += a * (samples[i * 2 + 1] - right);
+            samples[i * 2] = left;
+            samples[i * 2 + 1] = right;
+        }
+    }
+
+private:
+    std::atomic<float> cutoff{OPEN_HZ};
+    float left = 0.0f, right = 0.0f;
+};
+
+// Dips the level to DEPTH for HOLD seconds each time Duck() is called, then eases back
+class DspDucker {
+public:
+    static constexpr float DEPTH = 0.3f;
+    static constexpr float ATTACK = 0.05f;  // Seconds to reach DEPTH
+    static constexpr float HOLD = 1.5f;     // Seconds held down
+    static constexpr float RELEASE = 1.0f;  // Seconds back to full
+
+    // Game thread
+    void Duck() { requests.fetch_add(1, std::memory_order_relaxed); }
+
+    void Process(float* samples, uint32_t frames, int sampleRate) {
+        uint32_t seen = requests.load(std::memory_order_relaxed);
+        if (seen != handled) {
+            handled = seen;
+            holdFrames = (int64_t)(HOLD * (float)sampleRate);
+        }
+        float from = level;
+        float blockSeconds = (float)frames / (float)sampleRate;
+        if (holdFrames > 0) {
+            level = std::fmax(DEPTH, level - (1.0f - DEPTH) * blockSeconds / ATTACK);
+            holdFrames -= frames;
+        } else {
+            level = std::fmin(1.0f, level + (1.0f - DEPTH) * blockSeconds / RELEASE);
+        }
+        if (from == 1.0f && level == 1.0f) return;
+        ApplyGainRamp(samples, frames, from, level);
+    }
+
+private:
+    std::atomic<uint32_t> requests{0};
+    uint32_t handled = 0;
+    int64_t holdFrames = 0;
+    float level = 1.0f;
+};
+
+// ---------------------------------
+// DspChain
+// ---------------------------------
+// A fixed sequence of stages run as one stream processor: DspChain<DspLowPass, DspGain>
+// filters and then scales. The chain is a tuple, so the whole graph is known at compile
+// time and each block is a few inlined loops. Get<Stage>() reaches a stage's settings.
+//
+// raylib processors carry no user pointer, so each chain type can be attached to one
+// stream at a time.
+template <typename... Stages>
+class DspChain {
+public:
+    DspChain() = default;
+    ~DspChain() { Detach(); }
+
+    DspChain(const DspChain&) = delete;
+    DspChain& operator=(const DspChain&) = delete;
+
+    // False if the stream isn't playable or another chain of this type is attached
+    bool Attach(raylib::AudioStream& target) {
+        if (stream || !target.IsValid() || active.load()) return false;
+        stream = &target;
+        sampleRate = (int)target.sampleRate;
+        active.store(this, std::memory_order_release);
+        target.AttachProcessor(&Run);
+        return true;
+    }
+
+    // Once this returns raylib's audio thread has left Run for good
+    void Detach() {
+        if (!stream) return;
+        stream->DetachProcessor(&Run);
+        active.store(nullptr);
+        stream = nullptr;
+    }
+
+    template <typename Stage>
+    Stage& Get() { return std::get<Stage>(stages); }
+
+private:
+    static inline std::atomic<DspChain*> active{nullptr};
+
+    std::tuple<Stages...> stages;
+    raylib::AudioStream* stream = nullptr;
+    int sampleRate = 44100;
+
+    // raylib's audio thread
+    static void Run(void* buffer, unsigned int frames) {
+        DspChain* self = active.load(std::memory_order_acquire);
+        if (!self) return;
+        float* samples = (float*)buffer;
+        std::apply([&](Stages&... stage) { (stage.Process(samples, frames, self->sampleRate), ...); }, self->stages);
+    }
+};
+
+#endif // DIGDUG_AUDIODSP_HPP_
@@ -0,0 +1,147 @@
+#ifndef DIGDUG_BATCHSIM_HPP_
+#define DIGDUG_BATCHSIM_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "InputSources.hpp"
+#include "JobPool.hpp"
+#include "World.hpp"
+
+// ---------------------------------
+// Batch simulation
+// ---------------------------------
+// Plays many independent headless games across a JobPool and reduces them to statistics for
+// soak tests and balance tuning.
+
+struct GameResult {
+    GameState end = GameState::PLAYING; // PLAYING means the game hit the tick limit
+    int score = 0;
+    int ticks = 0;
+    int livesLeft = 0;
+    double simSeconds = 0.0;            // Time spent inside World::Update
+    const char* levelProblem = nullptr; // First broken invariant seen in a generated level
+};
+
+struct BatchConfig {
+    int games = 1000;
+    int maxTicks = 60 * 60;
+    unsigned seed = 1;
+    Tuning tuning;
+    const EnemyScript* enemies = nullptr;            // Built-in kinds when null
+    const std::vector<ScriptStep>* script = nullptr; // Bot plays when null
+    const LevelPack* levels = nullptr; // Games play this level file or pack when set
+    bool endless = false;              // ... and start it over after its last level
+};
+
+struct BatchStats {
+    int games = 0, wins = 0, losses = 0, timeouts = 0, badLevels = 0;
+    long long ticks = 0;
+    double meanScore = 0.0, medianScore = 0.0;
+    double meanTicks = 0.0;      // Game lifetime
+    double meanTickNs = 0.0;     // Cost of one World::Update
+    double simSeconds = 0.0;
+};
+
+// Invariants of a freshly generated level; returns nullptr when it is sound
+inline const char* CheckLevel(const World& world) {
+    for (size_t i = 0; i < world.tunnels.size(); i++) {
+        const Tunnel& t = world.tunnels[i];
+        if (t.length < TUNNEL_MIN_LENGTH || t.length > TUNNEL_MAX_LENGTH) return "tunnel length out of range";
+        // Tunnels keep a one-tile border of dirt around the map
+        int endX = t.startX + (t.direction == TunnelDirection::HORIZONTAL ? t.length : 1);
+        int endY = t.startY + (t.direction == TunnelDirection::VERTICAL ? t.length : 1);
+        if (t.startX < 1 || t.startY < 1 || endX > GRID_WIDTH - 1 || endY > GRID_HEIGHT - 1) return "tunnel out of bounds";
+        for (size_t j = 0; j < i; j++) {
+            if (t.Intersects(world.tunnels[j])) return "tunnels overlap";
+        }
+    }
+    int horizontal = 0;
+    for (const Tunnel& t : world.tunnels) horizontal += t.direction == TunnelDirection::HORIZONTAL;
+    // Tunnel counts come from the tuning only for generated levels
+    if (!world.levels
+        && (horizontal < world.tuning.horizontalTunnels || (int)world.tunnels.size() < world.tuning.maxTunnels))
+        return "fewer tunnels than requested";
+    for (size_t i = 0; i < world.enemies.Size(); i++) {
+        int gx = (int)(world.enemies.x[i] / TILE_SIZE);
+        int gy = (int)(world.enemies.y[i] / TILE_SIZE);
+        if (world.GetTunnelAt(gx, gy) != world.enemies.tunnel[i]) return "enemy spawned outside its tunnel";
+    }
+    return nullptr;
+}
+
+// Plays one game from the splash screen until it ends or maxTicks pass
+inline GameResult RunGame(unsigned seed, const BatchConfig& config) {
+    World world;
+    world.tuning = config.tuning;
+    if (config.enemies) world.SetEnemyScript(*config.enemies);
+    world.levels = config.levels;
+    world.endless = config.endless;
+    world.rng.Seed(seed);
+    world.ResetAll();
+
+    static const std::vector<ScriptStep> noScript;
+    ScriptPlayer scripted(config.script ? *config.script : noScript);
+    Bot bot(seed * 2654435761u);
+    GameResult result;
+    int checkedSerial = -1;
+
+    for (; result.ticks < config.maxTicks; result.ticks++) {
+        InputState in = config.script ? scripted.Next() : bot.Next(world);
+        auto t0 = std::chrono::steady_clock::now();
+        world.Update(in);
+        result.simSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        if (world.levelSerial != checkedSerial) {
+            checkedSerial = world.levelSerial;
+            if (!result.levelProblem) result.levelProblem = CheckLevel(world);
+        }
+        if (world.state == GameState::GAMEOVER || world.state == GameState::WIN) break;
+    }
+
+    result.end = world.state;
+    result.score = world.player.score;
+    result.livesLeft = world.player.lives;
+    return result;
+}
+
+// Runs config.games games, one job each; game g uses seed config.seed + g
+inline std::vector<GameResult> RunBatch(JobPool& pool, const BatchConfig& config) {
+    std::vector<GameResult> results((size_t)std::max(config.games, 0));
+    pool.ParallelFor(results.size(), [&](size_t g) {
+        results[g] = RunGame(config.seed + (unsigned)g, config);
+    });
+    return results;
+}
+
+inline BatchStats Summarize(const std::vector<GameResult>& results) {
+    BatchStats stats;
+    stats.games = (int)results.size();
+    if (results.empty()) return stats;
+
+    std::vector<int> scores;
+    scores.reserve(results.size());
+    double totalScore = 0.0;
+    for (const GameResult& r : results) {
+        if (r.end == GameState::WIN) stats.wins++;
+        else if (r.end == GameState::GAMEOVER) stats.losses++;
+        else stats.timeouts++;
+        if (r.levelProblem) stats.badLevels++;
+        stats.ticks += r.ticks;
+        stats.simSeconds += r.simSeconds;
+        totalScore += r.score;
+        scores.push_back(r.score);
+    }
+    std::sort(scores.begin(), scores.end());
+    size_t mid = scores.size() / 2;
+    stats.medianScore = scores.size() % 2 ? scores[mid] : (scores[mid - 1] + scores[mid]) / 2.0;
+    stats.meanScore = totalScore / stats.games;
+    stats.meanTicks = (double)stats.ticks / stats.games;
+    stats.meanTickNs = stats.ticks > 0 ? stats.simSeconds * 1e9 / (double)stats.ticks : 0.0;
+    return stats;
+}
+
+#endif // DIGDUG_BATCHSIM_HPP_
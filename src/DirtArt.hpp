@@ -0,0 +1,115 @@
+#ifndef DIGDUG_DIRTART_HPP_
+#define DIGDUG_DIRTART_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "MemoryStats.hpp"
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Dirt backdrops
+// ---------------------------------
+// Each level's undug earth is a map-sized image: depth strata like the arcade's, cellular
+// rock, a light gradient from the surface and white-noise grain, all from raylib's CPU
+// image generators. Variants differ in seed and palette.
+//
+// The generators only touch memory, so baking runs on a worker while the previous level
+// is played and the next variant is always ready before it is needed. The game thread
+// just uploads the finished image. Nothing else in the game draws from raylib's random
+// generator, so the worker reseeding it for each variant is safe.
+inline raylib::Image BakeDirt(int width, int height, unsigned variant) {
+    static const Color STRATA[][4] = {
+        { { 214, 160, 80, 255 }, { 186, 112, 44, 255 }, { 150, 74, 30, 255 }, { 112, 44, 24, 255 } },
+        { { 200, 170, 96, 255 }, { 168, 124, 60, 255 }, { 128, 92, 52, 255 }, { 92, 64, 50, 255 } },
+        { { 222, 140, 92, 255 }, { 184, 96, 64, 255 }, { 140, 64, 52, 255 }, { 96, 40, 44, 255 } },
+    };
+    const Color* palette = STRATA[variant % (sizeof(STRATA) / sizeof(STRATA[0]))];
+    SetRandomSeed(0x9E3779B9u * (variant + 1));
+
+    raylib::Image dirt(width, height, palette[0]);
+    for (int band = 1; band < 4; band++) {
+        int top = height * band / 4;
+        dirt.DrawRectangle(0, top, width, height - top, palette[band]);
+    }
+
+    // Generated patterns go on as alpha masks over a flat colour, tinted down to a wash
+    Rectangle all { 0, 0, (float)width, (float)height };
+    auto overlay = [&](const ::Image& pattern, Color color, unsigned char strength) {
+        raylib::Image layer(width, height, color);
+        layer.AlphaMask(pattern);
+        dirt.Draw(layer, all, all, Color{ 255, 255, 255, strength });
+    };
+    raylib::Image rock(raylib::Image::Cellular(width, height, 24 + (int)(variant % 3) * 8));
+    overlay(rock, Color{ 40, 24, 16, 255 }, 90);
+    raylib::Image light(raylib::Image::GradientLinear(width, height, 0, WHITE, BLACK));
+    overlay(light, WHITE, 40);
+    raylib::Image grain(raylib::Image::WhiteNoise(width, height, 0.5f));
+    overlay(grain, BLACK, 28);
+    return dirt;
+}
+
+class DirtBaker {
+public:
+    // Starts baking the first variant straight away
+    DirtBaker(int width, int height) : width(width), height(height), worker([this] { Run(); }) {}
+
+    ~DirtBaker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    DirtBaker(const DirtBaker&) = delete;
+    DirtBaker& operator=(const DirtBaker&) = delete;
+
+    // Moves the next finished backdrop into out and starts on the one after; false without
+    // waiting if it isn't done yet
+    bool Take(raylib::Image& out) {
+        if (!ready.load(std::memory_order_acquire)) return false;
+        out = std::move(result);
+        ready.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = true;
+        }
+        wake.notify_one();
+        return true;
+    }
+
+private:
+    int width, height;
+
+    // Written by the worker while !ready, moved out by the game thread once ready
+    raylib::Image result;
+    std::atomic<bool> ready{false};
+
+    std::mutex mutex; // Guards pending and stopping
+    std::condition_variable wake;
+    bool pending = true;
+    bool stopping = false;
+    std::thread worker; // Last, so it starts after everything it touches
+
+    void Run() {
+        MemoryScope scope(MemTag::ASSETS);
+        unsigned variant = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return pending || stopping; });
+            if (stopping) return;
+            pending = false;
+            lock.unlock();
+            result = BakeDirt(width, height, variant++);
+            ready.store(true, std::memory_order_release);
+            lock.lock();
+        }
+    }
+};
+
+#endif // DIGDUG_DIRTART_HPP_
@@ -0,0 +1,173 @@
+#ifndef DIGDUG_EFFECTS_HPP_
+#define DIGDUG_EFFECTS_HPP_
+
+#include <cstdint>
+
+#include "raylib.hpp"
+#include "Rng.hpp"
+#include "SpriteBatch.hpp"
+
+// ---------------------------------
+// EffectPool
+// ---------------------------------
+// Short-lived visuals that don't affect play: the red flash over a player that just died,
+// the sparks of a harpooned enemy and the crumbs off a freshly dug tile. They are spawned
+// from the tick's events, advanced once per simulation tick and drawn on their own sprite
+// layer in the same batch as everything else.
+//
+// Slots live in one fixed array and are recycled through a free list, so spawning never
+// allocates; when every slot is taken new effects are dropped and counted. Nothing here is
+// part of the simulation, so snapshots, replays and rollback never see it, and the pool's
+// own Rng only varies how the sparks fly.
+//
+// SetDensity() thins out the sparks and crumbs when frames run over budget; flashes, which
+// tell the player something, are always shown.
+enum class EffectKind : uint8_t { FLASH, SPARK, CRUMB };
+
+class EffectPool {
+public:
+    static constexpr int CAPACITY = 512;
+
+    EffectPool() { Clear(); }
+
+    // Frees every slot
+    void Clear() {
+        for (int i = 0; i < CAPACITY; i++) {
+            slots[i].life = 0;
+            slots[i].next = i + 1 < CAPACITY ? i + 1 : -1;
+        }
+        freeHead = 0;
+        active = 0;
+    }
+
+    // One effect; returns its slot, or -1 when the pool is full
+    int Spawn(EffectKind kind, float x, float y, float vx, float vy, float size, int life, Color color) {
+        if (freeHead < 0) {
+            dropped++;
+            return -1;
+        }
+        int index = freeHead;
+        Effect& e = slots[index];
+        freeHead = e.next;
+        e.kind = kind;
+        e.x = e.prevX = x;
+        e.y = e.prevY = y;
+        e.vx = vx;
+        e.vy = vy;
+        e.size = size;
+        e.age = 0;
+        e.life = (int16_t)(life > 0 ? life : 1);
+        e.color = color;
+        active++;
+        return index;
+    }
+
+    // A size x size body shown in color for ticks, where a player died
+    void Flash(float x, float y, float size, int ticks, Color color) {
+        Spawn(EffectKind::FLASH, x, y, 0.0f, 0.0f, size, ticks, color);
+    }
+
+    // Eight sparks flying out from (x, y), slowing as they go
+    void Sparks(float x, float y, Color color) {
+        static const float DIRS[8][2] = { { 1, 0 }, { 0.7f, 0.7f }, { 0, 1 }, { -0.7f, 0.7f },
+                                          { -1, 0 }, { -0.7f, -0.7f }, { 0, -1 }, { 0.7f, -0.7f } };
+        for (int i = 0; i < 8; i++) {
+            if (!Keep(i, 8)) continue;
+            const float* d = DIRS[i];
+            float speed = 1.5f + (float)rng.Below(100) * 0.015f;
+            Spawn(EffectKind::SPARK, x, y, d[0] * speed, d[1] * speed, 2.0f, 18 + (int)rng.Below(8), color);
+        }
+    }
+
+    // A few crumbs dropping out of the tile whose top-left corner is (x, y)
+    void Crumbs(float x, float y, float tileSize, Color color) {
+        for (int i = 0; i < 3; i++) {
+            if (!Keep(i, 3)) continue;
+            float cx = x + (float)rng.Below((uint32_t)tileSize);
+            float cy = y + (float)rng.Below((uint32_t)tileSize);
+            float vx = ((float)rng.Below(100) - 50.0f) * 0.01f;
+            Spawn(EffectKind::CRUMB, cx, cy, vx, -0.5f, 2.0f, 14 + (int)rng.Below(6), color);
+        }
+    }
+
+    // One simulation tick
+    void Update() {
+        for (int i = 0; i < CAPACITY; i++) {
+            Effect& e = slots[i];
+            if (e.life == 0) continue;
+            e.prevX = e.x;
+            e.prevY = e.y;
+            e.x += e.vx;
+            e.y += e.vy;
+            if (e.kind == EffectKind::SPARK) {
+                e.vx *= 0.9f;
+                e.vy *= 0.9f;
+            } else if (e.kind == EffectKind::CRUMB) {
+                e.vy += 0.15f;
+            }
+            if (++e.age >= e.life) Free(i);
+        }
+    }
+
+    // Adds every live effect to the batch, alpha of a tick past the latest update
+    void Draw(SpriteBatch& batch, float alpha) const {
+        for (int i = 0; i < CAPACITY; i++) {
+            const Effect& e = slots[i];
+            if (e.life == 0) continue;
+            float x = e.prevX + (e.x - e.prevX) * alpha;
+            float y = e.prevY + (e.y - e.prevY) * alpha;
+            Color tint = e.color;
+            if (e.kind == EffectKind::FLASH) {
+                batch.Add(SpriteBatch::EFFECTS, SpriteId::PLAYER, x, y, e.size, e.size, tint);
+                continue;
+            }
+            // Fade out over the second half of the effect's life
+            int half = e.life / 2;
+            if (e.age > half) tint.a = (unsigned char)(tint.a * (e.life - e.age) / (e.life - half));
+            batch.Add(SpriteBatch::EFFECTS, SpriteId::PIXEL, x - e.size / 2, y - e.size / 2, e.size, e.size, tint);
+        }
+    }
+
+    // Fraction of the sparks and crumbs spawned, 0 to 1
+    void SetDensity(float fraction) { density = fraction < 0.0f ? 0.0f : (fraction > 1.0f ? 1.0f : fraction); }
+    float Density() const { return density; }
+
+    int Active() const { return active; }
+    int Dropped() const { return dropped; }
+
+private:
+    struct Effect {
+        float x, y;
+        float prevX, prevY; // Position before the latest tick, for interpolation
+        float vx, vy;
+        float size;
+        int16_t age;
+        int16_t life;       // 0 while the slot is free
+        int next;           // Free-list link while the slot is free
+        Color color;
+        EffectKind kind;
+    };
+
+    Effect slots[CAPACITY];
+    int freeHead = 0;
+    int active = 0;
+    int dropped = 0;
+    float density = 1.0f;
+    Rng rng{ 0x5eed, 7 };
+
+    // Whether the i-th of n particles is spawned at the current density, spreading the ones
+    // kept evenly over the n
+    bool Keep(int i, int n) const {
+        int kept = (int)((float)n * density + 0.5f);
+        return (i * kept) / n != ((i + 1) * kept) / n;
+    }
+
+    void Free(int index) {
+        slots[index].life = 0;
+        slots[index].next = freeHead;
+        freeHead = index;
+        active--;
+    }
+};
+
+#endif // DIGDUG_EFFECTS_HPP_
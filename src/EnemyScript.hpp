@@ -0,0 +1,349 @@
+#ifndef DIGDUG_ENEMYSCRIPT_HPP_
+#define DIGDUG_ENEMYSCRIPT_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "RaylibCpp.hpp"
+#include "SpriteBatch.hpp"
+
+// ---------------------------------
+// Enemy kinds
+// ---------------------------------
+// Enemy kinds share one store; everything that differs between them comes from the world's
+// EnemyScript. MONSTER and DRAGON are always kinds 0 and 1 and a script can add more after
+// them, so a kind is any value below the script's Count(), not just the two named here.
+enum class EnemyKind : uint8_t { MONSTER, DRAGON };
+
+struct EnemyKindInfo {
+    float speed;      // Patrol speed inside the home tunnel
+    float chaseSpeed; // Default speed once the tunnel is activated (see Tuning)
+    int score;        // Awarded for a harpoon kill
+    Color color;
+    Color chaseColor;
+};
+
+// The built-in kinds' defaults
+static const EnemyKindInfo ENEMY_KINDS[] = {
+    { 0.5f, 1.2f, 100, RED,   MAROON },    // MONSTER
+    { 0.5f, 1.5f, 200, GREEN, DARKGREEN }, // DRAGON
+};
+
+// ---------------------------------
+// Enemy bytecode
+// ---------------------------------
+// Every kind carries two short programs of (opcode, argument) byte pairs ending in END, run
+// by World with a switch over the opcode, so a kind is a row of plain data rather than a class.
+//
+// The spawn program decides, tunnel by tunnel as a level is generated, whether the level
+// starts with one of the kind in that tunnel. Every condition has to hold; they are checked
+// in order and the first that fails stops the program, so rng is drawn exactly as far as
+// the conditions before each draw allow. Kinds spawn in kind order.
+enum class SpawnOp : uint8_t {
+    END,
+    NEVER,      // Fails: the kind only comes from level files and stress runs
+    COIN,       // One rng.Coin()
+    CHANCE,     // Holds with arg percent probability
+    EMPTY,      // No enemy of an earlier spawn in this tunnel yet
+    HORIZONTAL,
+    VERTICAL,
+    LONG,       // Tunnel at least arg tiles long
+};
+
+// The chase program picks a released enemy's next waypoint each time it decides. Moves end
+// the program; NEAR and FAR guard the one move after them, which is skipped unless the
+// player is within (NEAR) or beyond (FAR) arg tiles, counted along the axes. A program that
+// runs out of moves follows the flow field.
+enum class ChaseOp : uint8_t {
+    END,
+    FLOW,     // Next tile on the shortest dug path to the player, or straight at them off it
+    DIRECT,   // Straight at the player, through the dirt
+    FLEE,     // The neighbouring dug tile furthest along the dug paths from the player
+    NEAR,
+    FAR,
+};
+
+// ---------------------------------
+// EnemyScript
+// ---------------------------------
+// The enemy kinds a world spawns, compiled from text once at load time. A script starts out
+// as the built-in monster and dragon; a file then changes them or adds kinds, one section per
+// kind, "key = value" lines and # comments as in tuning files:
+//
+//   [ghost]                    # a new kind, starting as a copy of monster
+//   sprite = monster           # monster or dragon art
+//   color = 200 200 255        # r g b [a], while patrolling
+//   chase_color = 120 120 255  # once released
+//   speed = 0.5                # patrol pixels per tick
+//   chase_speed = 1.0          # set by the tuning file for monster and dragon instead
+//   score = 300
+//   spawn = vertical chance 25 # always | never | coin | chance P | empty | horizontal |
+//                              # vertical | long N
+//   chase = near 4 direct flow # flow | direct | flee | near N | far N
+//
+// The built-in kinds amount to
+//
+//   [monster]                  [dragon]
+//   spawn = coin               spawn = empty coin
+//   chase = flow               chase = flow
+//
+// Co-op peers must load the same script: it decides what both of them simulate.
+class EnemyScript {
+public:
+    static constexpr int MAX_KINDS = 16;
+    static constexpr int MAX_OPS = 8;                     // Per program, not counting END
+    static constexpr int PROGRAM_BYTES = 2 * (MAX_OPS + 1);
+    static constexpr int NAME_BYTES = 16;
+
+    struct Type {
+        char name[NAME_BYTES];
+        EnemyKindInfo info;
+        SpriteId sprite;
+        uint8_t spawn[PROGRAM_BYTES];
+        uint8_t chase[PROGRAM_BYTES];
+    };
+
+    EnemyScript() { Reset(); }
+
+    // Back to the built-in monster and dragon
+    void Reset() {
+        count = 0;
+        std::string unused;
+        AddType("monster", ENEMY_KINDS[0], SpriteId::MONSTER);
+        AddType("dragon", ENEMY_KINDS[1], SpriteId::DRAGON);
+        Assemble("coin", false, types[0].spawn, unused);
+        Assemble("empty coin", false, types[1].spawn, unused);
+    }
+
+    int Count() const { return count; }
+    const Type& Get(EnemyKind kind) const { return types[(int)kind]; }
+
+    // Applies text over the built-in kinds. On failure the script is unchanged and error names
+    // the first bad line.
+    bool Compile(const char* text, std::string& error) {
+        EnemyScript result;
+        Type* current = nullptr;
+        int lineNumber = 0;
+        for (const char* line = text; *line;) {
+            const char* end = strchr(line, '\n');
+            if (!end) end = line + strlen(line);
+            lineNumber++;
+            std::string content(line, end);
+            line = *end ? end + 1 : end;
+
+            size_t hash = content.find('#');
+            if (hash != std::string::npos) content.resize(hash);
+            content = Trim(content);
+            if (content.empty()) continue;
+            std::string problem;
+            if (content[0] == '[') {
+                current = content.back() == ']' ? result.Section(Trim(content.substr(1, content.size() - 2)), problem)
+                                                : nullptr;
+                if (!current && problem.empty()) problem = "bad section header";
+            } else if (!current) {
+                problem = "'" + content + "' is outside a [kind] section";
+            } else {
+                size_t eq = content.find('=');
+                std::string key = Trim(content.substr(0, eq));
+                std::string value = eq == std::string::npos ? std::string() : Trim(content.substr(eq + 1));
+                bool builtin = current < result.types + 2;
+                if (value.empty()) problem = "no value for '" + key + "'";
+                else result.Set(*current, key, value, builtin, problem);
+            }
+            if (!problem.empty()) {
+                error = "line " + std::to_string(lineNumber) + ": " + problem;
+                return false;
+            }
+        }
+        *this = result;
+        return true;
+    }
+
+    // The built-in kinds, for worlds not given a script of their own
+    static const EnemyScript& Builtin() {
+        static const EnemyScript script;
+        return script;
+    }
+
+private:
+    Type types[MAX_KINDS];
+    int count = 0;
+
+    static std::string Trim(const std::string& s) {
+        size_t a = s.find_first_not_of(" \t\r"), b = s.find_last_not_of(" \t\r");
+        return a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+    }
+
+    Type* AddType(const std::string& name, const EnemyKindInfo& info, SpriteId sprite) {
+        Type& t = types[count++];
+        std::memset(&t, 0, sizeof(t));
+        std::memcpy(t.name, name.c_str(), name.size()); // Checked to fit by the caller
+        t.info = info;
+        t.sprite = sprite;
+        t.spawn[0] = (uint8_t)SpawnOp::NEVER;
+        t.chase[0] = (uint8_t)ChaseOp::FLOW;
+        return &t;
+    }
+
+    // The kind named, added as a copy of monster the first time a name comes up
+    Type* Section(const std::string& name, std::string& problem) {
+        for (int k = 0; k < count; k++) {
+            if (name == types[k].name) return &types[k];
+        }
+        if (name.empty() || name.size() >= NAME_BYTES) {
+            problem = "kind names are 1 to " + std::to_string(NAME_BYTES - 1) + " characters";
+            return nullptr;
+        }
+        if (count == MAX_KINDS) {
+            problem = "more than " + std::to_string(MAX_KINDS) + " kinds";
+            return nullptr;
+        }
+        Type* t = AddType(name, types[0].info, types[0].sprite);
+        std::memcpy(t->spawn, types[0].spawn, PROGRAM_BYTES);
+        std::memcpy(t->chase, types[0].chase, PROGRAM_BYTES);
+        return t;
+    }
+
+    static bool ParseNumber(const std::string& text, float min, float max, float& out) {
+        char* end = nullptr;
+        out = strtof(text.c_str(), &end);
+        return end != text.c_str() && *end == '\0' && out >= min && out <= max;
+    }
+
+    // "r g b" or "r g b a", each 0 to 255
+    static bool ParseColor(const std::string& text, Color& out) {
+        int c[4] = { 0, 0, 0, 255 }, n = 0;
+        const char* p = text.c_str();
+        while (*p && n < 4) {
+            char* end = nullptr;
+            long v = strtol(p, &end, 10);
+            if (end == p || v < 0 || v > 255) return false;
+            c[n++] = (int)v;
+            p = end;
+            while (*p == ' ' || *p == '\t') p++;
+        }
+        if (*p || n < 3) return false;
+        out = Color{ (unsigned char)c[0], (unsigned char)c[1], (unsigned char)c[2], (unsigned char)c[3] };
+        return true;
+    }
+
+    static void Set(Type& t, const std::string& key, const std::string& value, bool builtin, std::string& problem) {
+        float number = 0.0f;
+        bool ok = true;
+        if (key == "sprite") {
+            ok = value == "monster" || value == "dragon";
+            t.sprite = value == "dragon" ? SpriteId::DRAGON : SpriteId::MONSTER;
+        } else if (key == "color") {
+            ok = ParseColor(value, t.info.color);
+        } else if (key == "chase_color") {
+            ok = ParseColor(value, t.info.chaseColor);
+        } else if (key == "speed") {
+            ok = ParseNumber(value, 0.0f, 8.0f, number);
+            t.info.speed = number;
+        } else if (key == "chase_speed") {
+            if (builtin) {
+                problem = std::string(t.name) + " takes its chase speed from " + t.name + "_chase in the tuning file";
+                return;
+            }
+            ok = ParseNumber(value, 0.1f, 8.0f, number);
+            t.info.chaseSpeed = number;
+        } else if (key == "score") {
+            ok = ParseNumber(value, 0.0f, 100000.0f, number);
+            t.info.score = (int)number;
+        } else if (key == "spawn" || key == "chase") {
+            std::string bad;
+            if (!Assemble(value, key == "chase", key == "chase" ? t.chase : t.spawn, bad)) {
+                problem = key + ": " + bad;
+                return;
+            }
+        } else {
+            problem = "unknown key '" + key + "'";
+            return;
+        }
+        if (!ok) problem = "bad value for " + key;
+    }
+
+    // Words into a spawn or chase program; out is left alone on failure
+    static bool Assemble(const std::string& words, bool chase, uint8_t* out, std::string& problem) {
+        struct Word {
+            const char* name;
+            uint8_t op;
+            int maxArg; // 0 for none
+        };
+        static const Word SPAWN_WORDS[] = {
+            { "never", (uint8_t)SpawnOp::NEVER, 0 },
+            { "coin", (uint8_t)SpawnOp::COIN, 0 },
+            { "chance", (uint8_t)SpawnOp::CHANCE, 100 },
+            { "empty", (uint8_t)SpawnOp::EMPTY, 0 },
+            { "horizontal", (uint8_t)SpawnOp::HORIZONTAL, 0 },
+            { "vertical", (uint8_t)SpawnOp::VERTICAL, 0 },
+            { "long", (uint8_t)SpawnOp::LONG, 255 },
+        };
+        static const Word CHASE_WORDS[] = {
+            { "flow", (uint8_t)ChaseOp::FLOW, 0 },
+            { "direct", (uint8_t)ChaseOp::DIRECT, 0 },
+            { "flee", (uint8_t)ChaseOp::FLEE, 0 },
+            { "near", (uint8_t)ChaseOp::NEAR, 255 },
+            { "far", (uint8_t)ChaseOp::FAR, 255 },
+        };
+        const Word* table = chase ? CHASE_WORDS : SPAWN_WORDS;
+        const size_t tableSize = chase ? sizeof(CHASE_WORDS) / sizeof(Word) : sizeof(SPAWN_WORDS) / sizeof(Word);
+
+        uint8_t code[PROGRAM_BYTES] = {};
+        int ops = 0;
+        bool guarded = false; // The last op was NEAR or FAR
+        const char* p = words.c_str();
+        for (;;) {
+            while (*p == ' ' || *p == '\t') p++;
+            if (!*p) break;
+            const char* start = p;
+            while (*p && *p != ' ' && *p != '\t') p++;
+            std::string word(start, p);
+            if (!chase && word == "always" && ops == 0) continue; // No conditions at all
+
+            const Word* match = nullptr;
+            for (size_t i = 0; i < tableSize; i++) {
+                if (word == table[i].name) match = &table[i];
+            }
+            if (!match) {
+                problem = "unknown word '" + word + "'";
+                return false;
+            }
+            int arg = 0;
+            if (match->maxArg > 0) {
+                while (*p == ' ' || *p == '\t') p++;
+                char* end = nullptr;
+                long v = strtol(p, &end, 10);
+                if (end == p || (*end && *end != ' ' && *end != '\t') || v < 0 || v > match->maxArg) {
+                    problem = word + " needs a number from 0 to " + std::to_string(match->maxArg);
+                    return false;
+                }
+                arg = (int)v;
+                p = end;
+            }
+            if (ops == MAX_OPS) {
+                problem = "more than " + std::to_string(MAX_OPS) + " words";
+                return false;
+            }
+            bool isGuard = chase && (match->op == (uint8_t)ChaseOp::NEAR || match->op == (uint8_t)ChaseOp::FAR);
+            if (guarded && isGuard) {
+                problem = word + " can't guard another near or far";
+                return false;
+            }
+            guarded = isGuard;
+            code[2 * ops] = match->op;
+            code[2 * ops + 1] = (uint8_t)arg;
+            ops++;
+        }
+        if (guarded) {
+            problem = "near and far need a move after them";
+            return false;
+        }
+        std::memcpy(out, code, PROGRAM_BYTES);
+        return true;
+    }
+};
+
+#endif // DIGDUG_ENEMYSCRIPT_HPP_
@@ -0,0 +1,103 @@
+#ifndef DIGDUG_EVENTS_HPP_
+#define DIGDUG_EVENTS_HPP_
+
+#include <cstdint>
+
+// ---------------------------------
+// Game events
+// ---------------------------------
+// What happened during a tick, for everything outside the simulation (HUD, sound, persistence,
+// analytics). The simulation pushes events as it changes state and the bus hands them to every
+// subscriber once the tick is over, so subscribers never see a half-updated world.
+enum class EventType : uint8_t {
+    SCORE,            // a: points added, b: new total
+    ENEMY_KILLED,     // a: EnemyKind, b: its colour (ColorToInt), x, y: its centre
+    FRUIT_COLLECTED,
+    TUNNEL_ACTIVATED, // a: tunnel index, b: enemies released
+    PLAYER_DIED,      // Once per player down; a: lives left, b: 1 for player, 2 for partner, x, y: their pos
+    LEVEL_STARTED,    // a: levelSerial
+    LEVEL_RESTARTED,  // Respawn: the level is back at its start, a: lives left
+    STATE_CHANGED,    // a: previous GameState, b: new GameState
+    GAME_ENDED,       // a: final score, b: GameState (GAMEOVER or WIN)
+    HARPOON_FIRED,    // a: 0 for player, 1 for partner
+    TILE_DUG,         // a: tile x, b: tile y
+};
+
+// Payloads are copied in when the event is pushed: by dispatch the world may have moved on (a
+// level's last kill is dispatched after the next level is in), so subscribers must not look
+// up what an event names in the live world.
+struct GameEvent {
+    EventType type;
+    int32_t a = 0;
+    int32_t b = 0;
+    float x = 0.0f, y = 0.0f; // Where it happened, for events that say so
+};
+
+// ---------------------------------
+// EventBus
+// ---------------------------------
+// Fixed-capacity ring plus a fixed subscriber table, so neither pushing nor dispatching ever
+// allocates. Pushing is a no-op while nobody subscribes, which keeps batch runs free of it.
+// Events pushed during dispatch are delivered in the same Dispatch call; if the ring fills up
+// the newest events are dropped and counted.
+class EventBus {
+public:
+    static constexpr int CAPACITY = 256; // Power of two
+    static constexpr int MAX_SUBSCRIBERS = 8;
+
+    // Plain function plus context pointer; captureless lambdas convert to this
+    using Handler = void (*)(void* context, const GameEvent& e);
+
+    // False when the table is full
+    bool Subscribe(Handler handler, void* context) {
+        if (subscriberCount == MAX_SUBSCRIBERS) return false;
+        subscribers[subscriberCount++] = { handler, context };
+        return true;
+    }
+
+    // While muted, pushes are dropped silently (rollback re-simulating ticks already reported)
+    void SetMuted(bool value) { muted = value; }
+
+    void Push(EventType type, int a = 0, int b = 0, float x = 0.0f, float y = 0.0f) {
+        Push(GameEvent{ type, a, b, x, y });
+    }
+
+    void Push(const GameEvent& e) {
+        if (subscriberCount == 0 || muted) return;
+        if (count == CAPACITY) {
+            dropped++;
+            return;
+        }
+        ring[(head + count) & (CAPACITY - 1)] = e;
+        count++;
+    }
+
+    // Delivers queued events in push order to each subscriber in subscription order
+    void Dispatch() {
+        while (count > 0) {
+            GameEvent e = ring[head];
+            head = (head + 1) & (CAPACITY - 1);
+            count--;
+            for (int s = 0; s < subscriberCount; s++) subscribers[s].handler(subscribers[s].context, e);
+        }
+    }
+
+    int Pending() const { return count; }
+    int Dropped() const { return dropped; }
+
+private:
+    struct Subscriber {
+        Handler handler;
+        void* context;
+    };
+
+    GameEvent ring[CAPACITY];
+    int head = 0;
+    int count = 0;
+    int dropped = 0;
+    Subscriber subscribers[MAX_SUBSCRIBERS];
+    int subscriberCount = 0;
+    bool muted = false;
+};
+
+#endif // DIGDUG_EVENTS_HPP_
@@ -0,0 +1,153 @@
+#ifndef DIGDUG_FLOWFIELD_HPP_
+#define DIGDUG_FLOWFIELD_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "TileBitset.hpp"
+
+// ---------------------------------
+// FlowField
+// ---------------------------------
+// Shortest paths from every passable tile to one goal tile, from a single breadth-first
+// search. Each tile stores its distance and the first step along a shortest path, so any
+// number of chasers can steer with one lookup each instead of searching on their own.
+//
+// Tiles are stamped with the search that wrote them instead of clearing the grid, so a
+// rebuild costs only the reachable region. Tiles that become passable later are patched in
+// with AddPassable, which only ever shortens paths and so touches just the tiles that improve.
+class FlowField {
+public:
+    static constexpr uint16_t UNREACHED = 0xFFFF;
+
+    enum Step : uint8_t { NONE, LEFT, RIGHT, UP, DOWN };
+
+    FlowField() = default;
+    FlowField(int width, int height) { Resize(width, height); }
+
+    void Resize(int width, int height) {
+        w = width;
+        h = height;
+        dist.assign((size_t)w * h, UNREACHED);
+        step.assign((size_t)w * h, NONE);
+        stamp.assign((size_t)w * h, 0);
+        generation = 0;
+        queue.reserve((size_t)w * h);
+        goalX = goalY = -1;
+    }
+
+    int Width() const { return w; }
+    int Height() const { return h; }
+    int GoalX() const { return goalX; }
+    int GoalY() const { return goalY; }
+
+    // Searches 4-connected tiles set in passable, starting from the goal (which counts as
+    // passable even if it isn't)
+    template <typename Bits>
+    void Build(const Bits& passable, int gx, int gy) {
+        if (++generation == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        goalX = gx;
+        goalY = gy;
+        if (!InBounds(gx, gy)) return;
+
+        queue.clear();
+        Write(Index(gx, gy), 0, NONE);
+        queue.push_back(Index(gx, gy));
+        Propagate(passable);
+    }
+
+    // Patches in a tile that has just become passable. Opening a tile can only shorten paths,
+    // so the tile takes its best neighbour's distance plus one and improvements spread out
+    // from there; tiles whose distance doesn't change are never visited.
+    template <typename Bits>
+    void AddPassable(const Bits& passable, int x, int y) {
+        if (!InBounds(x, y) || !InBounds(goalX, goalY)) return;
+        int i = Index(x, y);
+        uint16_t best = Dist(i);
+        Step via = NONE;
+        if (x > 0     && Dist(i - 1) < best - 1) { best = (uint16_t)(Dist(i - 1) + 1); via = LEFT; }
+        if (x < w - 1 && Dist(i + 1) < best - 1) { best = (uint16_t)(Dist(i + 1) + 1); via = RIGHT; }
+        if (y > 0     && Dist(i - w) < best - 1) { best = (uint16_t)(Dist(i - w) + 1); via = UP; }
+        if (y < h - 1 && Dist(i + w) < best - 1) { best = (uint16_t)(Dist(i + w) + 1); via = DOWN; }
+        if (via == NONE) return;
+
+        queue.clear();
+        Write(i, best, via);
+        queue.push_back(i);
+        Propagate(passable);
+    }
+
+    bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < w && y < h; }
+    uint16_t Distance(int x, int y) const { return Dist(Index(x, y)); }
+    Step StepAt(int x, int y) const {
+        int i = Index(x, y);
+        return stamp[i] == generation ? (Step)step[i] : NONE;
+    }
+
+    static int StepX(Step s) { return s == LEFT ? -1 : (s == RIGHT ? 1 : 0); }
+    static int StepY(Step s) { return s == UP ? -1 : (s == DOWN ? 1 : 0); }
+
+    // Snapshot fields (see Snapshot.hpp). A patched field can break distance ties differently
+    // from a fresh Build, so replays must restore it rather than rebuild it.
+    template <typename Archive, typename Self>
+    static void Transfer(Archive& a, Self& f) {
+        a.Pod(f.w);
+        a.Pod(f.h);
+        a.Pod(f.goalX);
+        a.Pod(f.goalY);
+        a.Pod(f.generation);
+        a.Vector(f.dist);
+        a.Vector(f.step);
+        a.Vector(f.stamp);
+    }
+
+private:
+    int w = 0;
+    int h = 0;
+    int goalX = -1;
+    int goalY = -1;
+    std::vector<uint16_t> dist;
+    std::vector<uint8_t> step;
+    std::vector<uint32_t> stamp; // dist/step are valid where stamp == generation
+    uint32_t generation = 0;
+    std::vector<int> queue;
+
+    int Index(int x, int y) const { return y * w + x; }
+
+    uint16_t Dist(int i) const { return stamp[i] == generation ? dist[i] : UNREACHED; }
+
+    void Write(int i, uint16_t d, Step s) {
+        stamp[i] = generation;
+        dist[i] = d;
+        step[i] = s;
+    }
+
+    // Breadth-first relaxation from the queued tiles, which must share one distance
+    template <typename Bits>
+    void Propagate(const Bits& passable) {
+        for (size_t head = 0; head < queue.size(); head++) {
+            int c = queue[head];
+            int cx = c % w, cy = c / w;
+            uint16_t next = (uint16_t)(dist[c] + 1);
+            // A neighbour reached from c steps back towards c
+            if (cx > 0)     Relax(passable, cx - 1, cy, next, RIGHT);
+            if (cx < w - 1) Relax(passable, cx + 1, cy, next, LEFT);
+            if (cy > 0)     Relax(passable, cx, cy - 1, next, DOWN);
+            if (cy < h - 1) Relax(passable, cx, cy + 1, next, UP);
+        }
+    }
+
+    template <typename Bits>
+    void Relax(const Bits& passable, int x, int y, uint16_t d, Step towardsParent) {
+        int i = Index(x, y);
+        if (Dist(i) <= d || !passable.Get(x, y)) return;
+        Write(i, d, towardsParent);
+        queue.push_back(i);
+    }
+};
+
+#endif // DIGDUG_FLOWFIELD_HPP_
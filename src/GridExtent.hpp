@@ -0,0 +1,69 @@
+#ifndef DIGDUG_GRIDEXTENT_HPP_
+#define DIGDUG_GRIDEXTENT_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------
+// Grid extents
+// ---------------------------------
+// The world and its tile containers are templates over one of these. FixedGrid makes the
+// width and height template arguments, so bounds checks and row strides fold to constants
+// and per-tile storage is a std::array inside the object; DynamicGrid carries them at run
+// time for maps sized at startup. Both answer the same calls, so one source serves both.
+//
+// TileArray<T> is per-tile storage and Words is TileBitset's storage (rows padded to whole
+// 64-bit words); AssignTiles fills either flavour.
+template <int W, int H>
+struct FixedGrid {
+    static constexpr bool FIXED = true;
+    static constexpr int WORDS_PER_ROW = (W + 63) / 64;
+
+    template <typename T>
+    using TileArray = std::array<T, (size_t)W * H>;
+    using Words = std::array<uint64_t, (size_t)WORDS_PER_ROW * H>;
+
+    FixedGrid() = default;
+    FixedGrid(int, int) {} // The size is the type; lets callers construct either kind alike
+
+    static constexpr int Width() { return W; }
+    static constexpr int Height() { return H; }
+    static constexpr int WordsPerRow() { return WORDS_PER_ROW; }
+    static constexpr size_t Tiles() { return (size_t)W * H; }
+
+    bool operator==(const FixedGrid&) const { return true; }
+    bool operator!=(const FixedGrid&) const { return false; }
+};
+
+struct DynamicGrid {
+    static constexpr bool FIXED = false;
+
+    template <typename T>
+    using TileArray = std::vector<T>;
+    using Words = std::vector<uint64_t>;
+
+    DynamicGrid() = default;
+    DynamicGrid(int width, int height) : w(width), h(height) {}
+
+    int Width() const { return w; }
+    int Height() const { return h; }
+    int WordsPerRow() const { return (w + 63) / 64; }
+    size_t Tiles() const { return (size_t)w * h; }
+
+    bool operator==(const DynamicGrid& o) const { return w == o.w && h == o.h; }
+    bool operator!=(const DynamicGrid& o) const { return !(*this == o); }
+
+private:
+    int w = 0;
+    int h = 0;
+};
+
+template <typename T, size_t N>
+inline void AssignTiles(std::array<T, N>& tiles, size_t, const T& value) { tiles.fill(value); }
+
+template <typename T>
+inline void AssignTiles(std::vector<T>& tiles, size_t count, const T& value) { tiles.assign(count, value); }
+
+#endif // DIGDUG_GRIDEXTENT_HPP_
@@ -0,0 +1,217 @@
+#ifndef DIGDUG_HIGHSCORES_HPP_
+#define DIGDUG_HIGHSCORES_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Snapshot.hpp"
+
+// ---------------------------------
+// Leaderboard
+// ---------------------------------
+// The best SIZE scores, highest first. Stored as a small binary file: a header followed by
+// the entries, written and read with the snapshot archives.
+struct ScoreEntry {
+    int32_t score = 0;
+    int32_t reserved = 0; // Keeps the layout free of padding
+    int64_t time = 0;     // Unix seconds when the game ended
+};
+
+class Leaderboard {
+public:
+    static constexpr int SIZE = 10;
+    static constexpr uint32_t MAGIC = 0x53484444; // "DDHS"
+    static constexpr uint32_t VERSION = 1;
+
+    int Count() const { return count; }
+    const ScoreEntry& operator[](int i) const { return entries[i]; }
+    int Best() const { return count > 0 ? entries[0].score : 0; }
+
+    // Rank the score landed at, or -1 if it didn't make the table. Ties keep the older entry first.
+    int Insert(int32_t score, int64_t time) {
+        int at = count;
+        while (at > 0 && entries[at - 1].score < score) at--;
+        if (at >= SIZE) return -1;
+        for (int i = (count < SIZE ? count : SIZE - 1); i > at; i--) entries[i] = entries[i - 1];
+        entries[at].score = score;
+        entries[at].time = time;
+        if (count < SIZE) count++;
+        return at;
+    }
+
+    void Encode(std::vector<uint8_t>& out) const {
+        SnapshotWriter writer(out);
+        uint32_t header[2] = { MAGIC, VERSION };
+        writer.Pod(header);
+        writer.Array(entries, (size_t)count);
+    }
+
+    bool Decode(const std::vector<uint8_t>& in) {
+        SnapshotReader reader(in);
+        uint32_t header[2] = {};
+        reader.Pod(header);
+        if (!reader.Ok() || header[0] != MAGIC || header[1] != VERSION) return false;
+        std::vector<ScoreEntry> stored;
+        reader.Vector(stored);
+        if (!reader.Ok() || !reader.AtEnd()) return false;
+        count = 0;
+        for (const ScoreEntry& e : stored) Insert(e.score, e.time);
+        return true;
+    }
+
+private:
+    ScoreEntry entries[SIZE];
+    int count = 0;
+};
+
+// ---------------------------------
+// HighScoreStore
+// ---------------------------------
+// Keeps the leaderboard on disk without blocking the game thread. Loading and saving both
+// happen on a background thread: Submit only updates the table in memory and wakes the writer,
+// and submissions that arrive while a write is in flight are coalesced into the next one.
+// Each write goes to path.tmp, is flushed to disk, then renamed over path, so a crash leaves
+// either the old file or the new one.
+class HighScoreStore {
+public:
+    // legacyPath is an old single-number text file, read only when path doesn't exist yet
+    explicit HighScoreStore(std::string path, std::string legacyPath = std::string())
+        : path(std::move(path)), legacyPath(std::move(legacyPath)), worker([this] { Run(); }) {}
+
+    ~HighScoreStore() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join(); // Pending scores are written before the thread exits
+    }
+
+    HighScoreStore(const HighScoreStore&) = delete;
+    HighScoreStore& operator=(const HighScoreStore&) = delete;
+
+    bool Loaded() const { return loaded.load(std::memory_order_acquire); }
+    int Best() const { return best.load(std::memory_order_relaxed); }
+
+    // Copy of the table, safe to call from any thread
+    Leaderboard Table() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return table;
+    }
+
+    // Records a finished game; returns its leaderboard rank or -1
+    int Submit(int score) {
+        int rank;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rank = table.Insert(score, (int64_t)time(nullptr));
+            if (rank < 0) return -1;
+            best.store(table.Best(), std::memory_order_relaxed);
+            dirty = true;
+        }
+        wake.notify_one();
+        return rank;
+    }
+
+private:
+    std::string path;
+    std::string legacyPath;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    Leaderboard table;
+    bool dirty = false;
+    bool stopping = false;
+    std::atomic<bool> loaded{false};
+    std::atomic<int> best{0};
+    std::thread worker; // Last, so it starts after everything it touches
+
+    void Run() {
+        Leaderboard stored = Load();
+        {
+            // Merge in case scores were submitted before the load finished
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int i = 0; i < table.Count(); i++) stored.Insert(table[i].score, table[i].time);
+            table = stored;
+            best.store(table.Best(), std::memory_order_relaxed);
+        }
+        loaded.store(true, std::memory_order_release);
+
+        std::vector<uint8_t> bytes;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return dirty || stopping; });
+            if (dirty) {
+                dirty = false;
+                table.Encode(bytes);
+                lock.unlock();
+                Write(bytes);
+                lock.lock();
+            } else if (stopping) {
+                return;
+            }
+        }
+    }
+
+    Leaderboard Load() const {
+        Leaderboard result;
+        std::vector<uint8_t> bytes;
+        if (ReadFile(path.c_str(), bytes)) {
+            result.Decode(bytes);
+        } else if (!legacyPath.empty()) {
+            FILE* file = fopen(legacyPath.c_str(), "r");
+            int score = 0;
+            if (file) {
+                if (fscanf(file, "%d", &score) == 1 && score > 0) result.Insert(score, 0);
+                fclose(file);
+            }
+        }
+        return result;
+    }
+
+    static bool ReadFile(const char* name, std::vector<uint8_t>& out) {
+        FILE* file = fopen(name, "rb");
+        if (!file) return false;
+        uint8_t chunk[512];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) out.insert(out.end(), chunk, chunk + n);
+        fclose(file);
+        return true;
+    }
+
+    bool Write(const std::vector<uint8_t>& bytes) const {
+        std::string tmp = path + ".tmp";
+        FILE* file = fopen(tmp.c_str(), "wb");
+        if (!file) return false;
+        bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && fflush(file) == 0;
+#if defined(_WIN32)
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        ok = fclose(file) == 0 && ok;
+        if (!ok) {
+            remove(tmp.c_str());
+            return false;
+        }
+#if defined(_WIN32)
+        // rename() won't replace an existing file on Windows
+        remove(path.c_str());
+#endif
+        return rename(tmp.c_str(), path.c_str()) == 0;
+    }
+};
+
+#endif // DIGDUG_HIGHSCORES_HPP_
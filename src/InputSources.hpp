@@ -0,0 +1,135 @@
+#ifndef DIGDUG_INPUTSOURCES_HPP_
+#define DIGDUG_INPUTSOURCES_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "World.hpp"
+
+// ---------------------------------
+// Input sources
+// ---------------------------------
+// Stand-ins for the keyboard when a World runs headless.
+//
+// A script is a list of "<ticks> <keys>" lines, keys drawn from L R U D (held), F (fire) and
+// C (confirm) or "." for none. F and C fire on the first tick of their line only.
+struct ScriptStep {
+    int ticks;
+    InputState input;
+};
+
+inline bool LoadScript(const char* path, std::vector<ScriptStep>& steps) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        ScriptStep step{};
+        std::string keys;
+        if (!(fields >> step.ticks)) continue;
+        fields >> keys;
+        for (char c : keys) {
+            switch (c) {
+                case 'L': step.input.left = true; break;
+                case 'R': step.input.right = true; break;
+                case 'U': step.input.up = true; break;
+                case 'D': step.input.down = true; break;
+                case 'F': step.input.fire = true; break;
+                case 'C': step.input.confirm = true; break;
+                default: break;
+            }
+        }
+        steps.push_back(step);
+    }
+    return true;
+}
+
+class ScriptPlayer {
+public:
+    explicit ScriptPlayer(const std::vector<ScriptStep>& steps) : steps(steps) {}
+
+    // Input for the next tick; idles once the script runs out
+    InputState Next() {
+        while (index < steps.size() && tick >= steps[index].ticks) { index++; tick = 0; }
+        if (index >= steps.size()) return InputState{};
+        InputState in = steps[index].input;
+        if (tick > 0) in.fire = in.confirm = false;
+        tick++;
+        return in;
+    }
+
+private:
+    const std::vector<ScriptStep>& steps;
+    size_t index = 0;
+    int tick = 0;
+};
+
+// Walks towards the nearest live enemy, lines up on one axis and fires when in range, with a
+// little noise so runs don't all play the same line.
+class Bot {
+public:
+    explicit Bot(uint32_t seed) : state(seed ? seed : 1u) {}
+
+    template <typename Grid>
+    InputState Next(const BasicWorld<Grid>& world) {
+        InputState in;
+        if (world.state != GameState::PLAYING) {
+            in.confirm = true;
+            return in;
+        }
+        if (world.Respawning()) return in;
+
+        const Player& p = world.player;
+        const EnemyStore& enemies = world.enemies;
+        int target = -1;
+        float best = 0.0f;
+        for (size_t i = 0; i < enemies.Size(); i++) {
+            if (!enemies.Alive(i)) continue;
+            float d = std::abs(enemies.x[i] - p.pos.x) + std::abs(enemies.y[i] - p.pos.y);
+            if (target < 0 || d < best) { target = (int)i; best = d; }
+        }
+        if (target < 0) return in;
+
+        if (NextRandom() % 16 == 0) wander = (int)(NextRandom() % 4) + 1;
+        if (wander > 0) {
+            in.left = wander == 1; in.right = wander == 2; in.up = wander == 3; in.down = wander == 4;
+            if (NextRandom() % 8 == 0) wander = 0;
+            return in;
+        }
+
+        float dx = enemies.x[target] - p.pos.x;
+        float dy = enemies.y[target] - p.pos.y;
+        const float reach = world.tuning.harpoonRange + p.size / 2.0f;
+        if (std::abs(dy) > 4.0f && std::abs(dx) > 4.0f) {
+            // Close the shorter gap first to get in line
+            if (std::abs(dy) < std::abs(dx)) { in.up = dy < 0; in.down = dy > 0; }
+            else { in.left = dx < 0; in.right = dx > 0; }
+        } else if (std::abs(dy) <= 4.0f) {
+            in.left = dx < 0; in.right = dx > 0;
+            if (std::abs(dx) < reach && !p.hasHarpoon) in.fire = true;
+        } else {
+            in.up = dy < 0; in.down = dy > 0;
+            if (std::abs(dy) < reach && !p.hasHarpoon) in.fire = true;
+        }
+        return in;
+    }
+
+private:
+    uint32_t state;
+    int wander = 0;
+
+    uint32_t NextRandom() {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+#endif // DIGDUG_INPUTSOURCES_HPP_
@@ -0,0 +1,180 @@
+#ifndef DIGDUG_JOBPOOL_HPP_
+#define DIGDUG_JOBPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------
+// JobPool
+// ---------------------------------
+// Fixed set of worker threads, each with its own job deque. A worker pops the newest job from
+// its own deque and, when that runs dry, steals the oldest job from another worker's, so long
+// and short jobs even out across cores without a single shared queue to fight over. Jobs
+// submitted from outside the pool are dealt round-robin; jobs submitted by a worker go to its
+// own deque.
+class JobPool {
+public:
+    explicit JobPool(unsigned threadCount = 0) {
+        if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+        // Every queue exists before any worker starts, since workers steal from all of them
+        for (unsigned i = 0; i < threadCount; i++) queues.emplace_back(new Queue());
+        workers.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; i++) workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    unsigned Size() const { return (unsigned)queues.size(); }
+
+    void Submit(std::function<void()> job) {
+        int self = WorkerIndex();
+        unsigned q = self >= 0 ? (unsigned)self : nextQueue++ % Size();
+        pending++;
+        {
+            std::lock_guard<std::mutex> lock(queues[q]->lock);
+            queues[q]->jobs.push_back(std::move(job));
+            queued++;
+        }
+        {
+            // Taking the lock orders this against a worker's check-then-sleep, so the
+            // notification can't slip in between and be lost
+            std::lock_guard<std::mutex> lock(sleepLock);
+        }
+        wake.notify_one();
+    }
+
+    // Blocks until every submitted job has finished; call from outside the pool
+    void Wait() {
+        std::unique_lock<std::mutex> lock(sleepLock);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+    // Calls fn(i) for i in [0, count) across the pool and waits for all of them
+    template <typename Fn>
+    void ParallelFor(size_t count, Fn fn) {
+        for (size_t i = 0; i < count; i++) Submit([fn, i] { fn(i); });
+        Wait();
+    }
+
+    // Splits [0, count) into ranges of grain items (the last may be shorter) and calls
+    // fn(begin, end) for each across the pool, running the first on the calling thread, then
+    // waits. The split depends only on count and grain, never on the thread count, so results
+    // that are merged per range come out the same everywhere. Call from outside the pool.
+    template <typename Fn>
+    void ParallelForRange(size_t count, size_t grain, Fn fn) {
+        if (grain == 0) grain = 1;
+        if (count <= grain) {
+            if (count > 0) fn((size_t)0, count);
+            return;
+        }
+        // Jobs hold just a pointer and an index, which std::function stores without allocating
+        struct Ranges {
+            Fn* fn;
+            size_t count, grain;
+            void Run(size_t r) const {
+                size_t begin = r * grain;
+                (*fn)(begin, begin + grain < count ? begin + grain : count);
+            }
+        } ranges{ &fn, count, grain };
+        const Ranges* shared = &ranges;
+        size_t rangeCount = (count + grain - 1) / grain;
+        for (size_t r = 1; r < rangeCount; r++) Submit([shared, r] { shared->Run(r); });
+        ranges.Run(0);
+        Wait();
+    }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepLock;
+    std::condition_variable wake; // Jobs queued or stopping
+    std::condition_variable idle; // pending reached zero
+    std::atomic<size_t> pending{0}; // Submitted and not yet finished
+    std::atomic<size_t> queued{0};  // Sitting in some deque
+    std::atomic<unsigned> nextQueue{0};
+    bool stopping = false;
+
+    struct WorkerSlot {
+        const JobPool* pool = nullptr;
+        int index = -1;
+    };
+
+    static WorkerSlot& CurrentWorker() {
+        static thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    // This thread's worker index in this pool, or -1 when called from outside it
+    int WorkerIndex() const {
+        const WorkerSlot& slot = CurrentWorker();
+        return slot.pool == this ? slot.index : -1;
+    }
+
+    bool TryPop(unsigned self, std::function<void()>& job) {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.lock);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+                queued--;
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < Size(); k++) {
+            Queue& victim = *queues[(self + k) % Size()];
+            std::lock_guard<std::mutex> lock(victim.lock);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop(unsigned self) {
+        CurrentWorker().pool = this;
+        CurrentWorker().index = (int)self;
+        std::function<void()> job;
+        while (true) {
+            if (TryPop(self, job)) {
+                job();
+                job = nullptr;
+                if (--pending == 0) {
+                    std::lock_guard<std::mutex> lock(sleepLock);
+                    idle.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepLock);
+            wake.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+        }
+    }
+};
+
+#endif // DIGDUG_JOBPOOL_HPP_
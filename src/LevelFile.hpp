@@ -0,0 +1,331 @@
+#ifndef DIGDUG_LEVELFILE_HPP_
+#define DIGDUG_LEVELFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "MappedFileData.hpp"
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------
+// Level files
+// ---------------------------------
+// An authored level as one flat, little-endian image that is used in place: a fixed header
+// of section offsets, then the dug bitmap in TileBitset's own word layout (rows padded to
+// 64-bit words), the tunnel table and the spawn table. Every section starts 8-byte aligned
+// and every record is fixed-size, so "loading" is bounds checks plus pointer arithmetic and
+// the bitmap goes into the world with one memcpy. Unlike snapshots the layout is spelled out
+// field by field and doesn't change with the build.
+namespace LevelFile {
+    const uint32_t MAGIC = 0x314c4444; // "DDL1"
+
+    struct Header {
+        uint32_t magic;
+        uint32_t size;          // Whole image, header included
+        uint16_t width, height; // Tiles
+        uint16_t tunnelCount, spawnCount;
+        uint32_t dugOffset;     // From the start of the image
+        uint32_t tunnelOffset;
+        uint32_t spawnOffset;
+        uint32_t reserved;
+    };
+
+    struct TunnelRecord {
+        uint16_t x, y;
+        uint16_t length;
+        uint8_t direction; // 0 horizontal, 1 vertical
+        uint8_t reserved;
+    };
+
+    struct SpawnRecord {
+        uint16_t x, y;   // Tile
+        uint16_t tunnel; // Home tunnel index
+        uint8_t kind;    // EnemyKind
+        uint8_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 32 && sizeof(TunnelRecord) == 8 && sizeof(SpawnRecord) == 8,
+                  "level file records are fixed-size");
+
+    inline size_t WordsPerRow(int width) { return (size_t)(width + 63) / 64; }
+    inline size_t Align8(size_t n) { return (n + 7) & ~(size_t)7; }
+}
+
+// Read-only view of a level image, pointing into the caller's bytes (which must stay alive
+// and be 8-byte aligned, as malloc and mmap both guarantee)
+class LevelView {
+public:
+    // Checks that the header and every section fit in size bytes; records are validated
+    // against the world when the level is loaded
+    bool Open(const void* image, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)image;
+        header = nullptr;
+        if (!bytes || ((uintptr_t)bytes & 7) != 0 || size < sizeof(LevelFile::Header)) return false;
+        const LevelFile::Header* h = (const LevelFile::Header*)bytes;
+        if (h->magic != LevelFile::MAGIC || h->size > size || h->width == 0 || h->height == 0) return false;
+        size_t dugBytes = LevelFile::WordsPerRow(h->width) * h->height * sizeof(uint64_t);
+        if (!Fits(*h, h->dugOffset, dugBytes)
+            || !Fits(*h, h->tunnelOffset, (size_t)h->tunnelCount * sizeof(LevelFile::TunnelRecord))
+            || !Fits(*h, h->spawnOffset, (size_t)h->spawnCount * sizeof(LevelFile::SpawnRecord)))
+            return false;
+        header = h;
+        base = bytes;
+        return true;
+    }
+
+    bool Valid() const { return header != nullptr; }
+    size_t Size() const { return header->size; }
+    int Width() const { return header->width; }
+    int Height() const { return header->height; }
+    int TunnelCount() const { return header->tunnelCount; }
+    int SpawnCount() const { return header->spawnCount; }
+
+    // Width() x Height() bits, rows padded to whole 64-bit words
+    const uint64_t* Dug() const { return (const uint64_t*)(base + header->dugOffset); }
+    size_t DugWords() const { return LevelFile::WordsPerRow(header->width) * header->height; }
+    const LevelFile::TunnelRecord* Tunnels() const { return (const LevelFile::TunnelRecord*)(base + header->tunnelOffset); }
+    const LevelFile::SpawnRecord* Spawns() const { return (const LevelFile::SpawnRecord*)(base + header->spawnOffset); }
+
+private:
+    const LevelFile::Header* header = nullptr;
+    const uint8_t* base = nullptr;
+
+    static bool Fits(const LevelFile::Header& h, uint32_t offset, size_t bytes) {
+        return (offset & 7) == 0 && offset >= sizeof(LevelFile::Header) && offset <= h.size && bytes <= h.size - offset;
+    }
+};
+
+// Assembles a level image; World::WriteLevel fills one from the current level
+class LevelWriter {
+public:
+    LevelWriter(int width, int height) : width(width), height(height),
+        dug(LevelFile::WordsPerRow(width) * height, 0) {}
+
+    uint64_t* DugWords() { return dug.data(); }
+
+    void AddTunnel(int x, int y, int length, bool vertical) {
+        tunnels.push_back(LevelFile::TunnelRecord{ (uint16_t)x, (uint16_t)y, (uint16_t)length, (uint8_t)(vertical ? 1 : 0), 0 });
+    }
+
+    void AddSpawn(int tileX, int tileY, int tunnel, int kind) {
+        spawns.push_back(LevelFile::SpawnRecord{ (uint16_t)tileX, (uint16_t)tileY, (uint16_t)tunnel, (uint8_t)kind, 0 });
+    }
+
+    // Appends the image to out at an 8-byte aligned offset (packs put levels back to back) and
+    // returns that offset
+    size_t Write(std::vector<uint8_t>& out) const {
+        using namespace LevelFile;
+        size_t start = Align8(out.size());
+        Header h{};
+        h.magic = MAGIC;
+        h.width = (uint16_t)width;
+        h.height = (uint16_t)height;
+        h.tunnelCount = (uint16_t)tunnels.size();
+        h.spawnCount = (uint16_t)spawns.size();
+        h.dugOffset = (uint32_t)sizeof(Header);
+        h.tunnelOffset = (uint32_t)(h.dugOffset + dug.size() * sizeof(uint64_t));
+        h.spawnOffset = (uint32_t)Align8(h.tunnelOffset + tunnels.size() * sizeof(TunnelRecord));
+        h.size = (uint32_t)Align8(h.spawnOffset + spawns.size() * sizeof(SpawnRecord));
+
+        out.resize(start + h.size, 0);
+        uint8_t* image = out.data() + start;
+        std::memcpy(image, &h, sizeof(h));
+        std::memcpy(image + h.dugOffset, dug.data(), dug.size() * sizeof(uint64_t));
+        if (!tunnels.empty()) std::memcpy(image + h.tunnelOffset, tunnels.data(), tunnels.size() * sizeof(TunnelRecord));
+        if (!spawns.empty()) std::memcpy(image + h.spawnOffset, spawns.data(), spawns.size() * sizeof(SpawnRecord));
+        return start;
+    }
+
+private:
+    int width, height;
+    std::vector<uint64_t> dug;
+    std::vector<LevelFile::TunnelRecord> tunnels;
+    std::vector<LevelFile::SpawnRecord> spawns;
+};
+
+// ---------------------------------
+// MappedFile
+// ---------------------------------
+// A whole file as read-only bytes, with control over which parts stay in memory.
+// raylib::MappedFileData maps it on POSIX, so opening is constant time and pages are read in
+// on first touch; on Windows it reads the whole file instead.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const char* path) { Open(path); }
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path) {
+        Close();
+        // Missing files are an expected answer here, not something for raylib to log
+        if (!::FileExists(path)) return false;
+        return file.Load(path);
+    }
+
+    void Close() { file.Unload(); }
+
+    const uint8_t* Data() const { return file.GetData(); }
+    size_t Size() const { return (size_t)file.GetSize(); }
+
+    // Starts reading a range in the background (kernel readahead), so touching it later
+    // doesn't block on the disk
+    void Prefetch(size_t offset, size_t length) const { Advise(offset, length, true); }
+
+    // Drops a range's pages from memory; they are read from the file again if touched
+    void Release(size_t offset, size_t length) const { Advise(offset, length, false); }
+
+private:
+    raylib::MappedFileData file;
+
+    void Advise(size_t offset, size_t length, bool willNeed) const {
+#if !defined(RAYLIB_CPP_MMAP)
+        (void)offset;
+        (void)length;
+        (void)willNeed; // The whole file is in memory already
+#else
+        const uint8_t* bytes = Data();
+        size_t size = Size();
+        // A file that was read rather than mapped is in memory already
+        if (!file.IsMapped() || offset >= size) return;
+        // Whole pages only: a partial page at either end may hold a neighbour's data
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t end = length < size - offset ? offset + length : size;
+        size_t begin = willNeed ? offset / page * page : (offset + page - 1) / page * page;
+        end = willNeed || end == size ? end : end / page * page;
+        if (end > begin) madvise((void*)(bytes + begin), end - begin, willNeed ? MADV_WILLNEED : MADV_DONTNEED);
+#endif
+    }
+};
+
+// ---------------------------------
+// LevelPack
+// ---------------------------------
+// Many levels in one file: a header, an index of (offset, size) per level, then the level
+// images back to back. Opening maps the file and checks the index fits; each level is only
+// checked when it is asked for, so a pack of thousands of levels opens in constant time.
+// The pack is read-only once open and can be shared by worlds on several threads.
+//
+// Levels are used in play order: the next PREFETCH levels are read ahead while one is
+// played and finished ones are dropped again, so only the levels around the current one
+// stay in memory however long the pack. A plain level file opens as a pack of one.
+namespace LevelFile {
+    const uint32_t PACK_MAGIC = 0x314b4444; // "DDK1"
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t count;
+        uint32_t indexOffset; // From the start of the file; PackEntry[count]
+        uint32_t reserved;
+    };
+
+    struct PackEntry {
+        uint64_t offset; // From the start of the file, 8-byte aligned
+        uint32_t size;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(PackHeader) == 16 && sizeof(PackEntry) == 16, "pack records are fixed-size");
+}
+
+class LevelPack {
+public:
+    static constexpr int PREFETCH = 3; // Levels read ahead of the current one
+
+    bool Open(const char* path) {
+        count = 0;
+        if (!file.Open(path) || file.Size() < sizeof(uint32_t)) return false;
+        uint32_t magic;
+        std::memcpy(&magic, file.Data(), sizeof(magic));
+        if (magic == LevelFile::MAGIC) {
+            LevelView level;
+            if (!level.Open(file.Data(), file.Size())) return false;
+            single = LevelFile::PackEntry{ 0, (uint32_t)level.Size(), 0 };
+            index = &single;
+            count = 1;
+            return true;
+        }
+        if (magic != LevelFile::PACK_MAGIC || file.Size() < sizeof(LevelFile::PackHeader)) return false;
+        const LevelFile::PackHeader* h = (const LevelFile::PackHeader*)file.Data();
+        if ((h->indexOffset & 7) != 0 || h->indexOffset < sizeof(LevelFile::PackHeader) || h->indexOffset > file.Size()
+            || (file.Size() - h->indexOffset) / sizeof(LevelFile::PackEntry) < h->count)
+            return false;
+        index = (const LevelFile::PackEntry*)(file.Data() + h->indexOffset);
+        count = (int)h->count;
+        return true;
+    }
+
+    int Count() const { return count; }
+
+    // False if level i is out of range or its image is damaged
+    bool Level(int i, LevelView& out) const {
+        if (i < 0 || i >= count) return false;
+        const LevelFile::PackEntry& e = index[i];
+        if (e.offset > file.Size() || e.size > file.Size() - e.offset) return false;
+        return out.Open(file.Data() + e.offset, e.size);
+    }
+
+    // Level current has just been loaded and the one before it finished
+    void Advance(int current) const {
+        if (count <= 1) return;
+        int previous = (current + count - 1) % count;
+        if (previous != current) Release(previous);
+        for (int k = 1; k <= PREFETCH && k < count; k++) {
+            const LevelFile::PackEntry& e = index[(current + k) % count];
+            file.Prefetch((size_t)e.offset, e.size);
+        }
+    }
+
+private:
+    MappedFile file;
+    const LevelFile::PackEntry* index = nullptr;
+    LevelFile::PackEntry single{};
+    int count = 0;
+
+    void Release(int i) const {
+        const LevelFile::PackEntry& e = index[i];
+        file.Release((size_t)e.offset, e.size);
+    }
+};
+
+// Collects level images (from World::WriteLevel) into a pack image
+class LevelPackWriter {
+public:
+    // Appends one level image
+    void Add(const std::vector<uint8_t>& level) {
+        size_t at = LevelFile::Align8(levels.size());
+        levels.resize(at, 0);
+        levels.insert(levels.end(), level.begin(), level.end());
+        entries.push_back(LevelFile::PackEntry{ at, (uint32_t)level.size(), 0 });
+    }
+
+    int Count() const { return (int)entries.size(); }
+
+    void Write(std::vector<uint8_t>& out) const {
+        using namespace LevelFile;
+        size_t indexBytes = entries.size() * sizeof(PackEntry);
+        size_t levelsAt = sizeof(PackHeader) + indexBytes; // Both multiples of 8
+        PackHeader h{ PACK_MAGIC, (uint32_t)entries.size(), (uint32_t)sizeof(PackHeader), 0 };
+        out.assign(levelsAt + levels.size(), 0);
+        std::memcpy(out.data(), &h, sizeof(h));
+        for (size_t i = 0; i < entries.size(); i++) {
+            PackEntry e = entries[i];
+            e.offset += levelsAt;
+            std::memcpy(out.data() + sizeof(PackHeader) + i * sizeof(PackEntry), &e, sizeof(e));
+        }
+        if (!levels.empty()) std::memcpy(out.data() + levelsAt, levels.data(), levels.size());
+    }
+
+private:
+    std::vector<uint8_t> levels; // Images packed from offset 0, each 8-byte aligned
+    std::vector<LevelFile::PackEntry> entries;
+};
+
+#endif // DIGDUG_LEVELFILE_HPP_
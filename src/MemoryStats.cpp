@@ -0,0 +1,37 @@
+#include "MemoryStats.hpp"
+
+// Out of line, and in a file of their own, so the compiler never sees through operator new
+// and delete to the malloc and header arithmetic underneath
+
+void* MemoryStats::Allocate(size_t size, MemTag tag) {
+    void* block = malloc(HEADER + size);
+    if (!block) return nullptr;
+    Header* header = (Header*)block;
+    header->size = size;
+    header->tag = tag;
+    Counter& c = counters[(int)tag];
+    size_t live = c.live.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    return (char*)block + HEADER;
+}
+
+void MemoryStats::Free(void* p) {
+    if (!p) return;
+    Header* header = (Header*)((char*)p - HEADER);
+    counters[(int)header->tag].live.fetch_sub(header->size, std::memory_order_relaxed);
+    free(header);
+}
+
+// ---------------------------------
+// Replacement operator new and delete
+// ---------------------------------
+// Every C++ allocation in a program linking this file goes through MemoryStats, charged to
+// the tag of the MemoryScope the allocating thread is in
+void* operator new(size_t size) {
+    if (void* p = MemoryStats::Allocate(size ? size : 1, MemoryStats::Current())) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { MemoryStats::Free(p); }
+void operator delete(void* p, size_t) noexcept { MemoryStats::Free(p); }
@@ -0,0 +1,150 @@
+#ifndef DIGDUG_MEMORYSTATS_HPP_
+#define DIGDUG_MEMORYSTATS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// ---------------------------------
+// MemoryStats
+// ---------------------------------
+// Heap use per subsystem: live bytes, the peak, allocation count and an optional budget for
+// each tag. Memory is charged to a tag in one of two ways:
+//  - TaggedAllocator<T, Tag> for a container that always belongs to one subsystem;
+//  - a MemoryScope, which makes everything the thread allocates until it ends count towards
+//    its tag. That only works in a program that routes operator new through Allocate(), which
+//    linking MemoryStats.cpp does (the game and the benchmarks); elsewhere scopes cost a
+//    thread-local store and count nothing.
+//
+// Each block carries its size and tag in a small header, so it is credited back to the right
+// tag whichever thread frees it. Only C++ allocations are seen: raylib's own malloc calls for
+// images, waves and models are not, which is what the asset loader's resident bytes and
+// raylib::GpuMemory are for.
+enum class MemTag : uint8_t { OTHER, WORLD, ASSETS, AUDIO, COUNT };
+
+class MemoryStats {
+public:
+    struct Usage {
+        size_t live = 0;
+        size_t peak = 0;
+        uint64_t allocations = 0; // Made so far, not live
+        size_t budget = 0;        // 0 for none
+    };
+
+    // size bytes charged to tag; nullptr if malloc fails. Out of line, in MemoryStats.cpp, so
+    // the header arithmetic is never inlined into new and delete expressions, where the
+    // compiler takes it for reads outside the object.
+    static void* Allocate(size_t size, MemTag tag);
+
+    // A block from Allocate(), or nullptr
+    static void Free(void* p);
+
+    // The tag this thread's untagged allocations go to
+    static MemTag Current() { return current; }
+
+    static Usage Get(MemTag tag) {
+        const Counter& c = counters[(int)tag];
+        Usage u;
+        u.live = c.live.load(std::memory_order_relaxed);
+        u.peak = c.peak.load(std::memory_order_relaxed);
+        u.allocations = c.allocations.load(std::memory_order_relaxed);
+        u.budget = c.budget.load(std::memory_order_relaxed);
+        return u;
+    }
+
+    static void SetBudget(MemTag tag, size_t bytes) {
+        counters[(int)tag].budget.store(bytes, std::memory_order_relaxed);
+    }
+
+    static bool OverBudget(MemTag tag) {
+        Usage u = Get(tag);
+        return u.budget > 0 && u.live > u.budget;
+    }
+
+    static const char* Name(MemTag tag) {
+        static const char* const NAMES[(int)MemTag::COUNT] = { "other", "world", "assets", "audio" };
+        return tag < MemTag::COUNT ? NAMES[(int)tag] : "?";
+    }
+
+private:
+    friend class MemoryScope;
+
+    struct Header {
+        size_t size;
+        MemTag tag;
+    };
+    // Keeps the block after it aligned as malloc's own
+    static constexpr size_t HEADER = alignof(std::max_align_t);
+    static_assert(sizeof(Header) <= HEADER, "MemoryStats header must fit in its alignment");
+
+    struct Counter {
+        std::atomic<size_t> live;
+        std::atomic<size_t> peak;
+        std::atomic<uint64_t> allocations;
+        std::atomic<size_t> budget;
+    };
+
+    // Zero-initialised before any dynamic initialiser runs, so allocations during static
+    // construction are counted too
+    static inline Counter counters[(int)MemTag::COUNT];
+    static inline thread_local MemTag current = MemTag::OTHER;
+};
+
+// ---------------------------------
+// MemoryScope
+// ---------------------------------
+// Charges this thread's allocations to tag until the scope ends or End() is called, then
+// restores whatever tag was in force before. Scopes nest.
+class MemoryScope {
+public:
+    explicit MemoryScope(MemTag tag) : previous(MemoryStats::current) { MemoryStats::current = tag; }
+    ~MemoryScope() { End(); }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+    void End() {
+        if (ended) return;
+        MemoryStats::current = previous;
+        ended = true;
+    }
+
+private:
+    MemTag previous;
+    bool ended = false;
+};
+
+// ---------------------------------
+// TaggedAllocator
+// ---------------------------------
+// STL allocator charging every block to Tag, whatever scope the container grows in
+template <typename T, MemTag Tag>
+struct TaggedAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "TaggedAllocator doesn't do over-aligned types");
+
+    using value_type = T;
+    template <typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() = default;
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        if (void* p = MemoryStats::Allocate(n * sizeof(T), Tag)) return (T*)p;
+        throw std::bad_alloc();
+    }
+    void deallocate(T* p, size_t) { MemoryStats::Free(p); }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+    template <typename U>
+    bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+};
+
+#endif // DIGDUG_MEMORYSTATS_HPP_
@@ -0,0 +1,230 @@
+#ifndef DIGDUG_MUSICSTREAM_HPP_
+#define DIGDUG_MUSICSTREAM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "MemoryStats.hpp"
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// SampleRing
+// ---------------------------------
+// Single-producer single-consumer ring of interleaved stereo 16-bit frames. Each side owns
+// one index and only reads the other's, so neither ever waits or locks.
+class SampleRing {
+public:
+    static constexpr uint32_t FRAMES = 1u << 14; // Power of two; ~370 ms at 44.1 kHz
+
+    uint32_t Readable() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+    uint32_t Writable() const {
+        return FRAMES - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+    }
+
+    // Producer: copies up to count frames in, returns how many fit
+    uint32_t Write(const int16_t* frames, uint32_t count) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t n = std::min(count, Writable());
+        for (uint32_t i = 0; i < n;) {
+            uint32_t at = (h + i) & (FRAMES - 1);
+            uint32_t run = std::min(n - i, FRAMES - at);
+            std::memcpy(&data[at * 2], frames + i * 2, run * 2 * sizeof(int16_t));
+            i += run;
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: copies up to count frames out, returns how many there were
+    uint32_t Read(int16_t* frames, uint32_t count) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t n = std::min(count, Readable());
+        for (uint32_t i = 0; i < n;) {
+            uint32_t at = (t + i) & (FRAMES - 1);
+            uint32_t run = std::min(n - i, FRAMES - at);
+            std::memcpy(frames + i * 2, &data[at * 2], run * 2 * sizeof(int16_t));
+            i += run;
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> head{0}; // Frames written, wrapping
+    alignas(64) std::atomic<uint32_t> tail{0}; // Frames read, wrapping
+    int16_t data[FRAMES * 2];
+};
+
+// ---------------------------------
+// ChipTune
+// ---------------------------------
+// The built-in loop when there is no music file: a triangle lead over a square bass,
+// 16 eighth notes to the bar.
+class ChipTune {
+public:
+    static constexpr int STEPS = 16;
+
+    explicit ChipTune(int sampleRate) : sampleRate(sampleRate), stepFrames(sampleRate * 60 / 140 / 2) {}
+
+    void Render(int16_t* out, uint32_t frames) {
+        static const int LEAD[STEPS] = { 72, 0, 76, 79, 77, 76, 74, 0, 71, 74, 72, 0, 67, 69, 71, 74 };
+        static const int BASS[STEPS / 4] = { 48, 53, 43, 47 };
+        for (uint32_t i = 0; i < frames; i++) {
+            if (left-- <= 0) {
+                leadHz = LEAD[step] ? NoteHz(LEAD[step]) : 0.0f;
+                bassHz = NoteHz(BASS[step / 4]);
+                left = stepFrames - 1;
+                step = (step + 1) % STEPS;
+            }
+            float envelope = (float)left / (float)stepFrames;
+            leadPhase = Advance(leadPhase, leadHz);
+            bassPhase = Advance(bassPhase, bassHz);
+            float lead = leadHz > 0.0f ? (4.0f * std::fabs(leadPhase - 0.5f) - 1.0f) * envelope : 0.0f;
+            float bass = bassPhase < 0.5f ? 1.0f : -1.0f;
+            out[i * 2] = (int16_t)((lead * 0.28f + bass * 0.10f) * 32767.0f);
+            out[i * 2 + 1] = (int16_t)((lead * 0.22f + bass * 0.14f) * 32767.0f);
+        }
+    }
+
+private:
+    int sampleRate;
+    int stepFrames;
+    int step = 0;
+    int left = 0;
+    float leadHz = 0.0f, bassHz = 0.0f;
+    float leadPhase = 0.0f, bassPhase = 0.0f;
+
+    static float NoteHz(int midi) { return 440.0f * std::pow(2.0f, (float)(midi - 69) / 12.0f); }
+
+    float Advance(float phase, float hz) const {
+        phase += hz / (float)sampleRate;
+        return phase >= 1.0f ? phase - 1.0f : phase;
+    }
+};
+
+// ---------------------------------
+// MusicStreamer
+// ---------------------------------
+// Background music that doesn't depend on the game loop. A feeder thread decodes the track
+// once, then loops it into a SampleRing a chunk at a time (or renders the ChipTune there),
+// and raylib's audio thread pulls from the ring in the stream's callback. A stalled frame
+// never starves the audio; if the feeder itself falls behind, the gap plays as silence and
+// is counted.
+//
+// raylib callbacks carry no user pointer, so only one streamer can be playing at a time.
+class MusicStreamer {
+public:
+    static constexpr int SAMPLE_RATE = 44100;
+    static constexpr uint32_t CHUNK = 1024; // Frames decoded per step
+    static constexpr int FEED_MS = 5;
+
+    // Plays path on a loop, or the built-in tune when it is empty or won't decode. Silent
+    // without an audio device.
+    explicit MusicStreamer(std::string path) : path(std::move(path)) {
+        if (!IsAudioDeviceReady() || active.load()) return;
+        stream.Load(SAMPLE_RATE, 16, 2);
+        active.store(this);
+        stream.SetCallback(&Pull);
+        worker = std::thread([this] { Run(); });
+        stream.Play();
+    }
+
+    ~MusicStreamer() {
+        if (!worker.joinable()) return;
+        // Once the stream is unloaded raylib's audio thread can't call Pull again
+        stream.Unload();
+        stream = ::AudioStream {};
+        active.store(nullptr);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    MusicStreamer(const MusicStreamer&) = delete;
+    MusicStreamer& operator=(const MusicStreamer&) = delete;
+
+    void SetVolume(float volume) {
+        if (worker.joinable()) stream.SetVolume(volume);
+    }
+
+    raylib::AudioStream& Stream() { return stream; }
+
+    // Frames the audio thread had to fill with silence
+    uint64_t Underruns() const { return underruns.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<MusicStreamer*> active{nullptr};
+
+    std::string path;
+    raylib::AudioStream stream;
+    SampleRing ring;
+    std::atomic<uint64_t> underruns{0};
+
+    std::mutex mutex; // Guards stopping
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread worker;
+
+    // raylib's audio thread
+    static void Pull(void* buffer, unsigned int frames) {
+        int16_t* out = (int16_t*)buffer;
+        MusicStreamer* self = active.load(std::memory_order_acquire);
+        uint32_t got = self ? self->ring.Read(out, frames) : 0;
+        if (got < frames) {
+            std::memset(out + got * 2, 0, (frames - got) * 2 * sizeof(int16_t));
+            if (self) self->underruns.fetch_add(frames - got, std::memory_order_relaxed);
+        }
+    }
+
+    void Run() {
+        MemoryScope scope(MemTag::AUDIO);
+        ::Wave track {};
+        if (!path.empty() && FileExists(path.c_str())) {
+            track = ::LoadWave(path.c_str());
+            if (::IsWaveValid(track)) ::WaveFormat(&track, SAMPLE_RATE, 16, 2);
+        }
+        bool fromFile = ::IsWaveValid(track) && track.frameCount > 0;
+        ChipTune tune(SAMPLE_RATE);
+        int16_t chunk[CHUNK * 2];
+        uint32_t position = 0; // Next frame of the track
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            lock.unlock();
+            while (ring.Writable() >= CHUNK) {
+                if (fromFile) {
+                    // Loops by wrapping mid-chunk
+                    const int16_t* samples = (const int16_t*)track.data;
+                    for (uint32_t i = 0; i < CHUNK;) {
+                        uint32_t run = std::min(CHUNK - i, track.frameCount - position);
+                        std::memcpy(chunk + i * 2, samples + (size_t)position * 2, run * 2 * sizeof(int16_t));
+                        i += run;
+                        position = (position + run) % track.frameCount;
+                    }
+                } else {
+                    tune.Render(chunk, CHUNK);
+                }
+                ring.Write(chunk, CHUNK);
+            }
+            lock.lock();
+            wake.wait_for(lock, std::chrono::milliseconds(FEED_MS), [this] { return stopping; });
+        }
+        lock.unlock();
+        if (track.data) ::UnloadWave(track);
+    }
+};
+
+#endif // DIGDUG_MUSICSTREAM_HPP_
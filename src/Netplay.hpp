@@ -0,0 +1,392 @@
+#ifndef DIGDUG_NETPLAY_HPP_
+#define DIGDUG_NETPLAY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+// Keep windows.h from declaring names raylib also uses (Rectangle, CloseWindow, DrawText, ...)
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "World.hpp"
+
+// ---------------------------------
+// Input bits
+// ---------------------------------
+// One tick of one player's input is six bits, which is all that ever goes over the wire.
+namespace InputBits {
+    enum : uint8_t { LEFT = 1, RIGHT = 2, UP = 4, DOWN = 8, FIRE = 16, CONFIRM = 32 };
+    const uint8_t HELD = LEFT | RIGHT | UP | DOWN;
+}
+
+inline uint8_t PackInput(const InputState& in) {
+    return (uint8_t)((in.left ? InputBits::LEFT : 0) | (in.right ? InputBits::RIGHT : 0) | (in.up ? InputBits::UP : 0)
+                     | (in.down ? InputBits::DOWN : 0) | (in.fire ? InputBits::FIRE : 0)
+                     | (in.confirm ? InputBits::CONFIRM : 0));
+}
+
+inline InputState UnpackInput(uint8_t bits) {
+    InputState in;
+    in.left = (bits & InputBits::LEFT) != 0;
+    in.right = (bits & InputBits::RIGHT) != 0;
+    in.up = (bits & InputBits::UP) != 0;
+    in.down = (bits & InputBits::DOWN) != 0;
+    in.fire = (bits & InputBits::FIRE) != 0;
+    in.confirm = (bits & InputBits::CONFIRM) != 0;
+    return in;
+}
+
+// Hash of the state both peers must agree on, for desync detection. Covers what play depends
+// on rather than snapshot bytes, since equivalent worlds can differ in scratch fields.
+inline uint32_t StateChecksum(const World& w) {
+    uint32_t h = 2166136261u; // FNV-1a
+    auto mix = [&h](const void* data, size_t size) {
+        const uint8_t* p = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++) h = (h ^ p[i]) * 16777619u;
+    };
+    const Player* players[2] = { &w.player, &w.partner };
+    for (const Player* p : players) {
+        mix(&p->pos, sizeof(p->pos));
+        mix(&p->alive, sizeof(p->alive));
+    }
+    mix(&w.player.lives, sizeof(int));
+    mix(&w.player.score, sizeof(int));
+    mix(&w.state, sizeof(w.state));
+    mix(&w.sequences, sizeof(w.sequences));
+    mix(&w.rng, sizeof(w.rng));
+    mix(w.enemies.x.data(), w.enemies.x.size() * sizeof(float));
+    mix(w.enemies.y.data(), w.enemies.y.size() * sizeof(float));
+    mix(w.enemies.flags.data(), w.enemies.flags.size());
+    return h;
+}
+
+// ---------------------------------
+// UdpSocket
+// ---------------------------------
+// Non-blocking IPv4 datagram socket talking to a single peer.
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket() { Close(); }
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Binds to port on every interface; 0 takes any free port
+    bool Open(uint16_t port) {
+        Close();
+#if defined(_WIN32)
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+        wsaStarted = true;
+#endif
+        handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (handle == INVALID_HANDLE) {
+            Close();
+            return false;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+#if defined(_WIN32)
+        u_long nonBlocking = 1;
+        bool ok = ioctlsocket(handle, FIONBIO, &nonBlocking) == 0;
+#else
+        bool ok = fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+        if (!ok || bind(handle, (const sockaddr*)&addr, sizeof(addr)) != 0) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close() {
+        if (handle != INVALID_HANDLE) {
+#if defined(_WIN32)
+            closesocket(handle);
+#else
+            close(handle);
+#endif
+            handle = INVALID_HANDLE;
+        }
+#if defined(_WIN32)
+        if (wsaStarted) WSACleanup();
+        wsaStarted = false;
+#endif
+        hasPeer = false;
+    }
+
+    bool IsOpen() const { return handle != INVALID_HANDLE; }
+
+    uint16_t LocalPort() const {
+        sockaddr_in addr{};
+        SockLen len = sizeof(addr);
+        if (getsockname(handle, (sockaddr*)&addr, &len) != 0) return 0;
+        return ntohs(addr.sin_port);
+    }
+
+    // Sends go to host (a name or dotted address) from now on
+    bool SetPeer(const char* host, uint16_t port) {
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* found = nullptr;
+        if (getaddrinfo(host, nullptr, &hints, &found) != 0 || !found) return false;
+        std::memcpy(&peer, found->ai_addr, sizeof(peer));
+        peer.sin_port = htons(port);
+        freeaddrinfo(found);
+        hasPeer = true;
+        return true;
+    }
+
+    bool HasPeer() const { return hasPeer; }
+
+    bool Send(const void* data, size_t size) {
+        if (!hasPeer) return false;
+        return sendto(handle, (const char*)data, (int)size, 0, (const sockaddr*)&peer, sizeof(peer)) == (int)size;
+    }
+
+    // Size of the next datagram from the peer, or -1 once none are waiting. Without a peer the
+    // first sender becomes it; anything from other addresses is dropped.
+    int Receive(void* data, size_t capacity) {
+        for (;;) {
+            sockaddr_in from{};
+            SockLen len = sizeof(from);
+            int n = (int)recvfrom(handle, (char*)data, (int)capacity, 0, (sockaddr*)&from, &len);
+            if (n < 0) return -1;
+            if (!hasPeer) {
+                peer = from;
+                hasPeer = true;
+            }
+            if (from.sin_addr.s_addr == peer.sin_addr.s_addr && from.sin_port == peer.sin_port) return n;
+        }
+    }
+
+private:
+#if defined(_WIN32)
+    using Handle = SOCKET;
+    using SockLen = int;
+    static constexpr Handle INVALID_HANDLE = INVALID_SOCKET;
+    bool wsaStarted = false;
+#else
+    using Handle = int;
+    using SockLen = socklen_t;
+    static constexpr Handle INVALID_HANDLE = -1;
+#endif
+    Handle handle = INVALID_HANDLE;
+    sockaddr_in peer{};
+    bool hasPeer = false;
+};
+
+// ---------------------------------
+// NetSession
+// ---------------------------------
+// Two-player co-op over UDP with rollback. Both peers run the same deterministic World; only
+// input crosses the network. Every tick each peer sends the inputs the other hasn't
+// acknowledged yet (a byte per tick, so lost packets are covered by the next one) and
+// carries on with a prediction of the peer's input: the held keys it last sent, with no
+// presses. World snapshots are kept for the last RING ticks; when a real input arrives that
+// differs from what was predicted, the world is loaded from the snapshot of that tick and the
+// ticks since are simulated again, with events muted since they were reported already.
+//
+// Local input is applied INPUT_DELAY ticks late, which hides that much latency outright, and
+// simulation never runs more than MAX_ROLLBACK ticks past the peer's newest input: beyond
+// that Tick stalls until the peer catches up. Peers must run the same build (the packet is a
+// plain struct).
+class NetSession {
+public:
+    static constexpr uint32_t MAGIC = 0x504e4444; // "DDNP"
+    static constexpr uint32_t INPUT_DELAY = 2;
+    static constexpr uint32_t MAX_ROLLBACK = 8;
+    static constexpr uint32_t RING = 32; // Power of two, above 2 * (INPUT_DELAY + MAX_ROLLBACK)
+
+    // Player 0 hosts and supplies the seed; player 1 connects and takes the seed from the
+    // host's first packet. The world is reset when the session starts and switched to co-op.
+    NetSession(World& world, UdpSocket& socket, int localIndex, uint64_t seed = 0)
+        : world(world), socket(socket), local(localIndex), remote(1 - localIndex), seed(seed) {
+        std::memset(inputs, 0, sizeof(inputs));
+        std::memset(used, 0, sizeof(used));
+        std::memset(checksums, 0, sizeof(checksums));
+        known[0] = known[1] = INPUT_DELAY; // The first ticks have no input on either side
+        if (local == 0) Start();
+    }
+
+    bool Started() const { return started; }
+    bool Desynced() const { return desynced; }
+    int LocalIndex() const { return local; }
+    uint32_t Frame() const { return frame; }            // Ticks simulated
+    uint32_t Confirmed() const { return known[remote]; } // Ticks of peer input received
+    int Rollbacks() const { return rollbacks; }
+    int ResimulatedTicks() const { return resimulated; }
+    int Stalls() const { return stalls; }
+    int TicksSinceHeard() const { return sinceHeard; }
+
+    // Runs one tick with this local input; false (nothing simulated, input not consumed)
+    // while waiting for the host or for the peer to catch up
+    bool Tick(const InputState& in) {
+        Poll();
+        sinceHeard++;
+        if (!started || frame >= known[remote] + MAX_ROLLBACK) {
+            if (started) stalls++;
+            Send();
+            return false;
+        }
+
+        inputs[local][(frame + INPUT_DELAY) % RING] = PackInput(in);
+        known[local] = frame + INPUT_DELAY + 1;
+        Simulate(frame);
+        frame++;
+        Send();
+        return true;
+    }
+
+    // Takes in waiting packets and rolls back if they contradict a prediction
+    void Poll() {
+        NetPacket packet;
+        int size;
+        while ((size = socket.Receive(&packet, sizeof(packet))) >= 0) {
+            if (size >= (int)offsetof(NetPacket, inputs) && packet.magic == MAGIC
+                && (size_t)size >= offsetof(NetPacket, inputs) + packet.count) {
+                Accept(packet);
+            }
+        }
+        if (rollbackFrom < frame) Rollback();
+    }
+
+private:
+    struct NetPacket {
+        uint32_t magic;
+        uint32_t seedLo, seedHi; // Host's level seed
+        uint32_t first;          // Tick of inputs[0]
+        uint32_t ack;            // Ticks of the receiver's input the sender has
+        uint32_t checkFrame;     // Tick whose start state checksum covers, confirmed on the sender
+        uint32_t checksum;
+        uint8_t count;
+        uint8_t inputs[RING];
+    };
+
+    static constexpr uint32_t NONE = 0xffffffffu;
+
+    World& world;
+    UdpSocket& socket;
+    int local, remote;
+    uint64_t seed;
+    bool started = false;
+    bool desynced = false;
+
+    uint32_t frame = 0;                 // Next tick to simulate
+    uint8_t inputs[2][RING];            // By player, then tick % RING
+    uint32_t known[2];                  // Ticks of each player's input known here
+    uint8_t used[RING];                 // Peer input each simulated tick used
+    std::vector<uint8_t> states[RING];  // World at the start of each simulated tick
+    uint32_t checksums[RING];           // StateChecksum of those states
+    uint32_t peerAck = 0;               // Ticks of our input the peer has
+    uint32_t rollbackFrom = NONE;       // Earliest mispredicted tick
+
+    int rollbacks = 0;
+    int resimulated = 0;
+    int stalls = 0;
+    int sinceHeard = 0;
+
+    void Start() {
+        started = true;
+        world.rng.Seed(seed);
+        world.ResetAll();
+        world.coop = true;
+    }
+
+    // What the peer pressed on tick f, or the prediction while it isn't known yet
+    uint8_t RemoteInput(uint32_t f) const {
+        if (f < known[remote]) return inputs[remote][f % RING];
+        return (uint8_t)(inputs[remote][(known[remote] - 1) % RING] & InputBits::HELD);
+    }
+
+    void Simulate(uint32_t f) {
+        world.SaveSnapshot(states[f % RING]);
+        checksums[f % RING] = StateChecksum(world);
+        used[f % RING] = RemoteInput(f);
+        uint8_t bits[2];
+        bits[local] = inputs[local][f % RING];
+        bits[remote] = used[f % RING];
+        world.Update(UnpackInput(bits[0]), UnpackInput(bits[1]));
+    }
+
+    void Rollback() {
+        world.events.SetMuted(true);
+        world.LoadSnapshot(states[rollbackFrom % RING]);
+        for (uint32_t f = rollbackFrom; f < frame; f++) Simulate(f);
+        world.events.SetMuted(false);
+        rollbacks++;
+        resimulated += (int)(frame - rollbackFrom);
+        rollbackFrom = NONE;
+    }
+
+    void Accept(const NetPacket& packet) {
+        sinceHeard = 0;
+        if (!started) {
+            if (local == 0) return;
+            seed = (uint64_t)packet.seedLo | ((uint64_t)packet.seedHi << 32);
+            Start();
+        }
+        if (packet.ack > peerAck) peerAck = packet.ack;
+
+        // Inputs arrive in order from the peer's last acknowledged tick; take the new ones
+        uint32_t end = packet.first + packet.count;
+        if (packet.first <= known[remote]) {
+            for (uint32_t f = known[remote]; f < end; f++) {
+                uint8_t bits = packet.inputs[f - packet.first];
+                inputs[remote][f % RING] = bits;
+                if (f < frame && bits != used[f % RING] && f < rollbackFrom) rollbackFrom = f;
+            }
+            if (end > known[remote]) known[remote] = end;
+        }
+
+        // Compare the peer's confirmed state with ours, if ours is confirmed too and still held
+        uint32_t f = packet.checkFrame;
+        if (f != NONE && f < frame && f + RING > frame && f <= known[remote] && f <= rollbackFrom
+            && checksums[f % RING] != packet.checksum)
+            desynced = true;
+    }
+
+    void Send() {
+        NetPacket packet;
+        packet.magic = MAGIC;
+        packet.seedLo = (uint32_t)seed;
+        packet.seedHi = (uint32_t)(seed >> 32);
+        uint32_t first = peerAck;
+        if (known[local] - first > RING) first = known[local] - RING;
+        packet.first = first;
+        packet.count = (uint8_t)(known[local] - first);
+        for (uint32_t f = first; f < known[local]; f++) packet.inputs[f - first] = inputs[local][f % RING];
+        packet.ack = known[remote];
+        // Newest tick whose start state no longer depends on a prediction
+        uint32_t confirmed = known[remote] < known[local] ? known[remote] : known[local];
+        if (confirmed > frame) confirmed = frame;
+        if (started && confirmed > 0 && confirmed - 1 < frame && frame - (confirmed - 1) < RING) {
+            packet.checkFrame = confirmed - 1;
+            packet.checksum = checksums[(confirmed - 1) % RING];
+        } else {
+            packet.checkFrame = NONE;
+            packet.checksum = 0;
+        }
+        socket.Send(&packet, offsetof(NetPacket, inputs) + packet.count);
+    }
+};
+
+#endif // DIGDUG_NETPLAY_HPP_
@@ -0,0 +1,356 @@
+#ifndef DIGDUG_PROFILER_HPP_
+#define DIGDUG_PROFILER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "FixedString.hpp"
+#include "raylib.hpp"
+
+#ifdef DIGDUG_TRACY
+#include <tracy/Tracy.hpp>
+#endif
+
+// ---------------------------------
+// Profiler
+// ---------------------------------
+// Scoped CPU timers grouped per frame. PROFILE_ZONE("name") times the rest of the enclosing
+// block; each zone's total for a frame goes into a ring buffer of the last HISTORY frames,
+// from which the overlay and CSV dump report min/avg/p99.
+//
+// Zones only record on a thread that has a Profiler installed with SetCurrent(), so shared
+// code such as World::Update can be instrumented and still run untimed on worker threads.
+// Define DIGDUG_NO_PROFILER to compile every zone out.
+//
+// A capture additionally keeps every zone instance and frame boundary so it can be written
+// out as Chrome trace JSON (chrome://tracing, Perfetto). Building with DIGDUG_TRACY also
+// forwards zones and frame marks to a connected Tracy client.
+//
+// The zones open at any moment are also kept as a stack another thread may read, which is
+// what StackSampler turns into flame graphs.
+class Profiler {
+public:
+    static constexpr int HISTORY = 240; // Frames kept (4 seconds at 60 fps)
+    static constexpr int MAX_ZONES = 32;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20; // Capture stops growing past this
+    static constexpr int MAX_DEPTH = 16; // Zones nested deeper still time, but aren't on the stack
+
+    struct Stats {
+        float lastMs = 0.0f;
+        float minMs = 0.0f;
+        float avgMs = 0.0f;
+        float p99Ms = 0.0f;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    bool overlayVisible = false;
+
+    // Id for a zone name, shared by every Profiler. Names must outlive the program (literals).
+    static int Zone(const char* name) {
+        std::lock_guard<std::mutex> lock(RegistryLock());
+        std::vector<const char*>& names = Names();
+        for (size_t i = 0; i < names.size(); i++) {
+            if (strcmp(names[i], name) == 0) return (int)i;
+        }
+        if ((int)names.size() >= MAX_ZONES) return -1;
+        names.push_back(name);
+        return (int)names.size() - 1;
+    }
+
+    // A zone's name, or null for an unknown id
+    static const char* ZoneName(int zone) {
+        std::lock_guard<std::mutex> lock(RegistryLock());
+        const std::vector<const char*>& names = Names();
+        return zone >= 0 && zone < (int)names.size() ? names[(size_t)zone] : nullptr;
+    }
+
+    static Profiler* Current() { return CurrentSlot(); }
+    static void SetCurrent(Profiler* profiler) { CurrentSlot() = profiler; }
+
+    void BeginFrame() {
+        std::fill(accum, accum + MAX_ZONES, 0);
+        frameStart = Clock::now();
+    }
+
+    void EndFrame() {
+        Clock::time_point frameEnd = Clock::now();
+        float* row = history[head];
+        for (int z = 0; z < MAX_ZONES; z++) row[z] = (float)(accum[z] / 1e6);
+        frameMs[head] = (float)(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        latencyMs[head] = inputMarked ? (float)(std::chrono::duration<double, std::milli>(frameEnd - inputTime).count()) : 0.0f;
+        inputMarked = false;
+        head = (head + 1) % HISTORY;
+        if (frames < HISTORY) frames++;
+        totalFrames++;
+        if (capturing) Record(FRAME_EVENT, frameStart, frameEnd);
+#ifdef DIGDUG_TRACY
+        FrameMark;
+#endif
+    }
+
+    void Add(int zone, Clock::time_point start, Clock::time_point end) {
+        if (zone < 0) return;
+        accum[zone] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        if (capturing) Record(zone, start, end);
+    }
+
+    // Puts a one-off span, such as a startup step or work another thread reported back, into
+    // the capture only. Track 0 is this thread's row; other tracks get rows of their own.
+    void AddSpan(const char* name, Clock::time_point start, Clock::time_point end, int track = 0) {
+        if (capturing) Record(FRAME_EVENT, start, end, name, track);
+    }
+
+    // Zone stack, kept by ProfileScope on the profiler's own thread
+    void Enter(int zone) {
+        int d = depth.load(std::memory_order_relaxed);
+        if (d < MAX_DEPTH) stack[d].store((int8_t)zone, std::memory_order_relaxed);
+        depth.store(d + 1, std::memory_order_release);
+    }
+    void Leave() { depth.store(depth.load(std::memory_order_relaxed) - 1, std::memory_order_release); }
+
+    // Copies the open zones, outermost first, from any thread and returns how many there are.
+    // The stack can change while this reads it, so a sample may mix two moments' zones; every
+    // entry is still a zone that was open at one of them.
+    int ReadStack(int* zones, int max) const {
+        int d = std::min(std::min(depth.load(std::memory_order_acquire), MAX_DEPTH), max);
+        for (int i = 0; i < d; i++) zones[i] = stack[i].load(std::memory_order_relaxed);
+        return d;
+    }
+
+    int Frames() const { return frames; }
+
+    // The latest frame's time and one zone's total within it; 0 before the first frame
+    float LastFrameMs() const { return frames > 0 ? frameMs[Slot(frames - 1)] : 0.0f; }
+    float LastZoneMs(int zone) const { return frames > 0 && zone >= 0 ? history[Slot(frames - 1)][zone] : 0.0f; }
+
+    // Input-to-present latency: mark when the frame samples input and call EndFrame right
+    // after presenting. Frames without a mark count as 0.
+    void MarkInput() {
+        inputTime = Clock::now();
+        inputMarked = true;
+    }
+
+    // -------------------------
+    // Trace capture
+    // -------------------------
+    bool Capturing() const { return capturing; }
+
+    void StartCapture() {
+        trace.clear();
+        captureStart = Clock::now();
+        capturing = true;
+    }
+
+    void StopCapture() { capturing = false; }
+
+    size_t CapturedEvents() const { return trace.size(); }
+
+    // Writes the capture as complete ("X") events, zones on the main thread's row with frames
+    // as their own row above the zones they enclose, and each span track on a row of its own
+    bool WriteChromeTrace(const char* path) const {
+        FILE* file = fopen(path, "w");
+        if (!file) return false;
+        std::vector<const char*> names = ZoneNames();
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}");
+        int tracks = 1;
+        for (const TraceEvent& e : trace) tracks = std::max(tracks, e.track + 1);
+        for (int t = 1; t < tracks; t++)
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"track %d\"}}",
+                    t + 1, t);
+        for (const TraceEvent& e : trace) {
+            const char* name = e.name ? e.name : e.zone == FRAME_EVENT ? "frame" : names[e.zone];
+            const char* category = e.name ? "span" : e.zone == FRAME_EVENT ? "frame" : "zone";
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    name, category, e.track + 1, e.startNs / 1e3, e.durationNs / 1e3);
+        }
+        fprintf(file, "\n]}\n");
+        fclose(file);
+        return true;
+    }
+
+    Stats ZoneStats(int zone) const {
+        std::vector<float> samples;
+        for (int f = 0; f < frames; f++) samples.push_back(history[Slot(f)][zone]);
+        return Summarize(samples);
+    }
+
+    Stats FrameStats() const {
+        std::vector<float> samples;
+        for (int f = 0; f < frames; f++) samples.push_back(frameMs[Slot(f)]);
+        return Summarize(samples);
+    }
+
+    Stats LatencyStats() const {
+        std::vector<float> samples;
+        for (int f = 0; f < frames; f++) samples.push_back(latencyMs[Slot(f)]);
+        return Summarize(samples);
+    }
+
+    // One row per buffered frame, oldest first; times in milliseconds
+    bool WriteCsv(const char* path) const {
+        FILE* file = fopen(path, "w");
+        if (!file) return false;
+        std::vector<const char*> names = ZoneNames();
+        fprintf(file, "frame,frame_ms,input_latency_ms");
+        for (const char* name : names) fprintf(file, ",%s", name);
+        fprintf(file, "\n");
+        for (int f = 0; f < frames; f++) {
+            int slot = Slot(f);
+            fprintf(file, "%lld,%.4f,%.4f", (long long)(totalFrames - frames + f), frameMs[slot], latencyMs[slot]);
+            for (size_t z = 0; z < names.size(); z++) fprintf(file, ",%.4f", history[slot][z]);
+            fprintf(file, "\n");
+        }
+        fclose(file);
+        return true;
+    }
+
+    // Draws the panel with its top-left at (x, y); returns its height, 0 while hidden
+    int DrawOverlay(int x, int y) const {
+        if (!overlayVisible) return 0;
+        std::vector<const char*> names = ZoneNames();
+        const int lineH = 14;
+        const int height = (int)(names.size() + 3) * lineH + 8;
+        DrawRectangle(x, y, 330, height, Fade(BLACK, 0.75f));
+        x += 6;
+        y += 4;
+        DrawText("zone              last   min   avg   p99 ms", x, y, 10, YELLOW);
+        y += lineH;
+        Stats frame = FrameStats();
+        DrawRow("frame", frame, x, y);
+        y += lineH;
+        DrawRow("input to present", LatencyStats(), x, y);
+        for (size_t z = 0; z < names.size(); z++) {
+            y += lineH;
+            DrawRow(names[z], ZoneStats((int)z), x, y);
+        }
+        return height;
+    }
+
+private:
+    static constexpr int FRAME_EVENT = -1;
+
+    struct TraceEvent {
+        int zone;            // FRAME_EVENT for a frame boundary or span
+        const char* name;    // A span's, null otherwise
+        int track;           // 0 unless a span's
+        uint64_t startNs;    // Since the capture started
+        uint64_t durationNs;
+    };
+
+    uint64_t accum[MAX_ZONES] = {};
+    float history[HISTORY][MAX_ZONES] = {};
+    float frameMs[HISTORY] = {};
+    float latencyMs[HISTORY] = {};
+    int head = 0;   // Next slot to write
+    int frames = 0; // Valid slots
+    long long totalFrames = 0;
+    Clock::time_point frameStart = Clock::now();
+    Clock::time_point inputTime;
+    bool inputMarked = false;
+    bool capturing = false;
+    Clock::time_point captureStart;
+    std::vector<TraceEvent> trace;
+    std::atomic<int> depth{ 0 };
+    std::atomic<int8_t> stack[MAX_DEPTH] = {}; // Zone ids fit: MAX_ZONES is 32
+
+    void Record(int zone, Clock::time_point start, Clock::time_point end, const char* name = nullptr, int track = 0) {
+        if (trace.size() >= MAX_TRACE_EVENTS || start < captureStart) return;
+        using std::chrono::duration_cast;
+        using std::chrono::nanoseconds;
+        trace.push_back({zone, name, track, (uint64_t)duration_cast<nanoseconds>(start - captureStart).count(),
+                         (uint64_t)duration_cast<nanoseconds>(end - start).count()});
+    }
+
+    static std::mutex& RegistryLock() {
+        static std::mutex lock;
+        return lock;
+    }
+    static std::vector<const char*>& Names() {
+        static std::vector<const char*> names;
+        return names;
+    }
+    static std::vector<const char*> ZoneNames() {
+        std::lock_guard<std::mutex> lock(RegistryLock());
+        return Names();
+    }
+    static Profiler*& CurrentSlot() {
+        static thread_local Profiler* current = nullptr;
+        return current;
+    }
+
+    // Ring slot of the f-th oldest buffered frame
+    int Slot(int f) const { return (head - frames + f + HISTORY) % HISTORY; }
+
+    static Stats Summarize(std::vector<float>& samples) {
+        Stats stats;
+        if (samples.empty()) return stats;
+        stats.lastMs = samples.back();
+        double sum = 0.0;
+        for (float s : samples) sum += s;
+        stats.avgMs = (float)(sum / (double)samples.size());
+        size_t p99 = (samples.size() * 99) / 100;
+        if (p99 >= samples.size()) p99 = samples.size() - 1;
+        std::nth_element(samples.begin(), samples.begin() + (long)p99, samples.end());
+        stats.p99Ms = samples[p99];
+        stats.minMs = *std::min_element(samples.begin(), samples.end());
+        return stats;
+    }
+
+    static void DrawRow(const char* name, const Stats& s, int x, int y) {
+        DrawText(name, x, y, 10, RAYWHITE);
+        raylib::FixedString<32> times;
+        times.Append(s.lastMs, 2, 6).Append(' ').Append(s.minMs, 2, 5).Append(' ').Append(s.avgMs, 2, 5);
+        DrawText(times.Append(' ').Append(s.p99Ms, 2, 5), x + 150, y, 10, RAYWHITE);
+    }
+};
+
+// Adds the lifetime of the scope to a zone of the current thread's profiler
+class ProfileScope {
+public:
+    explicit ProfileScope(int zone) : zone(zone), profiler(Profiler::Current()) {
+        if (!profiler) return;
+        profiler->Enter(zone);
+        start = Profiler::Clock::now();
+    }
+    ~ProfileScope() {
+        if (!profiler) return;
+        profiler->Add(zone, start, Profiler::Clock::now());
+        profiler->Leave();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int zone;
+    Profiler* profiler;
+    Profiler::Clock::time_point start;
+};
+
+#define DIGDUG_PROFILE_CONCAT_(a, b) a##b
+#define DIGDUG_PROFILE_CONCAT(a, b) DIGDUG_PROFILE_CONCAT_(a, b)
+
+#ifdef DIGDUG_TRACY
+#define DIGDUG_PROFILE_TRACY_(name) ZoneScopedN(name);
+#else
+#define DIGDUG_PROFILE_TRACY_(name)
+#endif
+
+#ifndef DIGDUG_NO_PROFILER
+#define PROFILE_ZONE(name)                                                                         \
+    DIGDUG_PROFILE_TRACY_(name)                                                                    \
+    static const int DIGDUG_PROFILE_CONCAT(profileZoneId_, __LINE__) = Profiler::Zone(name);        \
+    ProfileScope DIGDUG_PROFILE_CONCAT(profileZone_, __LINE__)(DIGDUG_PROFILE_CONCAT(profileZoneId_, __LINE__))
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+#endif // DIGDUG_PROFILER_HPP_
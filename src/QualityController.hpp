@@ -0,0 +1,110 @@
+#ifndef DIGDUG_QUALITYCONTROLLER_HPP_
+#define DIGDUG_QUALITYCONTROLLER_HPP_
+
+#include <algorithm>
+
+// ---------------------------------
+// QualityController
+// ---------------------------------
+// Sheds optional work while frames run over budget and brings it back once there is room
+// again. Each frame reports two times: the whole frame, and its work, which is the frame
+// less the time spent waiting on vsync and the pacer. Every WINDOW frames the controller
+// takes the p95 of both and moves at most one level:
+//  - down a level (more shedding) when the frame p95 is over budget by more than SLACK, so
+//    a few hitches a second, such as a level being generated, don't count;
+//  - up a level when the work p95 has stayed under RAISE_FRACTION of the budget for a run
+//    of windows. The run needed starts at MIN_HOLD and doubles whenever a level that was
+//    just restored has to be shed again, so a level that doesn't fit isn't retried every few
+//    seconds; it halves again once a restored level has held for STABLE_WINDOWS.
+//
+// Levels, from full quality:
+//   1  no bloom                 4  no sparks or crumbs
+//   2  no CRT filter            5  chasers rethink their path half as often
+//   3  half the sparks/crumbs   6  a quarter as often
+// The last two change the game itself, so co-op sessions, which must simulate alike on both
+// machines, cap the level at 4 with SetMaxLevel. Built with DIGDUG_NO_PROFILER, the waits
+// aren't timed, so the work never looks light enough to raise the level again.
+class QualityController {
+public:
+    static constexpr int MAX_LEVEL = 6;
+    static constexpr int WINDOW = 60;               // Frames per decision
+    static constexpr float SLACK = 1.1f;            // Frame p95 over budget * SLACK sheds a level
+    static constexpr float RAISE_FRACTION = 0.6f;   // Work p95 under budget * this may restore one
+    static constexpr int MIN_HOLD = 3;              // Windows of headroom before restoring a level
+    static constexpr int MAX_HOLD = 64;
+    static constexpr int QUICK_DROP = 5;            // A drop this soon after a raise doubles the hold
+    static constexpr int STABLE_WINDOWS = 30;       // A raise that lasts this long halves it
+
+    explicit QualityController(float budgetMs) : budget(budgetMs) {}
+
+    // One frame's times in milliseconds; returns whether the level changed
+    bool Sample(float frameMs, float workMs) {
+        frames[count] = frameMs;
+        work[count] = workMs;
+        if (++count < WINDOW) return false;
+        count = 0;
+        frameP95 = P95(frames);
+        workP95 = P95(work);
+        windowsSinceRaise++;
+        if (raiseStanding && windowsSinceRaise == STABLE_WINDOWS) hold = std::max(MIN_HOLD, hold / 2);
+
+        if (frameP95 > budget * SLACK) {
+            calm = 0;
+            if (level >= maxLevel) return false;
+            if (raiseStanding && windowsSinceRaise <= QUICK_DROP) hold = std::min(MAX_HOLD, hold * 2);
+            raiseStanding = false;
+            level++;
+            return true;
+        }
+        if (workP95 >= budget * RAISE_FRACTION || level == 0) {
+            calm = 0;
+            return false;
+        }
+        if (++calm < hold) return false;
+        calm = 0;
+        windowsSinceRaise = 0;
+        raiseStanding = true;
+        level--;
+        return true;
+    }
+
+    // Caps how far the controller sheds, shedding less at once if it is already past it
+    void SetMaxLevel(int max) {
+        maxLevel = std::max(0, std::min(MAX_LEVEL, max));
+        level = std::min(level, maxLevel);
+    }
+
+    int Level() const { return level; }
+    float Budget() const { return budget; }
+    // Of the latest window
+    float FrameP95() const { return frameP95; }
+    float WorkP95() const { return workP95; }
+
+    // What a level means for each kind of optional work
+    int ShedPasses() const { return std::min(level, 2); }  // For ArcadeFilter::Shed
+    float EffectDensity() const { return level >= 4 ? 0.0f : (level >= 3 ? 0.5f : 1.0f); }
+    int AiIntervalScale() const { return level >= 6 ? 4 : (level >= 5 ? 2 : 1); }
+
+private:
+    float budget;
+    int level = 0;
+    int maxLevel = MAX_LEVEL;
+    float frames[WINDOW] = {};
+    float work[WINDOW] = {};
+    int count = 0;
+    float frameP95 = 0.0f, workP95 = 0.0f;
+    int calm = 0;                         // Windows in a row with room to restore a level
+    int hold = MIN_HOLD;
+    int windowsSinceRaise = 0;
+    bool raiseStanding = false;           // No level shed since the latest restore
+
+    static float P95(const float (&samples)[WINDOW]) {
+        float sorted[WINDOW];
+        std::copy(samples, samples + WINDOW, sorted);
+        const int index = WINDOW * 95 / 100;
+        std::nth_element(sorted, sorted + index, sorted + WINDOW);
+        return sorted[index];
+    }
+};
+
+#endif // DIGDUG_QUALITYCONTROLLER_HPP_
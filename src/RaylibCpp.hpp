@@ -0,0 +1,20 @@
+#ifndef DIGDUG_RAYLIBCPP_HPP_
+#define DIGDUG_RAYLIBCPP_HPP_
+
+// ---------------------------------
+// raylib-cpp
+// ---------------------------------
+// Where the game gets raylib-cpp from. Normally that is the single-header build, which CMake
+// precompiles once for every target (DIGDUG_PCH), so an edited source doesn't parse it again.
+// Configured with DIGDUG_RAYLIB_MODULE the wrappers are imported from the module built out of
+// raylib-cpp/modules instead; raylib's C headers are still included for what a module can't
+// export, the colour macros and CLITERAL.
+#ifdef DIGDUG_RAYLIB_MODULE
+#include "raylib.hpp"
+#include "raymath.hpp"
+import raylib;
+#else
+#include "raylib-cpp.hpp"
+#endif
+
+#endif // DIGDUG_RAYLIBCPP_HPP_
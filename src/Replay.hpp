@@ -0,0 +1,148 @@
+#ifndef DIGDUG_REPLAY_HPP_
+#define DIGDUG_REPLAY_HPP_
+
+#include <cstdint>
+
+#include "RaylibCpp.hpp"
+#include "World.hpp"
+
+// ---------------------------------
+// Replays
+// ---------------------------------
+// A session is its level seed plus the input fed to every simulation tick, stored as a
+// raylib automation event list (.rae). Events are indexed by tick rather than by rendered
+// frame: raylib's own recorder samples per frame, and frames map onto ticks differently on
+// every run, so it can't reproduce a fixed-step simulation.
+//
+// Event types follow raylib's AutomationEventType numbering. The first event is a header
+// (EVENT_NONE carrying the seed) and the last marks the tick the recording stopped at.
+
+namespace ReplayEvent {
+    enum : unsigned int { NONE = 0, KEY_UP = 1, KEY_DOWN = 2, KEY_PRESSED = 3 };
+    const int VERSION = 1;
+    const int HEADER = 0x5244; // params[3] of the header event
+    const int END = 0x5245;    // params[3] of the closing event
+}
+
+// Held directions as (key, InputState member) pairs, in a fixed order
+struct ReplayKey {
+    int key;
+    bool InputState::*held;
+};
+
+const ReplayKey REPLAY_KEYS[] = {
+    { KEY_LEFT, &InputState::left }, { KEY_RIGHT, &InputState::right },
+    { KEY_UP, &InputState::up },     { KEY_DOWN, &InputState::down },
+};
+
+class ReplayRecorder {
+public:
+    // Starts a recording for a world seeded with seed
+    explicit ReplayRecorder(uint64_t seed) {
+        Push({ 0, ReplayEvent::NONE, { (int)(uint32_t)seed, (int)(uint32_t)(seed >> 32), ReplayEvent::VERSION, ReplayEvent::HEADER } });
+    }
+
+    // Call once per tick with the input about to be simulated
+    void Record(const InputState& in) {
+        for (const ReplayKey& k : REPLAY_KEYS) {
+            if (in.*k.held != held.*k.held) Push({ tick, in.*k.held ? ReplayEvent::KEY_DOWN : ReplayEvent::KEY_UP, { k.key, 0, 0, 0 } });
+        }
+        if (in.fire) Push({ tick, ReplayEvent::KEY_PRESSED, { KEY_SPACE, 0, 0, 0 } });
+        if (in.confirm) Push({ tick, ReplayEvent::KEY_PRESSED, { KEY_ENTER, 0, 0, 0 } });
+        held = in;
+        tick++;
+    }
+
+    // True once the event list filled up; ticks after that were not recorded
+    bool Truncated() const { return truncated; }
+    unsigned int Ticks() const { return tick; }
+
+    // Writes the events so far; recording can carry on afterwards
+    bool Export(const char* path) {
+        if (!events.IsValid()) return false; // raylib built without automation events
+        unsigned int end = truncated ? truncatedAt : tick;
+        events.events[events.count++] = { end, ReplayEvent::NONE, { 0, 0, 0, ReplayEvent::END } };
+        bool ok = events.Export(path);
+        events.count--;
+        return ok;
+    }
+
+private:
+    raylib::AutomationEventList events; // Fixed capacity, allocated by raylib
+    InputState held;
+    unsigned int tick = 0;
+    bool truncated = false;
+    unsigned int truncatedAt = 0;
+
+    void Push(const AutomationEvent& e) {
+        // Keep one slot free for the closing event
+        if (truncated) return;
+        if (events.GetCount() + 1 >= events.GetCapacity()) {
+            truncated = true;
+            truncatedAt = tick;
+            return;
+        }
+        events.events[events.count++] = e;
+    }
+};
+
+// Turns a recording back into one InputState per tick, like ScriptPlayer
+class ReplayPlayer {
+public:
+    // Throws raylib::RaylibException if the file can't be read
+    explicit ReplayPlayer(const char* path) : events(path) {
+        const AutomationEvent* e = events.GetEvents();
+        if (events.GetCount() >= 2 && e[0].type == ReplayEvent::NONE && e[0].params[3] == ReplayEvent::HEADER
+            && e[0].params[2] == ReplayEvent::VERSION) {
+            seed = (uint64_t)(uint32_t)e[0].params[0] | ((uint64_t)(uint32_t)e[0].params[1] << 32);
+            const AutomationEvent& last = e[events.GetCount() - 1];
+            if (last.type == ReplayEvent::NONE && last.params[3] == ReplayEvent::END) {
+                length = last.frame;
+                valid = true;
+            }
+        }
+        cursor = 1;
+    }
+
+    bool Valid() const { return valid; }
+    uint64_t Seed() const { return seed; }
+    unsigned int Length() const { return length; } // Recorded ticks
+    bool Done() const { return tick >= length; }
+
+    InputState Next() {
+        InputState in = held;
+        const AutomationEvent* e = events.GetEvents();
+        for (; cursor < events.GetCount() && e[cursor].frame == tick; cursor++) {
+            const AutomationEvent& ev = e[cursor];
+            if (ev.type == ReplayEvent::KEY_DOWN || ev.type == ReplayEvent::KEY_UP) {
+                for (const ReplayKey& k : REPLAY_KEYS) {
+                    if (k.key == ev.params[0]) in.*k.held = ev.type == ReplayEvent::KEY_DOWN;
+                }
+            } else if (ev.type == ReplayEvent::KEY_PRESSED) {
+                if (ev.params[0] == KEY_SPACE) in.fire = true;
+                if (ev.params[0] == KEY_ENTER) in.confirm = true;
+            }
+        }
+        held = in;
+        held.fire = held.confirm = false;
+        tick++;
+        return in;
+    }
+
+    // Seeds and resets a world the way the recorded session started
+    void Begin(World& world) const {
+        world.rng.Seed(seed);
+        world.ResetAll();
+    }
+
+private:
+    raylib::AutomationEventList events;
+    InputState held;
+    uint64_t seed = 0;
+    unsigned int length = 0;
+    unsigned int tick = 0;
+    unsigned int cursor = 0;
+    bool valid = false;
+};
+
+#endif // DIGDUG_REPLAY_HPP_
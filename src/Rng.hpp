@@ -0,0 +1,62 @@
+#ifndef DIGDUG_RNG_HPP_
+#define DIGDUG_RNG_HPP_
+
+#include <cstdint>
+
+// ---------------------------------
+// Rng
+// ---------------------------------
+// PCG32 (O'Neill, XSH-RR variant): 64-bit state, 32-bit output. Cheap enough to call per tile,
+// and small enough to live inside every World so parallel worlds never share state and a
+// level is reproducible from its seed alone.
+class Rng {
+public:
+    Rng() { Seed(0); }
+    explicit Rng(uint64_t seed, uint64_t stream = 0) { Seed(seed, stream); }
+
+    // Same (seed, stream) pair always gives the same sequence
+    void Seed(uint64_t seed, uint64_t stream = 0) {
+        state = 0;
+        inc = (stream << 1) | 1u;
+        Next();
+        state += seed;
+        Next();
+    }
+
+    uint32_t Next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rot = (uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform integer in [0, bound), without modulo bias (Lemire's multiply-shift)
+    uint32_t Below(uint32_t bound) {
+        uint64_t m = (uint64_t)Next() * bound;
+        uint32_t low = (uint32_t)m;
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = (uint64_t)Next() * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    // Uniform integer in [lo, hi]
+    int Range(int lo, int hi) { return lo + (int)Below((uint32_t)(hi - lo + 1)); }
+
+    bool Coin() { return (Next() >> 31) != 0; }
+
+    // Same position in the same sequence
+    bool operator==(const Rng& other) const { return state == other.state && inc == other.inc; }
+    bool operator!=(const Rng& other) const { return !(*this == other); }
+
+private:
+    uint64_t state = 0;
+    uint64_t inc = 1;
+};
+
+#endif // DIGDUG_RNG_HPP_
@@ -0,0 +1,162 @@
+#ifndef DIGDUG_SEQUENCER_HPP_
+#define DIGDUG_SEQUENCER_HPP_
+
+#include <cstdint>
+
+// ---------------------------------
+// Sequencer
+// ---------------------------------
+// Timed game-state sequences (the title screen, the respawn countdown, the game-over screen)
+// written as one function that waits for ticks or input, rather than a counter per sequence
+// that every tick decrements and tests. A running sequence is a pooled Slot: which sequence,
+// where it stopped and what it waits for. Run() costs one comparison on ticks before the
+// earliest wake-up, unless input arrives while a sequence waits for it, however many are
+// waiting.
+//
+// Sequences are stackless coroutines in the protothread style rather than C++20 ones: all of
+// a sequence's state is its slot and the whole sequencer is trivially copyable, so it goes
+// into snapshots and the netplay checksum with the rest of the world and a rolled-back world
+// resumes its sequences exactly. The price is that locals don't survive a wait; keep what must
+// outlive one in the slot's value, or in the host. A sequence belongs to the scope (the game
+// state) it was started in and is dropped once the host leaves it.
+//
+// The host's Step(Cursor&) runs the slot's sequence from where it stopped:
+//
+//   void Step(Sequencer::Cursor& s) {
+//       SEQUENCE_BEGIN(s);
+//       SEQUENCE_WAIT_TICKS(s, 60);
+//       ...one second later
+//       SEQUENCE_WAIT_CONFIRM(s);
+//       ...on the next tick with confirm held
+//       SEQUENCE_END(s);
+//   }
+class Sequencer {
+public:
+    static constexpr int SLOTS = 8;
+    static constexpr uint32_t ON_CONFIRM = 0xffffffffu; // Slot::wake for a sequence waiting for input
+
+    struct Slot {
+        uint8_t id;      // Host's sequence number
+        uint8_t scope;   // Dropped once Run is called with another
+        uint8_t active;
+        uint8_t pad;
+        uint32_t line;   // Where it resumes, 0 from the start; written by the SEQUENCE_ macros
+        uint32_t wake;   // Tick it resumes on, or ON_CONFIRM
+        int32_t value;   // Survives waits, for the sequence's own use
+    };
+
+    // What a step sees: its slot and the current tick
+    struct Cursor {
+        Slot& slot;
+        const uint32_t now;
+
+        // At least one tick, so a sequence never resumes on the tick it waited
+        void WaitTicks(int ticks) { slot.wake = now + (uint32_t)(ticks > 1 ? ticks : 1); }
+        void WaitConfirm() { slot.wake = ON_CONFIRM; }
+    };
+
+    // Starts id in scope, replacing it if it is running, and steps it up to its first wait
+    // straight away; false with every slot taken
+    template <typename Host>
+    bool Start(Host& host, uint8_t id, uint8_t scope, int32_t value = 0) {
+        Cancel(id);
+        for (int i = 0; i < SLOTS; i++) {
+            // Slots this Run is stepping stay out of reach, so a new sequence never takes over one of them
+            if (slots[i].active || (busy & (1u << i))) continue;
+            slots[i] = Slot{ id, scope, 1, 0, 0, now, value };
+            Cursor cursor{ slots[i], now };
+            host.Step(cursor);
+            Reschedule();
+            return true;
+        }
+        return false;
+    }
+
+    // Once per tick: drops sequences outside scope, then resumes those whose wait is over.
+    // Sequences started by the ones resumed wait for a later tick.
+    template <typename Host>
+    void Run(Host& host, uint8_t scope, bool confirm) {
+        now++;
+        if (scope != current) {
+            current = scope;
+            for (Slot& slot : slots) {
+                if (slot.scope != scope) slot.active = 0;
+            }
+            Reschedule();
+        }
+        if (now < nextWake && !(confirm && confirmWaiters > 0)) return;
+
+        for (int i = 0; i < SLOTS; i++) {
+            if (slots[i].active && Due(slots[i], confirm)) busy |= 1u << i;
+        }
+        for (int i = 0; i < SLOTS; i++) {
+            if (!(busy & (1u << i)) || !slots[i].active) continue;
+            Cursor cursor{ slots[i], now };
+            host.Step(cursor);
+        }
+        busy = 0;
+        Reschedule();
+    }
+
+    void Cancel(uint8_t id) {
+        int i = Find(id);
+        if (i < 0) return;
+        slots[i].active = 0;
+        Reschedule();
+    }
+
+    void Clear() {
+        for (Slot& slot : slots) slot.active = 0;
+        Reschedule();
+    }
+
+    bool Running(uint8_t id) const { return Find(id) >= 0; }
+
+    // Ticks until id resumes; 0 if it isn't running or waits for input
+    int TicksLeft(uint8_t id) const {
+        int i = Find(id);
+        return i >= 0 && slots[i].wake != ON_CONFIRM ? (int)(slots[i].wake - now) : 0;
+    }
+
+private:
+    uint32_t now = 0;                // Counts Run calls
+    uint32_t nextWake = ON_CONFIRM;  // Earliest timed wake-up
+    uint32_t busy = 0;               // Slots being stepped by Run, a bit each
+    uint8_t current = 0;             // Scope of the last Run
+    uint8_t confirmWaiters = 0;
+    uint8_t pad[2] = {};
+    Slot slots[SLOTS] = {};
+
+    bool Due(const Slot& slot, bool confirm) const {
+        return slot.wake == ON_CONFIRM ? confirm : slot.wake <= now;
+    }
+
+    // Index of id's slot, or -1 if it isn't running
+    int Find(uint8_t id) const {
+        for (int i = 0; i < SLOTS; i++) {
+            if (slots[i].active && slots[i].id == id) return i;
+        }
+        return -1;
+    }
+
+    void Reschedule() {
+        nextWake = ON_CONFIRM;
+        confirmWaiters = 0;
+        for (const Slot& slot : slots) {
+            if (!slot.active) continue;
+            if (slot.wake == ON_CONFIRM) confirmWaiters++;
+            else if (slot.wake < nextWake) nextWake = slot.wake;
+        }
+    }
+};
+
+// Resumable-function scaffolding for a host's Step; see Sequencer. Nothing declared between
+// SEQUENCE_BEGIN and SEQUENCE_END may be initialised across a wait.
+#define SEQUENCE_BEGIN(cursor) switch ((cursor).slot.line) { case 0:
+#define SEQUENCE_WAIT_TICKS(cursor, ticks) \
+    do { (cursor).WaitTicks(ticks); (cursor).slot.line = __LINE__; return; case __LINE__:; } while (0)
+#define SEQUENCE_WAIT_CONFIRM(cursor) \
+    do { (cursor).WaitConfirm(); (cursor).slot.line = __LINE__; return; case __LINE__:; } while (0)
+#define SEQUENCE_END(cursor) } (cursor).slot.active = 0
+
+#endif // DIGDUG_SEQUENCER_HPP_
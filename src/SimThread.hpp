@@ -0,0 +1,188 @@
+#ifndef DIGDUG_SIMTHREAD_HPP_
+#define DIGDUG_SIMTHREAD_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "World.hpp"
+
+// ---------------------------------
+// TripleBuffer
+// ---------------------------------
+// One writer and one reader handing whole values across threads without either waiting on the
+// other. The writer fills Back() and publishes it; the reader takes the newest published value
+// with Acquire() and keeps it as Front() for as long as it likes. The third slot sits between
+// them, so a publish never touches what the reader holds and a slow reader just skips values.
+template <typename T>
+class TripleBuffer {
+public:
+    T& Back() { return slots[back]; }
+    T& Front() { return slots[front]; }
+
+    // Hands Back() to the reader and gives the writer a new one. Returns whether the value
+    // published before this one was acquired; if not, it is lost and Back() now holds it.
+    bool Publish() {
+        uint8_t previous = middle.exchange((uint8_t)(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX;
+        return (previous & FRESH) == 0;
+    }
+
+    // Moves to the newest published value, if there is one since the last call
+    bool Acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+private:
+    static constexpr uint8_t INDEX = 3;
+    static constexpr uint8_t FRESH = 4; // Set on the middle slot from a publish until it is acquired
+
+    T slots[3];
+    uint8_t back = 0;              // Writer's
+    uint8_t front = 1;             // Reader's
+    std::atomic<uint8_t> middle{ 2 };
+};
+
+// ---------------------------------
+// SimThread
+// ---------------------------------
+// Runs the fixed-timestep simulation on its own thread and publishes what the renderer needs
+// after each batch of ticks, so a slow frame doesn't hold up the simulation and a slow tick
+// doesn't hold up drawing. The main thread keeps the window and GL context and only ever reads
+// frames; the sim thread is the only one touching the live world.
+//
+// A frame is a full copy of the world (copy-assigned into the same slot, so it stops
+// allocating once warm), the tick it was taken after, and what happened since the renderer's
+// last frame: the dug tiles, in the copy's dirtyTiles, and the ticks' events. Frames the
+// renderer skips would drop those, so they are carried into the next frame until a publish
+// reports its predecessor was seen; the renderer may see some twice, so events carry a
+// sequence number to skip repeats, and repainting a dug tile is harmless.
+struct SimEvent {
+    uint64_t seq; // Counts from 1
+    GameEvent event;
+};
+
+struct RenderFrame {
+    World world;
+    uint64_t tick = 0;       // Ticks run before this frame; 0 until the first publish
+    double tickTime = 0.0;   // SimThread::Now() at which the latest tick was due
+    std::vector<SimEvent> events;
+
+    // Pushes the events after delivered onto bus, dispatching as it goes so none overflow it
+    void Deliver(EventBus& bus, uint64_t& delivered) const {
+        for (const SimEvent& e : events) {
+            if (e.seq <= delivered) continue;
+            delivered = e.seq;
+            bus.Push(e.event);
+            if (bus.Pending() == EventBus::CAPACITY) bus.Dispatch();
+        }
+        bus.Dispatch();
+    }
+};
+
+class SimThread {
+public:
+    // Called on the sim thread once per tick with the Now() the tick was due at; it gathers the
+    // tick's input and runs world.Update
+    using TickFn = std::function<void(double due)>;
+
+    SimThread(World& world, int maxTicksPerBatch, TickFn tick)
+        : world(world), maxTicks(maxTicksPerBatch), tick(std::move(tick)), start(Clock::now()) {
+        world.events.Subscribe([](void* self, const GameEvent& e) {
+            SimThread& sim = *(SimThread*)self;
+            sim.pendingEvents.push_back(SimEvent{ ++sim.eventSeq, e });
+        }, this);
+        Publish(start); // So there is a frame to draw before the first tick
+        thread = std::thread([this] { Loop(); });
+    }
+
+    ~SimThread() {
+        stopping = true;
+        thread.join();
+    }
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    // Main thread: switches to the newest frame, if one was published since the last call.
+    // Frame() stays valid and unchanged until the next Acquire.
+    bool Acquire() { return frames.Acquire(); }
+    RenderFrame& Frame() { return frames.Front(); }
+
+    // Seconds since the thread started, on the clock RenderFrame::tickTime uses
+    double Now() const { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    World& world;
+    int maxTicks;
+    TickFn tick;
+    Clock::time_point start;
+    std::thread thread;
+    std::atomic<bool> stopping{ false };
+
+    TripleBuffer<RenderFrame> frames;
+    // Sim thread's, carried until seen; the leading sent* entries were in the latest frame
+    std::vector<int> pendingTiles;
+    std::vector<SimEvent> pendingEvents;
+    size_t sentTiles = 0, sentEvents = 0;
+    int tilesSerial = -1; // Level the pending tiles belong to
+    uint64_t eventSeq = 0;
+    uint64_t ticks = 0;
+
+    void Loop() {
+        MemoryScope scope(MemTag::WORLD);
+        const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(SIM_DT));
+        Clock::time_point due = start;
+        while (!stopping) {
+            int ran = 0;
+            while (Clock::now() >= due && ran < maxTicks) {
+                tick(std::chrono::duration<double>(due - start).count());
+                ticks++;
+                ran++;
+                due += step;
+            }
+            // Drop sim time after a long hitch instead of spiralling
+            if (ran == maxTicks && Clock::now() >= due) due = Clock::now();
+            if (ran > 0) Publish(due - step);
+            std::this_thread::sleep_until(due);
+        }
+    }
+
+    void Publish(Clock::time_point tickDue) {
+        // A new level's terrain is redrawn whole, so older tiles would only paint over it
+        if (world.levelSerial != tilesSerial) {
+            tilesSerial = world.levelSerial;
+            pendingTiles.clear();
+            sentTiles = 0;
+        }
+        pendingTiles.insert(pendingTiles.end(), world.dirtyTiles.begin(), world.dirtyTiles.end());
+        world.dirtyTiles.clear();
+
+        RenderFrame& frame = frames.Back();
+        frame.world = world;
+        frame.world.dirtyTiles = pendingTiles;
+        frame.tick = ticks;
+        frame.tickTime = std::chrono::duration<double>(tickDue - start).count();
+        frame.events = pendingEvents;
+        bool seen = frames.Publish();
+        Settle(pendingTiles, sentTiles, seen);
+        Settle(pendingEvents, sentEvents, seen);
+    }
+
+    // With the frame before the one just published seen, only the new entries can still be
+    // missed; otherwise everything published so far rides along in the next frame too
+    template <typename T>
+    static void Settle(std::vector<T>& pending, size_t& sent, bool previousSeen) {
+        if (previousSeen) pending.erase(pending.begin(), pending.begin() + (ptrdiff_t)sent);
+        sent = pending.size();
+    }
+};
+
+#endif // DIGDUG_SIMTHREAD_HPP_
@@ -0,0 +1,105 @@
+#ifndef DIGDUG_SNAPSHOT_HPP_
+#define DIGDUG_SNAPSHOT_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// ---------------------------------
+// Snapshot archives
+// ---------------------------------
+// Flat binary images of trivially copyable state. The same Transfer function drives both
+// directions, so the writer and reader can never disagree about layout: every field is one
+// memcpy and every vector is a length followed by its elements.
+//
+// Images are only meant to be read back by the same build (rollback, replays, respawn);
+// the header rejects images from a different format version or struct layout.
+
+class SnapshotWriter {
+public:
+    // Appends to out, which is cleared first; reuse one buffer to avoid reallocating
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : out(out) { out.clear(); }
+
+    template <typename T>
+    void Pod(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+        Bytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void Array(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+        uint32_t n = (uint32_t)count;
+        Bytes(&n, sizeof(n));
+        Bytes(data, count * sizeof(T));
+    }
+
+    template <typename T>
+    void Vector(const std::vector<T>& v) { Array(v.data(), v.size()); }
+
+private:
+    std::vector<uint8_t>& out;
+
+    void Bytes(const void* data, size_t size) {
+        if (size == 0) return;
+        size_t at = out.size();
+        out.resize(at + size);
+        std::memcpy(out.data() + at, data, size);
+    }
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {}
+    explicit SnapshotReader(const std::vector<uint8_t>& in) : SnapshotReader(in.data(), in.size()) {}
+
+    // False once any read ran past the end or hit a length mismatch; later reads are no-ops
+    bool Ok() const { return ok; }
+    bool AtEnd() const { return cursor == end; }
+
+    template <typename T>
+    void Pod(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+        Bytes(&value, sizeof(T));
+    }
+
+    // Fixed-size storage: the stored length must match count
+    template <typename T>
+    void Array(T* data, size_t count) {
+        uint32_t n = 0;
+        Bytes(&n, sizeof(n));
+        if (n != count) ok = false;
+        Bytes(data, count * sizeof(T));
+    }
+
+    // Resizes v to the stored length (no allocation while it fits the existing capacity)
+    template <typename T>
+    void Vector(std::vector<T>& v) {
+        uint32_t n = 0;
+        Bytes(&n, sizeof(n));
+        if (!ok || (size_t)(end - cursor) < (size_t)n * sizeof(T)) {
+            ok = false;
+            return;
+        }
+        v.resize(n);
+        Bytes(v.data(), (size_t)n * sizeof(T));
+    }
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool ok = true;
+
+    void Bytes(void* data, size_t size) {
+        if (!ok || (size_t)(end - cursor) < size) {
+            ok = false;
+            return;
+        }
+        if (size == 0) return;
+        std::memcpy(data, cursor, size);
+        cursor += size;
+    }
+};
+
+#endif // DIGDUG_SNAPSHOT_HPP_
@@ -0,0 +1,153 @@
+#ifndef DIGDUG_SOUNDEFFECTS_HPP_
+#define DIGDUG_SOUNDEFFECTS_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "MemoryStats.hpp"
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Sound effects
+// ---------------------------------
+// Short chip-style effects synthesised at startup, so they need no asset files. Each is
+// decoded once into a base Sound. Every voice of it is a raylib alias of that base,
+// sharing its samples, so playing an effect only restarts an existing voice.
+enum class SfxId : uint8_t { HARPOON, KILL, PICKUP, COUNT };
+
+struct SfxInfo {
+    int priority;     // Higher steals voices from lower
+    float startHz, endHz;
+    float seconds;
+    float noise;      // 0 pure square wave .. 1 pure noise
+    float volume;
+};
+
+static const SfxInfo SFX_INFO[(int)SfxId::COUNT] = {
+    { 1, 1400.0f, 500.0f,  0.09f, 0.0f, 0.35f }, // HARPOON: quick falling zap
+    { 2, 300.0f,  80.0f,   0.22f, 0.6f, 0.6f },  // KILL: noisy pop
+    { 3, 600.0f,  1800.0f, 0.25f, 0.0f, 0.45f }, // PICKUP: rising chirp
+};
+
+using SfxSamples = std::vector<int16_t, TaggedAllocator<int16_t, MemTag::AUDIO>>;
+
+// Mono 16-bit samples for one effect: a square wave sliding from startHz to endHz with noise
+// mixed in and a linear fade-out
+inline SfxSamples SynthSfx(const SfxInfo& info, int sampleRate) {
+    SfxSamples samples((size_t)(info.seconds * (float)sampleRate));
+    double phase = 0.0;
+    uint32_t noise = 0x1234567u;
+    for (size_t i = 0; i < samples.size(); i++) {
+        float t = (float)i / (float)samples.size();
+        float hz = info.startHz + (info.endHz - info.startHz) * t;
+        phase += hz / (double)sampleRate;
+        float square = phase - std::floor(phase) < 0.5 ? 1.0f : -1.0f;
+        noise ^= noise << 13;
+        noise ^= noise >> 17;
+        noise ^= noise << 5;
+        float white = (float)(noise & 0xFFFF) / 32767.5f - 1.0f;
+        float v = (square * (1.0f - info.noise) + white * info.noise) * info.volume * (1.0f - t);
+        samples[i] = (int16_t)(v * 32767.0f);
+    }
+    return samples;
+}
+
+// ---------------------------------
+// VoicePool
+// ---------------------------------
+// At most MAX_VOICES effects sound at once. Every effect has MAX_VOICES aliases made up
+// front, so any mix fits without creating one mid-game. When every voice is busy, a new
+// effect takes over the lowest-priority voice, the oldest among equals, or is dropped if all
+// of them outrank it. Play never allocates, loads or waits. Without an audio device the pool
+// is silent.
+class VoicePool {
+public:
+    static constexpr int MAX_VOICES = 8;
+    static constexpr int SAMPLE_RATE = 22050;
+
+    // Needs the audio device to be open already
+    VoicePool() {
+        if (!IsAudioDeviceReady()) return;
+        for (int s = 0; s < (int)SfxId::COUNT; s++) {
+            SfxSamples samples = SynthSfx(SFX_INFO[s], SAMPLE_RATE);
+            ::Wave wave { (unsigned int)samples.size(), SAMPLE_RATE, 16, 1, samples.data() };
+            base[s] = ::LoadSoundFromWave(wave); // Copies the samples
+            for (int v = 0; v < MAX_VOICES; v++) voices[s][v].sound = ::LoadSoundAlias(base[s]);
+        }
+        ready = true;
+    }
+
+    ~VoicePool() {
+        if (!ready) return;
+        for (int s = 0; s < (int)SfxId::COUNT; s++) {
+            for (Voice& voice : voices[s]) ::UnloadSoundAlias(voice.sound);
+            ::UnloadSound(base[s]);
+        }
+    }
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    // pitch 1 plays the effect as made; a little variation keeps repeats from droning
+    void Play(SfxId id, float pitch = 1.0f) {
+        if (!ready) return;
+        int s = (int)id;
+        int priority = SFX_INFO[s].priority;
+
+        // Count what is sounding, and find a free voice of this effect plus the cheapest victim
+        int playing = 0;
+        Voice* free = nullptr;
+        Voice* victim = nullptr;
+        for (int other = 0; other < (int)SfxId::COUNT; other++) {
+            for (Voice& voice : voices[other]) {
+                if (!voice.started || !::IsSoundPlaying(voice.sound)) {
+                    voice.started = 0;
+                    if (other == s && !free) free = &voice;
+                    continue;
+                }
+                playing++;
+                int p = SFX_INFO[other].priority;
+                if (!victim || p < victim->priority || (p == victim->priority && voice.started < victim->started)) victim = &voice;
+            }
+        }
+
+        // With no free alias all MAX_VOICES voices are this effect, so the victim is one of
+        // them. Otherwise stopping another effect frees a slot and the sound plays on one of
+        // its own aliases.
+        Voice* voice = free;
+        if (playing >= MAX_VOICES) {
+            if (victim->priority > priority) {
+                dropped++;
+                return;
+            }
+            ::StopSound(victim->sound);
+            victim->started = 0;
+            if (!voice) voice = victim;
+            stolen++;
+        }
+        ::SetSoundPitch(voice->sound, pitch);
+        ::PlaySound(voice->sound);
+        voice->started = ++clock;
+        voice->priority = priority;
+    }
+
+    bool Ready() const { return ready; }
+    int Stolen() const { return stolen; }
+    int Dropped() const { return dropped; }
+
+private:
+    struct Voice {
+        ::Sound sound {};
+        uint64_t started = 0; // Play order, 0 while idle
+        int priority = 0;
+    };
+
+    bool ready = false;
+    ::Sound base[(int)SfxId::COUNT] = {};
+    Voice voices[(int)SfxId::COUNT][MAX_VOICES];
+    uint64_t clock = 0;
+    int stolen = 0, dropped = 0;
+};
+
+#endif // DIGDUG_SOUNDEFFECTS_HPP_
@@ -0,0 +1,239 @@
+#ifndef DIGDUG_SPATIALHASH_HPP_
+#define DIGDUG_SPATIALHASH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "raylib.hpp"
+
+// ---------------------------------
+// EdgeBox
+// ---------------------------------
+// A rectangle's edges as integers for the broadphase's overlap test. Each edge is the float
+// CheckCollisionRecs would compute (x, then x + width), with its bits remapped so integers
+// order like the floats did, so the test is four integer compares with no branches and gives
+// exactly the float answer. Entities sit at fractional positions, so snapping them to a
+// fixed-point grid would move contacts by a fraction of a pixel and change what replays and
+// netplay peers see; keeping the float edges avoids that.
+struct EdgeBox {
+    int32_t left = 0, top = 0, right = 0, bottom = 0;
+
+    static EdgeBox From(const Rectangle& r) {
+        EdgeBox box;
+        box.left = Key(r.x);
+        box.top = Key(r.y);
+        box.right = Key(r.x + r.width);
+        box.bottom = Key(r.y + r.height);
+        return box;
+    }
+
+    // Same edge semantics as CheckCollisionRecs
+    bool Overlaps(const EdgeBox& o) const {
+        return (left < o.right) & (right > o.left) & (top < o.bottom) & (bottom > o.top);
+    }
+
+    // Sign-magnitude to two's complement; adding zero first turns -0 into +0 so they stay equal
+    static int32_t Key(float f) {
+        f += 0.0f;
+        int32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits ^ ((bits >> 31) & 0x7fffffff);
+    }
+};
+
+// ---------------------------------
+// SpatialHash
+// ---------------------------------
+// Uniform grid broadphase for entities no larger than one cell. Each entity is filed
+// under the cell holding its top-left corner, so anything overlapping a cell lives in
+// that cell or its left/up neighbours and no entity is stored twice. The grid is rebuilt
+// each tick with a counting sort into flat arrays; after the first tick no allocation
+// happens unless the entity count grows.
+class SpatialHash {
+public:
+    struct Hit {
+        uint32_t id = 0;
+        float distance = 0.0f;
+        bool hit = false;
+    };
+
+    SpatialHash() = default;
+    SpatialHash(float cellSize, int numCols, int numRows) { Init(cellSize, numCols, numRows); }
+
+    void Init(float cellSize, int numCols, int numRows) {
+        cell = cellSize;
+        invCell = 1.0f / cellSize;
+        cols = numCols;
+        rows = numRows;
+        cellStart.assign((size_t)cols * rows + 1, 0);
+        Clear();
+    }
+
+    int Cols() const { return cols; }
+    int Rows() const { return rows; }
+    size_t Size() const { return items.size(); }
+
+    // Starts a rebuild; follow with Insert() for every entity and then Build()
+    void Clear() {
+        items.clear();
+    }
+
+    void Insert(uint32_t id, const Rectangle& bounds) {
+        Item item;
+        item.id = id;
+        item.bounds = bounds;
+        item.edges = EdgeBox::From(bounds);
+        item.cell = CellY(bounds.y) * cols + CellX(bounds.x);
+        items.push_back(item);
+    }
+
+    void Build() {
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        for (const Item& item : items) cellStart[item.cell + 1]++;
+        for (size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+
+        sorted.resize(items.size());
+        cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        for (uint32_t i = 0; i < (uint32_t)items.size(); i++) {
+            sorted[cursor[items[i].cell]++] = i;
+        }
+        if (stamp.size() < items.size()) stamp.resize(items.size(), 0);
+    }
+
+    // Calls fn(id, bounds) once for every entity whose bounds overlap rect
+    template <typename Fn>
+    void QueryRect(const Rectangle& rect, Fn fn) {
+        const EdgeBox edges = EdgeBox::From(rect);
+        int x0 = CellX(rect.x) - 1, x1 = CellX(rect.x + rect.width);
+        int y0 = CellY(rect.y) - 1, y1 = CellY(rect.y + rect.height);
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                int c = cy * cols + cx;
+                for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                    const Item& item = items[sorted[k]];
+                    if (item.edges.Overlaps(edges)) fn(item.id, item.bounds);
+                }
+            }
+        }
+    }
+
+    // Calls fn(id, bounds, distance) for every entity hit by the ray segment from origin
+    // along unit direction dir, up to maxDistance, visiting cells in order along the ray.
+    // fn returns true to stop the walk early.
+    template <typename Fn>
+    void QueryRay(Vector2 origin, Vector2 dir, float maxDistance, Fn fn) {
+        if (++queryStamp == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            queryStamp = 1;
+        }
+
+        // Amanatides-Woo grid walk
+        int cx = CellX(origin.x), cy = CellY(origin.y);
+        int stepX = dir.x > 0 ? 1 : (dir.x < 0 ? -1 : 0);
+        int stepY = dir.y > 0 ? 1 : (dir.y < 0 ? -1 : 0);
+        float tMaxX = stepX != 0 ? ((cx + (stepX > 0)) * cell - origin.x) / dir.x : INFINITY;
+        float tMaxY = stepY != 0 ? ((cy + (stepY > 0)) * cell - origin.y) / dir.y : INFINITY;
+        float tDeltaX = stepX != 0 ? cell / std::fabs(dir.x) : INFINITY;
+        float tDeltaY = stepY != 0 ? cell / std::fabs(dir.y) : INFINITY;
+
+        float t = 0.0f;
+        while (t <= maxDistance) {
+            // Entities reaching into this cell are filed here or in the left/up neighbours
+            for (int ny = cy - 1; ny <= cy; ny++) {
+                for (int nx = cx - 1; nx <= cx; nx++) {
+                    if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+                    int c = ny * cols + nx;
+                    for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                        uint32_t index = sorted[k];
+                        if (stamp[index] == queryStamp) continue;
+                        stamp[index] = queryStamp;
+                        float d;
+                        const Item& item = items[index];
+                        if (RayBox(origin, dir, maxDistance, item.bounds, d) && fn(item.id, item.bounds, d)) return;
+                    }
+                }
+            }
+            if (tMaxX < tMaxY) {
+                t = tMaxX;
+                tMaxX += tDeltaX;
+                cx += stepX;
+            } else {
+                t = tMaxY;
+                tMaxY += tDeltaY;
+                cy += stepY;
+            }
+            if (cx < 0 || cy < 0 || cx > cols || cy > rows) break;
+        }
+    }
+
+    // Nearest entity along the ray accepted by filter(id)
+    template <typename Filter>
+    Hit Raycast(Vector2 origin, Vector2 dir, float maxDistance, Filter filter) {
+        Hit best;
+        best.distance = maxDistance;
+        QueryRay(origin, dir, maxDistance, [&](uint32_t id, const Rectangle&, float d) {
+            if (d <= best.distance && filter(id)) {
+                best.id = id;
+                best.distance = d;
+                best.hit = true;
+            }
+            return false;
+        });
+        return best;
+    }
+
+    // Slab test of a ray segment against an axis-aligned box; distance is the entry point
+    // (0 when the origin starts inside)
+    static bool RayBox(Vector2 origin, Vector2 dir, float maxDistance, const Rectangle& box, float& distance) {
+        float tMin = 0.0f, tMax = maxDistance;
+        const float o[2] = { origin.x, origin.y };
+        const float d[2] = { dir.x, dir.y };
+        const float lo[2] = { box.x, box.y };
+        const float hi[2] = { box.x + box.width, box.y + box.height };
+        for (int axis = 0; axis < 2; axis++) {
+            if (d[axis] == 0.0f) {
+                if (o[axis] < lo[axis] || o[axis] > hi[axis]) return false;
+                continue;
+            }
+            float inv = 1.0f / d[axis];
+            float t0 = (lo[axis] - o[axis]) * inv;
+            float t1 = (hi[axis] - o[axis]) * inv;
+            if (t0 > t1) { float tmp = t0; t0 = t1; t1 = tmp; }
+            if (t0 > tMin) tMin = t0;
+            if (t1 < tMax) tMax = t1;
+            if (tMin > tMax) return false;
+        }
+        distance = tMin;
+        return true;
+    }
+
+private:
+    struct Item {
+        uint32_t id;
+        Rectangle bounds;
+        EdgeBox edges;
+        int cell;
+    };
+
+    float cell = 1.0f;
+    float invCell = 1.0f;
+    int cols = 0;
+    int rows = 0;
+    std::vector<Item> items;
+    std::vector<int> cellStart;   // Prefix sums: cell c owns sorted[cellStart[c], cellStart[c + 1])
+    std::vector<int> cursor;
+    std::vector<uint32_t> sorted; // Item indices grouped by cell
+    std::vector<uint32_t> stamp;  // Per-item marker so ray walks report each item once
+    uint32_t queryStamp = 0;
+
+    int CellX(float x) const { return ClampCell((int)std::floor(x * invCell), cols); }
+    int CellY(float y) const { return ClampCell((int)std::floor(y * invCell), rows); }
+    static int ClampCell(int c, int n) { return c < 0 ? 0 : (c >= n ? n - 1 : c); }
+};
+
+#endif // DIGDUG_SPATIALHASH_HPP_
@@ -0,0 +1,188 @@
+#ifndef DIGDUG_SPRITEBATCH_HPP_
+#define DIGDUG_SPRITEBATCH_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Sprite atlas
+// ---------------------------------
+// Every entity sprite lives in one texture, in a row of CELL-sized cells in SpriteId order.
+// Shapes are white where the entity's colour goes, so one sprite serves every tint; art
+// with its own colours is drawn with a WHITE tint. Generate() paints the current placeholder
+// shapes; Load() takes a PNG laid out the same way, and Use() one that was loaded elsewhere.
+enum class SpriteId : uint8_t { PIXEL, PLAYER, MONSTER, DRAGON, FRUIT, COUNT };
+
+class SpriteAtlas {
+public:
+    static constexpr int CELL = 32;
+    static constexpr int PAD = 1; // Transparent border around each cell, so filtering never bleeds
+
+    void Generate() {
+        raylib::Image image(Stride() * (int)SpriteId::COUNT, CELL + 2 * PAD, BLANK);
+        int c = CELL / 2;
+        image.DrawRectangle(Origin(SpriteId::PIXEL), PAD, CELL, CELL, WHITE);
+        image.DrawRectangle(Origin(SpriteId::PLAYER), PAD, CELL, CELL, WHITE);
+        image.DrawRectangle(Origin(SpriteId::MONSTER), PAD, CELL, CELL, WHITE);
+        float x = (float)Origin(SpriteId::DRAGON);
+        image.DrawTriangle(Vector2{ x + c, (float)PAD }, Vector2{ x, (float)(PAD + CELL) },
+                           Vector2{ x + CELL, (float)(PAD + CELL) }, WHITE);
+        int fx = Origin(SpriteId::FRUIT) + c;
+        image.DrawCircle(fx, PAD + c, c, LIME);
+        image.DrawCircleLines(fx, PAD + c, c, DARKGREEN);
+        texture.Unload();
+        texture.Load(image);
+        external = nullptr;
+    }
+
+    // Throws raylib::RaylibException if the file can't be loaded
+    void Load(const char* path) {
+        texture.Unload();
+        texture.Load(path);
+        external = nullptr;
+    }
+
+    // Draws from art instead of the atlas's own texture; art must outlive the atlas
+    void Use(const raylib::Texture& art) { external = &art; }
+
+    const raylib::Texture& GetTexture() const { return external ? *external : texture; }
+
+    // Source rectangle of a sprite; PIXEL is sampled from its centre so it can be stretched
+    Rectangle Source(SpriteId id) const {
+        if (id == SpriteId::PIXEL) return Rectangle{ (float)(Origin(id) + CELL / 2), (float)(PAD + CELL / 2), 1, 1 };
+        return Rectangle{ (float)Origin(id), (float)PAD, (float)CELL, (float)CELL };
+    }
+
+private:
+    raylib::Texture texture;
+    const raylib::Texture* external = nullptr;
+
+    static int Stride() { return CELL + 2 * PAD; }
+    static int Origin(SpriteId id) { return (int)id * Stride() + PAD; }
+};
+
+// ---------------------------------
+// Sprite batch
+// ---------------------------------
+// The frame's render queue. Entities and the HUD queue what they draw during the frame and
+// Flush() draws it all at once, sorted by layer, then texture, then primitive (quads or
+// lines), so rlgl keeps one texture and mode for as long as possible and usually emits each
+// layer's sprites as a single draw call. Order within a layer, texture and primitive is the
+// order things were added; what differs in texture or primitive may be reordered within its
+// layer, so anything that has to cover something else goes on a later layer. The queue keeps
+// its capacity, so steady-state frames don't allocate.
+//
+// Everything entirely outside the cull rectangle (the camera's view, in world space) is dropped
+// when added, so off-screen entities cost one rectangle test and never reach rlgl. Anything
+// that needs a shader or a render target of its own (the fog, the terrain chunks being built)
+// is drawn directly instead.
+class SpriteBatch {
+public:
+    enum Layer : uint8_t { PLAYER, HARPOON, ENEMIES, PICKUPS, EFFECTS, HUD_BACK, HUD_FRONT };
+
+    explicit SpriteBatch(const SpriteAtlas& atlas) : atlas(atlas) {}
+
+    void SetCullRect(Rectangle view) { cull = view; }
+
+    void Add(Layer layer, SpriteId id, float x, float y, float width, float height, Color tint) {
+        Add(layer, atlas.GetTexture(), atlas.Source(id), Rectangle{ x, y, width, height }, tint);
+    }
+
+    void Add(Layer layer, SpriteId id, float x, float y, Color tint) {
+        Add(layer, id, x, y, (float)SpriteAtlas::CELL, (float)SpriteAtlas::CELL, tint);
+    }
+
+    // src of texture stretched over dst; texture must stay loaded until Flush
+    void Add(Layer layer, const ::Texture& texture, Rectangle src, Rectangle dst, Color tint) {
+        if (Culled(dst)) return;
+        Item& item = Push(layer, texture.id, QUADS, dst, tint);
+        item.texture = texture;
+        item.src = src;
+    }
+
+    // Solid, from raylib's shapes texture as DrawRectangleRec would
+    void AddRect(Layer layer, Rectangle rect, Color tint) {
+        if (!Culled(rect)) Push(layer, GetShapesTexture().id, QUADS, rect, tint).kind = RECT;
+    }
+
+    // One pixel wide outline, as DrawRectangleLines would; untextured
+    void AddRectLines(Layer layer, Rectangle rect, Color tint) {
+        if (!Culled(rect)) Push(layer, 0, LINES, rect, tint).kind = OUTLINE;
+    }
+
+    // Text with its top-left corner at (x, y); layout must outlive Flush and not change before it
+    void AddText(Layer layer, raylib::TextLayout& layout, float x, float y) {
+        Vector2 size = layout.Measure();
+        if (Culled(Rectangle{ x, y, size.x, size.y })) return;
+        Item& item = Push(layer, layout.GetFont().texture.id, QUADS, Rectangle{ x, y, size.x, size.y },
+                          layout.GetColor());
+        item.kind = TEXT;
+        item.layout = &layout;
+    }
+
+    size_t Size() const { return items.size(); }
+
+    // Times the last Flush changed texture or primitive, which is at least the draw calls it cost
+    int LastRuns() const { return runs; }
+
+    void Flush() {
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return a.key != b.key ? a.key < b.key : a.order < b.order;
+        });
+        runs = 0;
+        uint64_t state = ~0ull;
+        for (const Item& item : items) {
+            uint64_t itemState = item.key & STATE_MASK;
+            if (itemState != state) runs++;
+            state = itemState;
+            switch (item.kind) {
+            case SPRITE: DrawTexturePro(item.texture, item.src, item.dst, Vector2{ 0, 0 }, 0.0f, item.tint); break;
+            case RECT: DrawRectangleRec(item.dst, item.tint); break;
+            case OUTLINE:
+                DrawRectangleLines((int)item.dst.x, (int)item.dst.y, (int)item.dst.width, (int)item.dst.height,
+                                   item.tint);
+                break;
+            case TEXT: item.layout->Draw(Vector2{ item.dst.x, item.dst.y }, item.tint); break;
+            }
+        }
+        items.clear();
+    }
+
+private:
+    enum Primitive : uint8_t { QUADS, LINES }; // As rlgl's draw modes split a batch
+    enum Kind : uint8_t { SPRITE, RECT, OUTLINE, TEXT };
+
+    static constexpr uint64_t STATE_MASK = (1ull << 40) - 1; // Texture and primitive
+
+    struct Item {
+        uint64_t key;   // Layer, then texture, then primitive
+        uint32_t order; // Submission order, keeps the sort stable
+        Kind kind;
+        Rectangle dst;
+        Color tint;
+        Rectangle src{};
+        ::Texture texture{};                  // SPRITE's
+        raylib::TextLayout* layout = nullptr; // TEXT's
+    };
+
+    const SpriteAtlas& atlas;
+    std::vector<Item> items;
+    Rectangle cull{ -1e9f, -1e9f, 2e9f, 2e9f };
+    int runs = 0;
+
+    bool Culled(Rectangle r) const {
+        return r.x + r.width < cull.x || r.y + r.height < cull.y || r.x > cull.x + cull.width ||
+               r.y > cull.y + cull.height;
+    }
+
+    Item& Push(Layer layer, unsigned int textureId, Primitive primitive, Rectangle dst, Color tint) {
+        uint64_t key = ((uint64_t)layer << 40) | ((uint64_t)textureId << 8) | primitive;
+        items.push_back(Item{ key, (uint32_t)items.size(), SPRITE, dst, tint });
+        return items.back();
+    }
+};
+
+#endif // DIGDUG_SPRITEBATCH_HPP_
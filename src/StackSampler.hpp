@@ -0,0 +1,87 @@
+#ifndef DIGDUG_STACKSAMPLER_HPP_
+#define DIGDUG_STACKSAMPLER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "Profiler.hpp"
+
+// ---------------------------------
+// StackSampler
+// ---------------------------------
+// Samples one thread's open profiler zones (see Profiler::ReadStack) from a thread of its own
+// every periodUs and counts how often each stack came up, which is a flame graph's input. It
+// sees zones rather than native frames, so it needs no symbols, unwinder or OS support, and
+// every sample names game code; time outside any zone shows under the root alone.
+//
+// WriteFolded writes one "root;outer;inner count" line per stack, the collapsed format read
+// by flamegraph.pl, inferno and speedscope.
+class StackSampler {
+public:
+    // Starts sampling target's thread straight away; root names the bottom frame
+    StackSampler(const Profiler& target, const char* root, int periodUs = 1000)
+        : target(target), root(root), period(periodUs > 0 ? periodUs : 1), worker([this] { Run(); }) {}
+
+    ~StackSampler() { Stop(); }
+
+    StackSampler(const StackSampler&) = delete;
+    StackSampler& operator=(const StackSampler&) = delete;
+
+    void Stop() {
+        stopping.store(true, std::memory_order_relaxed);
+        if (worker.joinable()) worker.join();
+    }
+
+    // Only once stopped
+    uint64_t Samples() const { return samples; }
+    size_t Stacks() const { return counts.size(); }
+
+    bool WriteFolded(const char* path) const {
+        FILE* file = fopen(path, "w");
+        if (!file) return false;
+        for (const auto& entry : counts) {
+            fputs(root, file);
+            for (char zone : entry.first) {
+                const char* name = Profiler::ZoneName((int)(signed char)zone);
+                fprintf(file, ";%s", name ? name : "?");
+            }
+            fprintf(file, " %llu\n", (unsigned long long)entry.second);
+        }
+        return fclose(file) == 0;
+    }
+
+private:
+    const Profiler& target;
+    const char* root;
+    const std::chrono::microseconds period;
+    std::map<std::string, uint64_t> counts; // Zone ids as chars, outermost first; sampler's until Stop
+    uint64_t samples = 0;
+    std::atomic<bool> stopping{ false };
+    std::thread worker; // Last, so it starts after everything it uses
+
+    void Run() {
+        int zones[Profiler::MAX_DEPTH];
+        std::string key;
+        std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+        while (!stopping.load(std::memory_order_relaxed)) {
+            // On a schedule rather than a fixed sleep, so a late wake-up doesn't slow the rate;
+            // one that missed whole periods starts over rather than sampling the same moment again
+            next += period;
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (now > next) next = now + period;
+            std::this_thread::sleep_until(next);
+            int depth = target.ReadStack(zones, Profiler::MAX_DEPTH);
+            key.clear();
+            for (int i = 0; i < depth; i++) key.push_back((char)zones[i]);
+            counts[key]++;
+            samples++;
+        }
+    }
+};
+
+#endif // DIGDUG_STACKSAMPLER_HPP_
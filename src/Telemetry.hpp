@@ -0,0 +1,185 @@
+#ifndef DIGDUG_TELEMETRY_HPP_
+#define DIGDUG_TELEMETRY_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RaylibCpp.hpp"
+#include "TickHistogram.hpp"
+
+// ---------------------------------
+// Telemetry
+// ---------------------------------
+// Gameplay and performance records for the fleet dashboard, collected on the game thread and
+// shipped from a thread of its own, so the game thread never does I/O for them.
+//
+// Add() copies a fixed-size record into a ring allocated up front (single producer, so the
+// main thread only) and never blocks or allocates: with the ring full the record is dropped
+// and counted. The flusher thread wakes every POLL_MS, and once BATCH records are waiting or
+// the flush interval passes it packs what is there into a batch, deflates it with raylib's
+// CompressData and hands it to the sink. The sink is opened on the flusher thread too, so
+// name lookups and file opens stay off the game thread; Stop() and the destructor flush the rest.
+//
+// A batch on the wire, all little-endian:
+//   BatchHeader, then `count` Records, deflated if flags has DEFLATED (rawBytes before)
+enum class TelemetryKind : uint8_t {
+    SESSION_START, // a: seed low bits,  b: 1 in co-op
+    PERF,          // a: frames,  b: ticks,  x: average frame ms,  y: p99 tick ms (bucket bound)
+    DEATH,         // a: lives left,  b: who died (as PLAYER_DIED)
+    LEVEL,         // a: level serial
+    GAME_ENDED,    // a: final score,  b: deaths that game (a co-op double death is two)
+    SESSION_END,   // a: records dropped before it,  b: frames
+};
+
+class Telemetry {
+public:
+    static constexpr uint32_t MAGIC = 0x4d544444; // "DDTM"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t DEFLATED = 1;
+    static constexpr uint32_t CAPACITY = 4096;    // Records buffered between flushes
+    static constexpr uint32_t BATCH = 256;        // Most records per batch
+    static constexpr int POLL_MS = 250;
+
+#pragma pack(push, 1)
+    struct Record {
+        uint32_t ms;        // Since the session started
+        uint8_t kind;       // TelemetryKind
+        uint8_t pad[3];
+        int32_t a, b;
+        float x, y;
+    };
+    struct BatchHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t flags;
+        uint64_t session;   // Random per run
+        uint32_t sequence;  // Counts batches from 0
+        uint32_t count;
+        uint32_t rawBytes;  // Of the records before compression
+    };
+#pragma pack(pop)
+
+    // Takes one batch; false if it couldn't be sent, which drops it. Runs on the flusher thread.
+    using Sink = std::function<bool(const void* data, size_t size)>;
+
+    // openSink runs on the flusher thread before the first batch and may return an empty Sink
+    // to discard everything (a bad address, say)
+    Telemetry(uint64_t session, std::function<Sink()> openSink, double flushSeconds = 10.0)
+        : session(session), flushInterval(flushSeconds), start(Clock::now()), records(CAPACITY),
+          flusher([this, openSink] { Run(openSink); }) {}
+
+    ~Telemetry() { Stop(); }
+
+    // Sends what is waiting and ends the flusher thread; records added afterwards stay unsent
+    void Stop() {
+        if (!flusher.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(wakeLock);
+            stopping = true;
+        }
+        wake.notify_one();
+        flusher.join();
+    }
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    // Main thread only; false if the ring is full and the record was dropped
+    bool Add(TelemetryKind kind, int32_t a = 0, int32_t b = 0, float x = 0.0f, float y = 0.0f) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Record& r = records[h % CAPACITY];
+        r.ms = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+        r.kind = (uint8_t)kind;
+        std::memset(r.pad, 0, sizeof(r.pad));
+        r.a = a;
+        r.b = b;
+        r.x = x;
+        r.y = y;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint32_t BatchesSent() const { return sent.load(std::memory_order_relaxed); }
+    uint32_t BatchesFailed() const { return failed.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const uint64_t session;
+    const double flushInterval;
+    const Clock::time_point start;
+    std::vector<Record> records;
+    std::atomic<uint32_t> head{ 0 }; // Written by Add
+    std::atomic<uint32_t> tail{ 0 }; // Written by the flusher
+    std::atomic<uint32_t> dropped{ 0 }, sent{ 0 }, failed{ 0 };
+    uint32_t sequence = 0;
+    std::vector<uint8_t> batch;      // Flusher's
+
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread flusher;             // Last, so it starts after everything it uses
+
+    void Run(const std::function<Sink()>& openSink) {
+        Sink sink = openSink();
+        batch.reserve(sizeof(BatchHeader) + BATCH * sizeof(Record));
+        Clock::time_point lastFlush = Clock::now();
+        for (;;) {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(wakeLock);
+                wake.wait_for(lock, std::chrono::milliseconds(POLL_MS), [this] { return stopping; });
+                stop = stopping;
+            }
+            uint32_t waiting = head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+            bool due = std::chrono::duration<double>(Clock::now() - lastFlush).count() >= flushInterval;
+            if (stop || waiting >= BATCH || (due && waiting > 0)) {
+                while (Flush(sink)) {}
+                lastFlush = Clock::now();
+            }
+            if (stop) return;
+        }
+    }
+
+    // Sends up to BATCH waiting records; false once there were none
+    bool Flush(const Sink& sink) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t count = head.load(std::memory_order_acquire) - t;
+        if (count == 0) return false;
+        if (count > BATCH) count = BATCH;
+
+        batch.resize(sizeof(BatchHeader) + count * sizeof(Record));
+        Record* out = (Record*)(batch.data() + sizeof(BatchHeader));
+        for (uint32_t i = 0; i < count; i++) out[i] = records[(t + i) % CAPACITY];
+        tail.store(t + count, std::memory_order_release); // The ring slots are free again
+
+        BatchHeader header{ MAGIC, VERSION, 0, session, sequence++, count, count * (uint32_t)sizeof(Record) };
+        int packedSize = 0;
+        unsigned char* packed = ::CompressData((const unsigned char*)out, (int)header.rawBytes, &packedSize);
+        if (packed && packedSize > 0 && (uint32_t)packedSize < header.rawBytes) {
+            header.flags = DEFLATED;
+            batch.resize(sizeof(BatchHeader) + (size_t)packedSize);
+            std::memcpy(batch.data() + sizeof(BatchHeader), packed, (size_t)packedSize);
+        }
+        if (packed) ::MemFree(packed);
+        std::memcpy(batch.data(), &header, sizeof(header));
+
+        bool ok = sink && sink(batch.data(), batch.size());
+        (ok ? sent : failed).fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif // DIGDUG_TELEMETRY_HPP_
@@ -0,0 +1,188 @@
+#ifndef DIGDUG_TEXTURECOOKER_HPP_
+#define DIGDUG_TEXTURECOOKER_HPP_
+
+#include <cstdint>
+#include <cstring>
+
+#include "RaylibCpp.hpp"
+
+// ---------------------------------
+// Block compression
+// ---------------------------------
+// DXT1 (BC1) and DXT5 (BC3) encoders for the offline cooker. raylib decodes these formats
+// but can't produce them. Each 4x4 block gets its two end colours from the corners of the
+// box its colours span, taken along the way they run, with the two colours between them
+// interpolated, and every pixel takes the nearest of the four. That is a long way from what a dedicated encoder finds by
+// searching, in quality and in speed, but it runs offline and is plenty for sprites and
+// backdrops.
+namespace bc {
+
+inline uint16_t To565(int r, int g, int b) {
+    return (uint16_t)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+inline void From565(uint16_t c, int rgb[3]) {
+    int r = c >> 11 & 31, g = c >> 5 & 63, b = c & 31;
+    rgb[0] = r << 3 | r >> 2;
+    rgb[1] = g << 2 | g >> 4;
+    rgb[2] = b << 3 | b >> 2;
+}
+
+// The colour half of a block, 8 bytes: always the four-colour mode, which DXT5 requires
+inline void EncodeColor(const Color block[16], uint8_t out[8]) {
+    int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+    int mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        const unsigned char c[3] = { block[i].r, block[i].g, block[i].b };
+        for (int k = 0; k < 3; k++) {
+            if (c[k] < lo[k]) lo[k] = c[k];
+            if (c[k] > hi[k]) hi[k] = c[k];
+            mean[k] += c[k];
+        }
+    }
+    // Which way the colours run across the box: measured against the channel that varies
+    // most, and any channel running against it swaps its ends
+    int ref = 0;
+    for (int k = 1; k < 3; k++) {
+        if (hi[k] - lo[k] > hi[ref] - lo[ref]) ref = k;
+    }
+    int cov[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        int d[3] = { block[i].r * 16 - mean[0], block[i].g * 16 - mean[1], block[i].b * 16 - mean[2] };
+        for (int k = 0; k < 3; k++) cov[k] += d[k] * d[ref];
+    }
+    for (int k = 0; k < 3; k++) {
+        if (cov[k] < 0) {
+            int t = lo[k];
+            lo[k] = hi[k];
+            hi[k] = t;
+        }
+    }
+
+    uint16_t c0 = To565(hi[0], hi[1], hi[2]), c1 = To565(lo[0], lo[1], lo[2]);
+    if (c0 < c1) { uint16_t t = c0; c0 = c1; c1 = t; }
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        From565(c0, palette[0]);
+        From565(c1, palette[1]);
+        for (int k = 0; k < 3; k++) {
+            palette[2][k] = (2 * palette[0][k] + palette[1][k]) / 3;
+            palette[3][k] = (palette[0][k] + 2 * palette[1][k]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = block[i].r - palette[p][0], dg = block[i].g - palette[p][1], db = block[i].b - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+    out[0] = (uint8_t)c0; out[1] = (uint8_t)(c0 >> 8);
+    out[2] = (uint8_t)c1; out[3] = (uint8_t)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (uint8_t)(indices >> (8 * i));
+}
+
+// The alpha half of a DXT5 block, 8 bytes: eight levels between the block's extremes
+inline void EncodeAlpha(const Color block[16], uint8_t out[8]) {
+    int lo = 255, hi = 0;
+    for (int i = 0; i < 16; i++) {
+        if (block[i].a < lo) lo = block[i].a;
+        if (block[i].a > hi) hi = block[i].a;
+    }
+    uint64_t indices = 0;
+    if (hi != lo) {
+        int levels[8] = { hi, lo };
+        for (int k = 1; k < 7; k++) levels[k + 1] = ((7 - k) * hi + k * lo) / 7;
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 256;
+            for (int p = 0; p < 8; p++) {
+                int distance = block[i].a > levels[p] ? block[i].a - levels[p] : levels[p] - block[i].a;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    out[0] = (uint8_t)hi;
+    out[1] = (uint8_t)lo;
+    for (int i = 0; i < 6; i++) out[2 + i] = (uint8_t)(indices >> (8 * i));
+}
+
+// Compresses RGBA8 pixels, width and height multiples of 4, to DXT1 or DXT5 blocks
+inline void Encode(const Color* pixels, int width, int height, bool alpha, uint8_t* out) {
+    Color block[16];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            for (int y = 0; y < 4; y++) std::memcpy(&block[y * 4], &pixels[(by + y) * width + bx], 4 * sizeof(Color));
+            if (alpha) {
+                EncodeAlpha(block, out);
+                out += 8;
+            }
+            EncodeColor(block, out);
+            out += 8;
+        }
+    }
+}
+
+} // namespace bc
+
+// ---------------------------------
+// Cooking
+// ---------------------------------
+enum class CookFormat { AUTO, DXT1, DXT5, RGBA };
+
+// An image converted to a GPU format with its mipmap chain, ready for
+// raylib::CookedTexture::Export. AUTO picks DXT1 for opaque images and DXT5 for ones
+// with any transparency. Block formats need both sides a multiple of 4, and so does
+// every mipmap level they keep, since raylib sizes smaller levels as if they were whole
+// blocks; images that don't fit fall back to RGBA. Levels are each scaled down from the
+// full image rather than from the level before.
+inline raylib::Image CookImage(const raylib::Image& source, CookFormat format, bool mipmaps, int* outFormat) {
+    raylib::Image rgba = source.Copy();
+    rgba.Format(PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    int w = rgba.width, h = rgba.height;
+    bool blocks = format != CookFormat::RGBA && w % 4 == 0 && h % 4 == 0;
+    bool alpha = format == CookFormat::DXT5;
+    if (format == CookFormat::AUTO) {
+        const Color* pixels = (const Color*)rgba.data;
+        for (int i = 0; i < w * h && !alpha; i++) alpha = pixels[i].a != 255;
+    }
+    int pixelFormat = !blocks ? PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+                     : alpha  ? PIXELFORMAT_COMPRESSED_DXT5_RGBA
+                              : PIXELFORMAT_COMPRESSED_DXT1_RGB;
+
+    int levels = 1;
+    if (mipmaps) {
+        for (int lw = w / 2, lh = h / 2; lw >= 1 && lh >= 1; lw /= 2, lh /= 2) {
+            if (blocks && (lw % 4 != 0 || lh % 4 != 0)) break;
+            levels++;
+            if (lw == 1 || lh == 1) break;
+        }
+    }
+
+    int size = raylib::CookedTexture::GetDataSize(w, h, pixelFormat, levels);
+    uint8_t* data = (uint8_t*)RL_MALLOC((size_t)size);
+    uint8_t* out = data;
+    for (int level = 0, lw = w, lh = h; level < levels; level++, lw /= 2, lh /= 2) {
+        raylib::Image scaled = rgba.Copy();
+        if (level > 0) scaled.Resize(lw, lh);
+        int bytes = ::GetPixelDataSize(lw, lh, pixelFormat);
+        if (blocks) bc::Encode((const Color*)scaled.data, lw, lh, alpha, out);
+        else std::memcpy(out, scaled.data, (size_t)bytes);
+        out += bytes;
+    }
+
+    ::Image cooked{ data, w, h, levels, pixelFormat };
+    if (outFormat) *outFormat = pixelFormat;
+    return raylib::Image(cooked);
+}
+
+#endif // DIGDUG_TEXTURECOOKER_HPP_
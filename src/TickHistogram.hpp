@@ -0,0 +1,70 @@
+#ifndef DIGDUG_TICKHISTOGRAM_HPP_
+#define DIGDUG_TICKHISTOGRAM_HPP_
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+// ---------------------------------
+// TickHistogram
+// ---------------------------------
+// Tick durations in quarter-octave buckets from 1 us to about 65 ms, so a percentile costs a
+// pass over BUCKETS counters instead of keeping every sample. Add() is lock-free and may run
+// on the sim thread while the main thread reads and resets the counts; a tick landing during
+// Take() goes into this window or the next.
+class TickHistogram {
+public:
+    static constexpr int BUCKETS = 64;
+
+    void Add(double seconds) {
+        double us = seconds * 1e6;
+        int bucket = us > 1.0 ? (int)(std::log2(us) * 4.0) : 0;
+        if (bucket > BUCKETS - 1) bucket = BUCKETS - 1;
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Upper bound in milliseconds of the bucket holding the fraction-th tick since the last
+    // Take, or 0 with none; and starts a new window
+    float Take(double fraction, uint32_t* ticks = nullptr) {
+        uint32_t taken[BUCKETS];
+        for (int b = 0; b < BUCKETS; b++) taken[b] = counts[b].exchange(0, std::memory_order_relaxed);
+        return Percentile(taken, fraction, ticks);
+    }
+
+    // As Take, leaving the counts alone
+    float Peek(double fraction, uint32_t* ticks = nullptr) const {
+        uint32_t seen[BUCKETS];
+        for (int b = 0; b < BUCKETS; b++) seen[b] = Count(b);
+        return Percentile(seen, fraction, ticks);
+    }
+
+    uint32_t Count(int bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+
+    // Adds other's counts to these, as if its ticks had been added here too
+    void Merge(const TickHistogram& other) {
+        for (int b = 0; b < BUCKETS; b++) counts[b].fetch_add(other.Count(b), std::memory_order_relaxed);
+    }
+
+    // Bucket b holds [2^(b/4), 2^((b+1)/4)) us; the first also everything shorter, the last
+    // everything longer
+    static double UpperMs(int bucket) { return std::pow(2.0, (bucket + 1) / 4.0) / 1e3; }
+
+private:
+    std::atomic<uint32_t> counts[BUCKETS] = {};
+
+    static float Percentile(const uint32_t (&buckets)[BUCKETS], double fraction, uint32_t* ticks) {
+        uint64_t total = 0;
+        for (int b = 0; b < BUCKETS; b++) total += buckets[b];
+        if (ticks) *ticks = (uint32_t)total;
+        if (total == 0) return 0.0f;
+        uint64_t rank = (uint64_t)((double)total * fraction);
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += buckets[b];
+            if (seen > rank) return (float)UpperMs(b);
+        }
+        return (float)UpperMs(BUCKETS - 1);
+    }
+};
+
+#endif // DIGDUG_TICKHISTOGRAM_HPP_
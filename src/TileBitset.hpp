@@ -0,0 +1,209 @@
+#ifndef DIGDUG_TILEBITSET_HPP_
+#define DIGDUG_TILEBITSET_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "GridExtent.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ---------------------------------
+// Bit helpers
+// ---------------------------------
+inline int CountTrailingZeros64(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+inline int PopCount64(uint64_t v) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(v);
+#else
+    return __builtin_popcountll(v);
+#endif
+}
+
+// ---------------------------------
+// TileBitset
+// ---------------------------------
+// One bit per tile in a single contiguous, row-major allocation. Every row starts on a
+// 64-bit word boundary, so row scans never straddle rows and a whole row of up to 64
+// tiles is tested with one load. Bits past the row width are always zero.
+//
+// Over a FixedGrid the words live inline and every stride is a constant; TileBitset is the
+// run-time sized flavour.
+template <typename Grid>
+class BasicTileBitset {
+public:
+    static const int WORD_BITS = 64;
+
+    BasicTileBitset() { Resize(0, 0); }
+    BasicTileBitset(int width, int height) { Resize(width, height); }
+
+    // Clears every bit; a FixedGrid keeps its own size
+    void Resize(int width, int height) {
+        grid = Grid(width, height);
+        AssignTiles(words, (size_t)grid.WordsPerRow() * (size_t)grid.Height(), (uint64_t)0);
+    }
+
+    int Width() const { return grid.Width(); }
+    int Height() const { return grid.Height(); }
+    int WordsPerRow() const { return grid.WordsPerRow(); }
+    size_t WordCount() const { return words.size(); }
+
+    bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < Width() && y < Height(); }
+
+    bool Get(int x, int y) const {
+        return (words[Index(x, y)] >> (x % WORD_BITS)) & 1u;
+    }
+
+    void Set(int x, int y) {
+        words[Index(x, y)] |= Bit(x);
+    }
+
+    void Reset(int x, int y) {
+        words[Index(x, y)] &= ~Bit(x);
+    }
+
+    // Sets the bit and reports whether it was previously clear
+    bool TestAndSet(int x, int y) {
+        uint64_t& word = words[Index(x, y)];
+        uint64_t bit = Bit(x);
+        bool wasClear = (word & bit) == 0;
+        word |= bit;
+        return wasClear;
+    }
+
+    // Sets tiles [x, x + count) on row y
+    void SetRun(int x, int y, int count) {
+        while (count > 0) {
+            int offset = x % WORD_BITS;
+            int n = WORD_BITS - offset < count ? WORD_BITS - offset : count;
+            uint64_t mask = (n == WORD_BITS) ? ~0ull : (((1ull << n) - 1) << offset);
+            words[Index(x, y)] |= mask;
+            x += n;
+            count -= n;
+        }
+    }
+
+    // Sets tiles [x, x + count) on row y and calls fn(tileX) for each one that was clear
+    template <typename Fn>
+    void TestAndSetRun(int x, int y, int count, Fn fn) {
+        while (count > 0) {
+            int offset = x % WORD_BITS;
+            int n = WORD_BITS - offset < count ? WORD_BITS - offset : count;
+            uint64_t mask = (n == WORD_BITS) ? ~0ull : (((1ull << n) - 1) << offset);
+            uint64_t& word = words[Index(x, y)];
+            uint64_t fresh = mask & ~word;
+            word |= mask;
+            int base = x - offset;
+            while (fresh != 0) {
+                fn(base + CountTrailingZeros64(fresh));
+                fresh &= fresh - 1;
+            }
+            x += n;
+            count -= n;
+        }
+    }
+
+    void Clear() {
+        if (!words.empty()) std::memset(words.data(), 0, words.size() * sizeof(uint64_t));
+    }
+
+    uint64_t Word(int y, int wordIndex) const { return words[(size_t)y * WordsPerRow() + wordIndex]; }
+    const uint64_t* Row(int y) const { return words.data() + (size_t)y * WordsPerRow(); }
+    uint64_t* Row(int y) { return words.data() + (size_t)y * WordsPerRow(); }
+    const uint64_t* Data() const { return words.data(); }
+    uint64_t* Data() { return words.data(); }
+
+    // First set tile at or after fromX on row y, or Width() if there is none
+    int FindNextSet(int y, int fromX) const {
+        return FindNext(y, fromX, 0);
+    }
+
+    // First clear tile at or after fromX on row y, or Width() if there is none
+    int FindNextClear(int y, int fromX) const {
+        return FindNext(y, fromX, ~0ull);
+    }
+
+    // Calls fn(x, length) for each maximal horizontal run on row y of tiles that are set
+    // here and clear in `exclude` (which must have the same dimensions)
+    template <typename Fn>
+    void ForEachRunExcluding(int y, const BasicTileBitset& exclude, Fn fn) const {
+        const uint64_t* row = Row(y);
+        const uint64_t* ex = exclude.Row(y);
+        int runStart = -1;
+        for (int wi = 0; wi < WordsPerRow(); wi++) {
+            uint64_t bits = row[wi] & ~ex[wi];
+            int base = wi * WORD_BITS;
+            int bit = 0;
+            while (bit < WORD_BITS) {
+                // Look for the next 0->1 edge when outside a run, the next 1->0 edge inside one
+                uint64_t rest = (runStart < 0 ? bits : ~bits) >> bit;
+                if (rest == 0) break;
+                bit += CountTrailingZeros64(rest);
+                if (runStart < 0) {
+                    runStart = base + bit;
+                } else {
+                    fn(runStart, base + bit - runStart);
+                    runStart = -1;
+                }
+            }
+        }
+        if (runStart >= 0) fn(runStart, Width() - runStart);
+    }
+
+    // Calls fn(x, length) for each maximal horizontal run of set tiles on row y
+    template <typename Fn>
+    void ForEachRun(int y, Fn fn) const {
+        for (int x = FindNextSet(y, 0); x < Width();) {
+            int end = FindNextClear(y, x);
+            fn(x, end - x);
+            x = FindNextSet(y, end);
+        }
+    }
+
+    int Count() const {
+        int total = 0;
+        for (uint64_t word : words) total += PopCount64(word);
+        return total;
+    }
+
+private:
+    Grid grid;
+    typename Grid::Words words;
+
+    size_t Index(int x, int y) const { return (size_t)y * WordsPerRow() + (size_t)(x / WORD_BITS); }
+    static uint64_t Bit(int x) { return 1ull << (x % WORD_BITS); }
+
+    // Word-at-a-time scan; flip inverts the row so the same loop finds clear bits
+    int FindNext(int y, int fromX, uint64_t flip) const {
+        int w = Width();
+        if (fromX >= w) return w;
+        if (fromX < 0) fromX = 0;
+        const uint64_t* row = Row(y);
+        int wi = fromX / WORD_BITS;
+        uint64_t word = (row[wi] ^ flip) & (~0ull << (fromX % WORD_BITS));
+        while (true) {
+            if (word != 0) {
+                int x = wi * WORD_BITS + CountTrailingZeros64(word);
+                return x < w ? x : w;
+            }
+            if (++wi >= WordsPerRow()) return w;
+            word = row[wi] ^ flip;
+        }
+    }
+};
+
+using TileBitset = BasicTileBitset<DynamicGrid>;
+
+#endif // DIGDUG_TILEBITSET_HPP_
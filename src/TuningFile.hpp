@@ -0,0 +1,183 @@
+#ifndef DIGDUG_TUNINGFILE_HPP_
+#define DIGDUG_TUNINGFILE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "World.hpp"
+
+// ---------------------------------
+// Tuning files
+// ---------------------------------
+// Plain text, one "key = value" per line, # starts a comment. Keys not in the file keep the
+// value from the base tuning passed in, so a file only lists what it changes:
+//
+//   monster_chase = 1.4
+//   tunnels = 10
+//
+// Grid and tile sizes are not tunable; they fix the map and snapshot layout at build time.
+struct TuningKey {
+    const char* name;
+    float min, max;
+    float* (*floatField)(Tuning&);
+    int* (*intField)(Tuning&);
+};
+
+static const TuningKey TUNING_KEYS[] = {
+    { "monster_chase",      0.1f, 8.0f,   [](Tuning& t) { return &t.chaseSpeed[(int)EnemyKind::MONSTER]; }, nullptr },
+    { "dragon_chase",       0.1f, 8.0f,   [](Tuning& t) { return &t.chaseSpeed[(int)EnemyKind::DRAGON]; }, nullptr },
+    { "player_speed",       0.5f, 8.0f,   [](Tuning& t) { return &t.playerSpeed; }, nullptr },
+    { "harpoon_range",      8.0f, 400.0f, [](Tuning& t) { return &t.harpoonRange; }, nullptr },
+    { "horizontal_tunnels", 0.0f, 64.0f,  nullptr, [](Tuning& t) { return &t.horizontalTunnels; } },
+    { "tunnels",            0.0f, 64.0f,  nullptr, [](Tuning& t) { return &t.maxTunnels; } },
+    { "ai_interval",        1.0f, 60.0f,  nullptr, [](Tuning& t) { return &t.aiInterval; } },
+    { "start_lives",        1.0f, 9.0f,   nullptr, [](Tuning& t) { return &t.startLives; } },
+    { "respawn_delay",      1.0f, 600.0f, nullptr, [](Tuning& t) { return &t.respawnDelay; } },
+};
+
+// Applies text over out. On failure out is unchanged and error names the first bad line.
+inline bool ParseTuning(const char* text, Tuning& out, std::string& error) {
+    Tuning result = out;
+    int lineNumber = 0;
+    for (const char* line = text; *line;) {
+        const char* end = strchr(line, '\n');
+        if (!end) end = line + strlen(line);
+        lineNumber++;
+        std::string content(line, end);
+        line = *end ? end + 1 : end;
+
+        size_t hash = content.find('#');
+        if (hash != std::string::npos) content.resize(hash);
+        size_t eq = content.find('=');
+        auto trim = [](std::string s) {
+            size_t a = s.find_first_not_of(" \t\r"), b = s.find_last_not_of(" \t\r");
+            return a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+        };
+        std::string key = trim(content.substr(0, eq));
+        if (key.empty() && eq == std::string::npos) continue; // Blank or comment
+        std::string value = eq == std::string::npos ? std::string() : trim(content.substr(eq + 1));
+
+        const TuningKey* match = nullptr;
+        for (const TuningKey& k : TUNING_KEYS) {
+            if (key == k.name) match = &k;
+        }
+        char* parsedEnd = nullptr;
+        float number = value.empty() ? 0.0f : strtof(value.c_str(), &parsedEnd);
+        if (!match || value.empty() || *parsedEnd != '\0' || number < match->min || number > match->max) {
+            error = "line " + std::to_string(lineNumber) + ": " + (!match ? "unknown key '" + key + "'" : "bad value for " + key);
+            return false;
+        }
+        if (match->floatField) *match->floatField(result) = number;
+        else *match->intField(result) = (int)number;
+    }
+    out = result;
+    return true;
+}
+
+// Whole file as text; false if it can't be opened
+inline bool ReadTextFile(const char* path, std::string& out) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    out.clear();
+    char chunk[512];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) out.append(chunk, n);
+    fclose(file);
+    return true;
+}
+
+// ---------------------------------
+// TuningWatcher
+// ---------------------------------
+// Re-reads a tuning file on a background thread every POLL_MS and parses it there whenever
+// its contents change. The game thread picks up the result with Take() between ticks, which
+// costs one atomic load while nothing changed. Edits with errors are skipped (LastError()
+// says why) and the last good tuning stays in effect.
+class TuningWatcher {
+public:
+    static constexpr int POLL_MS = 500;
+
+    // Values missing from the file come from base
+    TuningWatcher(std::string path, const Tuning& base)
+        : path(std::move(path)), base(base), worker([this] { Run(); }) {}
+
+    ~TuningWatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    TuningWatcher(const TuningWatcher&) = delete;
+    TuningWatcher& operator=(const TuningWatcher&) = delete;
+
+    // New tuning parsed since the last call, if any
+    bool Take(Tuning& out) {
+        if (!fresh.load(std::memory_order_acquire)) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        out = latest;
+        fresh.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Empty once the file last read parsed cleanly
+    std::string LastError() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return error;
+    }
+
+    // Counts of good and rejected edits; poll these to notice either
+    int Reloads() const { return reloads.load(std::memory_order_relaxed); }
+    int Errors() const { return errors.load(std::memory_order_relaxed); }
+
+private:
+    std::string path;
+    Tuning base;
+    mutable std::mutex mutex; // Guards latest, error and stopping
+    std::condition_variable wake;
+    Tuning latest;
+    std::string error;
+    bool stopping = false;
+    std::atomic<bool> fresh{false};
+    std::atomic<int> reloads{0};
+    std::atomic<int> errors{0};
+    std::thread worker; // Last, so it starts after everything it touches
+
+    void Run() {
+        std::string seen, text, parseError;
+        bool haveSeen = false;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            lock.unlock();
+            bool changed = ReadTextFile(path.c_str(), text) && (!haveSeen || text != seen);
+            Tuning parsed = base;
+            bool ok = changed && ParseTuning(text.c_str(), parsed, parseError);
+            lock.lock();
+            if (changed) {
+                seen.swap(text);
+                haveSeen = true;
+                if (ok) {
+                    latest = parsed;
+                    error.clear();
+                    reloads.fetch_add(1, std::memory_order_relaxed);
+                    fresh.store(true, std::memory_order_release);
+                } else {
+                    error = parseError;
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            wake.wait_for(lock, std::chrono::milliseconds(POLL_MS), [this] { return stopping; });
+        }
+    }
+};
+
+#endif // DIGDUG_TUNINGFILE_HPP_
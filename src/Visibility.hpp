@@ -0,0 +1,130 @@
+#ifndef DIGDUG_VISIBILITY_HPP_
+#define DIGDUG_VISIBILITY_HPP_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "TileBitset.hpp"
+
+// ---------------------------------
+// VisibilityMap
+// ---------------------------------
+// How lit each tile is for the fog-of-war mode: the dug tiles the player could walk to in
+// at most `radius` steps, brightest close by and fading over the last FADE steps, plus the
+// undug tiles walling them in. Everything else is dark, however close.
+//
+// The search runs on the packed bitsets a word at a time: each step grows the frontier by
+// one tile in every direction with shifts, keeps the dug tiles not yet reached and carries
+// on from those, so a step costs one pass over the rows rather than a queue entry per tile.
+// Update() only searches again when the player has moved to another tile or the terrain was
+// replaced, which is when the result can change the most; tiles dug meanwhile show from the
+// player's next tile on. Not part of the simulation: nothing in the game reads it.
+template <typename Bits>
+class VisibilityMap {
+public:
+    static constexpr int FADE = 3;        // Steps over which the light falls off at the edge
+    static constexpr uint8_t LIT = 255;
+
+    explicit VisibilityMap(int radius = 6) : radius(radius) {}
+
+    int Radius() const { return radius; }
+    void SetRadius(int steps) {
+        radius = steps;
+        serial = -1; // Recompute on the next Update
+    }
+
+    // Searches again from the player's tile if it or the level changed; returns whether it did
+    bool Update(const Bits& dug, int tileX, int tileY, int levelSerial) {
+        if (tileX == fromX && tileY == fromY && levelSerial == serial) return false;
+        fromX = tileX;
+        fromY = tileY;
+        serial = levelSerial;
+        Compute(dug, tileX, tileY);
+        return true;
+    }
+
+    void Compute(const Bits& dug, int tileX, int tileY) {
+        if (reached.Width() != dug.Width() || reached.Height() != dug.Height()) {
+            reached.Resize(dug.Width(), dug.Height());
+            frontier.Resize(dug.Width(), dug.Height());
+            next.Resize(dug.Width(), dug.Height());
+        }
+        w = dug.Width();
+        h = dug.Height();
+        light.assign((size_t)w * (size_t)h, 0);
+        reached.Clear();
+        frontier.Clear();
+        if (!dug.InBounds(tileX, tileY)) return;
+
+        // The player's own tile counts as open even before it is dug out
+        frontier.Set(tileX, tileY);
+        reached.Set(tileX, tileY);
+        Stamp(tileX, tileY, 0);
+
+        const int words = dug.WordsPerRow();
+        const int tail = w % Bits::WORD_BITS;
+        const uint64_t lastMask = tail == 0 ? ~0ull : (1ull << tail) - 1;
+        for (int step = 1; step <= radius; step++) {
+            bool grew = false;
+            for (int y = 0; y < h; y++) {
+                const uint64_t* f = frontier.Row(y);
+                const uint64_t* above = y > 0 ? frontier.Row(y - 1) : nullptr;
+                const uint64_t* below = y + 1 < h ? frontier.Row(y + 1) : nullptr;
+                const uint64_t* open = dug.Row(y);
+                uint64_t* seen = reached.Row(y);
+                uint64_t* out = next.Row(y);
+                for (int wi = 0; wi < words; wi++) {
+                    // Frontier tiles' neighbours: left and right with the bits carried across
+                    // words, then the rows above and below
+                    uint64_t grow = f[wi] << 1 | f[wi] >> 1;
+                    if (wi > 0) grow |= f[wi - 1] >> (Bits::WORD_BITS - 1);
+                    if (wi + 1 < words) grow |= f[wi + 1] << (Bits::WORD_BITS - 1);
+                    if (above) grow |= above[wi];
+                    if (below) grow |= below[wi];
+                    if (wi + 1 == words) grow &= lastMask;
+                    grow &= ~seen[wi];
+
+                    // Walls are lit where the search meets them but don't let it through
+                    seen[wi] |= grow;
+                    out[wi] = grow & open[wi];
+                    StampWord(y, wi, grow, step);
+                    if (out[wi] != 0) grew = true;
+                }
+            }
+            if (!grew) break;
+            std::swap(frontier, next);
+        }
+    }
+
+    // 0 (dark) to LIT
+    uint8_t Light(int x, int y) const { return light[(size_t)y * (size_t)w + (size_t)x]; }
+    bool Visible(int x, int y) const { return Light(x, y) > 0; }
+
+    // Width() * Height() values, row-major
+    const uint8_t* Data() const { return light.data(); }
+    int Width() const { return w; }
+    int Height() const { return h; }
+
+private:
+    int radius;
+    int w = 0, h = 0;
+    int fromX = -1, fromY = -1;
+    int serial = -1;
+    Bits reached, frontier, next;
+    std::vector<uint8_t> light;
+
+    void Stamp(int x, int y, int step) {
+        int left = radius + 1 - step; // Steps of light left past this tile
+        light[(size_t)y * (size_t)w + (size_t)x] = left >= FADE ? LIT : (uint8_t)(LIT * left / FADE);
+    }
+
+    void StampWord(int y, int wordIndex, uint64_t bits, int step) {
+        while (bits != 0) {
+            Stamp(wordIndex * Bits::WORD_BITS + CountTrailingZeros64(bits), y, step);
+            bits &= bits - 1;
+        }
+    }
+};
+
+#endif // DIGDUG_VISIBILITY_HPP_
@@ -0,0 +1,1400 @@
+#ifndef DIGDUG_WORLD_HPP_
+#define DIGDUG_WORLD_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RaylibCpp.hpp"
+#include "EnemyScript.hpp"
+#include "FlowField.hpp"
+#include "JobPool.hpp"
+#include "LevelFile.hpp"
+#include "MemoryStats.hpp"
+#include "Events.hpp"
+#include "Profiler.hpp"
+#include "Rng.hpp"
+#include "Sequencer.hpp"
+#include "Snapshot.hpp"
+#include "SpatialHash.hpp"
+#include "SpriteBatch.hpp"
+#include "TileBitset.hpp"
+
+// Game simulation: everything a tick touches, with no window or input dependencies, so the
+// same World runs in the game and in headless tools. World is the arcade build, its grid fixed
+// at compile time; DynamicWorld is the same code with the size chosen at run time.
+
+// ---------------------------------
+// Grid & constants
+// ---------------------------------
+const int TILE_SIZE   = 32;
+const int GRID_WIDTH  = 25;
+const int GRID_HEIGHT = 18;
+
+// Map extent in pixels; the window shows at most a view-sized part of it (see main.cpp)
+const int SCREEN_W = GRID_WIDTH * TILE_SIZE;
+const int SCREEN_H = GRID_HEIGHT * TILE_SIZE;
+
+const int TUNNEL_MIN_LENGTH = 4;
+const int TUNNEL_MAX_LENGTH = 8;
+
+const int START_LIVES = 3;
+const int RESPAWN_DELAY = 180;   // 3 seconds @ 60 ticks/s
+const int DEATH_FLASH_TIME = 30; // 0.5 seconds @ 60 ticks/s
+const float HARPOON_RANGE = 50.0f; // Pixels from the player's centre
+
+// Fixed simulation rate. All speeds and timers are per tick, independent of the render rate.
+const int SIM_HZ = 60;
+const double SIM_DT = 1.0 / SIM_HZ;
+
+// Tunnel directions
+enum class TunnelDirection { HORIZONTAL, VERTICAL, NONE };
+
+// Input for one simulation tick. Held keys are sampled every frame; edges are latched
+// until a tick consumes them so presses aren't lost or repeated when the tick count per
+// frame varies.
+struct InputState {
+    bool left = false, right = false, up = false, down = false;
+    bool fire = false;    // Harpoon pressed
+    bool confirm = false; // ENTER / R / restart button pressed
+};
+
+// ---------------------------------
+// Helpers
+// ---------------------------------
+inline Rectangle MakeNormalizedRect(float x, float y, float w, float h) {
+    Rectangle r { x, y, w, h };
+    if (r.width < 0) { r.x += r.width; r.width *= -1; }
+    if (r.height < 0){ r.y += r.height; r.height *= -1; }
+    return r;
+}
+
+inline raylib::Vector2 LerpPos(const raylib::Vector2& from, const raylib::Vector2& to, float alpha) {
+    return from.Lerp(to, alpha);
+}
+
+// ---------------------------------
+// Tunnel structure
+// ---------------------------------
+struct Tunnel {
+    int startX, startY;
+    int length;
+    TunnelDirection direction;
+    bool dug = true; // Tunnels are visible from the start
+    bool activated = false; // Whether player has entered this tunnel
+    
+    Tunnel() : startX(0), startY(0), length(0), direction(TunnelDirection::NONE) {} // Filled in by snapshot loads
+    Tunnel(int x, int y, int len, TunnelDirection dir)
+        : startX(x), startY(y), length(len), direction(dir) {}
+    
+    bool Contains(int x, int y) const {
+        if (direction == TunnelDirection::HORIZONTAL) {
+            return y == startY && x >= startX && x < startX + length;
+        } else if (direction == TunnelDirection::VERTICAL) {
+            return x == startX && y >= startY && y < startY + length;
+        }
+        return false;
+    }
+    
+    bool Intersects(const Tunnel& other) const {
+        if (direction == TunnelDirection::HORIZONTAL && other.direction == TunnelDirection::HORIZONTAL) {
+            // Both horizontal - check if on same row and segments overlap
+            if (startY != other.startY) return false;
+            return !(startX + length <= other.startX || other.startX + other.length <= startX);
+        }
+        else if (direction == TunnelDirection::VERTICAL && other.direction == TunnelDirection::VERTICAL) {
+            // Both vertical - check if on same column and segments overlap
+            if (startX != other.startX) return false;
+            return !(startY + length <= other.startY || other.startY + other.length <= startY);
+        }
+        else {
+            // One horizontal, one vertical - check if they cross
+            if (direction == TunnelDirection::HORIZONTAL) {
+                // This is horizontal, other is vertical
+                return (other.startX >= startX && other.startX < startX + length) &&
+                       (startY >= other.startY && startY < other.startY + other.length);
+            } else {
+                // This is vertical, other is horizontal
+                return (startX >= other.startX && startX < other.startX + other.length) &&
+                       (other.startY >= startY && other.startY < startY + length);
+            }
+        }
+    }
+    
+    void Draw() const {
+        Color color = BLACK; // Tunnels are always black (dug)
+        if (direction == TunnelDirection::HORIZONTAL) {
+            DrawRectangle(startX * TILE_SIZE, startY * TILE_SIZE,
+                         length * TILE_SIZE, TILE_SIZE, color);
+        } else {
+            DrawRectangle(startX * TILE_SIZE, startY * TILE_SIZE,
+                         TILE_SIZE, length * TILE_SIZE, color);
+        }
+    }
+};
+
+// ---------------------------------
+// Game Objects
+// ---------------------------------
+class Player {
+public:
+    raylib::Vector2 pos;
+    raylib::Vector2 prevPos; // Position at the start of the current tick, for interpolation
+    int size = TILE_SIZE;
+    float speed = 2.0f;
+
+    bool alive = true;
+    int lives  = START_LIVES;
+
+    Color color = BLUE;
+
+    // Harpoon
+    bool hasHarpoon = false;
+    raylib::Vector2 harpoonDir{1,0};
+    int harpoonTimer = 0;         // frames remaining
+    float harpoonLength = HARPOON_RANGE; // Reach this tick: up to the first hit or undug tile
+    int score = 0;
+
+    Player(int x, int y) { pos = raylib::Vector2((float)x, (float)y); prevPos = pos; }
+
+    void ResetTo(int x, int y) {
+        pos = raylib::Vector2((float)x, (float)y);
+        prevPos = pos;
+        alive = true;
+        hasHarpoon = false;
+        harpoonTimer = 0;
+        harpoonDir = raylib::Vector2(1,0);
+        harpoonLength = HARPOON_RANGE;
+    }
+
+    // Advance the harpoon's timer by one tick
+    void TickTimers() {
+        if (harpoonTimer > 0) {
+            harpoonTimer--;
+            if (harpoonTimer <= 0) hasHarpoon = false;
+        }
+    }
+
+    // Moves within a map of mapW x mapH pixels
+    void Move(const InputState& in, float mapW, float mapH) {
+        if (in.right) { pos.x += speed; harpoonDir = raylib::Vector2(1, 0); }
+        if (in.left)  { pos.x -= speed; harpoonDir = raylib::Vector2(-1, 0); }
+        if (in.up)    { pos.y -= speed; harpoonDir = raylib::Vector2(0, -1); }
+        if (in.down)  { pos.y += speed; harpoonDir = raylib::Vector2(0, 1); }
+
+        // Keep on the map
+        if (pos.x < 0) pos.x = 0;
+        if (pos.y < 0) pos.y = 0;
+        if (pos.x > mapW - size) pos.x = mapW - size;
+        if (pos.y > mapH - size) pos.y = mapH - size;
+
+        // Fire harpoon
+        if (in.fire) {
+            hasHarpoon = true;
+            harpoonTimer = 15; // visible frames
+        }
+    }
+
+    void Draw(SpriteBatch& batch, float alpha) const {
+        raylib::Vector2 p = LerpPos(prevPos, pos, alpha);
+        p = raylib::Vector2((float)(int)p.x, (float)(int)p.y); // Whole pixels, like the old primitives
+        batch.Add(SpriteBatch::PLAYER, SpriteId::PLAYER, p.x, p.y, (float)size, (float)size, color);
+
+        if (hasHarpoon && harpoonTimer > 0) {
+            // One-pixel line from the centre, as a stretched pixel sprite
+            Rectangle line = MakeNormalizedRect(p.x + size/2, p.y + size/2,
+                                                harpoonDir.x != 0 ? harpoonDir.x*harpoonLength : 1.0f,
+                                                harpoonDir.y != 0 ? harpoonDir.y*harpoonLength : 1.0f);
+            batch.Add(SpriteBatch::HARPOON, SpriteId::PIXEL, line.x, line.y, line.width, line.height, RAYWHITE);
+        }
+    }
+
+    Rectangle Bounds() const {
+        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+    }
+};
+
+// Struct-of-arrays storage for every enemy, of every kind. Movement runs as straight loops
+// over contiguous floats: chasers pick a waypoint with their kind's chase program and a
+// per-axis velocity towards it, everyone integrates, then tunnel walkers bounce off their
+// tunnel ends.
+class EnemyStore {
+public:
+    enum Flags : uint8_t { ALIVE = 1, IN_TUNNEL = 2, CHASING = 4 };
+
+    std::vector<float> x, y;         // Position (top-left)
+    std::vector<float> prevX, prevY; // Position at the start of the current tick
+    std::vector<float> vx, vy;       // Velocity for this tick
+    std::vector<float> wpX, wpY;     // Chasers: waypoint from the last decision
+    std::vector<float> chaseSpeed;
+    std::vector<int> tunnel;         // Home tunnel index into World::tunnels
+    std::vector<EnemyKind> kind;
+    std::vector<uint8_t> flags;
+    int size = TILE_SIZE;
+    uint32_t aiTick = 0; // Moves so far, picks which chasers decide this tick
+    const EnemyScript* script = &EnemyScript::Builtin(); // Kinds' looks, scores and programs; set by World
+
+    size_t Size() const { return x.size(); }
+
+    void Clear() {
+        x.clear(); y.clear(); prevX.clear(); prevY.clear();
+        vx.clear(); vy.clear(); wpX.clear(); wpY.clear(); chaseSpeed.clear();
+        tunnel.clear(); kind.clear(); flags.clear();
+    }
+
+    // Capacity for n enemies, so Clear/Add cycles up to n never reallocate
+    void Reserve(size_t n) {
+        x.reserve(n); y.reserve(n); prevX.reserve(n); prevY.reserve(n);
+        vx.reserve(n); vy.reserve(n); wpX.reserve(n); wpY.reserve(n); chaseSpeed.reserve(n);
+        tunnel.reserve(n); kind.reserve(n); flags.reserve(n);
+    }
+
+    // Spawns an enemy patrolling its home tunnel, initially heading right/down
+    void Add(EnemyKind k, int px, int py, const Tunnel& home, int homeIndex, float chase) {
+        const EnemyKindInfo& info = script->Get(k).info;
+        bool horizontal = home.direction == TunnelDirection::HORIZONTAL;
+        x.push_back((float)px);
+        y.push_back((float)py);
+        prevX.push_back((float)px);
+        prevY.push_back((float)py);
+        vx.push_back(horizontal ? info.speed : 0.0f);
+        vy.push_back(horizontal ? 0.0f : info.speed);
+        wpX.push_back((float)px); // Already reached, so the first chasing tick decides
+        wpY.push_back((float)py);
+        chaseSpeed.push_back(chase);
+        tunnel.push_back(homeIndex);
+        kind.push_back(k);
+        flags.push_back(ALIVE | IN_TUNNEL);
+    }
+
+    bool Alive(size_t i) const { return (flags[i] & ALIVE) != 0; }
+    bool Chasing(size_t i) const { return (flags[i] & CHASING) != 0; }
+
+    bool AnyAlive() const {
+        for (uint8_t f : flags) if (f & ALIVE) return true;
+        return false;
+    }
+
+    void Kill(size_t i) {
+        flags[i] &= (uint8_t)~ALIVE;
+        vx[i] = vy[i] = 0.0f;
+    }
+
+    // Leave the home tunnel and start chasing the player
+    void Release(size_t i) {
+        flags[i] = (uint8_t)((flags[i] & ~IN_TUNNEL) | CHASING);
+    }
+
+    void SavePrev() {
+        prevX = x;
+        prevY = y;
+    }
+
+    // Ranges of at least this many enemies are worth handing to another thread
+    static constexpr size_t PARALLEL_GRAIN = 1024;
+
+    // Advance every live enemy by one tick. Chasers re-decide their waypoint every
+    // thinkInterval ticks, staggered by index so only 1/thinkInterval of them decide per tick.
+    // Each enemy only reads shared state and writes its own slots, so with a pool the store is
+    // split into fixed ranges and moved in parallel with the same result as a serial move.
+    void Move(const std::vector<Tunnel>& tunnels, const FlowField& flow, const raylib::Vector2& target,
+              int thinkInterval = 1, JobPool* pool = nullptr) {
+        PROFILE_ZONE("enemy move");
+        const size_t interval = thinkInterval > 1 ? (size_t)thinkInterval : 1;
+        const size_t phase = aiTick++ % interval;
+        if (pool && Size() > PARALLEL_GRAIN) {
+            pool->ParallelForRange(Size(), PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+                MoveRange(begin, end, tunnels, flow, target, interval, phase);
+            });
+        } else {
+            MoveRange(0, Size(), tunnels, flow, target, interval, phase);
+        }
+    }
+
+    // Moves enemies [begin, end); see Move
+    void MoveRange(size_t begin, size_t end, const std::vector<Tunnel>& tunnels, const FlowField& flow,
+                   const raylib::Vector2& target, size_t interval, size_t phase) {
+        float* px = x.data();
+        float* py = y.data();
+        float* pvx = vx.data();
+        float* pvy = vy.data();
+        float* pwx = wpX.data();
+        float* pwy = wpY.data();
+        const float* cs = chaseSpeed.data();
+        const uint8_t* f = flags.data();
+        const EnemyKind* k = kind.data();
+        const EnemyScript& programs = *script;
+
+        // Deciding: each chaser's kind program picks its waypoint (see Decide). Between
+        // decisions they keep steering at the old waypoint, and one that has been reached is
+        // replaced straight away. Steps are clamped so nobody overshoots a waypoint.
+        for (size_t i = begin; i < end; i++) {
+            if ((f[i] & (ALIVE | IN_TUNNEL | CHASING)) != (ALIVE | CHASING)) continue;
+            float dx = pwx[i] - px[i];
+            float dy = pwy[i] - py[i];
+            if (interval == 1 || i % interval == phase || std::fabs(dx) + std::fabs(dy) < 0.5f) {
+                const uint8_t* code = programs.Get(k[i]).chase;
+                float wx, wy;
+                // Plain flow followers, the built-in kinds among them, skip the interpreter
+                if (code[0] == (uint8_t)ChaseOp::FLOW) FlowWaypoint(flow, target, px[i], py[i], wx, wy);
+                else Decide(code, flow, target, px[i], py[i], wx, wy);
+                pwx[i] = wx;
+                pwy[i] = wy;
+                dx = wx - px[i];
+                dy = wy - py[i];
+            }
+            pvx[i] = dx > 0 ? std::min(dx, cs[i]) : std::max(dx, -cs[i]);
+            pvy[i] = dy > 0 ? std::min(dy, cs[i]) : std::max(dy, -cs[i]);
+        }
+
+        // Dead enemies have zero velocity, so no mask is needed here
+        for (size_t i = begin; i < end; i++) {
+            px[i] += pvx[i];
+            py[i] += pvy[i];
+        }
+
+        // Tunnel walkers reverse at either end of their tunnel
+        for (size_t i = begin; i < end; i++) {
+            if ((f[i] & (ALIVE | IN_TUNNEL)) != (ALIVE | IN_TUNNEL)) continue;
+            const Tunnel& home = tunnels[tunnel[i]];
+            if (home.direction == TunnelDirection::HORIZONTAL) {
+                int gridX = static_cast<int>(px[i]) / TILE_SIZE;
+                if (gridX <= home.startX || gridX >= home.startX + home.length - 1) pvx[i] = -pvx[i];
+            } else {
+                int gridY = static_cast<int>(py[i]) / TILE_SIZE;
+                if (gridY <= home.startY || gridY >= home.startY + home.length - 1) pvy[i] = -pvy[i];
+            }
+        }
+    }
+
+    // Runs a chase program (see ChaseOp) for an enemy at (ex, ey), writing its next waypoint.
+    // The player's tile distance is only worked out once a guard needs it.
+    void Decide(const uint8_t* code, const FlowField& flow, const raylib::Vector2& target, float ex, float ey,
+                float& wx, float& wy) const {
+        int tx = (int)((ex + size * 0.5f) / TILE_SIZE);
+        int ty = (int)((ey + size * 0.5f) / TILE_SIZE);
+        int distance = -1;
+        for (const uint8_t* op = code;; op += 2) {
+            switch ((ChaseOp)op[0]) {
+                case ChaseOp::NEAR:
+                case ChaseOp::FAR: {
+                    if (distance < 0) {
+                        int gx = (int)((target.x + size * 0.5f) / TILE_SIZE);
+                        int gy = (int)((target.y + size * 0.5f) / TILE_SIZE);
+                        distance = std::abs(gx - tx) + std::abs(gy - ty);
+                    }
+                    bool within = distance <= op[1];
+                    if (within != ((ChaseOp)op[0] == ChaseOp::NEAR)) op += 2; // Skip the guarded move
+                    break;
+                }
+                case ChaseOp::DIRECT:
+                    wx = target.x;
+                    wy = target.y;
+                    return;
+                case ChaseOp::FLEE: {
+                    // Off the dug area nothing is further away, so the enemy holds its tile
+                    wx = (float)(tx * TILE_SIZE);
+                    wy = (float)(ty * TILE_SIZE);
+                    if (!flow.InBounds(tx, ty)) return;
+                    uint16_t best = flow.Distance(tx, ty);
+                    static const int NX[4] = { -1, 1, 0, 0 }, NY[4] = { 0, 0, -1, 1 };
+                    for (int n = 0; n < 4; n++) {
+                        int nx = tx + NX[n], ny = ty + NY[n];
+                        if (!flow.InBounds(nx, ny)) continue;
+                        uint16_t d = flow.Distance(nx, ny);
+                        if (d == FlowField::UNREACHED || best == FlowField::UNREACHED || d <= best) continue;
+                        best = d;
+                        wx = (float)(nx * TILE_SIZE);
+                        wy = (float)(ny * TILE_SIZE);
+                    }
+                    return;
+                }
+                default: // FLOW, and the end of a program
+                    FlowWaypoint(flow, target, ex, ey, wx, wy);
+                    return;
+            }
+        }
+    }
+
+    // The next tile on the flow field's shortest dug path to the target. Off the dug area, or
+    // once on the target's tile, straight for the target.
+    void FlowWaypoint(const FlowField& flow, const raylib::Vector2& target, float ex, float ey, float& wx,
+                      float& wy) const {
+        wx = target.x;
+        wy = target.y;
+        int tx = (int)((ex + size * 0.5f) / TILE_SIZE);
+        int ty = (int)((ey + size * 0.5f) / TILE_SIZE);
+        if (flow.InBounds(tx, ty)) {
+            FlowField::Step s = flow.StepAt(tx, ty);
+            if (s != FlowField::NONE) {
+                wx = (float)((tx + FlowField::StepX(s)) * TILE_SIZE);
+                wy = (float)((ty + FlowField::StepY(s)) * TILE_SIZE);
+            }
+        }
+    }
+
+    Rectangle Bounds(size_t i) const {
+        return Rectangle{ x[i], y[i], (float)size, (float)size };
+    }
+
+    void Draw(SpriteBatch& batch, float alpha) const {
+        for (size_t i = 0; i < Size(); i++) {
+            if (!Alive(i)) continue;
+            const EnemyScript::Type& type = script->Get(kind[i]);
+            Color color = Chasing(i) ? type.info.chaseColor : type.info.color;
+            raylib::Vector2 p = LerpPos(raylib::Vector2(prevX[i], prevY[i]), raylib::Vector2(x[i], y[i]), alpha);
+            batch.Add(SpriteBatch::ENEMIES, type.sprite, (float)(int)p.x, (float)(int)p.y, (float)size, (float)size,
+                      color);
+        }
+    }
+};
+
+class Fruit {
+public:
+    raylib::Vector2 pos;
+    int size = TILE_SIZE;
+    bool collected = false;
+
+    Fruit(int x, int y) { pos = raylib::Vector2((float)x, (float)y); }
+
+    void Draw(SpriteBatch& batch) const {
+        if (!collected) batch.Add(SpriteBatch::PICKUPS, SpriteId::FRUIT, pos.x, pos.y, (float)size, (float)size, WHITE);
+    }
+
+    Rectangle Bounds() const {
+        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+    }
+};
+
+// Entities refer to each other by index, never by pointer, so copying a World (snapshots,
+// replays, parallel runs) copies plain values and nothing dangles when vectors reallocate
+static_assert(std::is_trivially_copyable<Tunnel>::value, "Tunnel must stay trivially copyable");
+static_assert(std::is_trivially_copyable<Player>::value, "Player must stay trivially copyable");
+static_assert(std::is_trivially_copyable<Fruit>::value, "Fruit must stay trivially copyable");
+
+// ---------------------------------
+// Collision ids
+// ---------------------------------
+// Entities in the spatial hash are identified by kind in the top byte and index below
+enum class HashKind : uint32_t { ENEMY, FRUIT };
+
+inline uint32_t MakeHashId(HashKind kind, size_t index) { return ((uint32_t)kind << 24) | (uint32_t)index; }
+inline HashKind HashIdKind(uint32_t id) { return (HashKind)(id >> 24); }
+inline size_t HashIdIndex(uint32_t id) { return id & 0xFFFFFFu; }
+
+// ---------------------------------
+// Game state
+// ---------------------------------
+enum class GameState { SPLASH, PLAYING, GAMEOVER, WIN };
+
+// The world's timed sequences (see BasicWorld::Step), each run in the state it was started in
+enum class Sequence : uint8_t {
+    TITLE,    // SPLASH: waits for confirm, then starts the first level
+    RESPAWN,  // PLAYING: holds play for the respawn delay, then restarts the level
+    GAME_END, // GAMEOVER or WIN: waits for confirm, then back to the title
+};
+
+// Balance knobs that tuning runs sweep; defaults are the shipped values
+struct Tuning {
+    float chaseSpeed[2] = { ENEMY_KINDS[0].chaseSpeed, ENEMY_KINDS[1].chaseSpeed }; // By EnemyKind
+    int horizontalTunnels = 4; // Horizontal tunnels attempted first
+    int maxTunnels = 8;        // Vertical tunnels fill up to this total
+    int aiInterval = 1;        // Ticks between a chaser's path decisions (staggered); moves are every tick
+    int startLives = START_LIVES;
+    int respawnDelay = RESPAWN_DELAY;   // Ticks
+    float playerSpeed = 2.0f;           // Pixels per tick
+    float harpoonRange = HARPOON_RANGE; // Pixels from the player's centre
+
+    bool operator==(const Tuning& o) const {
+        return chaseSpeed[0] == o.chaseSpeed[0] && chaseSpeed[1] == o.chaseSpeed[1]
+            && horizontalTunnels == o.horizontalTunnels && maxTunnels == o.maxTunnels && aiInterval == o.aiInterval
+            && startLives == o.startLives && respawnDelay == o.respawnDelay && playerSpeed == o.playerSpeed
+            && harpoonRange == o.harpoonRange;
+    }
+    bool operator!=(const Tuning& o) const { return !(*this == o); }
+};
+
+template <typename Grid>
+class BasicLevelPregen;
+
+// The arcade map. World is built for exactly this size; DynamicWorld takes one at run time.
+using ArcadeGrid = FixedGrid<GRID_WIDTH, GRID_HEIGHT>;
+
+template <typename Grid>
+struct BasicWorld {
+    using Pregen = BasicLevelPregen<Grid>;
+    using Bitset = BasicTileBitset<Grid>;
+
+    Grid grid; // First: the members below are sized from it
+
+    explicit BasicWorld(const Grid& grid = Grid(GRID_WIDTH, GRID_HEIGHT)) : grid(grid) {}
+
+    Player player{100,100};
+    Player partner{100 + 2*TILE_SIZE, 100}; // Second player in co-op; the team's lives and score live on player
+    bool coop = false; // Session setting like tuning: kept across levels, respawns and snapshot loads
+    EnemyStore enemies;
+    std::vector<Tunnel> tunnels;
+    Fruit fruit{MapWidth()/2 - TILE_SIZE/2, MapHeight()/2 - TILE_SIZE/2};
+    Bitset dug{ grid.Width(), grid.Height() };
+    Bitset tunnelTiles{ grid.Width(), grid.Height() }; // Tiles covered by tunnels: the free-space mask for placement
+    std::vector<int> dirtyTiles; // Tiles (y * grid.Width() + x) dug since the renderer last synced
+    int levelSerial = 0;         // Bumped whenever the terrain is replaced wholesale (new level, snapshot load)
+    GameState state = GameState::SPLASH;
+    int highScore = 0;
+
+    Sequencer sequences;
+
+    Tuning tuning;
+    Rng rng; // Drives level generation; seed it for reproducible levels
+
+    SpatialHash hash{ (float)TILE_SIZE, grid.Width(), grid.Height() };
+
+    // Paths to the player's tile over dug tiles, for chasers
+    FlowField flow{ grid.Width(), grid.Height() };
+    bool flowDirty = true; // Level regenerated since the last Build; single digs are patched in
+
+    // Tunnel lookup, rebuilt in ResetLevel. tunnelAt holds each tile's tunnel index (-1 for
+    // none); residents lists the enemy indices living in tunnel t in
+    // residents[residentStart[t], residentStart[t + 1]).
+    typename Grid::template TileArray<int16_t> tunnelAt = MakeTunnelAt(grid);
+    std::vector<int> residentStart;
+    std::vector<uint32_t> residents;
+    std::vector<int> residentCursor; // Scratch for the counting sort
+
+    bool invulnerable = false; // Stress runs: enemy contact is ignored so the level never resets
+
+    std::vector<uint8_t> levelStart; // Snapshot taken as each level is generated; respawns restore it
+
+    Pregen* pregen = nullptr; // Generates the next level in the background; null generates in place
+    const LevelPack* levels = nullptr; // Played in order in place of generated levels when set
+    int levelIndex = 0;  // Pack level being played
+    bool endless = false; // Packs start over after their last level instead of ending in a win
+
+    EventBus events; // Filled during Update, dispatched at the end of it
+    JobPool* jobs = nullptr; // Moves big enemy crowds across worker threads; null moves them inline
+
+    // Map size in pixels
+    int MapWidth() const { return grid.Width() * TILE_SIZE; }
+    int MapHeight() const { return grid.Height() * TILE_SIZE; }
+
+    static typename Grid::template TileArray<int16_t> MakeTunnelAt(const Grid& grid) {
+        typename Grid::template TileArray<int16_t> tiles;
+        AssignTiles(tiles, grid.Tiles(), (int16_t)-1);
+        return tiles;
+    }
+
+    // Switches tuning between ticks. Chase speeds apply to the enemies already out; tunnel
+    // counts and lives take effect from the next level and game.
+    void ApplyTuning(const Tuning& next) {
+        tuning = next;
+        for (size_t i = 0; i < enemies.Size(); i++) enemies.chaseSpeed[i] = ChaseSpeed(enemies.kind[i]);
+    }
+
+    // Monsters and dragons chase as tuned; the script's own kinds as it says
+    float ChaseSpeed(EnemyKind k) const {
+        return (int)k < 2 ? tuning.chaseSpeed[(int)k] : enemies.script->Get(k).info.chaseSpeed;
+    }
+
+    // Switches the enemy kinds; takes effect from the next level, which the caller should
+    // start (ResetAll), since enemies already out may be of kinds the new script lacks. The
+    // script must outlive the world.
+    void SetEnemyScript(const EnemyScript& script) { enemies.script = &script; }
+
+    // Called once per finished game; subscribers to GAME_ENDED persist it
+    void SaveHighScore() {
+        if (player.score > highScore) highScore = player.score;
+        events.Push(EventType::GAME_ENDED, player.score, (int)state);
+    }
+
+    void SetState(GameState next) {
+        if (next == state) return;
+        events.Push(EventType::STATE_CHANGED, (int)state, (int)next);
+        state = next;
+    }
+
+    void AddScore(int points) {
+        player.score += points;
+        events.Push(EventType::SCORE, points, player.score);
+    }
+
+    // Counts the placements of a tunnel of this direction and length that lie inside the
+    // generation bounds and cover only free tiles of tunnelTiles. When pick is in range, the
+    // pick-th placement (in scan order) is written to outX/outY.
+    int CountPlacements(TunnelDirection dir, int length, int pick, int& outX, int& outY) const {
+        const int w = tunnelTiles.Width(), h = tunnelTiles.Height();
+        int count = 0;
+        if (dir == TunnelDirection::HORIZONTAL) {
+            // Start columns [2, w - 9], kept one tile clear of the right edge
+            int xMin = 2, xMax = std::min(w - 9, w - 2 - length);
+            for (int y = 2; y <= h - 3; y++) {
+                for (int x = tunnelTiles.FindNextClear(y, 0); x < w;) {
+                    int end = tunnelTiles.FindNextSet(y, x);
+                    int lo = std::max(x, xMin), hi = std::min(end - length, xMax);
+                    if (hi >= lo) {
+                        int n = hi - lo + 1;
+                        if (pick >= count && pick < count + n) { outX = lo + pick - count; outY = y; }
+                        count += n;
+                    }
+                    x = tunnelTiles.FindNextClear(y, end);
+                }
+            }
+        } else {
+            // Start rows [2, h - 9], kept one tile clear of the bottom edge
+            int yMin = 2, yMax = std::min(h - 9, h - 2 - length);
+            for (int x = 2; x <= w - 3; x++) {
+                int runStart = 0;
+                for (int y = 0; y <= h; y++) {
+                    if (y < h && !tunnelTiles.Get(x, y)) continue;
+                    int lo = std::max(runStart, yMin), hi = std::min(y - length, yMax);
+                    if (hi >= lo) {
+                        int n = hi - lo + 1;
+                        if (pick >= count && pick < count + n) { outX = x; outY = lo + pick - count; }
+                        count += n;
+                    }
+                    runStart = y + 1;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Adds one tunnel drawn uniformly from every free (position, length) placement. Each call
+    // is one scan of the occupancy mask per length, and fails only when nothing fits.
+    bool PlaceRandomTunnel(TunnelDirection dir) {
+        int unused = 0;
+        int counts[TUNNEL_MAX_LENGTH + 1] = {};
+        int total = 0;
+        for (int len = TUNNEL_MIN_LENGTH; len <= TUNNEL_MAX_LENGTH; len++) {
+            counts[len] = CountPlacements(dir, len, -1, unused, unused);
+            total += counts[len];
+        }
+        if (total == 0) return false;
+
+        int pick = (int)rng.Below((uint32_t)total);
+        int length = TUNNEL_MIN_LENGTH;
+        while (pick >= counts[length]) pick -= counts[length++];
+        int x = 0, y = 0;
+        CountPlacements(dir, length, pick, x, y);
+        AddTunnel(Tunnel(x, y, length, dir));
+        return true;
+    }
+
+    // Appends a tunnel and carves it into the dug and occupancy masks
+    void AddTunnel(const Tunnel& tunnel) {
+        tunnels.push_back(tunnel);
+        if (tunnel.direction == TunnelDirection::HORIZONTAL) {
+            dug.SetRun(tunnel.startX, tunnel.startY, tunnel.length);
+            tunnelTiles.SetRun(tunnel.startX, tunnel.startY, tunnel.length);
+        } else {
+            for (int y = tunnel.startY; y < tunnel.startY + tunnel.length; y++) {
+                dug.Set(tunnel.startX, y);
+                tunnelTiles.Set(tunnel.startX, y);
+            }
+        }
+    }
+
+    // Expects dug and tunnelTiles to be clear
+    void CreateTunnels() {
+        tunnels.clear();
+        while ((int)tunnels.size() < tuning.horizontalTunnels && PlaceRandomTunnel(TunnelDirection::HORIZONTAL)) {}
+        while ((int)tunnels.size() < tuning.maxTunnels && PlaceRandomTunnel(TunnelDirection::VERTICAL)) {}
+    }
+
+    // Grows level storage to fit the current tuning. Every container is only ever cleared
+    // afterwards, so respawns and level transitions don't touch the heap.
+    void ReserveStorage() {
+        // At most one enemy of each kind spawns per tunnel
+        size_t maxTunnels = (size_t)std::max(tuning.maxTunnels, tuning.horizontalTunnels);
+        size_t maxEnemies = maxTunnels * (size_t)enemies.script->Count();
+        tunnels.reserve(maxTunnels);
+        enemies.Reserve(maxEnemies);
+        residentStart.reserve(maxTunnels + 1);
+        residentCursor.reserve(maxTunnels + 1);
+        residents.reserve(maxEnemies);
+        dirtyTiles.reserve(grid.Tiles());
+        levelStart.reserve(SnapshotBound(maxEnemies));
+    }
+
+    // Empties the terrain and the enemy list and puts the players at their start
+    void BeginLevel() {
+        ReserveStorage();
+        dug.Clear();
+        tunnelTiles.Clear();
+        dirtyTiles.clear();
+        levelSerial++;
+        flowDirty = true;
+        player.ResetTo(100,100);
+        partner.ResetTo(100 + 2*TILE_SIZE, 100);
+        partner.color = ORANGE;
+        enemies.Clear();
+    }
+
+    // Once tunnels and enemies are in: indexes them and records the level start
+    void FinishLevel() {
+        fruit.collected = false;
+        BuildTunnelIndex();
+        SaveSnapshot(levelStart, false);
+    }
+
+    // Runs a spawn program (see SpawnOp) for tunnel t
+    bool SpawnAllowed(const uint8_t* code, int t) {
+        const Tunnel& tunnel = tunnels[t];
+        for (const uint8_t* op = code;; op += 2) {
+            switch ((SpawnOp)op[0]) {
+                case SpawnOp::END: return true;
+                case SpawnOp::NEVER: return false;
+                case SpawnOp::COIN:
+                    if (!rng.Coin()) return false;
+                    break;
+                case SpawnOp::CHANCE:
+                    if (rng.Below(100) >= op[1]) return false;
+                    break;
+                case SpawnOp::EMPTY:
+                    for (int home : enemies.tunnel) {
+                        if (home == t) return false;
+                    }
+                    break;
+                case SpawnOp::HORIZONTAL:
+                    if (tunnel.direction != TunnelDirection::HORIZONTAL) return false;
+                    break;
+                case SpawnOp::VERTICAL:
+                    if (tunnel.direction != TunnelDirection::VERTICAL) return false;
+                    break;
+                case SpawnOp::LONG:
+                    if (tunnel.length < op[1]) return false;
+                    break;
+                default: return false;
+            }
+        }
+    }
+
+    void ResetLevel() {
+        BeginLevel();
+        
+        CreateTunnels(); // Also marks the tunnels dug
+        
+        // Each kind in turn goes through the tunnels, its spawn program picking the ones that
+        // get one, placed halfway along
+        const EnemyScript& script = *enemies.script;
+        for (int k = 0; k < script.Count(); k++) {
+            const uint8_t* spawn = script.Get((EnemyKind)k).spawn;
+            for (int t = 0; t < (int)tunnels.size(); t++) {
+                if (!SpawnAllowed(spawn, t)) continue;
+                const Tunnel& tunnel = tunnels[t];
+                int x, y;
+                if (tunnel.direction == TunnelDirection::HORIZONTAL) {
+                    x = (tunnel.startX + tunnel.length / 2) * TILE_SIZE;
+                    y = tunnel.startY * TILE_SIZE;
+                } else {
+                    x = tunnel.startX * TILE_SIZE;
+                    y = (tunnel.startY + tunnel.length / 2) * TILE_SIZE;
+                }
+                enemies.Add((EnemyKind)k, x, y, tunnel, t, ChaseSpeed((EnemyKind)k));
+            }
+        }
+
+        FinishLevel();
+    }
+
+    // Builds the level from a level file instead of generating one (rng is left alone). False,
+    // with the world left mid-reset, if the file is for another grid size or a record is out of
+    // range; ResetLevel then gets back to a playable state.
+    bool LoadLevel(const LevelView& level) {
+        if (!level.Valid() || level.Width() != grid.Width() || level.Height() != grid.Height()) return false;
+        BeginLevel();
+        std::memcpy(dug.Data(), level.Dug(), level.DugWords() * sizeof(uint64_t));
+
+        tunnels.clear();
+        tunnels.reserve(level.TunnelCount());
+        for (int t = 0; t < level.TunnelCount(); t++) {
+            const LevelFile::TunnelRecord& r = level.Tunnels()[t];
+            bool vertical = r.direction == 1;
+            int endX = r.x + (vertical ? 1 : r.length), endY = r.y + (vertical ? r.length : 1);
+            if (r.direction > 1 || r.length == 0 || endX > grid.Width() || endY > grid.Height()) return false;
+            AddTunnel(Tunnel(r.x, r.y, r.length, vertical ? TunnelDirection::VERTICAL : TunnelDirection::HORIZONTAL));
+        }
+
+        enemies.Reserve(level.SpawnCount());
+        for (int i = 0; i < level.SpawnCount(); i++) {
+            const LevelFile::SpawnRecord& r = level.Spawns()[i];
+            if (r.tunnel >= tunnels.size() || r.kind >= enemies.script->Count() || r.x >= grid.Width()
+                || r.y >= grid.Height())
+                return false;
+            EnemyKind k = (EnemyKind)r.kind;
+            enemies.Add(k, r.x * TILE_SIZE, r.y * TILE_SIZE, tunnels[r.tunnel], r.tunnel, ChaseSpeed(k));
+        }
+
+        FinishLevel();
+        return true;
+    }
+
+    // Appends the current level's layout as a level file image; call while the level is at
+    // its start, since enemy positions are taken as the spawn points
+    void WriteLevel(std::vector<uint8_t>& out) const {
+        LevelWriter writer(grid.Width(), grid.Height());
+        std::memcpy(writer.DugWords(), dug.Data(), dug.WordCount() * sizeof(uint64_t));
+        for (const Tunnel& t : tunnels)
+            writer.AddTunnel(t.startX, t.startY, t.length, t.direction == TunnelDirection::VERTICAL);
+        for (size_t i = 0; i < enemies.Size(); i++)
+            writer.AddSpawn((int)enemies.x[i] / TILE_SIZE, (int)enemies.y[i] / TILE_SIZE, enemies.tunnel[i], (int)enemies.kind[i]);
+        writer.Write(out);
+    }
+
+    // Moves to a freshly generated level. Generation only reads rng and tuning, so when the
+    // pregen worker has already built the level for this rng it is adopted as is, and the
+    // world ends up exactly as ResetLevel would have left it.
+    void NextLevel();
+
+    // Takes over a level-start image generated by another world (swapped into levelStart),
+    // keeping lives, score and game state
+    bool AdoptLevel(std::vector<uint8_t>& image) {
+        int lives = player.lives, score = player.score;
+        GameState current = state;
+        Sequencer running = sequences;
+        if (!LoadSnapshot(image)) return false;
+        player.lives = lives;
+        player.score = score;
+        state = current;
+        sequences = running;
+        levelStart.swap(image);
+        return true;
+    }
+
+    // Puts the current level back the way it was generated, keeping score, lives and the
+    // running sequences (the respawn one calls this)
+    void RestartLevel() {
+        int lives = player.lives, score = player.score;
+        Sequencer running = sequences;
+        if (!LoadSnapshot(levelStart)) {
+            ResetLevel();
+            return;
+        }
+        player.lives = lives;
+        player.score = score;
+        state = GameState::PLAYING;
+        sequences = running;
+    }
+
+    // -------------------------
+    // Snapshots
+    // -------------------------
+    // The whole simulation state as one flat image, so a loaded world plays on exactly as the
+    // saved one would. The spatial hash is rebuilt every tick and skipped; tuning, the high
+    // score and its path belong to the session rather than the game and are left alone.
+    //
+    // Full snapshots carry the level-start image too, so a rolled-back world still respawns
+    // into the right level. The level-start image itself is saved without one.
+    static constexpr uint32_t SNAPSHOT_MAGIC = 0x32534444; // "DDS2"
+
+    void SaveSnapshot(std::vector<uint8_t>& out, bool withLevelStart = true) const {
+        SnapshotWriter writer(out);
+        uint32_t header[5] = { SNAPSHOT_MAGIC, (uint32_t)grid.Width(), (uint32_t)grid.Height(), SnapshotLayout(), withLevelStart ? 1u : 0u };
+        writer.Pod(header);
+        Transfer(writer, *this);
+        if (withLevelStart) writer.Vector(levelStart);
+    }
+
+    // False if the image is from another build or truncated; the world is then partly
+    // overwritten and should be reset
+    bool LoadSnapshot(const std::vector<uint8_t>& in) {
+        SnapshotReader reader(in);
+        uint32_t header[5] = {};
+        reader.Pod(header);
+        if (!reader.Ok() || header[0] != SNAPSHOT_MAGIC || header[1] != (uint32_t)grid.Width() || header[2] != (uint32_t)grid.Height()
+            || header[3] != SnapshotLayout())
+            return false;
+        Transfer(reader, *this);
+        if (header[4]) reader.Vector(levelStart);
+        if (!reader.Ok() || !reader.AtEnd()) return false;
+        for (EnemyKind k : enemies.kind) {
+            if ((int)k >= enemies.script->Count()) return false; // Saved with another enemy script
+        }
+
+        dirtyTiles.clear();
+        levelSerial++;
+        return true;
+    }
+
+    // Upper bound on a snapshot's size for a level of up to maxTunnels tunnels and enemies
+    size_t SnapshotBound(size_t maxTunnels) const {
+        size_t enemyBytes = 9 * sizeof(float) + sizeof(int) + sizeof(EnemyKind) + sizeof(uint8_t);
+        size_t bitsetBytes = dug.WordCount() * sizeof(uint64_t);
+        return 256 + sizeof(Sequencer) + maxTunnels * (sizeof(Tunnel) + enemyBytes + 2 * sizeof(uint32_t) + sizeof(int))
+             + 2 * bitsetBytes + grid.Tiles() * (sizeof(int16_t) + 7);
+    }
+
+    // Field order shared by SaveSnapshot and LoadSnapshot; Self is BasicWorld or const BasicWorld
+    template <typename Archive, typename Self>
+    static void Transfer(Archive& a, Self& w) {
+        a.Pod(w.player);
+        a.Pod(w.partner);
+        a.Pod(w.fruit);
+        a.Pod(w.state);
+        a.Pod(w.sequences);
+        a.Pod(w.levelIndex);
+        a.Pod(w.rng);
+        a.Vector(w.tunnels);
+        a.Vector(w.enemies.x);
+        a.Vector(w.enemies.y);
+        a.Vector(w.enemies.prevX);
+        a.Vector(w.enemies.prevY);
+        a.Vector(w.enemies.vx);
+        a.Vector(w.enemies.vy);
+        a.Vector(w.enemies.wpX);
+        a.Vector(w.enemies.wpY);
+        a.Vector(w.enemies.chaseSpeed);
+        a.Vector(w.enemies.tunnel);
+        a.Vector(w.enemies.kind);
+        a.Vector(w.enemies.flags);
+        a.Pod(w.enemies.aiTick);
+        a.Array(w.dug.Data(), w.dug.WordCount());
+        a.Array(w.tunnelTiles.Data(), w.tunnelTiles.WordCount());
+        a.Array(w.tunnelAt.data(), w.tunnelAt.size()); // Sized by the grid, like the bitsets
+        a.Vector(w.residentStart);
+        a.Vector(w.residents);
+        a.Pod(w.flowDirty);
+        FlowField::Transfer(a, w.flow);
+    }
+
+    // Changes whenever a snapshotted struct changes size, so stale images are refused
+    static uint32_t SnapshotLayout() {
+        return (uint32_t)(sizeof(Player) * 31 * 31 + sizeof(Fruit) * 31 + sizeof(Tunnel))
+             ^ ((uint32_t)sizeof(Rng) << 24) ^ ((uint32_t)sizeof(Sequencer) << 16);
+    }
+
+    // Adds count enemies, alternating kinds, at the heads of random tunnels and sets every
+    // enemy chasing; for stress runs and benchmarks
+    void AddStressEnemies(int count, Rng& spawn) {
+        if (tunnels.empty()) return;
+        for (int i = 0; i < count; i++) {
+            int t = (int)spawn.Below((uint32_t)tunnels.size());
+            const Tunnel& home = tunnels[t];
+            EnemyKind k = (i & 1) ? EnemyKind::DRAGON : EnemyKind::MONSTER;
+            enemies.Add(k, home.startX * TILE_SIZE, home.startY * TILE_SIZE, home, t, ChaseSpeed(k));
+        }
+        BuildTunnelIndex();
+        for (size_t i = 0; i < enemies.Size(); i++) enemies.Release(i);
+    }
+
+    void BuildTunnelIndex() {
+        std::fill(tunnelAt.begin(), tunnelAt.end(), (int16_t)-1);
+        for (size_t t = 0; t < tunnels.size(); t++) {
+            const Tunnel& tunnel = tunnels[t];
+            for (int i = 0; i < tunnel.length; i++) {
+                int x = tunnel.startX + (tunnel.direction == TunnelDirection::HORIZONTAL ? i : 0);
+                int y = tunnel.startY + (tunnel.direction == TunnelDirection::VERTICAL ? i : 0);
+                tunnelAt[y * grid.Width() + x] = (int16_t)t;
+            }
+        }
+
+        // Bucket enemies by home tunnel (counting sort)
+        residentStart.assign(tunnels.size() + 1, 0);
+        for (int t : enemies.tunnel) residentStart[t + 1]++;
+        for (size_t t = 1; t < residentStart.size(); t++) residentStart[t] += residentStart[t - 1];
+        residents.resize(enemies.Size());
+        residentCursor.assign(residentStart.begin(), residentStart.end() - 1);
+        for (size_t i = 0; i < enemies.Size(); i++)
+            residents[residentCursor[enemies.tunnel[i]]++] = (uint32_t)i;
+    }
+
+    void ResetAll() {
+        player.lives = tuning.startLives;
+        player.score = 0;
+        player.alive = true;
+        levelIndex = 0;
+        NextLevel();
+        SetState(GameState::SPLASH);
+        StartSequence(Sequence::TITLE);
+    }
+    
+    // Index of the tunnel covering a tile, or -1
+    int GetTunnelAt(int gridX, int gridY) const {
+        if (gridX < 0 || gridY < 0 || gridX >= grid.Width() || gridY >= grid.Height()) return -1;
+        return tunnelAt[gridY * grid.Width() + gridX];
+    }
+    
+    void CheckTunnelActivation(const Player& p) {
+        int playerGridX = static_cast<int>(p.pos.x / TILE_SIZE);
+        int playerGridY = static_cast<int>(p.pos.y / TILE_SIZE);
+        
+        int t = GetTunnelAt(playerGridX, playerGridY);
+        if (t >= 0 && !tunnels[t].activated) {
+            tunnels[t].activated = true;
+            
+            // Alert monsters and dragons in this tunnel
+            for (int k = residentStart[t]; k < residentStart[t + 1]; k++) {
+                enemies.Release(residents[k]);
+            }
+            events.Push(EventType::TUNNEL_ACTIVATED, t, residentStart[t + 1] - residentStart[t]);
+            
+            // Debug message
+            // std::cout << "Tunnel activated! Monsters/Dragons are now chasing!" << std::endl;
+        }
+    }
+
+    // Distance along an axis-aligned dir from origin to the first undug tile, capped at the
+    // harpoon range. The tile the origin is in never blocks.
+    float HarpoonReach(Vector2 origin, Vector2 dir) const {
+        int stepX = dir.x > 0 ? 1 : (dir.x < 0 ? -1 : 0);
+        int stepY = dir.y > 0 ? 1 : (dir.y < 0 ? -1 : 0);
+        if (stepX == 0 && stepY == 0) return 0.0f;
+        int tx = (int)(origin.x / TILE_SIZE), ty = (int)(origin.y / TILE_SIZE);
+        for (;;) {
+            tx += stepX;
+            ty += stepY;
+            // Distance to the near edge of the next tile
+            float edge = stepX > 0 ? tx * TILE_SIZE - origin.x
+                       : stepX < 0 ? origin.x - (tx + 1) * TILE_SIZE
+                       : stepY > 0 ? ty * TILE_SIZE - origin.y
+                       : origin.y - (ty + 1) * TILE_SIZE;
+            if (edge >= tuning.harpoonRange) return tuning.harpoonRange;
+            if (!dug.InBounds(tx, ty) || !dug.Get(tx, ty)) return edge;
+        }
+    }
+
+    // Full search only when the goal moves or the level is new
+    void UpdateFlowField() {
+        PROFILE_ZONE("flow field");
+        int gx = (int)((player.pos.x + player.size / 2) / TILE_SIZE);
+        int gy = (int)((player.pos.y + player.size / 2) / TILE_SIZE);
+        if (flowDirty || gx != flow.GoalX() || gy != flow.GoalY()) {
+            flow.Build(dug, gx, gy);
+            flowDirty = false;
+        }
+    }
+
+    // Re-file every live entity after movement; queries this tick go through the hash
+    void RebuildSpatialHash() {
+        PROFILE_ZONE("spatial hash");
+        hash.Clear();
+        for (size_t i = 0; i < enemies.Size(); i++)
+            if (enemies.Alive(i)) hash.Insert(MakeHashId(HashKind::ENEMY, i), enemies.Bounds(i));
+        if (!fruit.collected) hash.Insert(MakeHashId(HashKind::FRUIT, 0), fruit.Bounds());
+        hash.Build();
+    }
+
+    // Moves a player and digs the tiles it passed over
+    void MovePlayer(Player& p, const InputState& in) {
+        p.speed = tuning.playerSpeed;
+        p.Move(in, (float)MapWidth(), (float)MapHeight());
+        if (in.fire) events.Push(EventType::HARPOON_FIRED, &p == &partner ? 1 : 0);
+        DigSwept(p.prevPos, p.pos, (float)p.size);
+
+        // Check if player entered any tunnels
+        CheckTunnelActivation(p);
+    }
+
+    // Digs every tile whose centre a size x size body covered on its way from `from` to `to`,
+    // as one run per row. Taking the box around both positions means no tile is skipped however
+    // far the body moved in a tick, and going by centres digs a tile once the body is more than
+    // halfway onto it, the same in every direction. A body too small to cover any centre digs
+    // the tile under its own centre.
+    void DigSwept(raylib::Vector2 from, raylib::Vector2 to, float size) {
+        const float tile = (float)TILE_SIZE;
+        float left = std::min(from.x, to.x), right = std::max(from.x, to.x) + size;
+        float top = std::min(from.y, to.y), bottom = std::max(from.y, to.y) + size;
+        // Tile t's centre is t * tile + tile / 2; these are the first and last in [left, right)
+        int x0 = (int)std::ceil((left - tile * 0.5f) / tile), x1 = (int)std::ceil((right - tile * 0.5f) / tile) - 1;
+        int y0 = (int)std::ceil((top - tile * 0.5f) / tile), y1 = (int)std::ceil((bottom - tile * 0.5f) / tile) - 1;
+        if (x0 > x1) x0 = x1 = (int)std::floor((to.x + size * 0.5f) / tile);
+        if (y0 > y1) y0 = y1 = (int)std::floor((to.y + size * 0.5f) / tile);
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, grid.Width() - 1);
+        y1 = std::min(y1, grid.Height() - 1);
+        for (int y = y0; y <= y1 && x0 <= x1; y++) {
+            dug.TestAndSetRun(x0, y, x1 - x0 + 1, [this, y](int x) {
+                dirtyTiles.push_back(y * grid.Width() + x);
+                events.Push(EventType::TILE_DUG, x, y);
+                if (!flowDirty) flow.AddPassable(dug, x, y);
+            });
+        }
+    }
+
+    // Enemy contact, fruit pickup and the harpoon, once enemies have moved
+    void ResolvePlayer(Player& p) {
+        // Check collisions with player (enemies and fruit)
+        {
+            PROFILE_ZONE("collision");
+            hash.QueryRect(p.Bounds(), [this, &p](uint32_t id, const Rectangle&) {
+                switch (HashIdKind(id)) {
+                    case HashKind::ENEMY:
+                        if (!invulnerable) p.alive = false;
+                        break;
+                    case HashKind::FRUIT:
+                        if (!fruit.collected) {
+                            fruit.collected = true;
+                            events.Push(EventType::FRUIT_COLLECTED);
+                            AddScore(500);
+                        }
+                        break;
+                }
+            });
+        }
+
+        // Handle harpoon
+        if (p.hasHarpoon && p.harpoonTimer > 0) {
+            PROFILE_ZONE("harpoon");
+            // Swept from the centre every tick, so fast enemies can't skip past it.
+            // Only the first enemy along the line is hit.
+            raylib::Vector2 origin(p.pos.x + p.size/2, p.pos.y + p.size/2);
+            float reach = HarpoonReach(origin, p.harpoonDir);
+            SpatialHash::Hit hit = hash.Raycast(origin, p.harpoonDir, reach, [this](uint32_t id) {
+                return HashIdKind(id) == HashKind::ENEMY && enemies.Alive(HashIdIndex(id));
+            });
+            p.harpoonLength = reach;
+            if (hit.hit) {
+                size_t i = HashIdIndex(hit.id);
+                enemies.Kill(i);
+                float half = (float)enemies.size / 2;
+                events.Push(EventType::ENEMY_KILLED, (int)enemies.kind[i],
+                            ColorToInt(enemies.script->Get(enemies.kind[i]).info.color), enemies.x[i] + half,
+                            enemies.y[i] + half);
+                AddScore(enemies.script->Get(enemies.kind[i]).info.score);
+                p.harpoonLength = hit.distance;
+            }
+        }
+    }
+
+    // Advance the simulation by exactly one fixed tick. partnerIn drives the second player in
+    // co-op and is ignored otherwise; either player can confirm menus.
+    void Update(const InputState& in, const InputState& partnerIn = InputState()) {
+        PROFILE_ZONE("sim tick");
+        player.prevPos = player.pos;
+        partner.prevPos = partner.pos;
+        enemies.SavePrev();
+        player.TickTimers();
+        if (coop) partner.TickTimers();
+        bool confirm = in.confirm || (coop && partnerIn.confirm);
+
+        // Sequences go first and may change the state; the rest of the tick follows the state
+        // it started in, so a screen handed over by a sequence gets its first tick next time
+        GameState current = state;
+        bool respawning = Respawning();
+        sequences.Run(*this, (uint8_t)state, confirm);
+
+        if (current == GameState::PLAYING) {
+            if (!respawning) {
+                // Normal updates only if not respawning
+                MovePlayer(player, in);
+                if (coop) MovePlayer(partner, partnerIn);
+
+                // Move monsters and dragons; chasers go for the first player
+                UpdateFlowField();
+                enemies.Move(tunnels, flow, player.pos, tuning.aiInterval, jobs);
+
+                RebuildSpatialHash();
+
+                ResolvePlayer(player);
+                if (coop) ResolvePlayer(partner);
+
+                // Either player dying costs the team a life and restarts the level for both
+                bool partnerDied = coop && !partner.alive;
+                if (!player.alive || partnerDied) {
+                    player.lives--;
+                    if (!player.alive) events.Push(EventType::PLAYER_DIED, player.lives, 1, player.pos.x, player.pos.y);
+                    if (partnerDied) events.Push(EventType::PLAYER_DIED, player.lives, 2, partner.pos.x, partner.pos.y);
+                    if (player.lives > 0) {
+                        StartSequence(Sequence::RESPAWN);
+                    } else {
+                        SetState(GameState::GAMEOVER);
+                        SaveHighScore();
+                        StartSequence(Sequence::GAME_END);
+                    }
+                }
+
+                if (!enemies.AnyAlive()) {
+                    if (levels && (levelIndex + 1 < levels->Count() || endless)) {
+                        levelIndex = (levelIndex + 1) % levels->Count();
+                        NextLevel();
+                    } else {
+                        SetState(GameState::WIN);
+                        SaveHighScore();
+                        StartSequence(Sequence::GAME_END);
+                    }
+                }
+            }
+        }
+
+        events.Dispatch();
+    }
+
+    // -------------------------
+    // Sequences
+    // -------------------------
+    bool Respawning() const { return state == GameState::PLAYING && sequences.Running((uint8_t)Sequence::RESPAWN); }
+
+    // Until the level restarts; 0 when not respawning
+    int RespawnTicksLeft() const { return Respawning() ? sequences.TicksLeft((uint8_t)Sequence::RESPAWN) : 0; }
+
+    // In the current state, replacing the sequence if it is already running
+    void StartSequence(Sequence id) { sequences.Start(*this, (uint8_t)id, (uint8_t)state); }
+
+    // Sequencer's host hook
+    void Step(Sequencer::Cursor& s) {
+        switch ((Sequence)s.slot.id) {
+        case Sequence::TITLE:
+            SEQUENCE_BEGIN(s);
+            SEQUENCE_WAIT_CONFIRM(s);
+            SetState(GameState::PLAYING);
+            NextLevel();
+            SEQUENCE_END(s);
+            break;
+        case Sequence::RESPAWN:
+            SEQUENCE_BEGIN(s);
+            SEQUENCE_WAIT_TICKS(s, tuning.respawnDelay);
+            RestartLevel();
+            events.Push(EventType::LEVEL_RESTARTED, player.lives);
+            SEQUENCE_END(s);
+            break;
+        case Sequence::GAME_END:
+            SEQUENCE_BEGIN(s);
+            SEQUENCE_WAIT_CONFIRM(s);
+            ResetAll();
+            SEQUENCE_END(s);
+            break;
+        }
+    }
+};
+
+// ---------------------------------
+// Level pregeneration
+// ---------------------------------
+// Builds the level a world will move to next on a worker thread while the current one is
+// played. The worker runs ResetLevel on a private world seeded with a copy of the requesting
+// world's rng and hands back its level-start image. The handoff is lock-free: the worker
+// publishes with a release store and the game thread polls it, so Take never waits. A level
+// that isn't ready yet, or was generated from a different rng, is simply generated in place.
+template <typename Grid>
+class BasicLevelPregen {
+public:
+    // Generates levels for worlds on this grid
+    explicit BasicLevelPregen(const Grid& grid = Grid(GRID_WIDTH, GRID_HEIGHT)) : grid(grid), worker([this] { Run(); }) {}
+
+    ~BasicLevelPregen() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    BasicLevelPregen(const BasicLevelPregen&) = delete;
+    BasicLevelPregen& operator=(const BasicLevelPregen&) = delete;
+
+    // Starts generating the level a world with this rng, tuning and enemy script would
+    // generate next. Ignored while an earlier request is still being worked on.
+    void Request(const Rng& rng, const Tuning& tuning, const EnemyScript* script) {
+        if (busy) return;
+        busy = true;
+        requested = rng;
+        requestedTuning = tuning;
+        requestedScript = script;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = rng;
+            jobTuning = tuning;
+            jobScript = script;
+            pending = true;
+        }
+        wake.notify_one();
+    }
+
+    // Moves world onto the finished level if it was generated from the world's current rng,
+    // tuning and enemy script; never blocks. A failed adopt can leave the world partly overwritten (see
+    // LoadSnapshot).
+    bool Take(BasicWorld<Grid>& world) {
+        if (!busy || !ready.load(std::memory_order_acquire)) {
+            misses++;
+            return false;
+        }
+        ready.store(false, std::memory_order_relaxed);
+        busy = false;
+        // The world's old level-start image lands in result, so buffers ping-pong without allocating
+        if (requested != world.rng || requestedTuning != world.tuning || requestedScript != world.enemies.script
+            || world.grid != grid || !world.AdoptLevel(result)) {
+            misses++;
+            return false;
+        }
+        hits++;
+        return true;
+    }
+
+    int Hits() const { return hits; }
+    int Misses() const { return misses; }
+
+private:
+    const Grid grid;
+
+    // Game thread only
+    bool busy = false;
+    Rng requested;
+    Tuning requestedTuning;
+    const EnemyScript* requestedScript = nullptr;
+    int hits = 0, misses = 0;
+
+    // Written by the worker while busy && !ready, read by the game thread once ready
+    std::vector<uint8_t> result;
+    std::atomic<bool> ready{false};
+
+    std::mutex mutex; // Guards the job fields and wakes the worker
+    std::condition_variable wake;
+    Rng job;
+    Tuning jobTuning;
+    const EnemyScript* jobScript = nullptr;
+    bool pending = false;
+    bool stopping = false;
+    std::thread worker; // Last, so it starts after everything it touches
+
+    void Run() {
+        MemoryScope scope(MemTag::WORLD);
+        BasicWorld<Grid> scratch(grid); // Reused for every level, so its storage is only grown once
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return pending || stopping; });
+            if (stopping) return;
+            pending = false;
+            scratch.rng = job;
+            scratch.tuning = jobTuning;
+            scratch.SetEnemyScript(*jobScript);
+            lock.unlock();
+            scratch.ResetLevel();
+            result.swap(scratch.levelStart);
+            ready.store(true, std::memory_order_release);
+            lock.lock();
+        }
+    }
+};
+
+template <typename Grid>
+inline void BasicWorld<Grid>::NextLevel() {
+    if (levels) {
+        LevelView level;
+        if (!levels->Level(levelIndex, level) || !LoadLevel(level)) ResetLevel();
+        levels->Advance(levelIndex);
+    } else if (!pregen) {
+        ResetLevel();
+    } else {
+        Rng before = rng;
+        if (!pregen->Take(*this)) {
+            rng = before;
+            ResetLevel();
+        }
+        pregen->Request(rng, tuning, enemies.script);
+    }
+    events.Push(EventType::LEVEL_STARTED, levelSerial);
+}
+
+using World = BasicWorld<ArcadeGrid>;
+using LevelPregen = BasicLevelPregen<ArcadeGrid>;
+using DynamicWorld = BasicWorld<DynamicGrid>;
+using DynamicLevelPregen = BasicLevelPregen<DynamicGrid>;
+
+#endif // DIGDUG_WORLD_HPP_
@@ -0,0 +1,277 @@
+#include "InputSources.hpp"
+#include "World.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Micro-benchmarks for the simulation hot paths. Each case runs in growing batches until a
+// batch takes at least --min-time seconds, then reports the cost of one operation, so numbers
+// are comparable across machines and runs.
+//
+//   digdug_bench [--filter TEXT] [--min-time SECONDS] [--enemies N] [--dug FRACTION]
+//                [--grid WxH] [--seed S] [--ai-interval K] [--threads N]
+//
+// --enemies, --dug and --ai-interval shape the world used by the tick cases; --threads > 1
+// moves its enemies on a job pool of that size. World's grid is fixed at compile time, so
+// --grid sizes the DynamicWorld tick case and the standalone flow field, spatial hash and
+// collision cases instead; at the default size DynamicWorld::Update vs World::Update is the
+// price of run-time dimensions.
+
+struct BenchOptions {
+    const char* filter = nullptr;
+    double minTime = 0.25;
+    int enemies = 0;       // Extra chasers on top of the generated level
+    float dugFraction = 0.3f;
+    int gridW = GRID_WIDTH, gridH = GRID_HEIGHT;
+    unsigned seed = 1;
+    int aiInterval = 1;
+    unsigned threads = 1;
+};
+
+// Heap allocations made by this program so far, reported per operation alongside the time;
+// the bench links MemoryStats.cpp, which routes operator new through MemoryStats
+static uint64_t BenchAllocations() {
+    uint64_t total = 0;
+    for (int t = 0; t < (int)MemTag::COUNT; t++) total += MemoryStats::Get((MemTag)t).allocations;
+    return total;
+}
+
+// Keeps a result alive so the optimiser can't drop the work that produced it
+static volatile uint64_t benchSink;
+
+// Times fn(iterations) and prints ns per operation; fn runs the operation that many times
+template <typename Fn>
+static void RunBench(const BenchOptions& opt, const char* name, Fn fn) {
+    if (opt.filter && !strstr(name, opt.filter)) return;
+    using Clock = std::chrono::steady_clock;
+    fn(1); // Warm caches and lazy allocations
+    long long iterations = 1;
+    double seconds = 0.0;
+    uint64_t allocations = 0;
+    for (;;) {
+        uint64_t allocsBefore = BenchAllocations();
+        auto t0 = Clock::now();
+        fn(iterations);
+        seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        allocations = BenchAllocations() - allocsBefore;
+        if (seconds >= opt.minTime || iterations >= (1ll << 40)) break;
+        // Aim a little past the target so the final batch usually clears it
+        double scale = seconds > 0.0 ? opt.minTime * 1.4 / seconds : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        iterations = (long long)((double)iterations * scale) + 1;
+    }
+    printf("%-28s %12.1f ns/op %8.2f allocs/op %12lld ops\n", name, seconds * 1e9 / (double)iterations,
+           (double)allocations / (double)iterations, iterations);
+}
+
+// A level in play with every enemy already chasing, extra dug tiles and extra enemies
+template <typename WorldT>
+static WorldT MakeTickWorld(const BenchOptions& opt, const WorldT& blank) {
+    WorldT world = blank;
+    world.tuning.aiInterval = opt.aiInterval;
+    world.rng.Seed(opt.seed);
+    world.ResetAll();
+    world.state = GameState::PLAYING;
+
+    Rng dig(opt.seed, 1);
+    for (int y = 1; y < world.grid.Height() - 1; y++) {
+        for (int x = 1; x < world.grid.Width() - 1; x++) {
+            if ((float)dig.Below(1 << 16) < opt.dugFraction * (float)(1 << 16)) world.dug.Set(x, y);
+        }
+    }
+    world.AddStressEnemies(opt.enemies, dig);
+    world.flowDirty = true;
+    return world;
+}
+
+// Undoes deaths so a tick benchmark stays on the steady-state playing path
+template <typename WorldT>
+static void KeepPlaying(WorldT& world) {
+    world.player.alive = true;
+    world.player.lives = START_LIVES;
+    world.sequences.Clear();
+    world.state = GameState::PLAYING;
+}
+
+static void PrintUsage(const char* exe) {
+    fprintf(stderr,
+            "usage: %s [--filter TEXT] [--min-time SECONDS] [--enemies N] [--dug FRACTION]\n"
+            "          [--grid WxH] [--seed S] [--ai-interval K] [--threads N]\n",
+            exe);
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--filter") && hasValue) opt.filter = argv[++i];
+        else if (!strcmp(arg, "--min-time") && hasValue) opt.minTime = atof(argv[++i]);
+        else if (!strcmp(arg, "--enemies") && hasValue) opt.enemies = atoi(argv[++i]);
+        else if (!strcmp(arg, "--dug") && hasValue) opt.dugFraction = (float)atof(argv[++i]);
+        else if (!strcmp(arg, "--seed") && hasValue) opt.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(arg, "--ai-interval") && hasValue) opt.aiInterval = atoi(argv[++i]);
+        else if (!strcmp(arg, "--threads") && hasValue) opt.threads = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(arg, "--grid") && hasValue && sscanf(argv[++i], "%dx%d", &opt.gridW, &opt.gridH) == 2
+                 && opt.gridW > 0 && opt.gridH > 0) {}
+        else {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    printf("enemies +%d, dug %.2f, grid %dx%d, ai interval %d\n", opt.enemies, opt.dugFraction, opt.gridW, opt.gridH,
+           opt.aiInterval);
+
+    // -------------------------
+    // Level generation
+    // -------------------------
+    {
+        World world;
+        world.rng.Seed(opt.seed);
+        RunBench(opt, "World::ResetLevel", [&](long long n) {
+            for (long long i = 0; i < n; i++) world.ResetLevel();
+            benchSink = world.enemies.Size();
+        });
+        RunBench(opt, "World::RestartLevel", [&](long long n) {
+            for (long long i = 0; i < n; i++) world.RestartLevel();
+            benchSink = world.enemies.Size();
+        });
+        RunBench(opt, "World::CreateTunnels", [&](long long n) {
+            for (long long i = 0; i < n; i++) {
+                world.dug.Clear();
+                world.tunnelTiles.Clear();
+                world.CreateTunnels();
+            }
+            benchSink = world.tunnels.size();
+        });
+    }
+
+    // -------------------------
+    // Simulation tick
+    // -------------------------
+    {
+        std::unique_ptr<JobPool> pool;
+        if (opt.threads > 1) pool.reset(new JobPool(opt.threads));
+        World world = MakeTickWorld(opt, World());
+        world.jobs = pool.get();
+        Bot bot(opt.seed);
+        RunBench(opt, "World::Update", [&](long long n) {
+            for (long long i = 0; i < n; i++) {
+                InputState in = bot.Next(world);
+                in.fire = false; // Keep the enemy count constant
+                world.Update(in);
+                KeepPlaying(world);
+            }
+            benchSink = (uint64_t)world.player.score;
+        });
+        RunBench(opt, "EnemyStore::Move", [&](long long n) {
+            world.UpdateFlowField();
+            for (long long i = 0; i < n; i++) world.enemies.Move(world.tunnels, world.flow, world.player.pos, opt.aiInterval, world.jobs);
+            benchSink = (uint64_t)world.enemies.x[0];
+        });
+        RunBench(opt, "World::RebuildSpatialHash", [&](long long n) {
+            for (long long i = 0; i < n; i++) world.RebuildSpatialHash();
+        });
+    }
+    {
+        std::unique_ptr<JobPool> pool;
+        if (opt.threads > 1) pool.reset(new JobPool(opt.threads));
+        DynamicWorld world = MakeTickWorld(opt, DynamicWorld(DynamicGrid(opt.gridW, opt.gridH)));
+        world.jobs = pool.get();
+        Bot bot(opt.seed);
+        RunBench(opt, "DynamicWorld::Update", [&](long long n) {
+            for (long long i = 0; i < n; i++) {
+                InputState in = bot.Next(world);
+                in.fire = false;
+                world.Update(in);
+                KeepPlaying(world);
+            }
+            benchSink = (uint64_t)world.player.score;
+        });
+    }
+
+    // -------------------------
+    // Grid-sized structures
+    // -------------------------
+    {
+        TileBitset passable(opt.gridW, opt.gridH);
+        Rng dig(opt.seed, 2);
+        for (int y = 0; y < opt.gridH; y++) {
+            for (int x = 0; x < opt.gridW; x++) {
+                if ((float)dig.Below(1 << 16) < opt.dugFraction * (float)(1 << 16)) passable.Set(x, y);
+            }
+        }
+        FlowField flow(opt.gridW, opt.gridH);
+        RunBench(opt, "FlowField::Build", [&](long long n) {
+            for (long long i = 0; i < n; i++) flow.Build(passable, (int)(i % opt.gridW), opt.gridH / 2);
+            benchSink = flow.Distance(0, 0);
+        });
+
+        // One entity per enemy slot, or one per 8 tiles when no --enemies count is given
+        int entities = opt.enemies > 0 ? opt.enemies : opt.gridW * opt.gridH / 8;
+        SpatialHash hash((float)TILE_SIZE, opt.gridW, opt.gridH);
+        std::vector<Rectangle> rects((size_t)entities);
+        for (Rectangle& r : rects) {
+            r = { (float)dig.Below((uint32_t)((opt.gridW - 1) * TILE_SIZE)),
+                  (float)dig.Below((uint32_t)((opt.gridH - 1) * TILE_SIZE)), (float)TILE_SIZE, (float)TILE_SIZE };
+        }
+        RunBench(opt, "SpatialHash::Build", [&](long long n) {
+            for (long long i = 0; i < n; i++) {
+                hash.Clear();
+                for (size_t k = 0; k < rects.size(); k++) hash.Insert((uint32_t)k, rects[k]);
+                hash.Build();
+            }
+        });
+        RunBench(opt, "SpatialHash::QueryRect", [&](long long n) {
+            uint64_t hits = 0;
+            for (long long i = 0; i < n; i++) {
+                const Rectangle& probe = rects[(size_t)i % rects.size()];
+                hash.QueryRect(probe, [&](uint32_t, const Rectangle&) { hits++; });
+            }
+            benchSink = hits;
+        });
+
+        // The hash's integer overlap test against raylib's float one, every pair of entities
+        std::vector<EdgeBox> edges;
+        for (const Rectangle& r : rects) edges.push_back(EdgeBox::From(r));
+        RunBench(opt, "CheckCollisionRecs", [&](long long n) {
+            uint64_t hits = 0;
+            for (long long i = 0; i < n; i++) {
+                const Rectangle& probe = rects[(size_t)i % rects.size()];
+                for (const Rectangle& r : rects) hits += CheckCollisionRecs(r, probe);
+            }
+            benchSink = hits;
+        });
+        RunBench(opt, "EdgeBox::Overlaps", [&](long long n) {
+            uint64_t hits = 0;
+            for (long long i = 0; i < n; i++) {
+                const EdgeBox& probe = edges[(size_t)i % edges.size()];
+                for (const EdgeBox& e : edges) hits += e.Overlaps(probe);
+            }
+            benchSink = hits;
+        });
+
+        // The same entities through the library's batch tests: one probe against all, and all pairs
+        std::vector<uint8_t> mask(rects.size());
+        RunBench(opt, "CollisionBatch::CheckRecs", [&](long long n) {
+            uint64_t hits = 0;
+            for (long long i = 0; i < n; i++) {
+                const Rectangle& probe = rects[(size_t)i % rects.size()];
+                hits += raylib::CollisionBatch::CheckRecs(mask.data(), rects.data(), rects.size(), probe);
+            }
+            benchSink = hits;
+        });
+        raylib::SweepAndPrune broadphase;
+        std::vector<raylib::SweepAndPrune::Pair> pairs;
+        RunBench(opt, "SweepAndPrune::FindPairs", [&](long long n) {
+            uint64_t found = 0;
+            for (long long i = 0; i < n; i++) found += broadphase.FindPairs(rects.data(), rects.size(), pairs);
+            benchSink = found;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "TextureCooker.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Cooks images offline into textures that load without decoding: block-compressed, with
+// their mipmap chain, in raylib::CookedTexture's .rltex container. Run it over the art as
+// part of packaging; the game and Texture::Load take the .rltex in place of the PNG.
+//
+//   digdug_cook [--format auto|dxt1|dxt5|rgba] [--no-mips] FILE...
+//
+// Each FILE.png is written to FILE.rltex beside it. auto, the default, picks DXT1 for
+// opaque images and DXT5 for ones with transparency. DXT needs the sides to be multiples
+// of 4, and images that aren't are cooked as RGBA with mipmaps instead.
+
+static void PrintUsage(const char* exe) {
+    fprintf(stderr, "usage: %s [--format auto|dxt1|dxt5|rgba] [--no-mips] FILE...\n", exe);
+}
+
+static const char* FormatName(int format) {
+    switch (format) {
+    case PIXELFORMAT_COMPRESSED_DXT1_RGB: return "dxt1";
+    case PIXELFORMAT_COMPRESSED_DXT5_RGBA: return "dxt5";
+    default: return "rgba";
+    }
+}
+
+int main(int argc, char** argv) {
+    CookFormat format = CookFormat::AUTO;
+    bool mipmaps = true;
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; first++) {
+        const char* arg = argv[first];
+        bool hasValue = first + 1 < argc;
+        if (!strcmp(arg, "--no-mips")) mipmaps = false;
+        else if (!strcmp(arg, "--format") && hasValue) {
+            const char* name = argv[++first];
+            if (!strcmp(name, "auto")) format = CookFormat::AUTO;
+            else if (!strcmp(name, "dxt1")) format = CookFormat::DXT1;
+            else if (!strcmp(name, "dxt5")) format = CookFormat::DXT5;
+            else if (!strcmp(name, "rgba")) format = CookFormat::RGBA;
+            else {
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        }
+        else {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (first == argc) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    int failed = 0;
+    for (int i = first; i < argc; i++) {
+        const char* path = argv[i];
+        raylib::Image source;
+        try {
+            source.Load(path);
+        } catch (const raylib::RaylibException&) {
+            fprintf(stderr, "could not load %s\n", path);
+            failed++;
+            continue;
+        }
+        int pixelFormat = 0;
+        raylib::Image cooked = CookImage(source, format, mipmaps, &pixelFormat);
+        std::string out = path;
+        size_t dot = out.find_last_of('.');
+        if (dot != std::string::npos && out.find_first_of("/\\", dot) == std::string::npos) out.erase(dot);
+        out += ".rltex";
+        if (!raylib::CookedTexture::Export(cooked, out)) {
+            fprintf(stderr, "could not write %s\n", out.c_str());
+            failed++;
+            continue;
+        }
+        int inBytes = GetPixelDataSize(source.width, source.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        int outBytes = raylib::CookedTexture::GetDataSize(cooked.width, cooked.height, pixelFormat, cooked.mipmaps);
+        printf("%s: %dx%d %s, %d mips, %d KB (RGBA8 %d KB)\n", out.c_str(), cooked.width, cooked.height,
+               FormatName(pixelFormat), cooked.mipmaps, outBytes / 1024, inBytes / 1024);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,368 @@
+#include "BatchSim.hpp"
+#include "JobPool.hpp"
+#include "Replay.hpp"
+#include "StackSampler.hpp"
+#include "TickHistogram.hpp"
+#include "TuningFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Runs whole games with no window: input comes from a built-in bot or a command script, and
+// games are spread across every core as fast as they will go. Intended for soak-testing level
+// generation, timing the tick and balance tuning on build agents.
+//
+//   digdug_headless [--games N] [--max-ticks T] [--seed S] [--script FILE] [--threads N]
+//                   [--monster-chase SPEED] [--dragon-chase SPEED]
+//                   [--horizontal-tunnels N] [--tunnels N] [--ai-interval K] [--tuning FILE]
+//                   [--enemies FILE] [--level FILE [--endless]]
+//   digdug_headless --replay FILE [--repeat N]
+//   digdug_headless --soak CORPUS [--repeat N] [--flame FILE [--sample-us N]]
+//   digdug_headless --write-level FILE [--seed S] [tuning options]
+//   digdug_headless --write-pack FILE N [--seed S] [tuning options]
+//
+// --replay plays back a session recorded by the game (session.rae) with its own seed and
+// default tuning, N times in a row on one thread, for a fixed workload to time.
+// --soak does the same for every recording in CORPUS, a directory searched for .rae files or a
+// text file listing one path per line, and prints a histogram of tick times over all of them
+// with each session's cost; any unreadable or diverging session fails the run, for CI.
+// --flame also samples the open profiler zones every N us (default 1000) and writes them as
+// folded stacks for flamegraph.pl, inferno or speedscope (see StackSampler.hpp). Zones are
+// only timed with --flame, so tick times come out a little higher with it than without.
+// --level plays every game on a level file or pack instead of generated levels, --endless
+// starting a pack over after its last level. --write-level saves the level that seed S
+// generates as a level file, as a starting point for authoring; --write-pack saves the
+// levels of seeds S to S + N - 1 as a pack. --tuning applies a tuning file (TuningFile.hpp)
+// over the options before it. --enemies spawns the kinds of an enemy script (EnemyScript.hpp).
+
+static const char* stateNames[] = { "splash", "playing", "game over", "win" };
+
+// Plays a recording repeat times, adding every tick's time to histogram when given. Returns 0
+// with the first run's result and the totals over all runs, 1 if the runs don't all end the
+// same way and 2 if the file isn't a replay.
+static int RunReplay(const char* path, int repeat, TickHistogram* histogram, GameResult& first, double& simSeconds,
+                     long long& ticks) {
+    simSeconds = 0.0;
+    ticks = 0;
+    for (int r = 0; r < repeat; r++) {
+        ReplayPlayer replay(path);
+        if (!replay.Valid()) {
+            fprintf(stderr, "%s is not a digdug replay\n", path);
+            return 2;
+        }
+        World world;
+        replay.Begin(world);
+        GameResult result;
+        while (!replay.Done()) {
+            InputState in = replay.Next();
+            auto t0 = std::chrono::steady_clock::now();
+            world.Update(in);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            result.simSeconds += seconds;
+            if (histogram) histogram->Add(seconds);
+            result.ticks++;
+        }
+        result.end = world.state;
+        result.score = world.player.score;
+        result.livesLeft = world.player.lives;
+        if (r == 0) first = result;
+        else if (result.score != first.score || result.end != first.end || result.livesLeft != first.livesLeft) {
+            fprintf(stderr, "%s diverged on run %d\n", path, r);
+            return 1;
+        }
+        simSeconds += result.simSeconds;
+        ticks += result.ticks;
+    }
+    return 0;
+}
+
+// Plays a recording repeat times; fails if the runs don't all end the same way
+static int PlayReplay(const char* path, int repeat) {
+    GameResult first;
+    double simSeconds = 0.0;
+    long long ticks = 0;
+    int status = RunReplay(path, repeat, nullptr, first, simSeconds, ticks);
+    if (status != 0) return status;
+
+    printf("replay:     %s, seed %llu\n", path, (unsigned long long)ReplayPlayer(path).Seed());
+    printf("result:     %s, score %d, %d lives left after %d ticks\n", stateNames[(int)first.end], first.score,
+           first.livesLeft, first.ticks);
+    printf("tick cost:  %.1f ns over %d runs\n", ticks > 0 ? simSeconds * 1e9 / (double)ticks : 0.0, repeat);
+    return 0;
+}
+
+// Recordings in a corpus: the .rae files under a directory, or the paths listed in a file
+static std::vector<std::string> CorpusFiles(const char* corpus) {
+    std::vector<std::string> files;
+    if (DirectoryExists(corpus)) {
+        FilePathList list = LoadDirectoryFilesEx(corpus, ".rae", true);
+        for (unsigned int i = 0; i < list.count; i++) files.push_back(list.paths[i]);
+        UnloadDirectoryFiles(list);
+    } else {
+        std::string text;
+        if (!ReadTextFile(corpus, text)) return files;
+        for (size_t start = 0; start < text.size();) {
+            size_t end = text.find('\n', start);
+            if (end == std::string::npos) end = text.size();
+            std::string line = text.substr(start, end - start);
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+            if (!line.empty() && line[0] != '#') files.push_back(line);
+            start = end + 1;
+        }
+    }
+    std::sort(files.begin(), files.end()); // Same order on every machine
+    return files;
+}
+
+// Replays a corpus; see --soak
+static int Soak(const char* corpus, int repeat, const char* flamePath, int sampleUs) {
+    std::vector<std::string> files = CorpusFiles(corpus);
+    if (files.empty()) {
+        fprintf(stderr, "no recordings in %s\n", corpus);
+        return 2;
+    }
+
+    // Zones only time, and so only show up in samples, with a profiler installed
+    Profiler profiler;
+    std::unique_ptr<StackSampler> sampler;
+    if (flamePath) {
+        Profiler::SetCurrent(&profiler);
+        sampler.reset(new StackSampler(profiler, "replay", sampleUs));
+    }
+
+    TickHistogram all;
+    int failed = 0;
+    double simSeconds = 0.0;
+    long long ticks = 0;
+    printf("%-40s %8s %10s %9s  %s\n", "session", "ticks", "ns/tick", "p99 ms", "result");
+    for (const std::string& file : files) {
+        TickHistogram own;
+        GameResult first;
+        double seconds = 0.0;
+        long long n = 0;
+        int status = 2;
+        try {
+            status = RunReplay(file.c_str(), repeat, &own, first, seconds, n);
+        } catch (const raylib::RaylibException&) {
+            fprintf(stderr, "could not read replay %s\n", file.c_str());
+        }
+        if (status != 0) {
+            failed++;
+            printf("%-40s %8s %10s %9s  %s\n", file.c_str(), "-", "-", "-", status == 1 ? "DIVERGED" : "UNREADABLE");
+            continue;
+        }
+        all.Merge(own);
+        simSeconds += seconds;
+        ticks += n;
+        printf("%-40s %8lld %10.1f %9.3f  %s, score %d\n", file.c_str(), n, n > 0 ? seconds * 1e9 / (double)n : 0.0,
+               own.Peek(0.99), stateNames[(int)first.end], first.score);
+    }
+    if (sampler) {
+        sampler->Stop();
+        Profiler::SetCurrent(nullptr);
+    }
+
+    printf("\nsessions:   %d (%d failed), %d runs each\n", (int)files.size(), failed, repeat);
+    printf("ticks:      %lld, %.1f ns mean\n", ticks, ticks > 0 ? simSeconds * 1e9 / (double)ticks : 0.0);
+    printf("tick time:  p50 %.3f, p90 %.3f, p99 %.3f, p99.9 %.3f ms (bucket bounds)\n", all.Peek(0.5), all.Peek(0.9),
+           all.Peek(0.99), all.Peek(0.999));
+
+    // Non-empty buckets only, so one stray slow tick doesn't add a screen of zeroes
+    uint32_t total = 0, peak = 1;
+    for (int b = 0; b < TickHistogram::BUCKETS; b++) {
+        total += all.Count(b);
+        peak = std::max(peak, all.Count(b));
+    }
+    printf("%10s %10s %7s\n", "<= ms", "ticks", "cum %");
+    uint64_t cumulative = 0;
+    for (int b = 0; b < TickHistogram::BUCKETS; b++) {
+        uint32_t c = all.Count(b);
+        if (c == 0) continue;
+        cumulative += c;
+        std::string bar((size_t)((uint64_t)c * 40 / peak), '#');
+        printf("%10.4f %10u %7.2f  %s\n", TickHistogram::UpperMs(b), c, 100.0 * (double)cumulative / total,
+               bar.c_str());
+    }
+
+    if (sampler) {
+        if (!sampler->WriteFolded(flamePath)) {
+            fprintf(stderr, "could not write %s\n", flamePath);
+            return 2;
+        }
+        printf("flame:      %s, %llu samples in %zu stacks\n", flamePath, (unsigned long long)sampler->Samples(),
+               sampler->Stacks());
+    }
+    return failed > 0 ? 1 : 0;
+}
+
+static bool WriteFile(const char* path, const std::vector<uint8_t>& bytes) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && ok;
+}
+
+static void PrintUsage(const char* exe) {
+    fprintf(stderr,
+            "usage: %s [--games N] [--max-ticks T] [--seed S] [--script FILE] [--threads N]\n"
+            "          [--monster-chase SPEED] [--dragon-chase SPEED]\n"
+            "          [--horizontal-tunnels N] [--tunnels N] [--ai-interval K] [--tuning FILE]\n"
+            "          [--enemies FILE] [--level FILE [--endless]]\n"
+            "       %s --replay FILE [--repeat N]\n"
+            "       %s --soak CORPUS [--repeat N] [--flame FILE [--sample-us N]]\n"
+            "       %s --write-level FILE [--seed S] [tuning options]\n"
+            "       %s --write-pack FILE N [--seed S] [tuning options]\n",
+            exe, exe, exe, exe, exe);
+}
+
+int main(int argc, char** argv) {
+    BatchConfig config;
+    EnemyScript enemies;
+    unsigned threads = 0;
+    const char* scriptPath = nullptr;
+    const char* replayPath = nullptr;
+    const char* soakCorpus = nullptr;
+    const char* flamePath = nullptr;
+    int sampleUs = 1000;
+    const char* levelPath = nullptr;
+    const char* writeLevelPath = nullptr;
+    const char* writePackPath = nullptr;
+    int packLevels = 0;
+    int repeat = 1;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        const char* arg = argv[i];
+        if (!strcmp(arg, "--games") && hasValue) config.games = atoi(argv[++i]);
+        else if (!strcmp(arg, "--max-ticks") && hasValue) config.maxTicks = atoi(argv[++i]);
+        else if (!strcmp(arg, "--seed") && hasValue) config.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(arg, "--script") && hasValue) scriptPath = argv[++i];
+        else if (!strcmp(arg, "--replay") && hasValue) replayPath = argv[++i];
+        else if (!strcmp(arg, "--repeat") && hasValue) repeat = atoi(argv[++i]);
+        else if (!strcmp(arg, "--soak") && hasValue) soakCorpus = argv[++i];
+        else if (!strcmp(arg, "--flame") && hasValue) flamePath = argv[++i];
+        else if (!strcmp(arg, "--sample-us") && hasValue) sampleUs = atoi(argv[++i]);
+        else if (!strcmp(arg, "--level") && hasValue) levelPath = argv[++i];
+        else if (!strcmp(arg, "--write-level") && hasValue) writeLevelPath = argv[++i];
+        else if (!strcmp(arg, "--write-pack") && i + 2 < argc) {
+            writePackPath = argv[++i];
+            packLevels = atoi(argv[++i]);
+        }
+        else if (!strcmp(arg, "--endless")) config.endless = true;
+        else if (!strcmp(arg, "--tuning") && hasValue) {
+            std::string text, error;
+            const char* path = argv[++i];
+            if (!ReadTextFile(path, text) || !ParseTuning(text.c_str(), config.tuning, error)) {
+                fprintf(stderr, "could not apply tuning %s%s%s\n", path, error.empty() ? "" : ": ", error.c_str());
+                return 2;
+            }
+        }
+        else if (!strcmp(arg, "--enemies") && hasValue) {
+            std::string text, error;
+            const char* path = argv[++i];
+            if (!ReadTextFile(path, text) || !enemies.Compile(text.c_str(), error)) {
+                fprintf(stderr, "could not load enemies %s%s%s\n", path, error.empty() ? "" : ": ", error.c_str());
+                return 2;
+            }
+            config.enemies = &enemies;
+        }
+        else if (!strcmp(arg, "--threads") && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(arg, "--monster-chase") && hasValue)
+            config.tuning.chaseSpeed[(int)EnemyKind::MONSTER] = (float)atof(argv[++i]);
+        else if (!strcmp(arg, "--dragon-chase") && hasValue)
+            config.tuning.chaseSpeed[(int)EnemyKind::DRAGON] = (float)atof(argv[++i]);
+        else if (!strcmp(arg, "--horizontal-tunnels") && hasValue) config.tuning.horizontalTunnels = atoi(argv[++i]);
+        else if (!strcmp(arg, "--tunnels") && hasValue) config.tuning.maxTunnels = atoi(argv[++i]);
+        else if (!strcmp(arg, "--ai-interval") && hasValue) config.tuning.aiInterval = atoi(argv[++i]);
+        else {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (replayPath) {
+        try {
+            return PlayReplay(replayPath, repeat);
+        } catch (const raylib::RaylibException&) {
+            fprintf(stderr, "could not read replay %s\n", replayPath);
+            return 2;
+        }
+    }
+
+    if (soakCorpus) return Soak(soakCorpus, repeat, flamePath, sampleUs);
+
+    if (writeLevelPath || writePackPath) {
+        std::vector<uint8_t> image;
+        const char* path = writeLevelPath ? writeLevelPath : writePackPath;
+        World world;
+        world.tuning = config.tuning;
+        world.SetEnemyScript(enemies);
+        if (writeLevelPath) {
+            world.rng.Seed(config.seed);
+            world.ResetLevel();
+            world.WriteLevel(image);
+        } else {
+            LevelPackWriter pack;
+            std::vector<uint8_t> level;
+            for (int n = 0; n < packLevels; n++) {
+                world.rng.Seed(config.seed + (unsigned)n);
+                world.ResetLevel();
+                level.clear();
+                world.WriteLevel(level);
+                pack.Add(level);
+            }
+            pack.Write(image);
+        }
+        if (!WriteFile(path, image)) {
+            fprintf(stderr, "could not write %s\n", path);
+            return 2;
+        }
+        printf("wrote:      %s, %d levels, %zu bytes\n", path, writeLevelPath ? 1 : packLevels, image.size());
+        return 0;
+    }
+
+    LevelPack levels;
+    if (levelPath) {
+        if (!levels.Open(levelPath)) {
+            fprintf(stderr, "%s is not a level file or pack\n", levelPath);
+            return 2;
+        }
+        config.levels = &levels;
+    }
+
+    std::vector<ScriptStep> script;
+    if (scriptPath) {
+        if (!LoadScript(scriptPath, script)) {
+            fprintf(stderr, "could not read script %s\n", scriptPath);
+            return 2;
+        }
+        config.script = &script;
+    }
+
+    JobPool pool(threads);
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<GameResult> results = RunBatch(pool, config);
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    BatchStats stats = Summarize(results);
+
+    for (size_t g = 0; g < results.size(); g++) {
+        if (results[g].levelProblem)
+            fprintf(stderr, "game %zu (seed %u): %s\n", g, config.seed + (unsigned)g, results[g].levelProblem);
+    }
+
+    printf("games:      %d (%d won, %d lost, %d timed out)\n", stats.games, stats.wins, stats.losses, stats.timeouts);
+    printf("score:      %.1f mean, %.1f median\n", stats.meanScore, stats.medianScore);
+    printf("lifetime:   %.1f ticks mean\n", stats.meanTicks);
+    printf("tick cost:  %.1f ns\n", stats.meanTickNs);
+    printf("throughput: %.0f games/s, %.0f ticks/s on %u threads\n",
+           stats.games / wallSeconds, (double)stats.ticks / wallSeconds, pool.Size());
+    if (stats.badLevels > 0) {
+        printf("bad levels: %d\n", stats.badLevels);
+        return 1;
+    }
+    return 0;
+}
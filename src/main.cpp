@@ -1,733 +1,1365 @@
-#include "raylib-cpp.hpp"
-#include <vector>
+#include "RaylibCpp.hpp"
+#include "ArcadeFilter.hpp"
+#include "AssetLoader.hpp"
+#include "AudioDsp.hpp"
+#include "DirtArt.hpp"
+#include "Effects.hpp"
+#include "HighScores.hpp"
+#include "MemoryStats.hpp"
+#include "MusicStream.hpp"
+#include "SoundEffects.hpp"
+#include "Netplay.hpp"
+#include "Profiler.hpp"
+#include "QualityController.hpp"
+#include "Replay.hpp"
+#include "SimThread.hpp"
+#include "TuningFile.hpp"
+#include "Visibility.hpp"
+#include "SpriteBatch.hpp"
+#include "Telemetry.hpp"
+#include "World.hpp"
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
-#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
 #include <string>
-#include <algorithm>
+#include <thread>
 
 // ---------------------------------
-// Grid & constants
+// Frame pacing
 // ---------------------------------
-const int TILE_SIZE   = 32;
-const int GRID_WIDTH  = 25;
-const int GRID_HEIGHT = 18;
-
-const int SCREEN_W = GRID_WIDTH * TILE_SIZE;
-const int SCREEN_H = GRID_HEIGHT * TILE_SIZE;
-
-const int START_LIVES = 3;
-const int RESPAWN_DELAY = 180;   // 3 seconds @ 60 FPS
-const int DEATH_FLASH_TIME = 30; // 0.5 seconds @ 60 FPS
-
-// Tunnel directions
-enum class TunnelDirection { HORIZONTAL, VERTICAL, NONE };
+const int MAX_TICKS_PER_FRAME = 8;        // Drop sim time after a long hitch instead of spiralling
+const double MAX_FRAME_TIME = 0.25;       // Clamp for frame deltas (debugger pauses, window drags)
+const double ASSET_UPLOAD_BUDGET = 0.002; // Seconds per frame spent creating textures, fonts and sounds
 
 // ---------------------------------
-// Helpers
+// Memory accounting
 // ---------------------------------
-static Rectangle MakeNormalizedRect(float x, float y, float w, float h) {
-    Rectangle r { x, y, w, h };
-    if (r.width < 0) { r.x += r.width; r.width *= -1; }
-    if (r.height < 0){ r.y += r.height; r.height *= -1; }
-    return r;
+// Every C++ allocation in the game goes through MemoryStats (see MemoryStats.cpp), charged to
+// the subsystem whose MemoryScope the allocating thread is in; the F3 overlay shows the totals
+// under the timings
+const size_t MB = 1 << 20;
+const size_t WORLD_MEMORY_BUDGET = 16 * MB;  // Live world, its pregenerated next level and the sim's frames
+const size_t ASSETS_MEMORY_BUDGET = 8 * MB;  // Loader bookkeeping and baked dirt, not raylib's pixel data
+const size_t AUDIO_MEMORY_BUDGET = 4 * MB;
+
+static void DrawMemoryOverlay(int x, int y, const AssetLoader& assets) {
+    static const char* const GPU_KINDS[raylib::GpuMemory::KIND_COUNT] = { "textures", "render textures", "meshes" };
+    const int lineH = 14;
+    const int rows = (int)MemTag::COUNT + raylib::GpuMemory::KIND_COUNT + 3;
+    DrawRectangle(x, y, 330, rows * lineH + 8, Fade(BLACK, 0.75f));
+    x += 6;
+    y += 4;
+    DrawText("heap              live  peak  budget MB   allocs", x, y, 10, YELLOW);
+    for (int t = 0; t < (int)MemTag::COUNT; t++) {
+        y += lineH;
+        MemoryStats::Usage usage = MemoryStats::Get((MemTag)t);
+        raylib::FixedString<64> line;
+        line.Append((double)usage.live / MB, 2, 6).Append(' ').Append((double)usage.peak / MB, 2, 5).Append(' ');
+        if (usage.budget > 0) line.Append((double)usage.budget / MB, 1, 6);
+        else line.Append("     -");
+        line.Append(' ').Append((unsigned long long)usage.allocations, 10);
+        DrawText(MemoryStats::Name((MemTag)t), x, y, 10, RAYWHITE);
+        DrawText(line, x + 90, y, 10, MemoryStats::OverBudget((MemTag)t) ? RED : RAYWHITE);
+    }
+    y += lineH;
+    DrawText("gpu (estimated)  count  MB", x, y, 10, YELLOW);
+    for (int k = 0; k < raylib::GpuMemory::KIND_COUNT; k++) {
+        y += lineH;
+        raylib::GpuMemory::Usage usage = raylib::GpuMemory::Get((raylib::GpuMemory::Kind)k);
+        raylib::FixedString<32> line;
+        line.Append((unsigned long long)usage.count, 5).Append(' ').Append((double)usage.bytes / MB, 2, 6);
+        DrawText(GPU_KINDS[k], x, y, 10, RAYWHITE);
+        DrawText(line, x + 90, y, 10, RAYWHITE);
+    }
+    y += lineH;
+    raylib::FixedString<32> resident;
+    DrawText("asset cache", x, y, 10, RAYWHITE);
+    DrawText(resident.Append((double)assets.ResidentBytes() / MB, 2, 12).Append(" MB"), x + 90, y, 10, RAYWHITE);
 }
 
-static bool Button(const char* label, Rectangle bounds) {
-    Vector2 m = GetMousePosition();
-    bool hover = CheckCollisionPointRec(m, bounds);
-    DrawRectangleRec(bounds, hover ? DARKGRAY : GRAY);
-    int tw = MeasureText(label, 20);
-    DrawText(label, (int)(bounds.x + (bounds.width - tw)/2), (int)(bounds.y + (bounds.height-20)/2), 20, WHITE);
-    return hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-}
+// Normally input is sampled right after the previous present and then waits on vsync with the
+// rest of the frame, so it reaches the screen about a frame after it was read. In low-latency
+// mode the frame instead waits first and samples input as late as its recent work time allows:
+// the wait sleeps while it safely can and spins the last stretch, since sleeps overshoot.
+class LatePacer {
+public:
+    static constexpr double MARGIN = 0.002;    // Slack left before the deadline (driver, GPU)
+    static constexpr double SPIN_TIME = 0.002; // Tail of the wait that is busy-waited
+    static constexpr double BUDGET_DECAY = 0.98; // Per frame; spikes count at once, then fade
+
+    explicit LatePacer(double period) : period(period), lastPresent(GetTime()) {}
+
+    // Returns at the latest moment the next frame can start and still present on time
+    void WaitForInput() {
+        double target = lastPresent + period - budget - MARGIN;
+        double ahead = target - GetTime();
+        if (ahead > SPIN_TIME) std::this_thread::sleep_for(std::chrono::duration<double>(ahead - SPIN_TIME));
+        while (GetTime() < target) {}
+        workStart = GetTime();
+    }
+
+    // Around EndDrawing: the work since WaitForInput sets the budget for the next frames
+    void Presenting() { budget = std::max(GetTime() - workStart, budget * BUDGET_DECAY); }
+    void Presented() { lastPresent = GetTime(); }
+
+    double Budget() const { return budget; }
+
+private:
+    double period;
+    double lastPresent;
+    double workStart = 0.0;
+    double budget = 0.0;
+};
 
 // ---------------------------------
-// Tunnel structure
+// Game input
 // ---------------------------------
-struct Tunnel {
-    int startX, startY;
-    int length;
-    TunnelDirection direction;
-    bool dug = true; // Tunnels are visible from the start
-    bool activated = false; // Whether player has entered this tunnel
-    
-    Tunnel(int x, int y, int len, TunnelDirection dir)
-        : startX(x), startY(y), length(len), direction(dir) {}
-    
-    bool Contains(int x, int y) const {
-        if (direction == TunnelDirection::HORIZONTAL) {
-            return y == startY && x >= startX && x < startX + length;
-        } else if (direction == TunnelDirection::VERTICAL) {
-            return x == startX && y >= startY && y < startY + length;
-        }
-        return false;
-    }
-    
-    bool Intersects(const Tunnel& other) const {
-        if (direction == TunnelDirection::HORIZONTAL && other.direction == TunnelDirection::HORIZONTAL) {
-            // Both horizontal - check if on same row and segments overlap
-            if (startY != other.startY) return false;
-            return !(startX + length <= other.startX || other.startX + other.length <= startX);
-        }
-        else if (direction == TunnelDirection::VERTICAL && other.direction == TunnelDirection::VERTICAL) {
-            // Both vertical - check if on same column and segments overlap
-            if (startX != other.startX) return false;
-            return !(startY + length <= other.startY || other.startY + other.length <= startY);
-        }
-        else {
-            // One horizontal, one vertical - check if they cross
-            if (direction == TunnelDirection::HORIZONTAL) {
-                // This is horizontal, other is vertical
-                return (other.startX >= startX && other.startX < startX + length) &&
-                       (startY >= other.startY && startY < other.startY + other.length);
-            } else {
-                // This is vertical, other is horizontal
-                return (startX >= other.startX && startX < other.startX + other.length) &&
-                       (other.startY >= startY && other.startY < startY + length);
-            }
+// The game keys and the first gamepad go through a timestamped event queue rather than being
+// read once per frame, so a tap released before the next poll still fires and moves for a
+// tick, and, with the sim on its own thread, each tick takes the input due by its own time
+// instead of whatever the last frame saw. raylib only polls once per frame, so an event is
+// stamped with the poll before the one that saw it, the earliest it can have happened.
+//
+// The pad is captured whole once per poll into a GamepadState and only its changes are
+// queued, turned into d-pad presses: the left stick past STICK_THRESHOLD counts as the d-pad,
+// the bottom face button fires and start confirms. Keyboard and pad directions are held
+// separately, so letting go of one doesn't cancel the other.
+//
+// Sample() runs on the main thread after each poll; Feed(), Latched() and Consumed() on
+// whichever thread ticks.
+class GameInput {
+public:
+    static constexpr float STICK_THRESHOLD = 0.5f;
+
+    explicit GameInput(double now) : lastPoll(now) {}
+
+    void Sample(double now) {
+        static const int KEYS[] = { KEY_LEFT, KEY_RIGHT, KEY_UP, KEY_DOWN, KEY_SPACE, KEY_ENTER, KEY_R };
+        raylib::Keyboard::QueueKeys(queue, KEYS, sizeof(KEYS) / sizeof(KEYS[0]), lastPoll);
+
+        raylib::Gamepad(0).Capture(pad);
+        uint32_t buttons = pad.buttons;
+        float x = pad.GetAxisMovement(GAMEPAD_AXIS_LEFT_X), y = pad.GetAxisMovement(GAMEPAD_AXIS_LEFT_Y);
+        if (x < -STICK_THRESHOLD) buttons |= 1u << GAMEPAD_BUTTON_LEFT_FACE_LEFT;
+        if (x > STICK_THRESHOLD) buttons |= 1u << GAMEPAD_BUTTON_LEFT_FACE_RIGHT;
+        if (y < -STICK_THRESHOLD) buttons |= 1u << GAMEPAD_BUTTON_LEFT_FACE_UP;
+        if (y > STICK_THRESHOLD) buttons |= 1u << GAMEPAD_BUTTON_LEFT_FACE_DOWN;
+        for (int button : PAD_BUTTONS) {
+            bool down = (buttons >> button) & 1u;
+            if (down != (bool)((padButtons >> button) & 1u)) queue.Push(lastPoll, 0, button, down);
         }
+        padButtons = buttons;
+
+        lastPoll = now;
     }
-    
-    void Draw() const {
-        Color color = BLACK; // Tunnels are always black (dug)
-        if (direction == TunnelDirection::HORIZONTAL) {
-            DrawRectangle(startX * TILE_SIZE, startY * TILE_SIZE,
-                         length * TILE_SIZE, TILE_SIZE, color);
-        } else {
-            DrawRectangle(startX * TILE_SIZE, startY * TILE_SIZE,
-                         TILE_SIZE, length * TILE_SIZE, color);
-        }
+
+    // The restart button, as a tap of ENTER
+    void Click() {
+        queue.Push(lastPoll, raylib::InputEvent::KEYBOARD, KEY_ENTER, true);
+        queue.Push(lastPoll, raylib::InputEvent::KEYBOARD, KEY_ENTER, false);
+    }
+
+    // Applies the events stamped up to time; R only restarts outside the splash screen
+    void Feed(double time, bool restartKey) {
+        queue.PopUntil(time, [&](const raylib::InputEvent& e) {
+            bool key = e.device == raylib::InputEvent::KEYBOARD;
+            int dir = Direction(key, e.code);
+            if (dir >= 0) {
+                uint8_t source = key ? 1 : 2;
+                held[dir] = (uint8_t)(e.down ? held[dir] | source : held[dir] & ~source);
+                tapped[dir] |= e.down;
+            } else if (e.down) {
+                if (key ? e.code == KEY_SPACE : e.code == GAMEPAD_BUTTON_RIGHT_FACE_DOWN) fire = true;
+                bool start = key ? e.code == KEY_ENTER || (e.code == KEY_R && restartKey)
+                                 : e.code == GAMEPAD_BUTTON_MIDDLE_RIGHT;
+                if (start) confirm = true;
+            }
+        });
+    }
+
+    // Held directions, plus any that went down since the last tick, and presses since then
+    InputState Latched() const {
+        InputState in;
+        in.left = held[0] || tapped[0];
+        in.right = held[1] || tapped[1];
+        in.up = held[2] || tapped[2];
+        in.down = held[3] || tapped[3];
+        in.fire = fire;
+        in.confirm = confirm;
+        return in;
+    }
+
+    // After a tick took Latched()
+    void Consumed() {
+        for (bool& t : tapped) t = false;
+        fire = confirm = false;
+    }
+
+private:
+    static constexpr int PAD_BUTTONS[] = { GAMEPAD_BUTTON_LEFT_FACE_LEFT, GAMEPAD_BUTTON_LEFT_FACE_RIGHT,
+                                           GAMEPAD_BUTTON_LEFT_FACE_UP, GAMEPAD_BUTTON_LEFT_FACE_DOWN,
+                                           GAMEPAD_BUTTON_RIGHT_FACE_DOWN, GAMEPAD_BUTTON_MIDDLE_RIGHT };
+
+    raylib::InputQueue<> queue;
+    double lastPoll;
+    raylib::GamepadState pad;  // Main thread's
+    uint32_t padButtons = 0;   // Main thread's: pad buttons as last queued, stick folded in
+    uint8_t held[4] = {};      // Left, right, up, down as of the latest event fed: 1 keyboard | 2 pad
+    bool tapped[4] = {};       // Went down since the last tick
+    bool fire = false, confirm = false;
+
+    // 0-3 for left, right, up, down, -1 for anything else
+    static int Direction(bool key, int code) {
+        if (key) return code == KEY_LEFT ? 0 : code == KEY_RIGHT ? 1 : code == KEY_UP ? 2 : code == KEY_DOWN ? 3 : -1;
+        return code == GAMEPAD_BUTTON_LEFT_FACE_LEFT ? 0 : code == GAMEPAD_BUTTON_LEFT_FACE_RIGHT ? 1
+             : code == GAMEPAD_BUTTON_LEFT_FACE_UP ? 2 : code == GAMEPAD_BUTTON_LEFT_FACE_DOWN ? 3 : -1;
     }
 };
 
 // ---------------------------------
-// Game Objects
+// View
 // ---------------------------------
-class Player {
+// The window shows at most VIEW_W x VIEW_H pixels of the map; larger maps scroll.
+const int VIEW_W = SCREEN_W < 1280 ? SCREEN_W : 1280;
+const int VIEW_H = SCREEN_H < 720 ? SCREEN_H : 720;
+
+// Keeps the player centred, clamped so the view never leaves the map (a map no bigger than
+// the view stays fixed at the origin). Snaps to whole pixels so tiles don't shimmer.
+class ViewCamera {
 public:
-    raylib::Vector2 pos;
-    int size = TILE_SIZE;
-    float speed = 2.0f;
+    ViewCamera() : camera(raylib::Vector2(0, 0), raylib::Vector2(0, 0)) {}
+
+    void Follow(const raylib::Vector2& focus) {
+        float x = focus.x - VIEW_W / 2.0f;
+        float y = focus.y - VIEW_H / 2.0f;
+        x = std::max(0.0f, std::min(x, (float)(SCREEN_W - VIEW_W)));
+        y = std::max(0.0f, std::min(y, (float)(SCREEN_H - VIEW_H)));
+        camera.SetTarget(raylib::Vector2((float)(int)x, (float)(int)y));
+    }
 
-    bool alive = true;
-    int lives  = START_LIVES;
+    // World-space rectangle currently on screen
+    Rectangle Visible() const {
+        return Rectangle{ camera.target.x, camera.target.y, (float)VIEW_W, (float)VIEW_H };
+    }
 
-    // Harpoon
-    bool hasHarpoon = false;
-    raylib::Vector2 harpoonDir{1,0};
-    int harpoonTimer = 0;         // frames remaining
-    int score = 0;
+    void BeginMode() { camera.BeginMode(); }
+    void EndMode() { camera.EndMode(); }
 
-    // Death animation
-    int deathFlashTimer = 0;
+private:
+    raylib::Camera2D camera;
+};
 
-    Player(int x, int y) { pos = raylib::Vector2((float)x, (float)y); }
+// ---------------------------------
+// UI helpers
+// ---------------------------------
+// One line of default-font text that is only re-formatted and laid out when its content
+// changes. The glyphs themselves still go through raylib's batch each frame, as one run of
+// quads on the font texture, so there is nothing to gain from baking them to textures.
+class TextLabel {
+public:
+    // Spacing matches what DrawText uses for the default font
+    TextLabel(int fontSize, Color color, const char* initial = "")
+        : text(GetFontDefault(), initial, (float)fontSize, (float)(fontSize / 10), color) {}
+
+    void Set(const char* s) {
+        if (text.GetText() == s) return;
+        text.SetText(s);
+        lastFormat = nullptr;
+    }
 
-    void ResetTo(int x, int y) {
-        pos = raylib::Vector2((float)x, (float)y);
-        alive = true;
-        hasHarpoon = false;
-        harpoonTimer = 0;
-        harpoonDir = raylib::Vector2(1,0);
-        deathFlashTimer = 0;
+    // Formats with up to two ints, skipping the work while format and values are unchanged
+    void SetInts(const char* format, int a, int b = 0) {
+        if (format == lastFormat && a == lastA && b == lastB) return;
+        lastFormat = format;
+        lastA = a;
+        lastB = b;
+        raylib::FixedString<64> line;
+        text.SetText(line.Format(format, a, b).c_str());
     }
 
-    void Move() {
-        if (IsKeyDown(KEY_RIGHT)) { pos.x += speed; harpoonDir = raylib::Vector2(1, 0); }
-        if (IsKeyDown(KEY_LEFT))  { pos.x -= speed; harpoonDir = raylib::Vector2(-1, 0); }
-        if (IsKeyDown(KEY_UP))    { pos.y -= speed; harpoonDir = raylib::Vector2(0, -1); }
-        if (IsKeyDown(KEY_DOWN))  { pos.y += speed; harpoonDir = raylib::Vector2(0, 1); }
+    int Width() const { return (int)text.Measure().x; }
 
-        // Keep in window
-        if (pos.x < 0) pos.x = 0;
-        if (pos.y < 0) pos.y = 0;
-        if (pos.x > SCREEN_W - size) pos.x = SCREEN_W - size;
-        if (pos.y > SCREEN_H - size) pos.y = SCREEN_H - size;
+    void Draw(int x, int y) const { text.Draw(Vector2{ (float)x, (float)y }); }
+    void DrawCentered(int centerX, int y) const { Draw(centerX - Width()/2, y); }
 
-        // Fire harpoon
-        if (IsKeyPressed(KEY_SPACE)) {
-            hasHarpoon = true;
-            harpoonTimer = 15; // visible frames
-        }
+    // As Draw, through the batch's next Flush
+    void Queue(SpriteBatch& batch, SpriteBatch::Layer layer, int x, int y) const {
+        batch.AddText(layer, text, (float)x, (float)y);
     }
+    void QueueCentered(SpriteBatch& batch, SpriteBatch::Layer layer, int centerX, int y) const {
+        Queue(batch, layer, centerX - Width()/2, y);
+    }
+
+private:
+    mutable raylib::TextLayout text; // Lays out lazily, on the first Draw or Measure after a change
+    const char* lastFormat = nullptr;
+    int lastA = 0, lastB = 0;
+};
+
+static bool Button(const TextLabel& label, Rectangle bounds) {
+    Vector2 m = GetMousePosition();
+    bool hover = CheckCollisionPointRec(m, bounds);
+    DrawRectangleRec(bounds, hover ? DARKGRAY : GRAY);
+    label.Draw((int)(bounds.x + (bounds.width - label.Width())/2), (int)(bounds.y + (bounds.height-20)/2));
+    return hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+}
 
-    void Draw() {
-        Color col = BLUE;
-        if (deathFlashTimer > 0) col = RED;
+// ---------------------------------
+// Terrain cache
+// ---------------------------------
+// Background and dug tiles are cached in render textures, one per CHUNK x CHUNK tile chunk.
+// Chunks get a texture only once they come near the view and give it back after sitting
+// outside it for EVICT_FRAMES, so GPU memory follows the explored area rather than the map
+// size. Digging only ever turns dirt into tunnel, so a resident chunk is rebuilt once per
+// level and afterwards just paints the tiles that flipped since the previous frame.
+//
+// The undug earth comes from a map-sized backdrop texture when one is set (see DirtArt.hpp);
+// changing it rebuilds chunks as they're next used, as a new level does.
+//
+// Textures can only be created on the thread that owns the GL context, so loading stays
+// here; instead, chunks in the ring around the view are prefetched at most PREFETCH_PER_FRAME
+// per frame, and only chunks actually on screen are built on demand.
+class TerrainCache {
+public:
+    static constexpr int CHUNK = 16;
+    static constexpr int CHUNK_PX = CHUNK * TILE_SIZE;
+    static constexpr int EVICT_FRAMES = 120;
+    static constexpr int PREFETCH_PER_FRAME = 2;
+
+    TerrainCache(int gridWidth, int gridHeight)
+        : chunksX((gridWidth + CHUNK - 1) / CHUNK), chunksY((gridHeight + CHUNK - 1) / CHUNK),
+          chunks((size_t)chunksX * chunksY) {}
+
+    // view is the world-space rectangle about to be drawn
+    void Sync(World& world, Rectangle view) {
+        frame++;
+        if (world.levelSerial != levelSerial) {
+            // Stale chunks rebuild as they're used; tiles dug before that are in world.dug already
+            levelSerial = world.levelSerial;
+            world.dirtyTiles.clear();
+        }
 
-        DrawRectangle((int)pos.x, (int)pos.y, size, size, col);
+        for (int tile : world.dirtyTiles) {
+            int x = tile % GRID_WIDTH;
+            int y = tile / GRID_WIDTH;
+            Chunk& chunk = At(x / CHUNK, y / CHUNK);
+            if (chunk.builtSerial == levelSerial) chunk.pending.push_back(tile);
+        }
+        world.dirtyTiles.clear();
 
-        if (hasHarpoon && harpoonTimer > 0) {
-            DrawLine((int)(pos.x + size/2), (int)(pos.y + size/2),
-                     (int)(pos.x + size/2 + harpoonDir.x*50),
-                     (int)(pos.y + size/2 + harpoonDir.y*50),
-                     RAYWHITE);
-            harpoonTimer--;
-            if (harpoonTimer <= 0) hasHarpoon = false;
+        int x0, y0, x1, y1;
+        ChunkRange(view, 0, x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) Touch(world, cx, cy);
         }
 
-        if (deathFlashTimer > 0) deathFlashTimer--;
-    }
+        int budget = PREFETCH_PER_FRAME;
+        ChunkRange(view, CHUNK_PX, x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                Chunk& chunk = At(cx, cy);
+                if (chunk.builtSerial == levelSerial) chunk.lastUsed = frame;
+                else if (budget > 0) { Touch(world, cx, cy); budget--; }
+            }
+        }
 
-    Rectangle Bounds() const {
-        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+        for (Chunk& chunk : chunks) {
+            if (chunk.texture.id != 0 && frame - chunk.lastUsed > EVICT_FRAMES) {
+                chunk.texture.Unload();
+                chunk.texture.id = 0;
+                chunk.builtSerial = -1;
+                chunk.pending.clear();
+            }
+        }
     }
-};
 
-class Monster {
-public:
-    raylib::Vector2 pos;
-    int size = TILE_SIZE;
-    float speed = 0.5f;
-    float chaseSpeed = 1.2f; // Faster when chasing
-    bool alive = true;
-    bool inTunnel = true;
-    bool chasing = false;
-    Tunnel* homeTunnel = nullptr;
-    int direction = 1; // 1 for right/down, -1 for left/up
-
-    Monster(int x, int y, Tunnel* tunnel) {
-        pos = raylib::Vector2((float)x, (float)y);
-        homeTunnel = tunnel;
-    }
-
-    void MoveInTunnel() {
-        if (!alive || !inTunnel) return;
-        
-        if (homeTunnel->direction == TunnelDirection::HORIZONTAL) {
-            pos.x += speed * direction;
-            
-            // Check if reached tunnel end
-            int gridX = static_cast<int>(pos.x) / TILE_SIZE;
-            if (gridX <= homeTunnel->startX ||
-                gridX >= homeTunnel->startX + homeTunnel->length - 1) {
-                direction *= -1; // Reverse direction
-            }
-        } else {
-            pos.y += speed * direction;
-            
-            // Check if reached tunnel end
-            int gridY = static_cast<int>(pos.y) / TILE_SIZE;
-            if (gridY <= homeTunnel->startY ||
-                gridY >= homeTunnel->startY + homeTunnel->length - 1) {
-                direction *= -1; // Reverse direction
+    // Draws only the chunks inside view (world space)
+    void Draw(Rectangle view) const {
+        int x0, y0, x1, y1;
+        ChunkRange(view, 0, x0, y0, x1, y1);
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                const Chunk& chunk = chunks[(size_t)cy * chunksX + cx];
+                if (chunk.builtSerial != levelSerial) continue;
+                // Render textures are stored bottom-up, so flip the source rect
+                Rectangle src { 0, 0, (float)CHUNK_PX, -(float)CHUNK_PX };
+                DrawTextureRec(chunk.texture.texture, src, Vector2{ (float)(cx * CHUNK_PX), (float)(cy * CHUNK_PX) }, WHITE);
             }
         }
     }
 
-    void MoveTowards(const raylib::Vector2& target) {
-        if (!alive || inTunnel) return;
-        
-        float currentSpeed = chasing ? chaseSpeed : speed;
-        
-        if (target.x > pos.x) pos.x += currentSpeed;
-        else if (target.x < pos.x) pos.x -= currentSpeed;
-        
-        if (target.y > pos.y) pos.y += currentSpeed;
-        else if (target.y < pos.y) pos.y -= currentSpeed;
+    // backdrop covers the whole map and must outlive the cache; null draws plain dirt
+    void SetBackdrop(const raylib::Texture* texture) {
+        backdrop = texture;
+        for (Chunk& chunk : chunks) chunk.builtSerial = -1;
     }
 
-    void Draw() const {
-        if (alive) {
-            Color color = chasing ? MAROON : RED;
-            DrawRectangle((int)pos.x, (int)pos.y, size, size, color);
-        }
+    int Resident() const {
+        int n = 0;
+        for (const Chunk& chunk : chunks) n += chunk.texture.id != 0;
+        return n;
     }
 
-    Rectangle Bounds() const {
-        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+private:
+    struct Chunk {
+        raylib::RenderTexture texture; // id 0 until the chunk is first needed
+        int builtSerial = -1;          // Level the texture shows, -1 if none
+        long lastUsed = 0;             // Frame the chunk was last near the view
+        std::vector<int> pending;      // Tiles dug since the last sync
+    };
+
+    int chunksX, chunksY;
+    std::vector<Chunk> chunks;
+    int levelSerial = -1;
+    long frame = 0;
+    const raylib::Texture* backdrop = nullptr;
+
+    Chunk& At(int cx, int cy) { return chunks[(size_t)cy * chunksX + cx]; }
+
+    // Chunks overlapping rect grown by margin pixels on every side, clamped to the map
+    void ChunkRange(Rectangle rect, int margin, int& x0, int& y0, int& x1, int& y1) const {
+        x0 = std::max(0, (int)(rect.x - margin) / CHUNK_PX);
+        y0 = std::max(0, (int)(rect.y - margin) / CHUNK_PX);
+        x1 = std::min(chunksX - 1, (int)(rect.x + rect.width - 1 + margin) / CHUNK_PX);
+        y1 = std::min(chunksY - 1, (int)(rect.y + rect.height - 1 + margin) / CHUNK_PX);
     }
-};
 
-class Dragon {
-public:
-    raylib::Vector2 pos;
-    int size = TILE_SIZE;
-    float speed = 0.5f;
-    float chaseSpeed = 1.5f; // Faster when chasing
-    bool alive = true;
-    bool inTunnel = true;
-    bool chasing = false;
-    Tunnel* homeTunnel = nullptr;
-    int direction = 1; // 1 for right/down, -1 for left/up
-
-    Dragon(int x, int y, Tunnel* tunnel) {
-        pos = raylib::Vector2((float)x, (float)y);
-        homeTunnel = tunnel;
-    }
-
-    void MoveInTunnel() {
-        if (!alive || !inTunnel) return;
-        
-        if (homeTunnel->direction == TunnelDirection::HORIZONTAL) {
-            pos.x += speed * direction;
-            
-            // Check if reached tunnel end
-            int gridX = static_cast<int>(pos.x) / TILE_SIZE;
-            if (gridX <= homeTunnel->startX ||
-                gridX >= homeTunnel->startX + homeTunnel->length - 1) {
-                direction *= -1; // Reverse direction
-            }
-        } else {
-            pos.y += speed * direction;
-            
-            // Check if reached tunnel end
-            int gridY = static_cast<int>(pos.y) / TILE_SIZE;
-            if (gridY <= homeTunnel->startY ||
-                gridY >= homeTunnel->startY + homeTunnel->length - 1) {
-                direction *= -1; // Reverse direction
+    // Makes the chunk resident and current
+    void Touch(const World& world, int cx, int cy) {
+        Chunk& chunk = At(cx, cy);
+        chunk.lastUsed = frame;
+        if (chunk.texture.id == 0) chunk.texture = raylib::RenderTexture(CHUNK_PX, CHUNK_PX);
+        if (chunk.builtSerial != levelSerial) {
+            Rebuild(world, chunk, cx, cy);
+        } else if (!chunk.pending.empty()) {
+            BeginChunk(chunk, cx, cy);
+            for (int tile : chunk.pending) {
+                DrawRectangle((tile % GRID_WIDTH)*TILE_SIZE, (tile / GRID_WIDTH)*TILE_SIZE, TILE_SIZE, TILE_SIZE, BLACK);
             }
+            EndChunk(chunk);
         }
+        chunk.pending.clear();
     }
 
-    void MoveTowards(const raylib::Vector2& target) {
-        if (!alive || inTunnel) return;
-        
-        float currentSpeed = chasing ? chaseSpeed : speed;
-        
-        if (target.x > pos.x) pos.x += currentSpeed;
-        else if (target.x < pos.x) pos.x -= currentSpeed;
-        
-        if (target.y > pos.y) pos.y += currentSpeed;
-        else if (target.y < pos.y) pos.y -= currentSpeed;
+    // Draws in world coordinates into the chunk's texture
+    void BeginChunk(Chunk& chunk, int cx, int cy) {
+        chunk.texture.BeginMode();
+        BeginMode2D(Camera2D{ Vector2{ 0, 0 }, Vector2{ (float)(cx * CHUNK_PX), (float)(cy * CHUNK_PX) }, 0.0f, 1.0f });
     }
 
-    void Draw() const {
-        if (!alive) return;
-        
-        Color color = chasing ? DARKGREEN : GREEN;
-        Vector2 p1 { pos.x + size/2.0f, pos.y };
-        Vector2 p2 { pos.x,              pos.y + (float)size };
-        Vector2 p3 { pos.x + (float)size, pos.y + (float)size };
-        DrawTriangle(p1, p2, p3, color);
+    void EndChunk(Chunk& chunk) {
+        EndMode2D();
+        chunk.texture.EndMode();
     }
 
-    Rectangle Bounds() const {
-        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+    void Rebuild(const World& world, Chunk& chunk, int cx, int cy) {
+        BeginChunk(chunk, cx, cy);
+        ClearBackground(BROWN);
+        if (backdrop) {
+            Rectangle area { (float)(cx * CHUNK_PX), (float)(cy * CHUNK_PX), (float)CHUNK_PX, (float)CHUNK_PX };
+            DrawTextureRec(*backdrop, area, Vector2{ area.x, area.y }, WHITE);
+        }
+
+        // Dug areas (tunnels included) as one rectangle per horizontal run, clipped to the chunk
+        int left = cx * CHUNK, right = std::min(left + CHUNK, GRID_WIDTH);
+        int top = cy * CHUNK, bottom = std::min(top + CHUNK, GRID_HEIGHT);
+        for (int y = top; y < bottom; y++) {
+            world.dug.ForEachRun(y, [&](int x, int length) {
+                int from = std::max(x, left), to = std::min(x + length, right);
+                if (from < to) DrawRectangle(from*TILE_SIZE, y*TILE_SIZE, (to - from)*TILE_SIZE, TILE_SIZE, BLACK);
+            });
+        }
+
+        EndChunk(chunk);
+        chunk.builtSerial = world.levelSerial;
     }
 };
 
-class Fruit {
+// ---------------------------------
+// Minimap
+// ---------------------------------
+// The whole map at one pixel per tile, kept as a CPU image in step with World::dug and drawn
+// SCALE times larger with point sampling, as one textured quad. Dug tiles are set in it as the
+// world reports them and only the merged rectangles around them go to the texture, so a frame
+// of digging uploads a few dozen bytes; a new level repaints and uploads it once, at 4 bytes
+// a tile however large the map.
+class Minimap {
 public:
-    raylib::Vector2 pos;
-    int size = TILE_SIZE;
-    bool collected = false;
-
-    Fruit(int x, int y) { pos = raylib::Vector2((float)x, (float)y); }
+    static constexpr int SCALE = 4; // Screen pixels per tile
+
+    Minimap(int gridWidth, int gridHeight)
+        : image(gridWidth, gridHeight, DARKBROWN), dirty(gridWidth, gridHeight) {}
+
+    // Before TerrainCache::Sync, which consumes world.dirtyTiles
+    void Sync(const World& world) {
+        if (world.levelSerial != levelSerial) {
+            levelSerial = world.levelSerial;
+            image.ClearBackground(DARKBROWN);
+            for (int y = 0; y < world.grid.Height(); y++) {
+                world.dug.ForEachRun(y, [&](int x, int length) { image.DrawRectangle(x, y, length, 1, BLACK); });
+            }
+            dirty.AddAll();
+        }
+        for (int tile : world.dirtyTiles) {
+            int x = tile % world.grid.Width(), y = tile / world.grid.Width();
+            image.DrawPixel(x, y, BLACK);
+            dirty.Add(x, y, 1, 1);
+        }
 
-    void Draw() const {
-        if (!collected) {
-            DrawCircle((int)(pos.x + size/2), (int)(pos.y + size/2), size/2, LIME);
-            DrawCircleLines((int)(pos.x + size/2), (int)(pos.y + size/2), size/2, DARKGREEN);
+        if (texture.id == 0) {
+            texture.Load(image);
+            dirty.Clear();
         }
+        uploaded = dirty.Flush(texture, image);
+    }
+
+    // Queued with its top-left corner at (x, y): the map and its frame behind, the players' dots in front
+    void Draw(SpriteBatch& batch, const World& world, int x, int y) const {
+        if (texture.id == 0) return;
+        float w = (float)(image.width * SCALE), h = (float)(image.height * SCALE);
+        batch.Add(SpriteBatch::HUD_BACK, texture, Rectangle{ 0, 0, (float)image.width, (float)image.height },
+                  Rectangle{ (float)x, (float)y, w, h }, Fade(WHITE, 0.8f));
+        batch.AddRectLines(SpriteBatch::HUD_BACK, Rectangle{ (float)(x - 1), (float)(y - 1), w + 2, h + 2 }, GRAY);
+        DrawDot(batch, world.player, x, y, BLUE);
+        if (world.coop) DrawDot(batch, world.partner, x, y, SKYBLUE);
     }
 
-    Rectangle Bounds() const {
-        return Rectangle{ pos.x, pos.y, (float)size, (float)size };
+    // Bytes the last Sync sent to the GPU
+    size_t Uploaded() const { return uploaded; }
+
+private:
+    raylib::Image image;
+    raylib::Texture texture;
+    raylib::DirtyRegion dirty;
+    int levelSerial = -1;
+    size_t uploaded = 0;
+
+    static void DrawDot(SpriteBatch& batch, const Player& p, int x, int y, Color color) {
+        float centre = p.size / 2.0f;
+        int dotX = x + (int)((p.pos.x + centre) / TILE_SIZE * SCALE) - SCALE / 2;
+        int dotY = y + (int)((p.pos.y + centre) / TILE_SIZE * SCALE) - SCALE / 2;
+        batch.AddRect(SpriteBatch::HUD_FRONT, Rectangle{ (float)dotX, (float)dotY, SCALE, SCALE }, color);
     }
 };
 
 // ---------------------------------
-// Game state
+// Fog of war
 // ---------------------------------
-enum class GameState { SPLASH, PLAYING, GAMEOVER, WIN };
-
-struct World {
-    Player player{100,100};
-    std::vector<Monster> monsters;
-    std::vector<Dragon>  dragons;
-    std::vector<Tunnel> tunnels;
-    Fruit fruit{SCREEN_W/2 - TILE_SIZE/2, SCREEN_H/2 - TILE_SIZE/2};
-    std::vector<std::vector<bool>> dug{ GRID_HEIGHT, std::vector<bool>(GRID_WIDTH, false) };
-    GameState state = GameState::SPLASH;
-    int highScore = 0;
-
-    int respawnTimer = 0;
-
-    void LoadHighScore() {
-        std::ifstream in("highscore.txt");
-        if (in) in >> highScore;
-    }
-    void SaveHighScore() {
-        if (player.score > highScore) {
-            highScore = player.score;
-            std::ofstream out("highscore.txt");
-            if (out) out << highScore;
-        }
-    }
-
-    bool IsValidTunnel(const Tunnel& newTunnel) {
-        // Check if tunnel is within bounds
-        if (newTunnel.direction == TunnelDirection::HORIZONTAL) {
-            if (newTunnel.startX < 1 || newTunnel.startX + newTunnel.length >= GRID_WIDTH - 1 ||
-                newTunnel.startY < 1 || newTunnel.startY >= GRID_HEIGHT - 1) {
-                return false;
-            }
-        } else {
-            if (newTunnel.startX < 1 || newTunnel.startX >= GRID_WIDTH - 1 ||
-                newTunnel.startY < 1 || newTunnel.startY + newTunnel.length >= GRID_HEIGHT - 1) {
-                return false;
-            }
-        }
-        
-        // Check if tunnel doesn't intersect with existing tunnels
-        for (const auto& tunnel : tunnels) {
-            if (newTunnel.Intersects(tunnel)) {
-                return false;
-            }
-        }
-        
-        return true;
+// --fog's darkness, drawn as a single quad however much of the map is dark. The
+// VisibilityMap's light goes into a texture of one texel per tile, which is stretched over
+// the map with bilinear filtering so the light fades out across tiles instead of stepping,
+// and a shader turns it into black of the matching opacity.
+static const char* const FOG_FS =
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main() {\n"
+    "    float light = smoothstep(0.0, 1.0, TEX(texture0, fragTexCoord).r);\n"
+    "    finalColor = vec4(0.0, 0.0, 0.0, (1.0 - light) * colDiffuse.a * fragColor.a);\n"
+    "}\n";
+
+class FogMask {
+public:
+    // Needs the GL context
+    void Load(int gridWidth, int gridHeight) {
+        pixels.assign((size_t)gridWidth * (size_t)gridHeight, BLACK);
+        texture.Load(raylib::Image(gridWidth, gridHeight, BLACK));
+        texture.SetFilter(TEXTURE_FILTER_BILINEAR);
+        texture.SetWrap(TEXTURE_WRAP_CLAMP); // So the map's edges don't blend with the far side
+        shader = raylib::Shader::LoadFromMemory(nullptr, (std::string(ARCADE_FS_PREFIX) + FOG_FS).c_str());
     }
 
-    void CreateTunnels() {
-        tunnels.clear();
-        
-        // Create some horizontal tunnels
-        int attempts = 0;
-        while (tunnels.size() < 4 && attempts < 50) {
-            int x = rand() % (GRID_WIDTH - 10) + 2;
-            int y = rand() % (GRID_HEIGHT - 4) + 2;
-            int length = rand() % 5 + 4; // 4-8 tiles long
-            
-            Tunnel newTunnel(x, y, length, TunnelDirection::HORIZONTAL);
-            if (IsValidTunnel(newTunnel)) {
-                tunnels.push_back(newTunnel);
-            }
-            attempts++;
-        }
-        
-        // Create some vertical tunnels
-        attempts = 0;
-        while (tunnels.size() < 8 && attempts < 50) {
-            int x = rand() % (GRID_WIDTH - 4) + 2;
-            int y = rand() % (GRID_HEIGHT - 10) + 2;
-            int length = rand() % 5 + 4; // 4-8 tiles long
-            
-            Tunnel newTunnel(x, y, length, TunnelDirection::VERTICAL);
-            if (IsValidTunnel(newTunnel)) {
-                tunnels.push_back(newTunnel);
-            }
-            attempts++;
-        }
-    }
-
-    void ResetLevel() {
-        for (auto& row : dug) std::fill(row.begin(), row.end(), false);
-        player.ResetTo(100,100);
-        monsters.clear();
-        dragons.clear();
-        
-        CreateTunnels();
-        
-        // Mark tunnel areas as dug
-        for (auto& tunnel : tunnels) {
-            if (tunnel.direction == TunnelDirection::HORIZONTAL) {
-                for (int x = tunnel.startX; x < tunnel.startX + tunnel.length; x++) {
-                    dug[tunnel.startY][x] = true;
-                }
-            } else {
-                for (int y = tunnel.startY; y < tunnel.startY + tunnel.length; y++) {
-                    dug[y][tunnel.startX] = true;
-                }
-            }
-            tunnel.activated = false;
-        }
-        
-        // Place monsters in tunnels
-        for (auto& tunnel : tunnels) {
-            if (rand() % 2 == 0) { // 50% chance to place a monster in this tunnel
-                int x, y;
-                if (tunnel.direction == TunnelDirection::HORIZONTAL) {
-                    x = (tunnel.startX + tunnel.length / 2) * TILE_SIZE;
-                    y = tunnel.startY * TILE_SIZE;
-                } else {
-                    x = tunnel.startX * TILE_SIZE;
-                    y = (tunnel.startY + tunnel.length / 2) * TILE_SIZE;
-                }
-                monsters.emplace_back(x, y, &tunnel);
-            }
-        }
-        
-        // Place dragons in remaining tunnels
-        for (auto& tunnel : tunnels) {
-            bool hasMonster = false;
-            for (auto& monster : monsters) {
-                if (monster.homeTunnel == &tunnel) {
-                    hasMonster = true;
-                    break;
-                }
-            }
-            
-            if (!hasMonster && rand() % 2 == 0) { // 50% chance to place a dragon in this tunnel
-                int x, y;
-                if (tunnel.direction == TunnelDirection::HORIZONTAL) {
-                    x = (tunnel.startX + tunnel.length / 2) * TILE_SIZE;
-                    y = tunnel.startY * TILE_SIZE;
-                } else {
-                    x = tunnel.startX * TILE_SIZE;
-                    y = (tunnel.startY + tunnel.length / 2) * TILE_SIZE;
-                }
-                dragons.emplace_back(x, y, &tunnel);
-            }
-        }
+    // Lights the tiles around p; uploads only when the map was searched again
+    void Sync(const World& world, const Player& p) {
+        int tx = (int)((p.pos.x + p.size / 2.0f) / TILE_SIZE), ty = (int)((p.pos.y + p.size / 2.0f) / TILE_SIZE);
+        if (!map.Update(world.dug, tx, ty, world.levelSerial)) return;
+        const uint8_t* light = map.Data();
+        for (size_t i = 0; i < pixels.size(); i++) pixels[i] = Color{ light[i], light[i], light[i], 255 };
+        texture.Update(pixels.data());
+    }
 
-        fruit.collected = false;
+    // In world space, over everything it should hide
+    void Draw(const World& world) const {
+        if (texture.id == 0) return;
+        BeginShaderMode(shader);
+        texture.Draw(raylib::Rectangle(0, 0, (float)texture.width, (float)texture.height),
+                     raylib::Rectangle(0, 0, (float)world.MapWidth(), (float)world.MapHeight()));
+        EndShaderMode();
     }
 
-    void ResetAll() {
-        player.lives = START_LIVES;
-        player.score = 0;
-        player.alive = true;
-        ResetLevel();
-        state = GameState::SPLASH;
-        respawnTimer = 0;
+private:
+    VisibilityMap<World::Bitset> map;
+    std::vector<Color> pixels;
+    raylib::Texture texture;
+    raylib::Shader shader;
+};
+
+// ---------------------------------
+// Startup tasks
+// ---------------------------------
+// Setup that needs neither the GL context nor anything drawn before it, such as opening the
+// audio device or generating the first level, runs on a thread per task while the main thread
+// puts the splash screen up. Tasks must not touch what the main thread uses until Wait() or
+// Done() says they have finished. Each task's span goes into the startup trace.
+class StartupTasks {
+public:
+    static constexpr int MAX_TASKS = 4;
+
+    ~StartupTasks() { Wait(); }
+
+    // name must outlive the program (a literal); ignored past MAX_TASKS
+    void Run(const char* name, std::function<void()> fn) {
+        if (count == MAX_TASKS) return;
+        Task& task = tasks[count++];
+        task.name = name;
+        task.thread = std::thread([&task, fn = std::move(fn)] {
+            task.start = Profiler::Clock::now();
+            fn();
+            task.end = Profiler::Clock::now();
+            task.done.store(true, std::memory_order_release);
+        });
     }
-    
-    Tunnel* GetTunnelAt(int gridX, int gridY) {
-        for (auto& tunnel : tunnels) {
-            if (tunnel.Contains(gridX, gridY)) {
-                return &tunnel;
-            }
+
+    bool Done() const {
+        for (int i = 0; i < count; i++) {
+            if (!tasks[i].done.load(std::memory_order_acquire)) return false;
         }
-        return nullptr;
-    }
-    
-    void CheckTunnelActivation() {
-        int playerGridX = static_cast<int>(player.pos.x / TILE_SIZE);
-        int playerGridY = static_cast<int>(player.pos.y / TILE_SIZE);
-        
-        for (auto& tunnel : tunnels) {
-            if (tunnel.Contains(playerGridX, playerGridY) && !tunnel.activated) {
-                tunnel.activated = true;
-                
-                // Alert monsters and dragons in this tunnel
-                for (auto &m : monsters) {
-                    if (m.homeTunnel == &tunnel) {
-                        m.inTunnel = false;
-                        m.chasing = true;
-                    }
-                }
-                for (auto &d : dragons) {
-                    if (d.homeTunnel == &tunnel) {
-                        d.inTunnel = false;
-                        d.chasing = true;
-                    }
-                }
-                
-                // Debug message
-                // std::cout << "Tunnel activated! Monsters/Dragons are now chasing!" << std::endl;
-            }
+        return true;
+    }
+
+    void Wait() {
+        for (int i = 0; i < count; i++) {
+            if (tasks[i].thread.joinable()) tasks[i].thread.join();
         }
     }
+
+    // Once done: each task's span on a trace track of its own
+    void Trace(Profiler& profiler) const {
+        for (int i = 0; i < count; i++) profiler.AddSpan(tasks[i].name, tasks[i].start, tasks[i].end, i + 1);
+    }
+
+private:
+    struct Task {
+        const char* name = nullptr;
+        Profiler::Clock::time_point start, end;
+        std::atomic<bool> done{ false };
+        std::thread thread;
+    };
+
+    Task tasks[MAX_TASKS];
+    int count = 0;
 };
 
 // ---------------------------------
-// Main
+// Telemetry
 // ---------------------------------
-int main() {
-    srand((unsigned)time(nullptr));
-    raylib::Window window(SCREEN_W, SCREEN_H, "Dig Dug with Tunnels");
-    SetTargetFPS(60);
+const double TELEMETRY_PERF_PERIOD = 5.0; // Seconds of frames and ticks each PERF record sums up
+
+// "host:port" into its parts; false without a port
+static bool SplitHostPort(const char* address, std::string& host, uint16_t& port) {
+    host = address;
+    size_t colon = host.rfind(':');
+    if (colon == std::string::npos) return false;
+    int value = atoi(host.c_str() + colon + 1);
+    host.resize(colon);
+    port = (uint16_t)value;
+    return value > 0 && value < 65536;
+}
 
-    World world;
-    world.LoadHighScore();
-    world.ResetAll();
+// Where batches go: appended to a file, or one datagram each to a collector. Called on the
+// telemetry thread; an empty sink drops everything.
+static Telemetry::Sink OpenTelemetrySink(const std::string& path, const std::string& address) {
+    if (!path.empty()) {
+        std::shared_ptr<FILE> file(fopen(path.c_str(), "ab"), [](FILE* f) { if (f) fclose(f); });
+        if (!file) return Telemetry::Sink();
+        return [file](const void* data, size_t size) {
+            bool written = fwrite(data, 1, size, file.get()) == size;
+            return fflush(file.get()) == 0 && written;
+        };
+    }
+    std::string host;
+    uint16_t port = 0;
+    std::shared_ptr<UdpSocket> socket(new UdpSocket());
+    if (!SplitHostPort(address.c_str(), host, port) || !socket->Open(0) || !socket->SetPeer(host.c_str(), port))
+        return Telemetry::Sink();
+    return [socket](const void* data, size_t size) { return socket->Send(data, size); };
+}
 
-    Rectangle restartBtn = { SCREEN_W/2.0f - 100, SCREEN_H/2.0f + 40, 200, 50 };
+// ---------------------------------
+// Main
+// ---------------------------------
+//   DigDugClone [--stress N] [--host PORT | --join HOST:PORT] [--level FILE [--endless]]
+//               [--low-latency] [--no-vsync] [--sim-thread] [--tuning FILE] [--enemies FILE] [--arcade]
+//               [--startup-trace FILE] [--fixed-quality] [--fog]
+//               [--telemetry HOST:PORT | --telemetry-file FILE]
+//
+// --stress starts straight into a level with N extra chasing enemies and an invulnerable
+// player, and shows tick rate and frame timing in place of the score.
+// --host and --join play two-player co-op over UDP: the host listens on PORT and picks the
+// level seed, the other side connects to it. Both must run the same build.
+// --level plays a level file or pack (see digdug_headless --write-level and --write-pack)
+// instead of generated levels; clearing a pack level moves on to the next, and --endless
+// starts the pack over after the last.
+// --low-latency samples input late in the frame (see LatePacer); --no-vsync presents without
+// waiting for vertical blank, pacing on the monitor's refresh rate in low-latency mode. The
+// profiler overlay (F3) shows input-to-present time either way.
+// --sim-thread runs the simulation on its own thread (see SimThread.hpp), so the frame only
+// draws its latest copy of the world. It is ignored in co-op, where the session drives the
+// ticks, and with --low-latency, which needs each tick to follow the input it just sampled.
+// --tuning names the balance file (default tuning.txt, see TuningFile.hpp). It is watched
+// while the game runs and edits apply between ticks; co-op sessions don't watch it, since both
+// peers must simulate with the same tuning.
+// --enemies names the enemy script (default enemies.txt, see EnemyScript.hpp), read once at
+// startup; without one, or with errors in it, the built-in monsters and dragons spawn. Co-op
+// peers must load the same one.
+// --arcade starts with the bloom and CRT filter on (F7 and F6 toggle them; see ArcadeFilter.hpp).
+// --startup-trace writes a Chrome trace (see Profiler.hpp) of everything from launch to the
+// end of the first main-loop frame once startup is over: the splash goes up as soon as the
+// window exists, while the StartupTasks open the audio device and generate the first level.
+// --fixed-quality keeps every effect on however long frames take; otherwise a
+// QualityController sheds the filter, the sparks and then some of the chasers' thinking while
+// frames miss the refresh, and restores them once there is room.
+// --fog plays in the dark: only the tunnels within a few steps of the player, and the dirt
+// walling them in, can be seen (see Visibility.hpp); the minimap is hidden to match.
+// --telemetry sends the session's deaths, levels, final scores and frame and tick timings to a
+// collector as UDP datagrams; --telemetry-file appends the same batches to a file instead.
+// Neither is on by default. See Telemetry.hpp for the format.
+int main(int argc, char** argv) {
+    int stressEnemies = 0;
+    int hostPort = 0;
+    const char* joinAddress = nullptr;
+    const char* levelPath = nullptr;
+    bool endless = false;
+    bool lowLatency = false;
+    bool vsync = true;
+    bool arcade = false;
+    bool simThreaded = false;
+    bool adaptiveQuality = true;
+    bool fogOfWar = false;
+    const char* telemetryAddress = nullptr;
+    const char* telemetryPath = nullptr;
+    const char* tuningPath = "tuning.txt";
+    const char* enemyPath = "enemies.txt";
+    const char* startupTracePath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--endless")) endless = true;
+        else if (!strcmp(argv[i], "--low-latency")) lowLatency = true;
+        else if (!strcmp(argv[i], "--no-vsync")) vsync = false;
+        else if (!strcmp(argv[i], "--arcade")) arcade = true;
+        else if (!strcmp(argv[i], "--sim-thread")) simThreaded = true;
+        else if (!strcmp(argv[i], "--fixed-quality")) adaptiveQuality = false;
+        else if (!strcmp(argv[i], "--fog")) fogOfWar = true;
+        else if (!strcmp(argv[i], "--stress") && hasValue) stressEnemies = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--host") && hasValue) hostPort = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--join") && hasValue) joinAddress = argv[++i];
+        else if (!strcmp(argv[i], "--level") && hasValue) levelPath = argv[++i];
+        else if (!strcmp(argv[i], "--tuning") && hasValue) tuningPath = argv[++i];
+        else if (!strcmp(argv[i], "--enemies") && hasValue) enemyPath = argv[++i];
+        else if (!strcmp(argv[i], "--startup-trace") && hasValue) startupTracePath = argv[++i];
+        else if (!strcmp(argv[i], "--telemetry") && hasValue) telemetryAddress = argv[++i];
+        else if (!strcmp(argv[i], "--telemetry-file") && hasValue) telemetryPath = argv[++i];
+    }
 
-    while (!window.ShouldClose()) {
-        // -------------------------
-        // UPDATE
-        // -------------------------
-        if (world.state == GameState::SPLASH) {
-            if (IsKeyPressed(KEY_ENTER)) {
-                world.state = GameState::PLAYING;
-                world.ResetLevel();
+    // F3 toggles the timing overlay, F4 dumps the buffered frames to profile.csv, F5 starts and
+    // stops a trace capture written to trace.json. Made before anything else so --startup-trace
+    // sees the whole of startup.
+    Profiler profiler;
+    Profiler::SetCurrent(&profiler);
+    if (startupTracePath) profiler.StartCapture();
+    const Profiler::Clock::time_point launch = Profiler::Clock::now();
+    auto sinceLaunch = [&]() {
+        return std::chrono::duration<double, std::milli>(Profiler::Clock::now() - launch).count();
+    };
+
+    // Pacing comes from vsync rather than SetTargetFPS; the simulation runs on its own fixed tick.
+    raylib::Window window(VIEW_W, VIEW_H, "Dig Dug with Tunnels", vsync ? FLAG_VSYNC_HINT : 0);
+    profiler.AddSpan("create window", launch, Profiler::Clock::now());
+    raylib::AudioDevice audio(true); // Opened by a startup task; closed on the way out
+    ArcadeFilter filter;
+    filter.Load(VIEW_W, VIEW_H);
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    LatePacer pacer(1.0 / (refreshRate > 0 ? refreshRate : 60));
+    QualityController quality(1000.0f / (float)(refreshRate > 0 ? refreshRate : 60));
+
+    // Builds each next level while the current one is played
+    LevelPregen pregen;
+    std::unique_ptr<JobPool> jobs; // Stress mode moves its crowd on every core
+
+    LevelPack levels;
+    if (levelPath && !levels.Open(levelPath))
+        TraceLog(LOG_WARNING, "LEVEL: %s is not a level file or pack", levelPath);
+
+    MemoryStats::SetBudget(MemTag::WORLD, WORLD_MEMORY_BUDGET);
+    MemoryStats::SetBudget(MemTag::ASSETS, ASSETS_MEMORY_BUDGET);
+    MemoryStats::SetBudget(MemTag::AUDIO, AUDIO_MEMORY_BUDGET);
+    // Compiled once, before the first level spawns anything
+    EnemyScript enemyScript;
+    bool scriptedEnemies = false;
+    std::string enemyText, enemyError;
+    if (ReadTextFile(enemyPath, enemyText)) {
+        scriptedEnemies = enemyScript.Compile(enemyText.c_str(), enemyError);
+        if (scriptedEnemies) TraceLog(LOG_INFO, "ENEMIES: %d kinds from %s", enemyScript.Count(), enemyPath);
+        else TraceLog(LOG_WARNING, "ENEMIES: %s not applied, %s", enemyPath, enemyError.c_str());
+    }
+
+    World world;
+    world.SetEnemyScript(enemyScript);
+    world.pregen = &pregen;
+    if (levels.Count() > 0) world.levels = &levels;
+    world.endless = endless;
+    uint64_t seed = (uint64_t)time(nullptr);
+    world.rng.Seed(seed);
+
+    // The audio device and the first level come up on their own threads while the splash
+    // screen shows; nothing below touches world or plays sound until they are done
+    StartupTasks startup;
+    startup.Run("open audio device", [] { InitAudioDevice(); }); // Without a device the game just plays silent
+    startup.Run("generate level", [&] {
+        MemoryScope scope(MemTag::WORLD);
+        world.ResetAll();
+        if (stressEnemies > 0) {
+            Rng spawn(seed, 1);
+            jobs.reset(new JobPool());
+            world.jobs = jobs.get();
+            world.state = GameState::PLAYING;
+            world.invulnerable = true;
+            world.AddStressEnemies(stressEnemies, spawn);
+        }
+    });
+
+    // Loads and saves on its own thread; the best score shows up once the file has been read
+    HighScoreStore scores("highscores.bin", "highscore.txt");
+
+    // Screen text, formatted only when the numbers change
+    TextLabel title(32, WHITE, "DIG DUG (Tunnel Edition)");
+    TextLabel startPrompt(24, YELLOW, "Loading...");
+    TextLabel splashHigh(20, GRAY);
+    TextLabel topScoresHeading(20, GRAY, "Top scores");
+    TextLabel topScores[5] = { {20, RAYWHITE}, {20, RAYWHITE}, {20, RAYWHITE}, {20, RAYWHITE}, {20, RAYWHITE} };
+    TextLabel scoreText(20, YELLOW);
+    TextLabel highText(18, GRAY);
+    TextLabel livesText(20, WHITE, "Lives:");
+    TextLabel respawnText(32, YELLOW);
+    TextLabel gameOverText(40, RED, "GAME OVER");
+    TextLabel winText(40, GREEN, "YOU WIN!");
+    TextLabel finalScoreText(24, WHITE);
+    TextLabel finalHighText(24, GRAY);
+    TextLabel restartLabel(20, WHITE, "Restart (Enter/R)");
+    TextLabel stressText(20, YELLOW);
+    TextLabel netText(20, YELLOW);
+
+    auto drawSplash = [&](int highScore) {
+        ClearBackground(BLACK);
+        title.DrawCentered(VIEW_W/2, 120);
+        DrawText("Arrow keys: Move & dig", VIEW_W/2 - 150, 200, 20, RAYWHITE);
+        DrawText("Space: Harpoon (kills red & green)", VIEW_W/2 - 180, 230, 20, RAYWHITE);
+        DrawText("Enter tunnels to release monsters!", VIEW_W/2 - 180, 260, 20, RAYWHITE);
+        startPrompt.Draw(VIEW_W/2 - 130, 320);
+        splashHigh.SetInts("High Score: %d", highScore);
+        splashHigh.Draw(20, 20);
+
+        Leaderboard table = scores.Table();
+        if (table.Count() > 0) topScoresHeading.Draw(VIEW_W/2 - 60, 380);
+        for (int i = 0; i < table.Count() && i < 5; i++) {
+            topScores[i].SetInts("%2d. %7d", i + 1, table[i].score);
+            topScores[i].Draw(VIEW_W/2 - 60, 408 + i*22);
+        }
+    };
+    // The splash, for as long as startup tasks are running
+    auto drawLoadingFrame = [&]() {
+        profiler.BeginFrame();
+        BeginDrawing();
+        drawSplash(scores.Best());
+        EndDrawing();
+        profiler.EndFrame();
+    };
+    drawLoadingFrame();
+    TraceLog(LOG_INFO, "STARTUP: First frame up after %.1f ms", sinceLaunch());
+
+    // Dirt bakes, files decode and the score file loads in the background; what's left here
+    // needs the GL context, so it goes in after the first frame rather than before it
+    TerrainCache terrain(GRID_WIDTH, GRID_HEIGHT);
+    Minimap minimap(GRID_WIDTH, GRID_HEIGHT);
+    FogMask fog;
+    if (fogOfWar) fog.Load(GRID_WIDTH, GRID_HEIGHT);
+
+    // Each level's dirt is baked on a worker during the level before; a new level swaps the
+    // next one in with a single upload, keeping the old dirt until it's done
+    DirtBaker dirtBaker(SCREEN_W, SCREEN_H);
+    raylib::Image dirtImage;
+    raylib::Texture dirtTexture;
+    bool wantDirt = true;
+
+    // Files decode on the loader's threads and upload a few per frame, so startup never waits
+    // on them; the placeholder sprites show until sprites.png, or sprites.rltex as cooked by
+    // digdug_cook, is in
+    AssetLoader assets;
+    SpriteAtlas atlas;
+    atlas.Generate();
+    AssetHandle<raylib::Texture> spriteArt;
+    if (FileExists("sprites.rltex")) spriteArt = assets.LoadTexture("sprites.rltex");
+    else if (FileExists("sprites.png")) spriteArt = assets.LoadTexture("sprites.png");
+    SpriteBatch sprites(atlas);
+    SpriteBatch hud(atlas); // Screen space, flushed once the overlays are queued too
+    ViewCamera view;
+
+    while (!startup.Done()) {
+        if (window.ShouldClose()) return 0;
+        drawLoadingFrame();
+    }
+    startup.Wait();
+    startup.Trace(profiler);
+    TraceLog(LOG_INFO, "STARTUP: Level and audio ready after %.1f ms", sinceLaunch());
+    startPrompt.Set("Press ENTER to Start");
+    filter.SetAll(arcade);
+
+    UdpSocket socket;
+    std::unique_ptr<NetSession> net;
+    MemoryScope netSetup(MemTag::WORLD);
+    if (hostPort > 0 && socket.Open((uint16_t)hostPort)) {
+        net.reset(new NetSession(world, socket, 0, seed));
+    } else if (joinAddress) {
+        std::string host;
+        uint16_t port = 0;
+        if (SplitHostPort(joinAddress, host, port) && socket.Open(0) && socket.SetPeer(host.c_str(), port))
+            net.reset(new NetSession(world, socket, 1));
+    }
+    netSetup.End();
+    if ((hostPort > 0 || joinAddress) && !net) TraceLog(LOG_WARNING, "NET: Could not open a co-op session");
+    if (simThreaded && (net || lowLatency)) {
+        TraceLog(LOG_WARNING, "SIM: --sim-thread is ignored in co-op and low-latency mode");
+        simThreaded = false;
+    }
+    // Everything outside the simulation listens here: the world's own bus when ticks run in
+    // the frame, the frames' events re-pushed on the main thread when they run on the sim thread
+    EventBus frameEvents;
+    EventBus& events = simThreaded ? frameEvents : world.events;
+
+    // Read and parsed on its own thread; picked up between ticks
+    std::unique_ptr<TuningWatcher> tuningWatcher;
+    if (!net) tuningWatcher.reset(new TuningWatcher(tuningPath, world.tuning));
+    int tuningErrors = 0;
+
+    // Set by the frame, read by the ticks, which may run on the sim thread
+    std::atomic<int> aiIntervalScale{ 1 };
+    int aiInterval = world.tuning.aiInterval; // Before scaling, as tuned
+    bool aiThrottled = false;                 // Ever ran scaled, which no replay could follow
+    if (net) quality.SetMaxLevel(4);          // Both peers must think alike
+
+    // Records go into a ring here and leave from the telemetry thread
+    std::unique_ptr<Telemetry> telemetry;
+    TickHistogram tickTimes; // Fed by whichever thread runs the ticks
+    if (telemetryAddress || telemetryPath) {
+        std::string path = telemetryPath ? telemetryPath : "", address = telemetryAddress ? telemetryAddress : "";
+        uint64_t session = seed ^ ((uint64_t)Profiler::Clock::now().time_since_epoch().count() << 16);
+        telemetry.reset(new Telemetry(session, [path, address] { return OpenTelemetrySink(path, address); }));
+        telemetry->Add(TelemetryKind::SESSION_START, (int32_t)(uint32_t)seed, net ? 1 : 0);
+    }
+    struct TelemetryFeed {
+        Telemetry* telemetry;
+        int deaths; // This game
+    } telemetryFeed{ telemetry.get(), 0 };
+    if (telemetry) {
+        events.Subscribe([](void* feed, const GameEvent& e) {
+            TelemetryFeed& f = *(TelemetryFeed*)feed;
+            if (e.type == EventType::PLAYER_DIED) {
+                f.deaths++;
+                f.telemetry->Add(TelemetryKind::DEATH, e.a, e.b);
+            } else if (e.type == EventType::LEVEL_STARTED) {
+                f.telemetry->Add(TelemetryKind::LEVEL, e.a);
+            } else if (e.type == EventType::GAME_ENDED) {
+                f.telemetry->Add(TelemetryKind::GAME_ENDED, e.a, f.deaths);
+                f.deaths = 0;
             }
+        }, &telemetryFeed);
+    }
+    int perfFrames = 0, sessionFrames = 0;
+    double perfFrameMs = 0.0, perfStart = GetTime();
+
+    events.Subscribe([](void* store, const GameEvent& e) {
+        if (e.type == EventType::GAME_ENDED) ((HighScoreStore*)store)->Submit(e.a);
+    }, &scores);
+    events.Subscribe([](void* want, const GameEvent& e) {
+        if (e.type == EventType::LEVEL_STARTED) *(bool*)want = true;
+    }, &wantDirt);
+
+    // Effects play on pooled voices straight from the tick's events
+    VoicePool sfx;
+    events.Subscribe([](void* pool, const GameEvent& e) {
+        VoicePool& voices = *(VoicePool*)pool;
+        if (e.type == EventType::HARPOON_FIRED) voices.Play(SfxId::HARPOON);
+        else if (e.type == EventType::ENEMY_KILLED) voices.Play(SfxId::KILL, e.a == (int)EnemyKind::DRAGON ? 0.8f : 1.0f);
+        else if (e.type == EventType::FRUIT_COLLECTED) voices.Play(SfxId::PICKUP);
+    }, &sfx);
+
+    // Flashes, sparks and crumbs, spawned from the tick's events and advanced with each tick
+    EffectPool effects;
+    events.Subscribe([](void* feed, const GameEvent& e) {
+        EffectPool& pool = *(EffectPool*)feed;
+        if (e.type == EventType::PLAYER_DIED) {
+            pool.Flash(e.x, e.y, (float)TILE_SIZE, DEATH_FLASH_TIME, RED);
+        } else if (e.type == EventType::ENEMY_KILLED) {
+            pool.Sparks(e.x, e.y, GetColor((unsigned int)e.b));
+        } else if (e.type == EventType::TILE_DUG) {
+            pool.Crumbs((float)(e.a * TILE_SIZE), (float)(e.b * TILE_SIZE), (float)TILE_SIZE, DARKBROWN);
+        } else if (e.type == EventType::LEVEL_STARTED || e.type == EventType::LEVEL_RESTARTED) {
+            pool.Clear();
         }
-        else if (world.state == GameState::PLAYING) {
-            if (world.respawnTimer > 0) {
-                world.respawnTimer--;
-                if (world.respawnTimer == 0) {
-                    world.player.alive = true;
-                    world.ResetLevel();
-                }
+    }, &effects);
+
+    auto applyQuality = [&]() {
+        filter.Shed(quality.ShedPasses());
+        effects.SetDensity(quality.EffectDensity());
+        aiIntervalScale = quality.AiIntervalScale();
+    };
+
+    // music.ogg when present, the built-in tune otherwise; fed from its own thread
+    MusicStreamer music("music.ogg");
+    music.SetVolume(0.5f);
+
+    // Muffled outside play, ducked for a moment when a life is lost
+    using MusicFx = DspChain<DspLowPass, DspDucker, DspGain>;
+    MusicFx musicFx;
+    musicFx.Attach(music.Stream());
+    events.Subscribe([](void* fx, const GameEvent& e) {
+        if (e.type == EventType::PLAYER_DIED) ((MusicFx*)fx)->Get<DspDucker>().Duck();
+    }, &musicFx);
+
+    // Every tick's input is recorded and written to session.rae on exit, for
+    // digdug_headless --replay
+    ReplayRecorder recorder(seed);
+
+    constexpr raylib::Rectangle restartBtn(VIEW_W/2.0f - 100, VIEW_H/2.0f + 40, 200, 50);
+
+    // Stress mode tick rate, counted over one-second windows
+    int ticksThisWindow = 0, ticksPerSecond = 0;
+    double windowStart = GetTime();
+
+    World* shown = &world; // What the frame draws: the world itself, or the sim thread's latest copy
+    double accumulator = 0.0;
+    double lastTime = GetTime();
+
+    // Game keys are stamped on the clock the ticks run on
+    std::unique_ptr<SimThread> sim;
+    auto inputClock = [&]() { return sim ? sim->Now() : GetTime(); };
+    GameInput input(simThreaded ? 0.0 : GetTime()); // The sim thread's clock starts with it
+
+    // Queues the game keys as of the last input poll and handles the others at once
+    auto sampleInput = [&]() {
+        input.Sample(inputClock());
+        if (IsKeyPressed(KEY_F3)) profiler.overlayVisible = !profiler.overlayVisible;
+        if (IsKeyPressed(KEY_F4)) profiler.WriteCsv("profile.csv");
+        if (IsKeyPressed(KEY_F6)) filter.ToggleCrt();
+        if (IsKeyPressed(KEY_F7)) filter.ToggleBloom();
+        if (IsKeyPressed(KEY_F5)) {
+            if (!profiler.Capturing()) {
+                profiler.StartCapture();
             } else {
-                // Normal updates only if not respawning
-                world.player.Move();
-                int gx = (int)(world.player.pos.x / TILE_SIZE);
-                int gy = (int)(world.player.pos.y / TILE_SIZE);
-                if (gy >= 0 && gy < GRID_HEIGHT && gx >= 0 && gx < GRID_WIDTH) {
-                    world.dug[gy][gx] = true;
-                }
-                
-                // Check if player entered any tunnels
-                world.CheckTunnelActivation();
-
-                // Move monsters and dragons
-                for (auto &m : world.monsters) {
-                    if (m.inTunnel) {
-                        m.MoveInTunnel();
-                    } else if (m.chasing) {
-                        m.MoveTowards(world.player.pos);
-                    }
-                }
-                for (auto &d : world.dragons) {
-                    if (d.inTunnel) {
-                        d.MoveInTunnel();
-                    } else if (d.chasing) {
-                        d.MoveTowards(world.player.pos);
-                    }
-                }
-
-                // Check collisions with player
-                for (auto &m : world.monsters)
-                    if (m.alive && CheckCollisionRecs(world.player.Bounds(), m.Bounds()))
-                        world.player.alive = false;
-
-                for (auto &d : world.dragons)
-                    if (d.alive && CheckCollisionRecs(world.player.Bounds(), d.Bounds()))
-                        world.player.alive = false;
-
-                // Handle harpoon
-                if (world.player.hasHarpoon && world.player.harpoonTimer > 0) {
-                    Rectangle harpoonRect;
-                    if (world.player.harpoonDir.x != 0) {
-                        float w = world.player.harpoonDir.x * 50;
-                        harpoonRect = MakeNormalizedRect(
-                            world.player.pos.x + world.player.size/2,
-                            world.player.pos.y + world.player.size/2 - 2,
-                            w, 4
-                        );
-                    } else {
-                        float h = world.player.harpoonDir.y * 50;
-                        harpoonRect = MakeNormalizedRect(
-                            world.player.pos.x + world.player.size/2 - 2,
-                            world.player.pos.y + world.player.size/2,
-                            4, h
-                        );
-                    }
-
-                    for (auto &m : world.monsters)
-                        if (m.alive && CheckCollisionRecs(harpoonRect, m.Bounds())) {
-                            m.alive = false;
-                            world.player.score += 100;
-                        }
-
-                    for (auto &d : world.dragons)
-                        if (d.alive && CheckCollisionRecs(harpoonRect, d.Bounds())) {
-                            d.alive = false;
-                            world.player.score += 200;
-                        }
-                }
+                profiler.StopCapture();
+                profiler.WriteChromeTrace("trace.json");
+            }
+        }
+    };
+
+    // One tick of the local game; co-op ticks go through the session instead
+    auto runTick = [&](const InputState& in) {
+        MemoryScope scope(MemTag::WORLD);
+        Tuning next;
+        if (tuningWatcher && tuningWatcher->Take(next)) {
+            world.ApplyTuning(next);
+            aiInterval = next.aiInterval;
+            TraceLog(LOG_INFO, "TUNING: Applied %s", tuningPath);
+        }
+        int scale = aiIntervalScale;
+        world.tuning.aiInterval = aiInterval * scale;
+        if (scale > 1) aiThrottled = true;
+        recorder.Record(in);
+        if (!telemetry) {
+            world.Update(in);
+            return;
+        }
+        Profiler::Clock::time_point start = Profiler::Clock::now();
+        world.Update(in);
+        tickTimes.Add(std::chrono::duration<double>(Profiler::Clock::now() - start).count());
+    };
+
+    // From here on only the sim thread touches world
+    uint64_t shownTick = 0, deliveredSeq = 0;
+    if (simThreaded) {
+        sim.reset(new SimThread(world, MAX_TICKS_PER_FRAME, [&](double due) {
+            world.highScore = std::max(world.highScore, scores.Best());
+            input.Feed(due, world.state != GameState::SPLASH);
+            runTick(input.Latched());
+            input.Consumed();
+        }));
+        sim->Acquire();
+        shown = &sim->Frame().world;
+    }
 
-                if (!world.fruit.collected && CheckCollisionRecs(world.player.Bounds(), world.fruit.Bounds())) {
-                    world.fruit.collected = true;
-                    world.player.score += 500;
-                }
+    while (!window.ShouldClose()) {
+        profiler.BeginFrame();
+        if (lowLatency) {
+            PROFILE_ZONE("pace wait");
+            pacer.WaitForInput();
+            PollInputEvents();
+        }
+        if (!sim) world.highScore = std::max(world.highScore, scores.Best());
 
-                if (!world.player.alive) {
-                    world.player.lives--;
-                    world.player.deathFlashTimer = DEATH_FLASH_TIME;
-                    if (world.player.lives > 0) {
-                        world.respawnTimer = RESPAWN_DELAY;
-                    } else {
-                        world.SaveHighScore();
-                        world.state = GameState::GAMEOVER;
-                    }
-                }
+        // -------------------------
+        // INPUT
+        // -------------------------
+        {
+            PROFILE_ZONE("input");
+            sampleInput();
+            profiler.MarkInput();
+        }
 
-                bool allMonstersDead = true;
-                for (auto &m : world.monsters) if (m.alive) { allMonstersDead = false; break; }
-                bool allDragonsDead = true;
-                for (auto &d : world.dragons) if (d.alive) { allDragonsDead = false; break; }
-                
-                if (allMonstersDead && allDragonsDead) {
-                    world.SaveHighScore();
-                    world.state = GameState::WIN;
+        // -------------------------
+        // UPDATE (fixed timestep)
+        // -------------------------
+        double now = GetTime();
+        double frameTime = now - lastTime;
+        lastTime = now;
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        accumulator += frameTime;
+
+        int ticks = 0;
+        float alpha = 0.0f; // Fraction of a tick elapsed since the latest state, used to blend prev -> current
+        if (sim) {
+            // The sim thread keeps its own time and takes the input itself; just pick up its newest frame
+            if (sim->Acquire()) {
+                RenderFrame& frame = sim->Frame();
+                ticks = (int)(frame.tick - shownTick);
+                shownTick = frame.tick;
+                shown = &frame.world;
+                frame.Deliver(frameEvents, deliveredSeq);
+            }
+            for (int i = 0; i < ticks; i++) effects.Update();
+            alpha = (float)std::min(1.0, std::max(0.0, (sim->Now() - sim->Frame().tickTime) / SIM_DT));
+        } else {
+            PROFILE_ZONE("update");
+            while (accumulator >= SIM_DT && ticks < MAX_TICKS_PER_FRAME) {
+                // Every event queued so far is due: the frame sampled them all before its ticks
+                input.Feed(std::numeric_limits<double>::infinity(), world.state != GameState::SPLASH);
+                if (net) {
+                    // Stalled: the peer is behind or not there yet, so keep the input for later
+                    MemoryScope scope(MemTag::WORLD);
+                    Profiler::Clock::time_point start = Profiler::Clock::now();
+                    if (!net->Tick(input.Latched())) break;
+                    if (telemetry) tickTimes.Add(std::chrono::duration<double>(Profiler::Clock::now() - start).count());
+                } else {
+                    runTick(input.Latched());
                 }
+                input.Consumed();
+                effects.Update();
+                accumulator -= SIM_DT;
+                ticks++;
             }
+            if (ticks == MAX_TICKS_PER_FRAME && accumulator >= SIM_DT) accumulator = 0.0;
+            alpha = (float)(accumulator / SIM_DT);
         }
-        else { // GAMEOVER or WIN
-            if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_R)) {
-                world.ResetAll();
-            }
+        if (tuningWatcher && tuningWatcher->Errors() != tuningErrors) {
+            tuningErrors = tuningWatcher->Errors();
+            TraceLog(LOG_WARNING, "TUNING: %s not applied, %s", tuningPath, tuningWatcher->LastError().c_str());
         }
+        ticksThisWindow += ticks;
+        if (now - windowStart >= 1.0) {
+            ticksPerSecond = (int)(ticksThisWindow / (now - windowStart));
+            ticksThisWindow = 0;
+            windowStart = now;
+        }
+
+        World& scene = *shown;
+        musicFx.Get<DspLowPass>().SetCutoff(scene.state == GameState::PLAYING ? DspLowPass::OPEN_HZ : 900.0f);
 
         // -------------------------
         // DRAW
         // -------------------------
+        if (assets.Pending() > 0) {
+            PROFILE_ZONE("asset upload");
+            assets.Upload(ASSET_UPLOAD_BUDGET);
+            if (const raylib::Texture* art = assets.Get(spriteArt)) {
+                atlas.Use(*art);
+                spriteArt = {}; // The atlas holds the reference for the rest of the run
+            }
+        }
+
+        // Terrain updates render to texture, so do them before the frame begins
+        if (wantDirt && dirtBaker.Take(dirtImage)) {
+            PROFILE_ZONE("dirt upload");
+            if (dirtTexture.id == 0) dirtTexture.Load(dirtImage);
+            else dirtTexture.Update(dirtImage.data);
+            terrain.SetBackdrop(&dirtTexture);
+            wantDirt = false;
+        }
+        if (scene.state == GameState::PLAYING) {
+            PROFILE_ZONE("terrain sync");
+            const Player& p = net && net->LocalIndex() == 1 ? scene.partner : scene.player;
+            view.Follow(LerpPos(p.prevPos, p.pos, alpha) + raylib::Vector2(p.size / 2.0f, p.size / 2.0f));
+            minimap.Sync(scene);
+            terrain.Sync(scene, view.Visible());
+            if (fogOfWar) fog.Sync(scene, p);
+        }
+
         BeginDrawing();
+        filter.Begin();
         ClearBackground(BROWN);
 
-        if (world.state == GameState::SPLASH) {
-            ClearBackground(BLACK);
-            const char* title = "DIG DUG (Tunnel Edition)";
-            DrawText(title, SCREEN_W/2 - MeasureText(title, 32)/2, 120, 32, WHITE);
-            DrawText("Arrow keys: Move & dig", SCREEN_W/2 - 150, 200, 20, RAYWHITE);
-            DrawText("Space: Harpoon (kills red & green)", SCREEN_W/2 - 180, 230, 20, RAYWHITE);
-            DrawText("Enter tunnels to release monsters!", SCREEN_W/2 - 180, 260, 20, RAYWHITE);
-            DrawText("Press ENTER to Start", SCREEN_W/2 - 130, 320, 24, YELLOW);
-            DrawText(TextFormat("High Score: %d", world.highScore), 20, 20, 20, GRAY);
-        }
-        else if (world.state == GameState::PLAYING) {
-            // Draw tunnels first (as black areas)
-            for (auto& tunnel : world.tunnels) {
-                tunnel.Draw();
+        if (scene.state == GameState::SPLASH) {
+            drawSplash(scene.highScore);
+        }
+        else if (scene.state == GameState::PLAYING) {
+            {
+                PROFILE_ZONE("draw world");
+                view.BeginMode();
+                terrain.Draw(view.Visible());
+
+                sprites.SetCullRect(view.Visible());
+                scene.player.Draw(sprites, alpha);
+                if (scene.coop) scene.partner.Draw(sprites, alpha);
+                scene.enemies.Draw(sprites, alpha);
+                scene.fruit.Draw(sprites);
+                effects.Draw(sprites, alpha);
+                sprites.Flush();
+                if (fogOfWar) fog.Draw(scene);
+                view.EndMode();
             }
-            
-            // Draw dug areas on top
-            for (int y = 0; y < GRID_HEIGHT; y++) {
-                for (int x = 0; x < GRID_WIDTH; x++) {
-                    if (world.dug[y][x]) {
-                        DrawRectangle(x*TILE_SIZE, y*TILE_SIZE, TILE_SIZE, TILE_SIZE, BLACK);
-                    }
-                }
+
+            PROFILE_ZONE("hud");
+            scoreText.SetInts("Score: %i", scene.player.score);
+            scoreText.Queue(hud, SpriteBatch::HUD_FRONT, 20, 20);
+            highText.SetInts("High: %i", scene.highScore);
+            highText.Queue(hud, SpriteBatch::HUD_FRONT, 20, 44);
+            livesText.Queue(hud, SpriteBatch::HUD_FRONT, VIEW_W - 160, 20);
+            for (int i = 0; i < scene.player.lives; ++i)
+                hud.AddRect(SpriteBatch::HUD_BACK, Rectangle{ (float)(VIEW_W - 90 + i*22), 18, 18, 18 }, BLUE);
+            if (!fogOfWar) {
+                minimap.Draw(hud, scene, VIEW_W - GRID_WIDTH * Minimap::SCALE - 20,
+                             VIEW_H - GRID_HEIGHT * Minimap::SCALE - 40);
             }
 
-            world.player.Draw();
-            for (auto &m : world.monsters) m.Draw();
-            for (auto &d : world.dragons)  d.Draw();
-            world.fruit.Draw();
-
-            DrawText(TextFormat("Score: %i", world.player.score), 20, 20, 20, YELLOW);
-            DrawText(TextFormat("High: %i", world.highScore), 20, 44, 18, GRAY);
-            DrawText("Lives:", SCREEN_W - 160, 20, 20, WHITE);
-            for (int i = 0; i < world.player.lives; ++i)
-                DrawRectangle(SCREEN_W - 90 + i*22, 18, 18, 18, BLUE);
-
-            if (world.respawnTimer > 0) {
-                int secs = (world.respawnTimer / 60) + 1;
-                const char* msg = TextFormat("Respawning in %d...", secs);
-                DrawText(msg, SCREEN_W/2 - MeasureText(msg, 32)/2, SCREEN_H/2 - 16, 32, YELLOW);
+            int left = scene.RespawnTicksLeft();
+            if (left > 0) {
+                int secs = (left / SIM_HZ) + 1;
+                respawnText.SetInts("Respawning in %d...", secs);
+                respawnText.QueueCentered(hud, SpriteBatch::HUD_FRONT, VIEW_W/2, VIEW_H/2 - 16);
             }
         }
-        else if (world.state == GameState::GAMEOVER) {
+        else if (scene.state == GameState::GAMEOVER || scene.state == GameState::WIN) {
             ClearBackground(BLACK);
-            const char* msg = "GAME OVER";
-            DrawText(msg, SCREEN_W/2 - MeasureText(msg, 40)/2, 160, 40, RED);
-            DrawText(TextFormat("Final Score: %i", world.player.score), SCREEN_W/2 - 140, 220, 24, WHITE);
-            DrawText(TextFormat("High Score:  %i", world.highScore),   SCREEN_W/2 - 140, 250, 24, GRAY);
-
-            if (Button("Restart (Enter/R)", restartBtn) || IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_R)) {
-                world.ResetAll();
+            (scene.state == GameState::WIN ? winText : gameOverText).DrawCentered(VIEW_W/2, 160);
+            finalScoreText.SetInts("Final Score: %i", scene.player.score);
+            finalScoreText.Draw(VIEW_W/2 - 140, 220);
+            finalHighText.SetInts("High Score:  %i", scene.highScore);
+            finalHighText.Draw(VIEW_W/2 - 140, 250);
+
+            if (Button(restartLabel, restartBtn)) {
+                input.Click();
             }
         }
-        else if (world.state == GameState::WIN) {
-            ClearBackground(BLACK);
-            const char* msg = "YOU WIN!";
-            DrawText(msg, SCREEN_W/2 - MeasureText(msg, 40)/2, 160, 40, GREEN);
-            DrawText(TextFormat("Final Score: %i", world.player.score), SCREEN_W/2 - 140, 220, 24, WHITE);
-            DrawText(TextFormat("High Score:  %i", world.highScore),   SCREEN_W/2 - 140, 250, 24, GRAY);
 
-            if (Button("Restart (Enter/R)", restartBtn) || IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_R)) {
-                world.ResetAll();
+        if (stressEnemies > 0) {
+            static const int updateZone = Profiler::Zone("update");
+            Profiler::Stats frame = profiler.FrameStats();
+            Profiler::Stats update = profiler.ZoneStats(updateZone);
+            int alive = 0;
+            for (size_t i = 0; i < scene.enemies.Size(); i++) alive += scene.enemies.Alive(i);
+            // Formatted every frame on purpose: the numbers change every frame
+            raylib::FixedString<128> line;
+            line.Append(alive).Append(" enemies  ").Append(ticksPerSecond).Append(" ticks/s  frame ");
+            line.Append(frame.avgMs).Append(" ms (p99 ").Append(frame.p99Ms).Append(")  update ").Append(update.avgMs);
+            line.Append(" ms  ").Append(terrain.Resident()).Append(" chunks  map ").Append((int)minimap.Uploaded());
+            line.Append(" B  quality ").Append(quality.Level());
+            line.Append("  runs ").Append(sprites.LastRuns() + hud.LastRuns());
+            stressText.Set(line);
+            Rectangle bar{ 0, (float)(VIEW_H - 30), (float)VIEW_W, 30 };
+            hud.AddRect(SpriteBatch::HUD_BACK, bar, Fade(BLACK, 0.7f));
+            stressText.Queue(hud, SpriteBatch::HUD_FRONT, 10, VIEW_H - 25);
+        }
+
+        if (net) {
+            if (!net->Started()) netText.Set("Waiting for the host...");
+            else if (net->TicksSinceHeard() > SIM_HZ / 2) netText.Set("Waiting for the other player...");
+            else if (net->Desynced()) netText.Set("Out of sync with the other player");
+            else netText.SetInts("Co-op  tick %d  rollbacks %d", (int)net->Frame(), net->Rollbacks());
+            Rectangle bar{ 0, (float)(VIEW_H - 30), (float)VIEW_W, 30 };
+            hud.AddRect(SpriteBatch::HUD_BACK, bar, Fade(BLACK, 0.7f));
+            netText.Queue(hud, SpriteBatch::HUD_FRONT, 10, VIEW_H - 25);
+        }
+        {
+            PROFILE_ZONE("hud flush");
+            hud.Flush();
+        }
+
+        // The profiler's readouts stay out of the filter, sharp
+        filter.End();
+        int overlayH = profiler.DrawOverlay(VIEW_W - 340, 50);
+        if (overlayH > 0) DrawMemoryOverlay(VIEW_W - 340, 50 + overlayH + 4, assets);
+        if (profiler.Capturing())
+            DrawText(TextFormat("TRACE %d events", (int)profiler.CapturedEvents()), VIEW_W - 340, VIEW_H - 24, 10, RED);
+
+        {
+            // Includes the vsync wait
+            PROFILE_ZONE("present");
+            if (lowLatency) pacer.Presenting();
+            EndDrawing();
+            if (lowLatency) pacer.Presented();
+        }
+        // EndDrawing polls input too; take its presses now, before the late poll replaces them
+        if (lowLatency) sampleInput();
+        profiler.EndFrame();
+        if (adaptiveQuality && scene.state == GameState::PLAYING) {
+            static const int paceZone = lowLatency ? Profiler::Zone("pace wait") : -1;
+            static const int presentZone = Profiler::Zone("present");
+            float frameMs = profiler.LastFrameMs();
+            float workMs = frameMs - profiler.LastZoneMs(presentZone) - profiler.LastZoneMs(paceZone);
+            if (quality.Sample(frameMs, workMs)) {
+                applyQuality();
+                TraceLog(LOG_INFO, "QUALITY: Level %d of %d (frame p95 %.1f ms, work p95 %.1f ms, budget %.1f ms)",
+                         quality.Level(), QualityController::MAX_LEVEL, quality.FrameP95(), quality.WorkP95(),
+                         quality.Budget());
+            }
+        }
+        if (telemetry) {
+            perfFrames++;
+            perfFrameMs += GetFrameTime() * 1000.0;
+            if (GetTime() - perfStart >= TELEMETRY_PERF_PERIOD) {
+                uint32_t tickCount = 0;
+                float p99 = tickTimes.Take(0.99, &tickCount);
+                telemetry->Add(TelemetryKind::PERF, perfFrames, (int32_t)tickCount,
+                               (float)(perfFrameMs / perfFrames), p99);
+                sessionFrames += perfFrames;
+                perfFrames = 0;
+                perfFrameMs = 0.0;
+                perfStart = GetTime();
             }
         }
+        if (startupTracePath) {
+            profiler.StopCapture();
+            profiler.WriteChromeTrace(startupTracePath);
+            TraceLog(LOG_INFO, "STARTUP: First frame after startup done after %.1f ms, trace in %s", sinceLaunch(),
+                     startupTracePath);
+            startupTracePath = nullptr;
+        }
+    }
 
-        EndDrawing();
+    sim.reset(); // Stops the ticks before the recording is read
+
+    // Stress, co-op, retuned, throttled and scripted sessions have worlds, input, tuning or
+    // enemies the replayer can't rebuild
+    bool retuned = tuningWatcher && tuningWatcher->Reloads() > 0;
+    if (stressEnemies == 0 && !net && !retuned && !aiThrottled && !scriptedEnemies) recorder.Export("session.rae");
+
+    if (telemetry) {
+        telemetry->Add(TelemetryKind::SESSION_END, (int32_t)telemetry->Dropped(), sessionFrames + perfFrames);
+        telemetry->Stop(); // Sends what is left
+        TraceLog(LOG_INFO, "TELEMETRY: %u batches sent, %u failed, %u records dropped", telemetry->BatchesSent(),
+                 telemetry->BatchesFailed(), telemetry->Dropped());
     }
 
     return 0;